@@ -0,0 +1,73 @@
+/*
+ * Copyright 2022 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/// @file
+/// @brief Header file for timing the benchmark programs.
+
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+
+
+/// Helpers shared by the benchmark programs. The benchmarks measure the portable parts of the application
+/// with synthetic data, so that performance claims can be reproduced on any platform.
+///
+namespace MeaBenchmark {
+
+    /// Runs the specified function repeatedly until at least the specified time has elapsed, after one untimed
+    /// run to warm up caches and allocate buffers.
+    ///
+    /// @param func         [in] Function to time.
+    /// @param minSeconds   [in] Minimum total time for the timed runs.
+    ///
+    /// @return Mean time per run, in seconds.
+    ///
+    template <typename Func>
+    double Time(Func func, double minSeconds = 0.5) {
+        typedef std::chrono::steady_clock Clock;
+
+        func();
+
+        long runs = 0;
+        const Clock::time_point start = Clock::now();
+        double elapsed = 0.0;
+        do {
+            func();
+            runs++;
+            elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+        } while (elapsed < minSeconds);
+
+        return elapsed / static_cast<double>(runs);
+    }
+
+    /// Prints a line of benchmark results.
+    ///
+    /// @param name     [in] Name of the measured case.
+    /// @param seconds  [in] Mean time per run, in seconds.
+    /// @param bytes    [in] Number of bytes processed per run, or 0 if throughput is not meaningful.
+    ///
+    inline void Report(const char* name, double seconds, double bytes = 0.0) {
+        if (bytes > 0.0) {
+            std::printf("%-40s %10.3f ms %10.2f GB/s\n", name, seconds * 1e3, bytes / seconds / 1e9);
+        } else {
+            std::printf("%-40s %10.3f ms\n", name, seconds * 1e3);
+        }
+    }
+};
@@ -0,0 +1,178 @@
+/*
+ * Copyright 2022 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/// @file
+/// @brief Benchmark of the magnifier image rendering.
+
+#include "Benchmark.h"
+#include <meazure/graphics/MagnifierRenderer.h>
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+typedef MeaMagnifierRenderer::Pixel Pixel;
+typedef MeaMagnifierRenderer::Image Image;
+
+
+namespace {
+    const int kZoomFactors[] = { 1, 2, 3, 4, 6, 8, 16, 32 };   // As in MeaMagnifier::kZoomFactorArr
+    const int kMinGridFactor = 6;                               // As in MeaMagnifier::kMinGridFactor
+    const int kSize = 512;                                      // Width and height of the magnifier image
+
+    /// Pixel buffer owned by the benchmark.
+    struct Buffer {
+        Buffer(int width, int height) :
+            pixels(static_cast<std::size_t>(width) * height),
+            image { pixels.data(), width, height, width } {}
+
+        std::vector<Pixel> pixels;
+        Image image;
+    };
+
+    /// Renderer that draws in separate passes, as the magnifier did before rendering in a single pass: the
+    /// image is scaled, then the frame, grid lines and center marker are drawn over it. Used as the baseline.
+    class MultiPassRenderer {
+
+    public:
+        void Render(const Image& src, const Image& dst, bool showGrid) {
+            ComputeEdges(m_xEdges, src.m_width, dst.m_width);
+            ComputeEdges(m_yEdges, src.m_height, dst.m_height);
+
+            for (int sy = 0; sy < src.m_height; sy++) {
+                const Pixel* srcRow = src.Row(sy);
+                Pixel* dstRow = dst.Row(m_yEdges[sy]);
+                for (int sx = 0; sx < src.m_width; sx++) {
+                    std::fill(dstRow + m_xEdges[sx], dstRow + m_xEdges[sx + 1], srcRow[sx]);
+                }
+                for (int dy = m_yEdges[sy] + 1; dy < m_yEdges[sy + 1]; dy++) {
+                    std::copy(dstRow, dstRow + dst.m_width, dst.Row(dy));
+                }
+            }
+
+            const int width = dst.m_width;
+            const int height = dst.m_height;
+            const Pixel frame = MeaMagnifierRenderer::kFrameColor;
+            const Pixel marker = MeaMagnifierRenderer::kMarkerColor;
+
+            HLine(dst, 0, width, 0, frame);
+            HLine(dst, 0, width, height - 1, frame);
+            VLine(dst, 0, 0, height, frame);
+            VLine(dst, width - 1, 0, height, frame);
+
+            if (showGrid) {
+                for (int sx = 0; sx < src.m_width; sx++) {
+                    VLine(dst, m_xEdges[sx], 0, height, frame);
+                }
+                for (int sy = 0; sy < src.m_height; sy++) {
+                    HLine(dst, 0, width, m_yEdges[sy], frame);
+                }
+            }
+
+            int cx = src.m_width / 2;
+            int cy = src.m_height / 2;
+            int left = m_xEdges[cx];
+            int top = m_yEdges[cy];
+            int right = m_xEdges[cx + 1] + 1;
+            int bottom = m_yEdges[cy + 1] + 1;
+            HLine(dst, left, right, top, marker);
+            HLine(dst, left, right, bottom - 1, marker);
+            VLine(dst, left, top, bottom, marker);
+            VLine(dst, right - 1, top, bottom, marker);
+        }
+
+    private:
+        static void ComputeEdges(std::vector<int>& edges, int srcLength, int dstLength) {
+            edges.resize(static_cast<std::size_t>(srcLength) + 1);
+            for (int i = 0; i <= srcLength; i++) {
+                edges[i] = i * dstLength / srcLength;
+            }
+        }
+
+        static void HLine(const Image& dst, int x1, int x2, int y, Pixel color) {
+            if (y < 0 || y >= dst.m_height) {
+                return;
+            }
+            x1 = std::max(x1, 0);
+            x2 = std::min(x2, dst.m_width);
+            if (x1 < x2) {
+                std::fill(dst.Row(y) + x1, dst.Row(y) + x2, color);
+            }
+        }
+
+        static void VLine(const Image& dst, int x, int y1, int y2, Pixel color) {
+            if (x < 0 || x >= dst.m_width) {
+                return;
+            }
+            for (int y = std::max(y1, 0); y < std::min(y2, dst.m_height); y++) {
+                dst.Row(y)[x] = color;
+            }
+        }
+
+        std::vector<int> m_xEdges;
+        std::vector<int> m_yEdges;
+    };
+}
+
+
+int main() {
+    std::printf("%dx%d magnifier image, surfaces reused across frames\n", kSize, kSize);
+
+    MeaMagnifierRenderer renderer;
+    MultiPassRenderer multiPassRenderer;
+    Buffer dst(kSize, kSize);
+    Buffer multiPassDst(kSize, kSize);
+
+    for (int zoom : kZoomFactors) {
+        // The source rectangle is sized as by the magnifier, and is captured next to the left edge of the screen
+        // so that part of it is blanked.
+        int srcLen = std::max((kSize / zoom) / 2, 1);
+        int srcWidth = 2 * srcLen - 1;
+        Buffer src(srcWidth, srcWidth);
+        unsigned int seed = 1;
+        for (Pixel& pixel : src.pixels) {
+            seed = seed * 1664525U + 1013904223U;
+            pixel = seed >> 8;
+        }
+        bool showGrid = zoom >= kMinGridFactor;
+
+        double seconds = MeaBenchmark::Time([&]() {
+            MeaMagnifierRenderer::ClearOutside(src.image, srcLen / 2, 0, srcWidth, srcWidth);
+            renderer.Render(src.image, dst.image, showGrid);
+        });
+        double multiPassSeconds = MeaBenchmark::Time([&]() {
+            MeaMagnifierRenderer::ClearOutside(src.image, srcLen / 2, 0, srcWidth, srcWidth);
+            multiPassRenderer.Render(src.image, multiPassDst.image, showGrid);
+        });
+
+        char name[64];
+        std::snprintf(name, sizeof(name), "Zoom %dx%s", zoom, showGrid ? " with grid" : "");
+        MeaBenchmark::Report(name, seconds);
+        std::snprintf(name, sizeof(name), "Zoom %dx%s, multiple passes", zoom, showGrid ? " with grid" : "");
+        MeaBenchmark::Report(name, multiPassSeconds);
+        std::printf("Speedup %.1fx\n", multiPassSeconds / seconds);
+
+        // Both renderers must produce the same image for the comparison to be meaningful.
+        if (dst.pixels != multiPassDst.pixels) {
+            std::fprintf(stderr, "Renderers differ at zoom %dx\n", zoom);
+            return 1;
+        }
+    }
+
+    return 0;
+}
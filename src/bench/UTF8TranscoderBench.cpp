@@ -0,0 +1,76 @@
+/*
+ * Copyright 2022 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/// @file
+/// @brief Benchmark of the table driven UTF-8 transcoder.
+
+#include "Benchmark.h"
+#include <meazure/utilities/UTF8Transcoder.h>
+#include <random>
+#include <string>
+
+
+namespace {
+    /// Builds mostly ASCII text with an occasional Latin-1 accented character, which is typical of the names
+    /// and descriptions written to position logs.
+    std::string MakeText(std::size_t size) {
+        std::mt19937 random(1);
+        std::uniform_int_distribution<int> ascii(0x20, 0x7E);
+        std::uniform_int_distribution<int> high(0xC0, 0xFF);
+        std::uniform_int_distribution<int> percent(0, 99);
+
+        std::string text;
+        text.reserve(size);
+        while (text.size() < size) {
+            text.push_back(static_cast<char>((percent(random) == 0) ? high(random) : ascii(random)));
+        }
+        return text;
+    }
+}
+
+
+int main() {
+    constexpr std::size_t kTextSize { 1024 * 1024 };
+
+    const std::string text = MakeText(kTextSize);
+    const MeaUTF8Transcoder transcoder(MeaUTF8Transcoder::Latin1Table());
+    std::string out;
+    out.reserve(2 * kTextSize);
+
+    // Table driven conversion of the whole text into a reused buffer.
+    double seconds = MeaBenchmark::Time([&]() {
+        out.clear();
+        transcoder.Append(out, text.data(), text.size());
+    });
+    MeaBenchmark::Report("Table driven", seconds, static_cast<double>(kTextSize));
+
+    // Conversion one character at a time, each into its own string, as when a conversion function is called
+    // for every character.
+    seconds = MeaBenchmark::Time([&]() {
+        out.clear();
+        for (char ch : text) {
+            std::string encoded;
+            MeaUTF8Transcoder::AppendCodePoint(encoded, static_cast<unsigned char>(ch));
+            out += encoded;
+        }
+    });
+    MeaBenchmark::Report("Per character", seconds, static_cast<double>(kTextSize));
+
+    return (out.size() >= kTextSize) ? 0 : 1;
+}
@@ -28,6 +28,19 @@
 #pragma data_seg("MeaHooksShared")
 DWORD g_meaHookThreadId { 0 };
 HHOOK g_meaMouseHook { nullptr };
+
+// Latest pointer position. The x coordinate is held in the low 32 bits and
+// the y coordinate in the high 32 bits so that both are published with a
+// single atomic exchange. Every hook publishes its position unconditionally,
+// so the last position seen by any input thread always wins and there is no
+// intermediate state that a stalled or terminated writer can leave behind.
+// The sequence is incremented after each position is published.
+volatile LONGLONG g_meaMousePosition { 0 };
+volatile LONGLONG g_meaMouseTimestamp { 0 };
+volatile LONG g_meaMouseSequence { 0 };
+
+volatile LONG g_meaMouseNotifyPending { 0 };    // Nonzero while a MEA_MOUSE_MSG has not been handled
+volatile LONG g_meaMousePublished { 0 };        // Number of samples published
 #pragma data_seg()
 
 #pragma comment(linker, "/section:MeaHooksShared,rws")
@@ -37,6 +50,24 @@ HHOOK g_meaMouseHook { nullptr };
 
 HINSTANCE g_hInstDll { nullptr };
 
+// Consumer side state. Only the process that enabled the hook reads samples.
+
+LONG g_meaLastSequence { 0 };       // Sequence number of the last sample read
+LONG g_meaConsumed { 0 };           // Number of samples read
+LONGLONG g_meaLastLatency { 0 };    // Performance counter ticks between publishing and reading the last sample
+LONGLONG g_meaMaxLatency { 0 };
+LONGLONG g_meaTotalLatency { 0 };
+
+
+/// Reads a 64-bit shared value atomically, including in a 32-bit process.
+///
+/// @param value    [in] Value to read.
+/// @return Value read.
+///
+static LONGLONG AtomicRead(volatile LONGLONG* value) {
+    return InterlockedCompareExchange64(value, 0, 0);
+}
+
 
 /// Entry point for the DLL.
 ///
@@ -72,8 +103,27 @@ BOOL APIENTRY DllMain(HINSTANCE hModule, DWORD  reason, LPVOID /* lpReserved */)
 LRESULT CALLBACK MouseHookProc(int nCode, WPARAM wParam, LPARAM lParam) {
     if (nCode == HC_ACTION) {
         MOUSEHOOKSTRUCT* mhs = (MOUSEHOOKSTRUCT*)lParam;
-        LPARAM coords = MAKELPARAM(mhs->pt.x, mhs->pt.y);
-        PostThreadMessage(g_meaHookThreadId, MEA_MOUSE_MSG, 0, coords);
+
+        // Mouse hooks run on the input threads of every process. Each hook
+        // overwrites the shared position, so when hooks race the position
+        // left in place is the one published last.
+        LARGE_INTEGER now;
+        QueryPerformanceCounter(&now);
+
+        LONGLONG position = static_cast<LONGLONG>((static_cast<ULONGLONG>(static_cast<ULONG>(mhs->pt.y)) << 32) |
+                                                  static_cast<ULONG>(mhs->pt.x));
+        InterlockedExchange64(&g_meaMouseTimestamp, now.QuadPart);
+        InterlockedExchange64(&g_meaMousePosition, position);
+        InterlockedIncrement(&g_meaMouseSequence);
+        InterlockedIncrement(&g_meaMousePublished);
+
+        // Only wake the application if it has handled the previous notification.
+        // The notification is cleared before the application reads the position,
+        // so a position published while a notification is pending is always read.
+        if (InterlockedExchange(&g_meaMouseNotifyPending, 1) == 0) {
+            LPARAM coords = MAKELPARAM(mhs->pt.x, mhs->pt.y);
+            PostThreadMessage(g_meaHookThreadId, MEA_MOUSE_MSG, 0, coords);
+        }
     }
 
     return CallNextHookEx(g_meaMouseHook, nCode, wParam, lParam);
@@ -83,6 +133,15 @@ bool MeaEnableMouseHook() {
     _ASSERT(g_meaMouseHook == nullptr);
 
     g_meaHookThreadId = GetCurrentThreadId();
+
+    g_meaLastSequence = g_meaMouseSequence;
+    g_meaConsumed = 0;
+    g_meaLastLatency = 0;
+    g_meaMaxLatency = 0;
+    g_meaTotalLatency = 0;
+    InterlockedExchange(&g_meaMousePublished, 0);
+    InterlockedExchange(&g_meaMouseNotifyPending, 0);
+
     g_meaMouseHook = SetWindowsHookEx(WH_MOUSE, MouseHookProc, g_hInstDll, 0);
 
     return (g_meaMouseHook != nullptr);
@@ -91,6 +150,13 @@ bool MeaEnableMouseHook() {
 bool MeaDisableMouseHook() {
     _ASSERT(g_meaMouseHook != nullptr);
 
+#ifdef _DEBUG
+    MeaMouseHookStats stats;
+    MeaGetMouseHookStats(stats);
+    _RPT5(_CRT_WARN, "Mouse hook: %ld published, %ld coalesced, latency last %lld us, avg %lld us, max %lld us\n",
+          stats.m_published, stats.m_coalesced, stats.m_lastLatencyUs, stats.m_avgLatencyUs, stats.m_maxLatencyUs);
+#endif
+
     // Turn off the hook
     bool ret = UnhookWindowsHookEx(g_meaMouseHook) ? true : false;
     g_meaMouseHook = nullptr;
@@ -99,6 +165,52 @@ bool MeaDisableMouseHook() {
     MSG msg;
     while (PeekMessage(&msg, nullptr, MEA_MOUSE_MSG, MEA_MOUSE_MSG, PM_REMOVE)) {
     }
+    InterlockedExchange(&g_meaMouseNotifyPending, 0);
 
     return ret;
 }
+
+bool MeaReadMouseSample(MeaMouseSample& sample) {
+    // Clear the notification before reading so that a position published
+    // after this point posts a new message rather than being missed.
+    InterlockedExchange(&g_meaMouseNotifyPending, 0);
+
+    // The sequence is read before the position. If a hook publishes in between,
+    // the newer position is returned now and returned again by the next read.
+    LONG sequence = InterlockedCompareExchange(&g_meaMouseSequence, 0, 0);
+    if (sequence == g_meaLastSequence) {
+        return false;
+    }
+    g_meaLastSequence = sequence;
+
+    ULONGLONG position = static_cast<ULONGLONG>(AtomicRead(&g_meaMousePosition));
+    sample.m_pos.x = static_cast<LONG>(static_cast<ULONG>(position));
+    sample.m_pos.y = static_cast<LONG>(static_cast<ULONG>(position >> 32));
+    sample.m_timestamp = AtomicRead(&g_meaMouseTimestamp);
+    sample.m_sequence = sequence;
+
+    LARGE_INTEGER now;
+    QueryPerformanceCounter(&now);
+    LONGLONG latency = now.QuadPart - sample.m_timestamp;
+    g_meaConsumed++;
+    g_meaLastLatency = latency;
+    g_meaTotalLatency += latency;
+    if (latency > g_meaMaxLatency) {
+        g_meaMaxLatency = latency;
+    }
+    return true;
+}
+
+void MeaGetMouseHookStats(MeaMouseHookStats& stats) {
+    LARGE_INTEGER frequency;
+    QueryPerformanceFrequency(&frequency);
+
+    auto toMicroseconds = [&frequency](LONGLONG ticks) { return (ticks * 1000000) / frequency.QuadPart; };
+
+    stats.m_published = g_meaMousePublished;
+    stats.m_consumed = g_meaConsumed;
+    stats.m_coalesced = stats.m_published - stats.m_consumed;
+    stats.m_lastLatencyUs = toMicroseconds(g_meaLastLatency);
+    stats.m_maxLatencyUs = toMicroseconds(g_meaMaxLatency);
+    stats.m_avgLatencyUs = (stats.m_consumed == 0) ? 0 : toMicroseconds(g_meaTotalLatency / stats.m_consumed);
+}
@@ -30,6 +30,29 @@
 // Mouse hook message
 #define MEA_MOUSE_MSG (WM_USER + 1)
 
+
+/// Most recent mouse pointer position reported by the mouse hook.
+///
+struct MeaMouseSample {
+    POINT m_pos;                ///< Pointer position, in screen coordinates.
+    LONGLONG m_timestamp;       ///< Performance counter value when the hook saw the position. When hooks on
+                                ///< different threads race, it may be that of a position published at nearly
+                                ///< the same time.
+    LONG m_sequence;            ///< Sequence number, which changes each time a sample is published.
+};
+
+/// Counters describing how pointer positions have moved from the mouse hook to
+/// the application since the hook was enabled.
+///
+struct MeaMouseHookStats {
+    LONG m_published;           ///< Number of samples published by the hook.
+    LONG m_consumed;            ///< Number of samples read by the application.
+    LONG m_coalesced;           ///< Samples replaced by a newer sample before they were read.
+    LONGLONG m_lastLatencyUs;   ///< Time between publishing and reading the last sample read, in microseconds.
+    LONGLONG m_maxLatencyUs;    ///< Longest time between publishing and reading a sample, in microseconds.
+    LONGLONG m_avgLatencyUs;    ///< Average time between publishing and reading a sample, in microseconds.
+};
+
 /// Enables mouse position reporting. This function installs the mouse hook
 /// procedure that calls back to processes that are interested in the mouse
 /// pointer position as it changes.
@@ -44,3 +67,24 @@ MEA_HOOKSAPI bool MeaEnableMouseHook(void);
 /// @return <b>true</b> if the mouse hook was removed successfully.
 ///
 MEA_HOOKSAPI bool MeaDisableMouseHook(void);
+
+/// Obtains the most recent pointer position published by the mouse hook.
+/// The hook does not post a message for every mouse event. Instead, it
+/// overwrites a single shared sample and posts MEA_MOUSE_MSG only if the
+/// previous message has been handled. Calling this function marks the
+/// message as handled, so the handler of MEA_MOUSE_MSG must call it to
+/// receive further messages. Positions published while a message is
+/// pending are coalesced so that only the newest is processed.
+///
+/// @param sample   [out] Most recent pointer position.
+/// @return <b>true</b> if a sample was published since the last call.
+///
+MEA_HOOKSAPI bool MeaReadMouseSample(MeaMouseSample& sample);
+
+/// Obtains the counters describing the delivery of pointer positions from
+/// the mouse hook. In a debug build, the counters are also written to the
+/// debugger output when the hook is disabled.
+///
+/// @param stats    [out] Delivery counters.
+///
+MEA_HOOKSAPI void MeaGetMouseHookStats(MeaMouseHookStats& stats);
@@ -19,18 +19,16 @@
 
 #include <meazure/pch.h>
 #include "CrossHair.h"
-#include "Plotter.h"
+#include "FramePacer.h"
 #include <meazure/resource.h>
 #include <meazure/ui/Layout.h>
 #define COMPILE_LAYERED_WINDOW_STUBS
 #include <meazure/ui/LayeredWindows.h>
 #include <cassert>
-#include <functional>
+#include <cstring>
+#include <vector>
 
 
-CSize MeaCrossHair::m_size;
-CSize MeaCrossHair::m_halfSize;
-CSize MeaCrossHair::m_spread;
 UINT MeaCrossHair::m_flashInterval { 100 };
 
 
@@ -50,11 +48,16 @@ MeaCrossHair::MeaCrossHair(const MeaScreenProvider& screenProvider, const MeaUni
     m_screenProvider(screenProvider),
     m_unitsProvider(unitsProvider),
     m_callback(nullptr),
+    m_targetLeftTop(0, 0),
+    m_composited(false),
     m_mouseCaptured(false),
     m_mouseOver(false),
     m_backBrush(nullptr),
     m_borderBrush(nullptr),
     m_hiliteBrush(nullptr),
+    m_borderColor(0),
+    m_backColor(0),
+    m_hiliteColor(0),
     m_drawState(Normal),
     m_flashCount(0),
     m_opacity(255),
@@ -88,29 +91,13 @@ bool MeaCrossHair::Create(COLORREF borderColor, COLORREF backColor,
 
     SetColors(borderColor, backColor, hiliteColor);
 
-    // Calculate class properties of the crosshair when the first
-    // instance of the class is created.
+    // Crosshairs with the same size share their shape, so the shape
+    // is only computed when the first of them is created.
     //
-    if (m_size.cx == 0) {
-        MeaFSize res = m_screenProvider.GetScreenRes(m_screenProvider.GetScreenIter(AfxGetMainWnd()));
-
-        // When screen scaling is being used (i.e. scaling > 100%), GDI will automatically scale polygons
-        // using the effective DPI. To counteract this scaling, we will reduce the actual resolution by
-        // the screen scaling factor. That way when GDI scales up the polygons, they will be rendered at the
-        // actual DPI.
-        res = res / MeaLayout::GetDPIScaleFactor(*AfxGetMainWnd());
-
-        m_size = m_unitsProvider.ConvertToPixels(MeaInchesId, res, 0.25, 25);
-        m_size.cx += 1 - (m_size.cx % 2);       // Must be odd
-        m_size.cy += 1 - (m_size.cy % 2);
-
-        m_halfSize.cx = m_size.cx / 2;
-        m_halfSize.cy = m_size.cy / 2;
-
-        m_spread = m_unitsProvider.ConvertToPixels(MeaInchesId, res, 0.04, 4);
-        m_spread.cx += (m_spread.cx % 2);       // Must be even
-        m_spread.cy += (m_spread.cy % 2);
-    }
+    m_shape = AcquireShape();
+    m_size = m_shape->GetSize();
+    m_halfSize.cx = m_size.cx / 2;
+    m_halfSize.cy = m_size.cy / 2;
 
     assert(m_backBrush != nullptr);
     CString wndClass = AfxRegisterWndClass(CS_HREDRAW | CS_VREDRAW,
@@ -120,7 +107,12 @@ bool MeaCrossHair::Create(COLORREF borderColor, COLORREF backColor,
         return false;
     }
 
-    if (HaveLayeredWindows() && (parent == nullptr)) {
+    // Popup crosshairs are presented as layered windows using per-pixel
+    // alpha, so they are rendered only when their appearance changes.
+    // Moving them does not require repainting.
+    //
+    m_composited = HaveLayeredWindows() && (parent == nullptr);
+    if (m_composited) {
         ModifyStyleEx(0, WS_EX_LAYERED);
         SetOpacity(opacity);
     }
@@ -157,7 +149,38 @@ bool MeaCrossHair::Create(COLORREF borderColor, COLORREF backColor,
     return true;
 }
 
+MeaCrossHairShapeCache& MeaCrossHair::GetShapeCache() {
+    static MeaCrossHairShapeCache cache;
+    return cache;
+}
+
+MeaCrossHairShapeCache::ShapePtr MeaCrossHair::AcquireShape() const {
+    MeaFSize res = m_screenProvider.GetScreenRes(m_screenProvider.GetScreenIter(AfxGetMainWnd()));
+
+    // When screen scaling is being used (i.e. scaling > 100%), GDI will automatically scale polygons
+    // using the effective DPI. To counteract this scaling, we will reduce the actual resolution by
+    // the screen scaling factor. That way when GDI scales up the polygons, they will be rendered at the
+    // actual DPI.
+    double dpiScale = MeaLayout::GetDPIScaleFactor(*AfxGetMainWnd());
+    res = res / dpiScale;
+
+    MeaCrossHairShape::Key key;
+    key.m_size = m_unitsProvider.ConvertToPixels(MeaInchesId, res, 0.25, 25);
+    key.m_size.cx += 1 - (key.m_size.cx % 2);       // Must be odd
+    key.m_size.cy += 1 - (key.m_size.cy % 2);
+
+    key.m_spread = m_unitsProvider.ConvertToPixels(MeaInchesId, res, 0.04, 4);
+    key.m_spread.cx += (key.m_spread.cx % 2);       // Must be even
+    key.m_spread.cy += (key.m_spread.cy % 2);
+
+    key.m_layers = kPetalLayers;
+    key.m_dpiScale = dpiScale;
+
+    return GetShapeCache().Acquire(key);
+}
+
 void MeaCrossHair::OnDestroy() {
+    MeaFramePacer::Forget(*this);
     MeaGraphic::OnDestroy();
 
     DestroyColors();
@@ -173,6 +196,9 @@ void MeaCrossHair::OnDestroy() {
         m_backDC.DeleteDC();
         m_origBackBitmap = nullptr;
     }
+
+    m_surface.Free();
+    m_shape.reset();
 }
 
 BOOL MeaCrossHair::PreTranslateMessage(MSG* pMsg) {
@@ -192,9 +218,12 @@ void MeaCrossHair::SetColors(COLORREF borderColor, COLORREF backColor,
     m_backBrush = new CBrush(backColor);
     m_hiliteBrush = new CBrush(hiliteColor);
 
+    m_borderColor = borderColor;
+    m_backColor = backColor;
+    m_hiliteColor = hiliteColor;
+
     if (m_hWnd != nullptr) {
-        Invalidate(FALSE);
-        UpdateWindow();
+        Redraw();
     }
 }
 
@@ -202,11 +231,10 @@ void MeaCrossHair::SetOpacity(BYTE opacity) {
     m_opacity = opacity;
 
     if (m_hWnd != nullptr) {
-        if (m_parent == nullptr) {
-            SetLayeredWindowAttributes(*this, 0, opacity, LWA_ALPHA);
+        if (m_composited || (m_parent != nullptr)) {
+            Redraw();
         } else {
-            Invalidate(FALSE);
-            UpdateWindow();
+            SetLayeredWindowAttributes(*this, 0, opacity, LWA_ALPHA);
         }
     }
 }
@@ -227,9 +255,6 @@ void MeaCrossHair::DestroyColors() {
 }
 
 void MeaCrossHair::SetRegion() {
-    POINT coords[4 * kTotalLayers];
-    POINT* coord = coords;
-
     // Each petal of the crosshair is made up of stacked rectangles.
     // Each rectangle is thk high by 2 * spread wide. Each rectangle
     // is called a layer.
@@ -245,31 +270,74 @@ void MeaCrossHair::SetRegion() {
     //          * *            |
     //           *             |
     //           * -------------
+    //
+    // The shape has already converted the layers into region
+    // rectangles, so the region is created directly from them
+    // rather than by filling the polygons.
+
+    const std::vector<RECT>& rects = m_shape->GetRegionRects();
+    const DWORD rectsSize = static_cast<DWORD>(rects.size() * sizeof(RECT));
+
+    std::vector<BYTE> data(sizeof(RGNDATAHEADER) + rectsSize);
+    RGNDATA* regionData = reinterpret_cast<RGNDATA*>(data.data());
+    regionData->rdh.dwSize = sizeof(RGNDATAHEADER);
+    regionData->rdh.iType = RDH_RECTANGLES;
+    regionData->rdh.nCount = static_cast<DWORD>(rects.size());
+    regionData->rdh.nRgnSize = rectsSize;
+    regionData->rdh.rcBound = m_shape->GetRegionBounds();
+    if (!rects.empty()) {
+        std::memcpy(regionData->Buffer, rects.data(), rectsSize);
+    }
 
-    std::function<void(int, int)> addPoint = [&](int x, int y) {
-        coord->x = x;
-        coord->y = y;
-        coord++;
-    };
+    HRGN region = ::ExtCreateRegion(nullptr, static_cast<DWORD>(data.size()), regionData);
+    if (region == nullptr) {
+        const MeaCrossHairShape& shape = *m_shape;
+        region = ::CreatePolyPolygonRgn(shape.GetVertices().data(), shape.GetPolyCounts().data(),
+                                        static_cast<int>(shape.GetPolyCounts().size()), ALTERNATE);
+    }
+    SetWindowRgn(region, FALSE);
+}
 
-    MeaPlotter::PlotCrosshair(m_size, m_spread, kPetalLayers, addPoint);
+void MeaCrossHair::Redraw() {
+    if (m_composited) {
+        Render();
+    } else {
+        Invalidate(FALSE);
+        UpdateWindow();
+    }
+}
 
-    HRGN region = ::CreatePolyPolygonRgn(coords, m_numCoords.data(), kTotalLayers, ALTERNATE);
-    SetWindowRgn(region, FALSE);
+void MeaCrossHair::Render() {
+    if (!m_surface.Allocate(m_size)) {
+        return;
+    }
+
+    // The crosshair is rendered from its shape's mask, which classifies
+    // each pixel as outside, inside or on the border of the crosshair.
+    //
+    const MeaLayeredRaster::Pixel palette[] = {
+        0,
+        MeaLayeredRaster::Premultiply(MeaLayeredRaster::FromColorRef(m_mouseOver ? m_hiliteColor : m_backColor),
+                                      m_opacity),
+        MeaLayeredRaster::Premultiply(
+            MeaLayeredRaster::FromColorRef((m_drawState == Normal) ? m_borderColor : m_hiliteColor), m_opacity)
+    };
+    MeaLayeredRaster::RenderMask(m_surface.GetImage(), m_shape->GetMask().data(), m_size.cx, palette,
+                                 sizeof(palette) / sizeof(palette[0]));
+
+    m_surface.Present(*this);
 }
 
 void MeaCrossHair::SetPosition(const POINT& center) {
-    POINT leftTop = GetLeftTop(center);
-    SetWindowPos(nullptr, leftTop.x, leftTop.y, 0, 0,
-        SWP_NOZORDER | SWP_NOSIZE | SWP_NOACTIVATE | SWP_NOSENDCHANGING);
+    m_targetLeftTop = GetLeftTop(center);
+    MeaFramePacer::Move(*this, m_targetLeftTop.x, m_targetLeftTop.y);
 }
 
 void MeaCrossHair::Flash(int flashCount) {
     if (m_hWnd != nullptr) {
         m_flashCount = flashCount;
         m_drawState = Inverted;
-        Invalidate(FALSE);
-        UpdateWindow();
+        Redraw();
         SetTimer(ID_MEA_CROSSHAIR_TIMER, m_flashInterval, nullptr);
     }
 }
@@ -277,8 +345,7 @@ void MeaCrossHair::Flash(int flashCount) {
 void MeaCrossHair::OnTimer(UINT_PTR timerId) {
     KillTimer(timerId);
     m_drawState = (m_drawState == Normal) ? Inverted : Normal;
-    Invalidate(FALSE);
-    UpdateWindow();
+    Redraw();
     if (--m_flashCount > 0) {
         SetTimer(timerId, m_flashInterval, nullptr);
     }
@@ -379,8 +446,7 @@ void MeaCrossHair::OnMouseMove(UINT flags, CPoint point) {
         tme.hwndTrack = m_hWnd;
         ::_TrackMouseEvent(&tme);
 
-        Invalidate(FALSE);
-        UpdateWindow();
+        Redraw();
     }
 }
 
@@ -393,8 +459,7 @@ LRESULT MeaCrossHair::OnMouseLeave(WPARAM /* wParam */, LPARAM /* lParam */) {
         m_callback->OnCHLeave(&chs);
     }
 
-    Invalidate(TRUE);
-    UpdateWindow();
+    Redraw();
 
     return 0;
 }
@@ -23,9 +23,10 @@
 #pragma once
 
 #include "Graphic.h"
+#include "CrossHairShape.h"
+#include "LayeredSurface.h"
 #include <meazure/ui/ScreenProvider.h>
 #include <meazure/units/UnitsProvider.h>
-#include <array>
 
 
 class MeaCrossHair;
@@ -171,6 +172,13 @@ public:
     ///
     void SetPosition(const POINT& center);
 
+    /// Obtains the rectangle occupied by the crosshair at the position most recently set. Moves are applied at
+    /// the next display frame, so the rectangle can differ from the current window rectangle.
+    ///
+    /// @return Crosshair rectangle, in the coordinates of its parent (i.e. the screen for a popup crosshair).
+    ///
+    CRect GetTargetRect() const { return CRect(m_targetLeftTop, m_size); }
+
     /// Sets the colors for the crosshair.
     ///
     /// @param borderColor  [in] Color for the crosshair border lines
@@ -200,7 +208,8 @@ protected:
     /// Called when the crosshair window is about to be destroyed.
     /// If the crosshair was created with a parent window specified,
     /// a number of bitmaps were created to simulate an opacity effect.
-    /// This method deletes those bitmaps.
+    /// This method deletes those bitmaps and releases the shared
+    /// crosshair shape.
     ///
     afx_msg void OnDestroy();
 
@@ -265,23 +274,22 @@ private:
     };
 
     static constexpr int kPetalLayers { 5 };
-    static constexpr int kTotalLayers { 4 * kPetalLayers };
-
-    static constexpr std::array<int, kTotalLayers> MakeNumCoords() noexcept {
-        std::array<int, kTotalLayers> arr {};
-        // The fill method is not constexpr until C++20
-        for (int i = 0; i < kTotalLayers; i++) {
-            arr[i] = 4;
-        }
-        return arr;
-    }
-    static inline const std::array<int, kTotalLayers> m_numCoords = MakeNumCoords();
-
-    static CSize m_size;            ///< Width and height of the crosshair, in pixels
-    static CSize m_halfSize;        ///< Half the width and height of the crosshair, in pixels
-    static CSize m_spread;          ///< Half the length of the base of a triangular section of the crosshair, in pixels
+
     static UINT m_flashInterval;    ///< Number of milliseconds to hold each display state while flashing the crosshair
 
+    /// Obtains the cache of shapes shared by all crosshairs.
+    ///
+    /// @return Crosshair shape cache.
+    ///
+    static MeaCrossHairShapeCache& GetShapeCache();
+
+    /// Obtains the shape for crosshairs displayed on the screen containing the main window. The size of the
+    /// crosshair is based on the resolution and DPI scale factor of that screen.
+    ///
+    /// @return Crosshair shape.
+    ///
+    MeaCrossHairShapeCache::ShapePtr AcquireShape() const;
+
     /// Given the center of the crosshair, returns the corresponding
     /// upper left corner.
     ///
@@ -290,14 +298,25 @@ private:
     /// @return Location of the upper left corner of the crosshair window,
     ///         in pixels.
     ///
-    static CPoint GetLeftTop(const CPoint& center) { return center - m_halfSize; }
+    CPoint GetLeftTop(const CPoint& center) const { return center - m_halfSize; }
 
-    /// Forms the window into the shape of the crosshair. A series of
-    /// rectangular regions are aggregated together to form the four
-    /// petals of the crosshair.
+    /// Forms the window into the shape of the crosshair. The window
+    /// region is created from the rectangles precomputed by the
+    /// crosshair's shape.
     ///
     void SetRegion();
 
+    /// Updates the appearance of the crosshair. A crosshair presented as
+    /// a layered window is rendered and presented immediately. Otherwise,
+    /// the crosshair window is repainted.
+    ///
+    void Redraw();
+
+    /// Renders the crosshair into its layered window buffer and presents
+    /// it. Used when the crosshair is presented as a layered window.
+    ///
+    void Render();
+
     /// Draws the crosshair background and border. Before this method
     /// is called, the shape of the crosshair has already been set by
     /// the SetRegion() method. The DrawCrossHair() method simply draws
@@ -325,11 +344,21 @@ private:
     const MeaScreenProvider& m_screenProvider;  ///< Screen information provider
     const MeaUnitsProvider& m_unitsProvider;    ///< Units information provider
     MeaCrossHairCallback* m_callback;           ///< Object to call for crosshair events
+    MeaCrossHairShapeCache::ShapePtr m_shape;   ///< Shape of the crosshair, shared with other crosshairs
+    CSize m_size;                               ///< Width and height of the crosshair, in pixels
+    CSize m_halfSize;                           ///< Half the width and height of the crosshair, in pixels
+    CPoint m_targetLeftTop;                     ///< Upper left corner of the crosshair at the position most
+                                                ///< recently set, in pixels
+    bool m_composited;                          ///< Indicates if the crosshair is presented as a layered window
+                                                ///< using per-pixel alpha
     bool m_mouseCaptured;                       ///< Indicates if the pointer is captured
     bool m_mouseOver;                           ///< Indicates if the pointer is over the crosshair
     CBrush* m_backBrush;                        ///< Brush to paint the normal crosshair background
     CBrush* m_borderBrush;                      ///< Brush to paint the crosshair border
     CBrush* m_hiliteBrush;                      ///< Brush to paint the highlighted crosshair background
+    COLORREF m_borderColor;                     ///< Color of the crosshair border
+    COLORREF m_backColor;                       ///< Normal crosshair background color
+    COLORREF m_hiliteColor;                     ///< Highlighted crosshair background color
     CSize m_pointerOffset;                      ///< Offset from the pointer location in the window to the
                                                 ///< center of the crosshair
     DrawState m_drawState;                      ///< Indicates how the crosshair should be drawn
@@ -344,4 +373,5 @@ private:
     CBitmap m_backBitmap;                       ///< Bitmap for the background when alpha blending when the crosshair
                                                 ///< is a child window
     CBitmap* m_origBackBitmap;                  ///< Original background bitmap
+    MeaLayeredSurface m_surface;                ///< Buffers for presenting the crosshair as a layered window
 };
@@ -0,0 +1,171 @@
+/*
+ * Copyright 2022 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "CrossHairShape.h"
+#include "Plotter.h"
+#include <cassert>
+#include <functional>
+
+
+MeaCrossHairShape::MeaCrossHairShape(const Key& key) : m_key(key), m_regionBounds { 0, 0, 0, 0 } {
+    assert(key.m_size.cx >= 0 && key.m_size.cy >= 0);
+
+    std::function<void(int, int)> addPoint = [this](int x, int y) {
+        POINT pt { x, y };
+        m_vertices.push_back(pt);
+    };
+    MeaPlotter::PlotCrosshair(key.m_size, key.m_spread, key.m_layers, addPoint);
+
+    // The plotter stops adding layers to a petal when the petal narrows to a point, so the number of polygons
+    // is determined from the vertices rather than from the requested number of layers.
+    m_polyCounts.assign(m_vertices.size() / 4, 4);
+
+    FillMask();
+    MarkBorder();
+    BuildRegionRects();
+}
+
+void MeaCrossHairShape::FillMask() {
+    const int width = m_key.m_size.cx;
+    const int height = m_key.m_size.cy;
+
+    m_mask.assign(static_cast<std::size_t>(width) * height, kOutside);
+
+    for (std::size_t i = 0; i + 3 < m_vertices.size(); i += 4) {
+        const POINT& a = m_vertices[i];
+        const POINT& c = m_vertices[i + 2];
+
+        // Polygon fills include the top and left edges of a rectangle but not its bottom and right edges.
+        int left = (a.x < c.x) ? a.x : c.x;
+        int right = (a.x < c.x) ? c.x : a.x;
+        int top = (a.y < c.y) ? a.y : c.y;
+        int bottom = (a.y < c.y) ? c.y : a.y;
+
+        left = (left < 0) ? 0 : left;
+        top = (top < 0) ? 0 : top;
+        right = (right > width) ? width : right;
+        bottom = (bottom > height) ? height : bottom;
+
+        for (int y = top; y < bottom; y++) {
+            unsigned char* row = m_mask.data() + static_cast<std::size_t>(y) * width;
+            for (int x = left; x < right; x++) {
+                row[x] ^= kInside;
+            }
+        }
+    }
+}
+
+void MeaCrossHairShape::MarkBorder() {
+    const int width = m_key.m_size.cx;
+    const int height = m_key.m_size.cy;
+
+    auto outside = [&](int x, int y) {
+        return x < 0 || y < 0 || x >= width || y >= height ||
+            m_mask[static_cast<std::size_t>(y) * width + x] == kOutside;
+    };
+
+    for (int y = 0; y < height; y++) {
+        unsigned char* row = m_mask.data() + static_cast<std::size_t>(y) * width;
+        for (int x = 0; x < width; x++) {
+            if (row[x] != kOutside &&
+                    (outside(x - 1, y) || outside(x + 1, y) || outside(x, y - 1) || outside(x, y + 1))) {
+                row[x] = kBorder;
+            }
+        }
+    }
+}
+
+void MeaCrossHairShape::BuildRegionRects() {
+    const int width = m_key.m_size.cx;
+    const int height = m_key.m_size.cy;
+
+    std::size_t bandStart = 0;      // Index of the first rectangle of the previous band
+
+    for (int y = 0; y < height; y++) {
+        const unsigned char* row = m_mask.data() + static_cast<std::size_t>(y) * width;
+        const std::size_t rowStart = m_regionRects.size();
+
+        for (int x = 0; x < width; ) {
+            if (row[x] == kOutside) {
+                x++;
+                continue;
+            }
+            int spanStart = x;
+            while (x < width && row[x] != kOutside) {
+                x++;
+            }
+            RECT rect { spanStart, y, x, y + 1 };
+            m_regionRects.push_back(rect);
+        }
+
+        // If this row has the same spans as the previous band, and the band ends at this row, extend the band.
+        const std::size_t rowCount = m_regionRects.size() - rowStart;
+        const std::size_t bandCount = rowStart - bandStart;
+        bool merge = rowCount > 0 && rowCount == bandCount && m_regionRects[bandStart].bottom == y;
+        for (std::size_t i = 0; merge && i < rowCount; i++) {
+            merge = m_regionRects[bandStart + i].left == m_regionRects[rowStart + i].left &&
+                    m_regionRects[bandStart + i].right == m_regionRects[rowStart + i].right;
+        }
+
+        if (merge) {
+            for (std::size_t i = 0; i < bandCount; i++) {
+                m_regionRects[bandStart + i].bottom = y + 1;
+            }
+            m_regionRects.resize(rowStart);
+        } else if (rowCount > 0) {
+            bandStart = rowStart;
+        }
+    }
+
+    if (!m_regionRects.empty()) {
+        m_regionBounds = m_regionRects.front();
+        for (const RECT& rect : m_regionRects) {
+            m_regionBounds.left = (rect.left < m_regionBounds.left) ? rect.left : m_regionBounds.left;
+            m_regionBounds.right = (rect.right > m_regionBounds.right) ? rect.right : m_regionBounds.right;
+            m_regionBounds.bottom = (rect.bottom > m_regionBounds.bottom) ? rect.bottom : m_regionBounds.bottom;
+        }
+    }
+}
+
+
+MeaCrossHairShapeCache::ShapePtr MeaCrossHairShapeCache::Acquire(const MeaCrossHairShape::Key& key) {
+    Shapes::const_iterator iter = m_shapes.find(key);
+    if (iter != m_shapes.end()) {
+        return iter->second;
+    }
+
+    // A new shape is needed, so the properties of the crosshairs have changed. Shapes with the old properties
+    // are discarded once no crosshair uses them.
+    Purge();
+
+    ShapePtr shape = std::make_shared<const MeaCrossHairShape>(key);
+    m_shapes.emplace(key, shape);
+    m_buildCount++;
+    return shape;
+}
+
+void MeaCrossHairShapeCache::Purge() {
+    for (Shapes::iterator iter = m_shapes.begin(); iter != m_shapes.end(); ) {
+        if (iter->second.use_count() == 1) {
+            iter = m_shapes.erase(iter);
+        } else {
+            ++iter;
+        }
+    }
+}
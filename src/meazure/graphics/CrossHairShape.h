@@ -0,0 +1,217 @@
+/*
+ * Copyright 2022 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/// @file
+/// @brief Header file for the shared crosshair shapes.
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <vector>
+#include <cstddef>
+
+
+/// Geometry of a crosshair window. A shape is computed once for each combination of crosshair size, spread,
+/// number of petal layers and DPI scale factor, and is shared by all crosshairs with those properties. A shape
+/// provides:
+///
+/// <ul>
+///     <li>The vertices of the rectangles that make up the petals of the crosshair, as produced by
+///         MeaPlotter::PlotCrosshair.</li>
+///     <li>A mask that classifies each pixel of the crosshair window as outside the crosshair, inside it, or
+///         on its border. The mask does not depend on the crosshair colors, so it can be used to render a
+///         crosshair in any color.</li>
+///     <li>The rectangles of the crosshair's window region, in the banded form used by Windows region data.
+///         A window region can be created from them using ExtCreateRegion, which is much faster than filling
+///         the polygons with CreatePolyPolygonRgn.</li>
+/// </ul>
+///
+/// Shapes are immutable once constructed. This class does not depend on MFC, but it uses the Windows POINT, RECT
+/// and SIZE types, so it can only be used where those types are defined.
+///
+class MeaCrossHairShape {
+
+public:
+    /// Classification of a pixel in the shape mask.
+    ///
+    enum MaskValue : unsigned char {
+        kOutside = 0,       ///< Pixel is not part of the crosshair.
+        kInside = 1,        ///< Pixel is in the interior of the crosshair.
+        kBorder = 2         ///< Pixel is on the outline of the crosshair.
+    };
+
+
+    /// Properties that determine the shape of a crosshair.
+    ///
+    struct Key {
+        SIZE m_size;            ///< Width and height of the crosshair, in pixels.
+        SIZE m_spread;          ///< Half the length of the base of a petal, in pixels.
+        int m_layers;           ///< Number of rectangles making up each petal.
+        double m_dpiScale;      ///< DPI scale factor of the screen on which the crosshair is displayed.
+
+        bool operator<(const Key& other) const {
+            if (m_size.cx != other.m_size.cx) return m_size.cx < other.m_size.cx;
+            if (m_size.cy != other.m_size.cy) return m_size.cy < other.m_size.cy;
+            if (m_spread.cx != other.m_spread.cx) return m_spread.cx < other.m_spread.cx;
+            if (m_spread.cy != other.m_spread.cy) return m_spread.cy < other.m_spread.cy;
+            if (m_layers != other.m_layers) return m_layers < other.m_layers;
+            return m_dpiScale < other.m_dpiScale;
+        }
+    };
+
+
+    /// Computes the shape with the specified properties.
+    ///
+    /// @param key      [in] Properties of the shape.
+    ///
+    explicit MeaCrossHairShape(const Key& key);
+
+    MeaCrossHairShape(const MeaCrossHairShape&) = delete;
+    MeaCrossHairShape& operator=(const MeaCrossHairShape&) = delete;
+
+    /// Obtains the properties of the shape.
+    ///
+    /// @return Shape properties.
+    ///
+    const Key& GetKey() const { return m_key; }
+
+    /// Obtains the width and height of the crosshair.
+    ///
+    /// @return Size of the crosshair, in pixels.
+    ///
+    const SIZE& GetSize() const { return m_key.m_size; }
+
+    /// Obtains the vertices of the crosshair polygons. Each polygon is a rectangle described by 4 vertices.
+    ///
+    /// @return Polygon vertices.
+    ///
+    const std::vector<POINT>& GetVertices() const { return m_vertices; }
+
+    /// Obtains the number of vertices in each polygon, in the form expected by CreatePolyPolygonRgn.
+    ///
+    /// @return Vertex count of each polygon.
+    ///
+    const std::vector<int>& GetPolyCounts() const { return m_polyCounts; }
+
+    /// Obtains the classification of the specified pixel.
+    ///
+    /// @param x    [in] Column of the pixel, where 0 is the left edge of the crosshair.
+    /// @param y    [in] Row of the pixel, where 0 is the top edge of the crosshair.
+    ///
+    /// @return Classification of the pixel. Pixels outside the crosshair window are kOutside.
+    ///
+    MaskValue GetMask(int x, int y) const {
+        if (x < 0 || y < 0 || x >= m_key.m_size.cx || y >= m_key.m_size.cy) {
+            return kOutside;
+        }
+        return static_cast<MaskValue>(m_mask[static_cast<std::size_t>(y) * m_key.m_size.cx + x]);
+    }
+
+    /// Obtains the pixel classification mask. The mask has one entry per pixel of the crosshair window, row by
+    /// row starting with the top row.
+    ///
+    /// @return Mask of MaskValue entries.
+    ///
+    const std::vector<unsigned char>& GetMask() const { return m_mask; }
+
+    /// Obtains the rectangles making up the crosshair's window region. The rectangles are sorted top to bottom
+    /// and then left to right, do not overlap, and rectangles in the same band have the same top and bottom.
+    ///
+    /// @return Region rectangles.
+    ///
+    const std::vector<RECT>& GetRegionRects() const { return m_regionRects; }
+
+    /// Obtains the bounding rectangle of the crosshair's window region.
+    ///
+    /// @return Region bounding rectangle.
+    ///
+    const RECT& GetRegionBounds() const { return m_regionBounds; }
+
+private:
+    /// Fills the mask from the polygons. A pixel is inside the crosshair if it is covered by an odd number of
+    /// rectangles, which is the alternate fill mode used for the window region.
+    ///
+    void FillMask();
+
+    /// Marks the pixels inside the crosshair that have a horizontal or vertical neighbor outside it as border.
+    ///
+    void MarkBorder();
+
+    /// Converts the mask into banded region rectangles. Adjacent rows with identical spans are merged.
+    ///
+    void BuildRegionRects();
+
+
+    Key m_key;                              ///< Properties of the shape.
+    std::vector<POINT> m_vertices;          ///< Vertices of the crosshair polygons.
+    std::vector<int> m_polyCounts;          ///< Number of vertices in each polygon.
+    std::vector<unsigned char> m_mask;      ///< Classification of each pixel of the crosshair window.
+    std::vector<RECT> m_regionRects;        ///< Rectangles of the window region.
+    RECT m_regionBounds;                    ///< Bounding rectangle of the window region.
+};
+
+
+/// Reference counted cache of crosshair shapes. Crosshairs with the same properties share a single shape,
+/// so that creating additional crosshairs, or recreating crosshairs when switching tools, does not recompute
+/// their geometry. A shape remains in the cache while it is in use by a crosshair. Shapes that are no longer
+/// used are discarded when a shape with different properties is requested (e.g. when the DPI scale changes).
+///
+class MeaCrossHairShapeCache {
+
+public:
+    typedef std::shared_ptr<const MeaCrossHairShape> ShapePtr;
+
+
+    MeaCrossHairShapeCache() = default;
+
+    MeaCrossHairShapeCache(const MeaCrossHairShapeCache&) = delete;
+    MeaCrossHairShapeCache& operator=(const MeaCrossHairShapeCache&) = delete;
+
+    /// Obtains the shape with the specified properties, computing it if it is not in the cache.
+    ///
+    /// @param key      [in] Properties of the shape.
+    ///
+    /// @return Shape with the specified properties.
+    ///
+    ShapePtr Acquire(const MeaCrossHairShape::Key& key);
+
+    /// Discards the shapes that are not in use by any crosshair.
+    ///
+    void Purge();
+
+    /// Obtains the number of shapes in the cache.
+    ///
+    /// @return Number of cached shapes.
+    ///
+    std::size_t GetSize() const { return m_shapes.size(); }
+
+    /// Obtains the number of shapes that have been computed by the cache.
+    ///
+    /// @return Number of shapes computed.
+    ///
+    unsigned int GetBuildCount() const { return m_buildCount; }
+
+private:
+    typedef std::map<MeaCrossHairShape::Key, ShapePtr> Shapes;
+
+
+    Shapes m_shapes;                        ///< Cached shapes.
+    unsigned int m_buildCount { 0 };        ///< Number of shapes computed.
+};
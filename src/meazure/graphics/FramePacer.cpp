@@ -0,0 +1,146 @@
+/*
+ * Copyright 2022 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <meazure/pch.h>
+#include "FramePacer.h"
+#include <dwmapi.h>
+
+
+MeaFramePacer* MeaFramePacer::m_active = nullptr;
+
+
+MeaFramePacer::MeaFramePacer() : m_scheduler(*this), m_frameWnd(nullptr) {}
+
+MeaFramePacer::~MeaFramePacer() {
+    try {
+        Stop();
+    } catch (...) {
+        assert(false);
+    }
+}
+
+void MeaFramePacer::Start(CWnd* frameWnd) {
+    assert(frameWnd != nullptr);
+
+    m_frameWnd = frameWnd;
+    m_frameTimer.Create(frameWnd, 0, MeaFrameMsg);
+    m_active = this;
+}
+
+void MeaFramePacer::Stop() {
+    if (m_active == this) {
+        m_active = nullptr;
+        m_frameTimer.Stop();
+        m_scheduler.Flush();
+    }
+}
+
+void MeaFramePacer::Move(CWnd& wnd, int x, int y) {
+    if (m_active != nullptr) {
+        m_active->m_scheduler.Move(wnd.m_hWnd, x, y);
+    } else {
+        wnd.SetWindowPos(nullptr, x, y, 0, 0, kMoveFlags);
+    }
+}
+
+void MeaFramePacer::Repaint(CWnd& wnd) {
+    if (m_active != nullptr) {
+        m_active->m_scheduler.Repaint(wnd.m_hWnd);
+    } else {
+        wnd.UpdateWindow();
+    }
+}
+
+void MeaFramePacer::Forget(const CWnd& wnd) {
+    if (m_active != nullptr) {
+        m_active->m_scheduler.Remove(wnd.m_hWnd);
+    }
+}
+
+void MeaFramePacer::Flush() {
+    if (m_active != nullptr) {
+        m_active->m_scheduler.Flush();
+    }
+}
+
+void MeaFramePacer::RequestFrame() {
+    m_frameTimer.Start(GetFrameDelay());
+}
+
+void MeaFramePacer::MoveWindows(const MeaFrameScheduler::Update* updates, std::size_t count) {
+    // All windows in a DeferWindowPos batch must have the same parent, so popup windows and child windows are
+    // moved in separate batches. A window may have been destroyed since it was scheduled. A single invalid window
+    // would cause an entire batch to fail, so such windows are skipped.
+    m_parents.clear();
+    for (std::size_t i = 0; i < count; i++) {
+        HWND hwnd = GetHwnd(updates[i]);
+        m_parents.push_back(::IsWindow(hwnd) ? ::GetAncestor(hwnd, GA_PARENT) : nullptr);
+    }
+
+    for (std::size_t i = 0; i < count; i++) {
+        HWND parent = m_parents[i];
+        if (parent == nullptr) {
+            continue;
+        }
+
+        HDWP hdwp = ::BeginDeferWindowPos(static_cast<int>(count - i));
+        for (std::size_t j = i; j < count; j++) {
+            if (m_parents[j] != parent) {
+                continue;
+            }
+            m_parents[j] = nullptr;
+
+            if (hdwp != nullptr) {
+                hdwp = ::DeferWindowPos(hdwp, GetHwnd(updates[j]), nullptr, updates[j].m_x, updates[j].m_y, 0, 0,
+                                        kMoveFlags);
+            } else {
+                ::SetWindowPos(GetHwnd(updates[j]), nullptr, updates[j].m_x, updates[j].m_y, 0, 0, kMoveFlags);
+            }
+        }
+        if (hdwp != nullptr) {
+            ::EndDeferWindowPos(hdwp);
+        }
+    }
+}
+
+void MeaFramePacer::RepaintWindow(MeaFrameScheduler::WindowId window) {
+    HWND hwnd = static_cast<HWND>(const_cast<void*>(window));
+    if (::IsWindow(hwnd)) {
+        ::UpdateWindow(hwnd);
+    }
+}
+
+int MeaFramePacer::GetFrameDelay() {
+    DWM_TIMING_INFO timingInfo = {};
+    timingInfo.cbSize = sizeof(timingInfo);
+
+    LARGE_INTEGER now;
+    LARGE_INTEGER frequency;
+    if (FAILED(::DwmGetCompositionTimingInfo(nullptr, &timingInfo)) || timingInfo.qpcRefreshPeriod == 0 ||
+            !::QueryPerformanceCounter(&now) || !::QueryPerformanceFrequency(&frequency)) {
+        return 0;
+    }
+
+    // Find the first vertical blank after the current time.
+    LONGLONG period = static_cast<LONGLONG>(timingInfo.qpcRefreshPeriod);
+    LONGLONG sinceVBlank = now.QuadPart - static_cast<LONGLONG>(timingInfo.qpcVBlank);
+    LONGLONG untilVBlank = period - (((sinceVBlank % period) + period) % period);
+
+    return static_cast<int>((untilVBlank * 1000) / frequency.QuadPart);
+}
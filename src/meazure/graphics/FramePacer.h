@@ -0,0 +1,130 @@
+/*
+ * Copyright 2022 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/// @file
+/// @brief Header file for the Windows frame pacing backend of the frame scheduler.
+
+#pragma once
+
+#include <meazure/utilities/FrameScheduler.h>
+#include <meazure/utilities/Timer.h>
+#include <vector>
+
+
+/// Applies the window updates collected by a MeaFrameScheduler at the display refresh. When updates are first
+/// requested in a frame, a timer is set to expire at the next vertical blank reported by the Desktop Window
+/// Manager, and the frame window is sent a MeaFrameMsg message. The frame window's handler calls OnFrame, which
+/// moves all windows using a single DeferWindowPos batch and then repaints them.
+///
+/// The pacer is owned by MeaToolMgr, which starts it when the application view is created. The graphics and data
+/// windows do not know about the tool manager, so they position themselves through the static methods of this
+/// class. While a pacer is started, those requests are scheduled for its next frame. Otherwise, they are performed
+/// immediately.
+///
+class MeaFramePacer : public MeaFrameScheduler::Backend {
+
+public:
+    MeaFramePacer();
+
+    virtual ~MeaFramePacer();
+
+    MeaFramePacer(const MeaFramePacer&) = delete;
+    MeaFramePacer& operator=(const MeaFramePacer&) = delete;
+
+    /// Starts scheduling window updates with this pacer.
+    ///
+    /// @param frameWnd     [in] Window that is sent the MeaFrameMsg message at the start of each frame.
+    ///
+    void Start(CWnd* frameWnd);
+
+    /// Applies any pending updates and stops scheduling window updates with this pacer. Subsequent updates are
+    /// performed immediately.
+    ///
+    void Stop();
+
+    /// Called by the frame window when it receives the MeaFrameMsg message.
+    ///
+    void OnFrame() { m_scheduler.OnFrame(); }
+
+    /// Obtains the counters describing the updates applied by this pacer.
+    ///
+    /// @return Scheduler counters.
+    ///
+    const MeaFrameScheduler::Metrics& GetMetrics() const { return m_scheduler.GetMetrics(); }
+
+    /// Moves the specified window at the next frame, or immediately if no pacer has been started.
+    ///
+    /// @param wnd      [in] Window to move.
+    /// @param x        [in] New left edge of the window, in its parent's coordinates.
+    /// @param y        [in] New top edge of the window, in its parent's coordinates.
+    ///
+    static void Move(CWnd& wnd, int x, int y);
+
+    /// Repaints the specified window at the next frame, or immediately if no pacer has been started. The window
+    /// must already have been invalidated.
+    ///
+    /// @param wnd      [in] Window to repaint.
+    ///
+    static void Repaint(CWnd& wnd);
+
+    /// Discards any pending updates for the specified window. Call this before a window is destroyed.
+    ///
+    /// @param wnd      [in] Window whose updates are discarded.
+    ///
+    static void Forget(const CWnd& wnd);
+
+    /// Applies all pending updates immediately. Call this before showing a window so that it appears in its
+    /// new position.
+    ///
+    static void Flush();
+
+protected:
+    void RequestFrame() override;
+
+    void MoveWindows(const MeaFrameScheduler::Update* updates, std::size_t count) override;
+
+    void RepaintWindow(MeaFrameScheduler::WindowId window) override;
+
+private:
+    /// Calculates the time until the next vertical blank of the display.
+    ///
+    /// @return Delay in milliseconds.
+    ///
+    static int GetFrameDelay();
+
+    /// Obtains the window handle of the specified update.
+    ///
+    /// @param update   [in] Scheduled update.
+    ///
+    /// @return Handle of the window to update.
+    ///
+    static HWND GetHwnd(const MeaFrameScheduler::Update& update) {
+        return static_cast<HWND>(const_cast<void*>(update.m_window));
+    }
+
+
+    static constexpr UINT kMoveFlags { SWP_NOSIZE | SWP_NOZORDER | SWP_NOACTIVATE | SWP_NOSENDCHANGING };
+
+    static MeaFramePacer* m_active;     ///< Started pacer to which the static methods forward, or nullptr.
+
+    MeaFrameScheduler m_scheduler;      ///< Collects the window updates for each frame.
+    MeaTimer m_frameTimer;              ///< Expires at the start of the next frame.
+    CWnd* m_frameWnd;                   ///< Window sent the MeaFrameMsg message.
+    std::vector<HWND> m_parents;        ///< Parents of the windows being moved. Kept to reuse its capacity.
+};
@@ -19,6 +19,7 @@
 
 #include <meazure/pch.h>
 #include "Graphic.h"
+#include "FramePacer.h"
 
 
 MeaGraphic::MeaGraphic() : CWnd(), m_id(0xFFFF), m_visible(false), m_parent(nullptr) {}
@@ -37,6 +38,10 @@ bool MeaGraphic::Create(PCTSTR classname, const SIZE& size, const CWnd* parent,
 
 void MeaGraphic::Show() {
     if (m_hWnd != nullptr) {
+        // Apply any pending move so that the graphic does not appear at its old position.
+        if (!m_visible) {
+            MeaFramePacer::Flush();
+        }
         ShowWindow(SW_SHOWNOACTIVATE);
         m_visible = true;
     }
@@ -0,0 +1,101 @@
+/*
+ * Copyright 2022 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "LayeredRaster.h"
+#include <cassert>
+
+
+MeaLayeredRaster::Image MeaLayeredRaster::Image::Sub(int x, int y, int width, int height) const {
+    int left = (x < 0) ? 0 : x;
+    int top = (y < 0) ? 0 : y;
+    int right = (x + width > m_width) ? m_width : x + width;
+    int bottom = (y + height > m_height) ? m_height : y + height;
+
+    if (right <= left || bottom <= top) {
+        return Image { m_pixels, 0, 0, m_stride };
+    }
+
+    return Image { Row(top) + left, right - left, bottom - top, m_stride };
+}
+
+void MeaLayeredRaster::Fill(const Image& image, Pixel pixel) {
+    for (int y = 0; y < image.m_height; y++) {
+        Pixel* row = image.Row(y);
+        for (int x = 0; x < image.m_width; x++) {
+            row[x] = pixel;
+        }
+    }
+}
+
+void MeaLayeredRaster::RenderMask(const Image& image, const unsigned char* mask, int maskStride,
+                                  const Pixel* palette, std::size_t paletteSize) {
+    for (int y = 0; y < image.m_height; y++) {
+        Pixel* row = image.Row(y);
+        const unsigned char* maskRow = mask + static_cast<std::ptrdiff_t>(y) * maskStride;
+        for (int x = 0; x < image.m_width; x++) {
+            row[x] = (maskRow[x] < paletteSize) ? palette[maskRow[x]] : 0;
+        }
+    }
+}
+
+void MeaLayeredRaster::ApplyOpacity(const Image& image, const Image& content, std::uint8_t alpha) {
+    assert(image.m_width == content.m_width && image.m_height == content.m_height);
+
+    for (int y = 0; y < image.m_height; y++) {
+        Pixel* row = image.Row(y);
+        const Pixel* contentRow = content.Row(y);
+
+        if (alpha == 255) {
+            for (int x = 0; x < image.m_width; x++) {
+                row[x] = contentRow[x] | 0xFF000000;
+            }
+        } else {
+            // Content typically consists of runs of a few colors (e.g. background and text), so the previous
+            // result is reused while the color is unchanged.
+            Pixel lastColor = (contentRow[0] & 0xFFFFFF) ^ 1;
+            Pixel lastPixel = 0;
+            for (int x = 0; x < image.m_width; x++) {
+                Pixel color = contentRow[x] & 0xFFFFFF;
+                if (color != lastColor) {
+                    lastColor = color;
+                    lastPixel = Premultiply(color, alpha);
+                }
+                row[x] = lastPixel;
+            }
+        }
+    }
+}
+
+void MeaLayeredRaster::ApplyOpacityDottedXor(const Image& image, const Image& content, std::uint8_t alpha,
+                                             Pixel color) {
+    assert(image.m_width == content.m_width && image.m_height == content.m_height);
+
+    color &= 0xFFFFFF;
+
+    // The dots are placed along the line, which is either a single row or a single column.
+    const bool vertical = image.m_width == 1;
+    for (int y = 0; y < image.m_height; y++) {
+        Pixel* row = image.Row(y);
+        const Pixel* contentRow = content.Row(y);
+        for (int x = 0; x < image.m_width; x++) {
+            bool dot = ((vertical ? y : x) % 2) == 0;
+            row[x] = Premultiply(dot ? (contentRow[x] ^ color) : contentRow[x], alpha);
+        }
+    }
+}
@@ -0,0 +1,147 @@
+/*
+ * Copyright 2022 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/// @file
+/// @brief Header file for the portable premultiplied ARGB raster operations used to compose layered windows.
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+
+/// Renders the contents of layered windows into 32-bit premultiplied ARGB pixel buffers, laid out as in a
+/// top-down 32 bits per pixel DIB section. A buffer rendered by these functions can be presented directly with
+/// UpdateLayeredWindow using per-pixel alpha. The functions do not depend on MFC or Windows and can be used on
+/// any platform.
+///
+/// Two kinds of content are supported:
+///
+/// <ul>
+///     <li>Shapes described by a mask, such as crosshairs, are rendered by mapping each mask value to a
+///         premultiplied color. Pixels outside the shape are fully transparent.</li>
+///     <li>Content drawn by GDI, such as the text of the data windows and rulers, is drawn opaque into a
+///         separate content buffer. The content is then copied into the presented buffer with a uniform opacity.
+///         GDI does not maintain the alpha channel, so the alpha byte of the content pixels is ignored.</li>
+/// </ul>
+///
+namespace MeaLayeredRaster {
+
+    /// Pixel in the format of a 32-bit DIB (i.e. 0xAARRGGBB). Pixels in a presented buffer are premultiplied by
+    /// their alpha. Pixels in a content buffer are opaque colors whose alpha byte is ignored.
+    ///
+    typedef std::uint32_t Pixel;
+
+    /// View of a pixel buffer owned by the caller.
+    ///
+    struct Image {
+        Pixel* m_pixels;            ///< First pixel of the top row.
+        int m_width;                ///< Width of the image, in pixels.
+        int m_height;               ///< Height of the image, in pixels.
+        int m_stride;               ///< Number of pixels from the start of one row to the start of the next.
+
+        /// Obtains the first pixel of the specified row.
+        ///
+        /// @param y    [in] Row, where 0 is the top row.
+        /// @return First pixel of the row.
+        ///
+        Pixel* Row(int y) const { return m_pixels + static_cast<std::ptrdiff_t>(y) * m_stride; }
+
+        /// Obtains a view of a rectangular portion of the image. The rectangle is clipped to the image.
+        ///
+        /// @param x        [in] Left edge of the portion.
+        /// @param y        [in] Top edge of the portion.
+        /// @param width    [in] Width of the portion.
+        /// @param height   [in] Height of the portion.
+        ///
+        /// @return View of the portion of the image. The view is empty if the rectangle is outside the image.
+        ///
+        Image Sub(int x, int y, int width, int height) const;
+    };
+
+
+    /// Converts a Windows COLORREF value (i.e. 0x00BBGGRR) to an opaque content pixel (i.e. 0x00RRGGBB).
+    ///
+    /// @param colorRef     [in] Color to convert.
+    /// @return Content pixel with the color.
+    ///
+    constexpr Pixel FromColorRef(std::uint32_t colorRef) {
+        return ((colorRef & 0xFF) << 16) | (colorRef & 0xFF00) | ((colorRef >> 16) & 0xFF);
+    }
+
+    /// Converts an opaque color to a premultiplied pixel with the specified alpha.
+    ///
+    /// @param color    [in] Color to convert (i.e. 0x..RRGGBB). The alpha byte is ignored.
+    /// @param alpha    [in] Alpha for the pixel, where 0 is transparent and 255 is opaque.
+    ///
+    /// @return Premultiplied pixel.
+    ///
+    constexpr Pixel Premultiply(Pixel color, std::uint8_t alpha) {
+        // (c * a + 127) / 255, computed without a division. Exact for all 8-bit c and a.
+        auto scale = [](std::uint32_t c, std::uint32_t a) {
+            std::uint32_t t = c * a + 128;
+            return (t + (t >> 8)) >> 8;
+        };
+        return (static_cast<Pixel>(alpha) << 24) |
+               (scale((color >> 16) & 0xFF, alpha) << 16) |
+               (scale((color >> 8) & 0xFF, alpha) << 8) |
+               scale(color & 0xFF, alpha);
+    }
+
+    /// Sets every pixel of the image to the specified value.
+    ///
+    /// @param image    [in] Image to fill.
+    /// @param pixel    [in] Value for the pixels.
+    ///
+    void Fill(const Image& image, Pixel pixel);
+
+    /// Renders a shape described by a mask. Each mask value is used as an index into the palette, and the
+    /// corresponding palette entry is written to the image. Mask values outside the palette are rendered as
+    /// transparent pixels.
+    ///
+    /// @param image        [in] Image into which to render. Must be the same size as the mask.
+    /// @param mask         [in] Mask values, one byte per pixel, row by row.
+    /// @param maskStride   [in] Number of bytes from the start of one mask row to the start of the next.
+    /// @param palette      [in] Premultiplied pixel for each mask value.
+    /// @param paletteSize  [in] Number of entries in the palette.
+    ///
+    void RenderMask(const Image& image, const unsigned char* mask, int maskStride, const Pixel* palette,
+                    std::size_t paletteSize);
+
+    /// Copies opaque content into a presented image, applying a uniform opacity. The images must be the same
+    /// size.
+    ///
+    /// @param image    [in] Premultiplied image to write.
+    /// @param content  [in] Opaque content to copy. The alpha byte of the content pixels is ignored.
+    /// @param alpha    [in] Opacity for the content, where 0 is transparent and 255 is opaque.
+    ///
+    void ApplyOpacity(const Image& image, const Image& content, std::uint8_t alpha);
+
+    /// Copies opaque content into a presented image in the same manner as ApplyOpacity, but first exclusive-ORs
+    /// every other pixel with the specified color. The result is the same as drawing a dotted line with an
+    /// XOR pen, so that drawing the line an even number of times leaves the content unchanged. This is used
+    /// to compose the position indicators of the rulers, which are 1 pixel wide lines.
+    ///
+    /// @param image    [in] Premultiplied image to write.
+    /// @param content  [in] Opaque content to copy. The alpha byte of the content pixels is ignored.
+    /// @param alpha    [in] Opacity for the content, where 0 is transparent and 255 is opaque.
+    /// @param color    [in] Color with which to exclusive-OR the content (i.e. 0x..RRGGBB).
+    ///
+    void ApplyOpacityDottedXor(const Image& image, const Image& content, std::uint8_t alpha, Pixel color);
+};
@@ -0,0 +1,113 @@
+/*
+ * Copyright 2022 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <meazure/pch.h>
+#include "LayeredSurface.h"
+#include <meazure/ui/LayeredWindows.h>
+#include <cassert>
+
+
+MeaLayeredSurface::MeaLayeredSurface() :
+    m_content { nullptr, 0, 0, 0 },
+    m_image { nullptr, 0, 0, 0 } {}
+
+MeaLayeredSurface::~MeaLayeredSurface() {
+    try {
+        Free();
+    } catch (...) {
+        assert(false);
+    }
+}
+
+bool MeaLayeredSurface::Allocate(const SIZE& size) {
+    if (IsAllocated() && m_image.m_width == size.cx && m_image.m_height == size.cy) {
+        return true;
+    }
+
+    Free();
+
+    if (size.cx <= 0 || size.cy <= 0) {
+        return false;
+    }
+
+    MeaLayeredRaster::Pixel* contentPixels = CreateBuffer(m_contentBuffer, size);
+    MeaLayeredRaster::Pixel* imagePixels = CreateBuffer(m_imageBuffer, size);
+    if (contentPixels == nullptr || imagePixels == nullptr) {
+        Free();
+        return false;
+    }
+
+    m_content = { contentPixels, size.cx, size.cy, size.cx };
+    m_image = { imagePixels, size.cx, size.cy, size.cx };
+    return true;
+}
+
+void MeaLayeredSurface::Free() {
+    FreeBuffer(m_contentBuffer);
+    FreeBuffer(m_imageBuffer);
+
+    m_content = { nullptr, 0, 0, 0 };
+    m_image = { nullptr, 0, 0, 0 };
+}
+
+bool MeaLayeredSurface::Present(CWnd& wnd) {
+    if (!IsAllocated()) {
+        return false;
+    }
+
+    POINT srcPos { 0, 0 };
+    SIZE size { m_image.m_width, m_image.m_height };
+    BLENDFUNCTION blend { AC_SRC_OVER, 0, 255, AC_SRC_ALPHA };
+
+    return UpdateLayeredWindow(wnd.m_hWnd, nullptr, nullptr, &size, m_imageBuffer.m_dc.m_hDC, &srcPos, 0, &blend,
+                               ULW_ALPHA) != FALSE;
+}
+
+MeaLayeredRaster::Pixel* MeaLayeredSurface::CreateBuffer(Buffer& buffer, const SIZE& size) {
+    BITMAPINFO info = {};
+    info.bmiHeader.biSize = sizeof(BITMAPINFOHEADER);
+    info.bmiHeader.biWidth = size.cx;
+    info.bmiHeader.biHeight = -size.cy;         // Top-down
+    info.bmiHeader.biPlanes = 1;
+    info.bmiHeader.biBitCount = 32;
+    info.bmiHeader.biCompression = BI_RGB;
+
+    void* bits = nullptr;
+    buffer.m_bitmap = ::CreateDIBSection(nullptr, &info, DIB_RGB_COLORS, &bits, nullptr, 0);
+    if (buffer.m_bitmap == nullptr || !buffer.m_dc.CreateCompatibleDC(nullptr)) {
+        return nullptr;
+    }
+    buffer.m_origBitmap = ::SelectObject(buffer.m_dc.m_hDC, buffer.m_bitmap);
+
+    return static_cast<MeaLayeredRaster::Pixel*>(bits);
+}
+
+void MeaLayeredSurface::FreeBuffer(Buffer& buffer) {
+    if (buffer.m_dc.m_hDC != nullptr) {
+        if (buffer.m_origBitmap != nullptr) {
+            ::SelectObject(buffer.m_dc.m_hDC, buffer.m_origBitmap);
+            buffer.m_origBitmap = nullptr;
+        }
+        buffer.m_dc.DeleteDC();
+    }
+    if (buffer.m_bitmap != nullptr) {
+        ::DeleteObject(buffer.m_bitmap);
+        buffer.m_bitmap = nullptr;
+    }
+}
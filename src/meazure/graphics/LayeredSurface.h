@@ -0,0 +1,132 @@
+/*
+ * Copyright 2022 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/// @file
+/// @brief Header file for the buffers used to present layered windows with UpdateLayeredWindow.
+
+#pragma once
+
+#include "LayeredRaster.h"
+
+
+/// Presents the contents of a layered popup window using UpdateLayeredWindow with per-pixel alpha. The surface
+/// holds two top-down 32 bits per pixel DIB sections the size of the window:
+///
+/// <ul>
+///     <li>The content buffer, into which GDI draws the opaque content of the window.</li>
+///     <li>The presented buffer, which holds the premultiplied ARGB image given to UpdateLayeredWindow. The
+///         image is composed from the content buffer, or rendered directly, using the functions of
+///         MeaLayeredRaster.</li>
+/// </ul>
+///
+/// Once presented, the window keeps its image when it is moved, so a layered window only needs to be rendered
+/// when its contents change. Windows presented this way do not receive WM_PAINT messages.
+///
+class MeaLayeredSurface {
+
+public:
+    MeaLayeredSurface();
+
+    ~MeaLayeredSurface();
+
+    MeaLayeredSurface(const MeaLayeredSurface&) = delete;
+    MeaLayeredSurface& operator=(const MeaLayeredSurface&) = delete;
+
+    /// Ensures that the buffers have the specified size. The buffers are only reallocated if their size changes.
+    /// The contents of the buffers are undefined after they are reallocated.
+    ///
+    /// @param size     [in] Width and height of the window, in pixels.
+    ///
+    /// @return <b>true</b> if the buffers were allocated.
+    ///
+    bool Allocate(const SIZE& size);
+
+    /// Releases the buffers.
+    ///
+    void Free();
+
+    /// Indicates whether the buffers have been allocated.
+    ///
+    /// @return <b>true</b> if the buffers are allocated.
+    ///
+    bool IsAllocated() const { return m_image.m_pixels != nullptr; }
+
+    /// Obtains a device context for drawing into the content buffer. Drawing must be followed by a call to
+    /// Flush before the content buffer is accessed through GetContent.
+    ///
+    /// @return Device context for the content buffer.
+    ///
+    CDC& GetContentDC() { return m_contentBuffer.m_dc; }
+
+    /// Completes any pending GDI drawing into the content buffer.
+    ///
+    void Flush() { ::GdiFlush(); }
+
+    /// Obtains the content buffer.
+    ///
+    /// @return View of the content buffer.
+    ///
+    const MeaLayeredRaster::Image& GetContent() const { return m_content; }
+
+    /// Obtains the presented buffer.
+    ///
+    /// @return View of the presented buffer.
+    ///
+    const MeaLayeredRaster::Image& GetImage() const { return m_image; }
+
+    /// Displays the presented buffer as the contents of the specified layered window. The window's position is
+    /// not changed.
+    ///
+    /// @param wnd      [in] Layered window to update.
+    ///
+    /// @return <b>true</b> if the window was updated.
+    ///
+    bool Present(CWnd& wnd);
+
+private:
+    /// DIB section and the memory device context into which it is selected.
+    ///
+    struct Buffer {
+        CDC m_dc;                               ///< Memory device context.
+        HBITMAP m_bitmap { nullptr };           ///< DIB section.
+        HGDIOBJ m_origBitmap { nullptr };       ///< Bitmap originally selected into the device context.
+    };
+
+
+    /// Creates a DIB section of the specified size and selects it into a memory device context.
+    ///
+    /// @param buffer   [in, out] Buffer to create.
+    /// @param size     [in] Width and height of the DIB section, in pixels.
+    ///
+    /// @return First pixel of the DIB section, or nullptr if it could not be created.
+    ///
+    static MeaLayeredRaster::Pixel* CreateBuffer(Buffer& buffer, const SIZE& size);
+
+    /// Releases the DIB section and memory device context of a buffer.
+    ///
+    /// @param buffer   [in, out] Buffer to release.
+    ///
+    static void FreeBuffer(Buffer& buffer);
+
+
+    Buffer m_contentBuffer;             ///< Buffer into which GDI draws the window content.
+    Buffer m_imageBuffer;               ///< Buffer presented by UpdateLayeredWindow.
+    MeaLayeredRaster::Image m_content;  ///< View of the content buffer.
+    MeaLayeredRaster::Image m_image;    ///< View of the presented buffer.
+};
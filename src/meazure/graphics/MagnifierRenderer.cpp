@@ -0,0 +1,190 @@
+/*
+ * Copyright 2022 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MagnifierRenderer.h"
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define MEA_RENDERER_SSE2
+#endif
+
+
+namespace {
+    constexpr int kNoKey = -3;      ///< Row key that matches no row.
+}
+
+
+void MeaMagnifierRenderer::ClearOutside(const Image& image, int left, int top, int right, int bottom) {
+    left = std::clamp(left, 0, image.m_width);
+    right = std::clamp(right, left, image.m_width);
+    top = std::clamp(top, 0, image.m_height);
+    bottom = std::clamp(bottom, top, image.m_height);
+
+    for (int y = 0; y < image.m_height; y++) {
+        Pixel* row = image.Row(y);
+        if (y < top || y >= bottom) {
+            std::fill(row, row + image.m_width, kClearColor);
+        } else {
+            std::fill(row, row + left, kClearColor);
+            std::fill(row + right, row + image.m_width, kClearColor);
+        }
+    }
+}
+
+void MeaMagnifierRenderer::Render(const Image& src, const Image& dst, bool showGrid) {
+    assert(src.m_width > 0 && src.m_height > 0);
+    assert(dst.m_width >= src.m_width && dst.m_height >= src.m_height);
+
+    if (src.m_width != m_srcWidth || dst.m_width != m_dstWidth) {
+        ComputeEdges(m_xEdges, src.m_width, dst.m_width);
+        m_xSources.resize(dst.m_width);
+        for (int sx = 0; sx < src.m_width; sx++) {
+            std::fill(m_xSources.begin() + m_xEdges[sx], m_xSources.begin() + m_xEdges[sx + 1], sx);
+        }
+        m_srcWidth = src.m_width;
+        m_dstWidth = dst.m_width;
+    }
+    if (src.m_height != m_srcHeight || dst.m_height != m_dstHeight) {
+        ComputeEdges(m_yEdges, src.m_height, dst.m_height);
+        m_srcHeight = src.m_height;
+        m_dstHeight = dst.m_height;
+    }
+
+    int width = dst.m_width;
+    int height = dst.m_height;
+
+    // The center marker outlines the center cell, overlapping the grid lines on either side of it. The right
+    // and bottom edges of the marker are exclusive and can lie beyond the image, in which case they are clipped.
+    int cx = src.m_width / 2;
+    int cy = src.m_height / 2;
+    int markerLeft = m_xEdges[cx];
+    int markerRight = std::min(m_xEdges[cx + 1] + 1, width);
+    int markerRightCol = m_xEdges[cx + 1];
+    int markerTop = m_yEdges[cy];
+    int markerBottomRow = m_yEdges[cy + 1];
+
+    int sy = 0;
+    int prevKey = kNoKey;       // Identifies the contents of the previous row so it can be replicated
+
+    for (int y = 0; y < height; y++) {
+        while (m_yEdges[sy + 1] <= y) {
+            sy++;
+        }
+
+        Pixel* row = dst.Row(y);
+        bool lineRow = (y == 0) || (y == height - 1) || (showGrid && y == m_yEdges[sy]);
+        bool markerEdgeRow = (y == markerTop) || (y == markerBottomRow);
+        bool markerSideRow = (y > markerTop) && (y < markerBottomRow);
+
+        // Rows with the same key are identical: frame or grid lines (-1), or the expansion of source row sy,
+        // either of which may have the marker sides drawn on it.
+        int key = (lineRow ? -1 : sy) * 2 + (markerSideRow ? 1 : 0);
+
+        if (!markerEdgeRow && key == prevKey) {
+            std::memcpy(row, dst.Row(y - 1), width * sizeof(Pixel));
+            continue;
+        }
+
+        if (lineRow) {
+            FillSpan(row, width, kFrameColor);
+        } else {
+            ExpandRow(src.Row(sy), src.m_width, row, width, showGrid);
+        }
+
+        if (markerEdgeRow) {
+            FillSpan(row + markerLeft, markerRight - markerLeft, kMarkerColor);
+            prevKey = kNoKey;
+        } else {
+            if (markerSideRow) {
+                row[markerLeft] = kMarkerColor;
+                if (markerRightCol < width) {
+                    row[markerRightCol] = kMarkerColor;
+                }
+            }
+            prevKey = key;
+        }
+    }
+}
+
+void MeaMagnifierRenderer::ComputeEdges(std::vector<int>& edges, int srcLength, int dstLength) {
+    edges.resize(static_cast<std::size_t>(srcLength) + 1);
+    for (int i = 0; i <= srcLength; i++) {
+        edges[i] = i * dstLength / srcLength;
+    }
+}
+
+void MeaMagnifierRenderer::ExpandRow(const Pixel* srcRow, int srcWidth, Pixel* dstRow, int dstWidth,
+                                     bool showGrid) const {
+    const int* edges = m_xEdges.data();
+
+    if (dstWidth < 4 * srcWidth) {
+        // At low zoom factors, cells are narrow and it is faster to look up the source of each pixel.
+        const int* sources = m_xSources.data();
+        for (int dx = 0; dx < dstWidth; dx++) {
+            dstRow[dx] = srcRow[sources[dx]];
+        }
+        if (showGrid) {
+            for (int sx = 0; sx < srcWidth; sx++) {
+                dstRow[edges[sx]] = kFrameColor;
+            }
+        }
+    } else if (showGrid) {
+        for (int sx = 0; sx < srcWidth; sx++) {
+            dstRow[edges[sx]] = kFrameColor;
+            FillSpan(dstRow + edges[sx] + 1, edges[sx + 1] - edges[sx] - 1, srcRow[sx]);
+        }
+    } else {
+        for (int sx = 0; sx < srcWidth; sx++) {
+            FillSpan(dstRow + edges[sx], edges[sx + 1] - edges[sx], srcRow[sx]);
+        }
+    }
+
+    dstRow[0] = kFrameColor;
+    dstRow[dstWidth - 1] = kFrameColor;
+}
+
+void MeaMagnifierRenderer::FillSpan(Pixel* dst, int count, Pixel value) {
+    if (count < 4) {
+        for (int i = 0; i < count; i++) {
+            dst[i] = value;
+        }
+        return;
+    }
+
+    int i = 0;
+
+#ifdef MEA_RENDERER_SSE2
+    __m128i v = _mm_set1_epi32(static_cast<int>(value));
+    for (; i + 8 <= count; i += 8) {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), v);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i + 4), v);
+    }
+    if (i + 4 <= count) {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), v);
+        i += 4;
+    }
+#endif
+
+    for (; i < count; i++) {
+        dst[i] = value;
+    }
+}
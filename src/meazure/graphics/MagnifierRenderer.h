@@ -0,0 +1,138 @@
+/*
+ * Copyright 2022 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/// @file
+/// @brief Header file for the portable magnifier image renderer.
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+
+/// Renders the magnified image displayed by the magnifier. The renderer works on 32-bit pixel buffers laid
+/// out as in a top-down 32 bits per pixel DIB section, so that the magnifier can capture the screen into one
+/// DIB section and render directly into the bits of another. The renderer does not depend on MFC or Windows
+/// and can be used on any platform.
+///
+/// The source image is a small square region of the screen centered on the position being magnified. Each
+/// source pixel is expanded into a cell of the destination image using nearest neighbour scaling. The
+/// destination image is framed and, optionally, overlaid with a grid outlining each cell. The cell
+/// corresponding to the center of the source is outlined with a marker.
+///
+/// The image is produced in a single pass over the destination. Each destination row is either expanded
+/// from its source row with the frame, grid and marker pixels written in the same pass, or, when it is
+/// identical to the row above it, copied from that row. Every destination pixel is therefore written once.
+///
+class MeaMagnifierRenderer {
+
+public:
+    /// Pixel in the format of a 32-bit DIB (i.e. 0x00RRGGBB).
+    ///
+    typedef std::uint32_t Pixel;
+
+    /// View of a pixel buffer owned by the caller.
+    ///
+    struct Image {
+        Pixel* m_pixels;            ///< First pixel of the top row.
+        int m_width;                ///< Width of the image, in pixels.
+        int m_height;               ///< Height of the image, in pixels.
+        int m_stride;               ///< Number of pixels from the start of one row to the start of the next.
+
+        /// Obtains the first pixel of the specified row.
+        ///
+        /// @param y    [in] Row, where 0 is the top row.
+        /// @return First pixel of the row.
+        ///
+        Pixel* Row(int y) const { return m_pixels + static_cast<std::ptrdiff_t>(y) * m_stride; }
+    };
+
+
+    static constexpr Pixel kFrameColor = 0x000000;      ///< Color of the image frame and grid.
+    static constexpr Pixel kMarkerColor = 0xFF0000;     ///< Color of the center marker.
+    static constexpr Pixel kClearColor = 0x000000;      ///< Color of source pixels outside the screen.
+
+
+    /// Converts a pixel to a Windows COLORREF value (i.e. 0x00BBGGRR).
+    ///
+    /// @param pixel    [in] Pixel to convert.
+    /// @return COLORREF value for the pixel.
+    ///
+    static constexpr std::uint32_t ToColorRef(Pixel pixel) {
+        return ((pixel & 0xFF) << 16) | (pixel & 0xFF00) | ((pixel >> 16) & 0xFF);
+    }
+
+    /// Sets the source pixels outside the specified rectangle to kClearColor. Used to blank the portions of the
+    /// source region that lie outside the screen being magnified.
+    ///
+    /// @param image    [in, out] Image to clear.
+    /// @param left     [in] Left edge of the region to retain, inclusive.
+    /// @param top      [in] Top edge of the region to retain, inclusive.
+    /// @param right    [in] Right edge of the region to retain, exclusive.
+    /// @param bottom   [in] Bottom edge of the region to retain, exclusive.
+    ///
+    static void ClearOutside(const Image& image, int left, int top, int right, int bottom);
+
+    /// Renders the magnified image. The source image is scaled to fill the destination image, which is
+    /// framed, overlaid with the grid if requested, and marked at the center cell.
+    ///
+    /// @param src          [in] Source image. Must be at least one pixel in each dimension.
+    /// @param dst          [in, out] Destination image. Must be at least as large as the source image.
+    /// @param showGrid     [in] Indicates whether to draw the grid outlining each source pixel.
+    ///
+    void Render(const Image& src, const Image& dst, bool showGrid);
+
+private:
+    /// Computes the destination coordinate at which each source pixel begins. The table is only recomputed when
+    /// the dimensions change, which is rare.
+    ///
+    /// @param edges        [in, out] Table of edges. On return has srcLength + 1 entries.
+    /// @param srcLength    [in] Number of source pixels.
+    /// @param dstLength    [in] Number of destination pixels.
+    ///
+    static void ComputeEdges(std::vector<int>& edges, int srcLength, int dstLength);
+
+    /// Expands a source row into a destination row, drawing the frame and the vertical grid lines in the same
+    /// pass.
+    ///
+    /// @param srcRow       [in] Source pixels.
+    /// @param srcWidth     [in] Number of source pixels.
+    /// @param dstRow       [out] Destination pixels.
+    /// @param dstWidth     [in] Number of destination pixels.
+    /// @param showGrid     [in] Indicates whether to draw the grid.
+    ///
+    void ExpandRow(const Pixel* srcRow, int srcWidth, Pixel* dstRow, int dstWidth, bool showGrid) const;
+
+    /// Sets a span of pixels to the specified value. Uses SSE2 stores where available.
+    ///
+    /// @param dst      [out] First pixel of the span.
+    /// @param count    [in] Number of pixels in the span.
+    /// @param value    [in] Pixel value.
+    ///
+    static void FillSpan(Pixel* dst, int count, Pixel value);
+
+
+    std::vector<int> m_xEdges;      ///< Destination column at which each source column begins.
+    std::vector<int> m_xSources;    ///< Source column for each destination column.
+    std::vector<int> m_yEdges;      ///< Destination row at which each source row begins.
+    int m_srcWidth = 0;             ///< Source width for which m_xEdges was computed.
+    int m_srcHeight = 0;            ///< Source height for which m_yEdges was computed.
+    int m_dstWidth = 0;             ///< Destination width for which m_xEdges was computed.
+    int m_dstHeight = 0;            ///< Destination height for which m_yEdges was computed.
+};
@@ -0,0 +1,233 @@
+/*
+ * Copyright 2022 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "RegionSampler.h"
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define MEA_SAMPLER_SSE2
+#endif
+
+
+namespace {
+    constexpr int kShifts[MeaRegionSampler::kNumChannels] = { 16, 8, 0 };     ///< Bit position of each channel.
+
+#ifdef MEA_SAMPLER_SSE2
+    /// Maximum number of pixels accumulated in the 32-bit SSE2 lanes before they are added to the 64-bit totals.
+    /// Each lane receives one quarter of the pixels, and 4096 squares of 255 fit in 32 bits.
+    constexpr int kMaxLanePixels = 4 * 4096;
+
+    std::uint64_t SumLanes(__m128i lanes) {
+        alignas(16) std::uint32_t values[4];
+        _mm_store_si128(reinterpret_cast<__m128i*>(values), lanes);
+        return static_cast<std::uint64_t>(values[0]) + values[1] + values[2] + values[3];
+    }
+#endif
+}
+
+
+void MeaRegionSampler::Sample(const Image& image, int left, int top, int right, int bottom) {
+    for (int channel = 0; channel < kNumChannels; channel++) {
+        m_histograms[channel].fill(0);
+        m_sums[channel] = 0;
+        m_sumSquares[channel] = 0;
+    }
+    m_count = 0;
+
+    m_rect = Clip(image, left, top, right, bottom);
+    AccumulateRect(image, m_rect, true);
+}
+
+void MeaRegionSampler::Move(const Image& image, int left, int top, int right, int bottom) {
+    Rect rect = Clip(image, left, top, right, bottom);
+
+    AccumulateDifference(image, m_rect, rect, false);
+    AccumulateDifference(image, rect, m_rect, true);
+    m_rect = rect;
+}
+
+MeaRegionSampler::Stats MeaRegionSampler::GetStats() const {
+    Stats stats = {};
+    stats.m_count = m_count;
+    if (m_count == 0) {
+        return stats;
+    }
+
+    double count = m_count;
+    std::uint32_t medianRank = (static_cast<std::uint32_t>(m_count) + 1) / 2;
+
+    for (int channel = 0; channel < kNumChannels; channel++) {
+        const Histogram& histogram = m_histograms[channel];
+        ChannelStats& channelStats = stats.m_channels[channel];
+
+        int value = 0;
+        while (histogram[value] == 0) {
+            value++;
+        }
+        channelStats.m_min = value;
+
+        std::uint32_t cumulative = 0;
+        while (cumulative + histogram[value] < medianRank) {
+            cumulative += histogram[value++];
+        }
+        channelStats.m_median = value;
+
+        value = static_cast<int>(histogram.size()) - 1;
+        while (histogram[value] == 0) {
+            value--;
+        }
+        channelStats.m_max = value;
+
+        double mean = m_sums[channel] / count;
+        double variance = m_sumSquares[channel] / count - mean * mean;
+        channelStats.m_mean = mean;
+        channelStats.m_stdDev = std::sqrt(std::max(variance, 0.0));
+    }
+
+    return stats;
+}
+
+MeaRegionSampler::Pixel MeaRegionSampler::GetMeanColor() const {
+    if (m_count == 0) {
+        return 0;
+    }
+
+    std::uint64_t count = static_cast<std::uint64_t>(m_count);
+    Pixel color = 0;
+    for (int channel = 0; channel < kNumChannels; channel++) {
+        Pixel mean = static_cast<Pixel>((m_sums[channel] + count / 2) / count);
+        color |= mean << kShifts[channel];
+    }
+    return color;
+}
+
+MeaRegionSampler::Rect MeaRegionSampler::Clip(const Image& image, int left, int top, int right, int bottom) {
+    Rect rect;
+    rect.m_left = std::clamp(left, 0, image.m_width);
+    rect.m_right = std::clamp(right, rect.m_left, image.m_width);
+    rect.m_top = std::clamp(top, 0, image.m_height);
+    rect.m_bottom = std::clamp(bottom, rect.m_top, image.m_height);
+    return rect;
+}
+
+void MeaRegionSampler::AccumulateDifference(const Image& image, const Rect& rect, const Rect& exclude, bool add) {
+    Rect overlap;
+    overlap.m_left = std::max(rect.m_left, exclude.m_left);
+    overlap.m_right = std::min(rect.m_right, exclude.m_right);
+    overlap.m_top = std::max(rect.m_top, exclude.m_top);
+    overlap.m_bottom = std::min(rect.m_bottom, exclude.m_bottom);
+
+    if (overlap.IsEmpty()) {
+        AccumulateRect(image, rect, add);
+        return;
+    }
+
+    // The portion of rect outside the overlap consists of full width bands above and below the overlap, and
+    // partial bands to its left and right.
+    AccumulateRect(image, { rect.m_left, rect.m_top, rect.m_right, overlap.m_top }, add);
+    AccumulateRect(image, { rect.m_left, overlap.m_bottom, rect.m_right, rect.m_bottom }, add);
+    AccumulateRect(image, { rect.m_left, overlap.m_top, overlap.m_left, overlap.m_bottom }, add);
+    AccumulateRect(image, { overlap.m_right, overlap.m_top, rect.m_right, overlap.m_bottom }, add);
+}
+
+void MeaRegionSampler::AccumulateRect(const Image& image, const Rect& rect, bool add) {
+    if (rect.IsEmpty()) {
+        return;
+    }
+
+    int width = rect.m_right - rect.m_left;
+    for (int y = rect.m_top; y < rect.m_bottom; y++) {
+        AccumulateSpan(image.Row(y) + rect.m_left, width, add);
+    }
+}
+
+void MeaRegionSampler::AccumulateSpan(const Pixel* pixels, int count, bool add) {
+    std::uint64_t sums[kNumChannels] = {};
+    std::uint64_t sumSquares[kNumChannels] = {};
+    int i = 0;
+
+#ifdef MEA_SAMPLER_SSE2
+    const __m128i channelMask = _mm_set1_epi32(0xFF);
+
+    while (count - i >= 4) {
+        int chunkEnd = i + std::min((count - i) & ~3, kMaxLanePixels);
+        __m128i laneSums[kNumChannels] = { _mm_setzero_si128(), _mm_setzero_si128(), _mm_setzero_si128() };
+        __m128i laneSquares[kNumChannels] = { _mm_setzero_si128(), _mm_setzero_si128(), _mm_setzero_si128() };
+
+        for (; i < chunkEnd; i += 4) {
+            __m128i quad = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels + i));
+
+            // Each 32-bit lane holds one channel value, so that as 16-bit lanes it is the pair (value, 0) and
+            // _mm_madd_epi16 yields its square.
+            __m128i red = _mm_and_si128(_mm_srli_epi32(quad, 16), channelMask);
+            __m128i green = _mm_and_si128(_mm_srli_epi32(quad, 8), channelMask);
+            __m128i blue = _mm_and_si128(quad, channelMask);
+
+            laneSums[Red] = _mm_add_epi32(laneSums[Red], red);
+            laneSums[Green] = _mm_add_epi32(laneSums[Green], green);
+            laneSums[Blue] = _mm_add_epi32(laneSums[Blue], blue);
+            laneSquares[Red] = _mm_add_epi32(laneSquares[Red], _mm_madd_epi16(red, red));
+            laneSquares[Green] = _mm_add_epi32(laneSquares[Green], _mm_madd_epi16(green, green));
+            laneSquares[Blue] = _mm_add_epi32(laneSquares[Blue], _mm_madd_epi16(blue, blue));
+        }
+
+        for (int channel = 0; channel < kNumChannels; channel++) {
+            sums[channel] += SumLanes(laneSums[channel]);
+            sumSquares[channel] += SumLanes(laneSquares[channel]);
+        }
+    }
+#endif
+
+    for (; i < count; i++) {
+        for (int channel = 0; channel < kNumChannels; channel++) {
+            std::uint64_t value = (pixels[i] >> kShifts[channel]) & 0xFF;
+            sums[channel] += value;
+            sumSquares[channel] += value * value;
+        }
+    }
+
+    // The histograms are updated pixel by pixel.
+    if (add) {
+        for (int j = 0; j < count; j++) {
+            Pixel pixel = pixels[j];
+            m_histograms[Red][(pixel >> 16) & 0xFF]++;
+            m_histograms[Green][(pixel >> 8) & 0xFF]++;
+            m_histograms[Blue][pixel & 0xFF]++;
+        }
+        for (int channel = 0; channel < kNumChannels; channel++) {
+            m_sums[channel] += sums[channel];
+            m_sumSquares[channel] += sumSquares[channel];
+        }
+        m_count += count;
+    } else {
+        for (int j = 0; j < count; j++) {
+            Pixel pixel = pixels[j];
+            m_histograms[Red][(pixel >> 16) & 0xFF]--;
+            m_histograms[Green][(pixel >> 8) & 0xFF]--;
+            m_histograms[Blue][pixel & 0xFF]--;
+        }
+        for (int channel = 0; channel < kNumChannels; channel++) {
+            m_sums[channel] -= sums[channel];
+            m_sumSquares[channel] -= sumSquares[channel];
+        }
+        m_count -= count;
+    }
+}
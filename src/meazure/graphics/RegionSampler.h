@@ -0,0 +1,173 @@
+/*
+ * Copyright 2022 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/// @file
+/// @brief Header file for the color statistics sampler used by the magnifier.
+
+#pragma once
+
+#include "MagnifierRenderer.h"
+#include <array>
+#include <cstdint>
+
+
+/// Computes color statistics over a rectangular region of a 32-bit pixel image. For each of the red, green and
+/// blue channels the sampler maintains a 256 bin histogram together with the running sum and sum of squares of
+/// the channel values. The mean and standard deviation are derived from the sums, and the minimum, maximum and
+/// median are located by scanning the histogram, so that obtaining the statistics costs the same regardless of
+/// the size of the region.
+///
+/// The sums are accumulated over spans of pixels, four pixels at a time using SSE2 where available. When the
+/// region is moved, only the pixels that leave the region are subtracted and only the pixels that enter it are
+/// added, so that sliding a region by one pixel costs a single row or column rather than the whole region. An
+/// incremental move is only valid if the pixels of the region that remain in it have not changed since they
+/// were accumulated. Otherwise, Sample must be called to recompute the statistics.
+///
+/// The sampler does not depend on MFC or Windows and can be used on any platform.
+///
+class MeaRegionSampler {
+
+public:
+    typedef MeaMagnifierRenderer::Pixel Pixel;
+    typedef MeaMagnifierRenderer::Image Image;
+
+    /// Color channels of a pixel.
+    ///
+    enum Channel {
+        Red = 0,
+        Green = 1,
+        Blue = 2
+    };
+
+    static constexpr int kNumChannels = 3;      ///< Number of color channels in a pixel.
+
+    /// Number of pixels in each channel value bin.
+    ///
+    typedef std::array<std::uint32_t, 256> Histogram;
+
+    /// Statistics for a single color channel. All values are zero if the region is empty.
+    ///
+    struct ChannelStats {
+        int m_min;                  ///< Smallest value in the region.
+        int m_max;                  ///< Largest value in the region.
+        int m_median;               ///< Median value. For an even count, the lower of the two middle values.
+        double m_mean;              ///< Average value in the region.
+        double m_stdDev;            ///< Population standard deviation of the values in the region.
+    };
+
+    /// Statistics for all channels of a region.
+    ///
+    struct Stats {
+        ChannelStats m_channels[kNumChannels];  ///< Statistics for each channel, indexed by Channel.
+        int m_count;                            ///< Number of pixels in the region.
+    };
+
+
+    /// Computes the statistics for the specified region of the image. The region is clipped to the image.
+    ///
+    /// @param image    [in] Image to sample.
+    /// @param left     [in] Left edge of the region, inclusive.
+    /// @param top      [in] Top edge of the region, inclusive.
+    /// @param right    [in] Right edge of the region, exclusive.
+    /// @param bottom   [in] Bottom edge of the region, exclusive.
+    ///
+    void Sample(const Image& image, int left, int top, int right, int bottom);
+
+    /// Moves the region to the specified position, updating the statistics incrementally. The region is clipped
+    /// to the image. The pixels of the image that lie in both the previous and the new region must not have
+    /// changed since they were sampled.
+    ///
+    /// @param image    [in] Image to sample.
+    /// @param left     [in] Left edge of the region, inclusive.
+    /// @param top      [in] Top edge of the region, inclusive.
+    /// @param right    [in] Right edge of the region, exclusive.
+    /// @param bottom   [in] Bottom edge of the region, exclusive.
+    ///
+    void Move(const Image& image, int left, int top, int right, int bottom);
+
+    /// Computes the statistics of the current region.
+    ///
+    /// @return Statistics for each channel.
+    ///
+    Stats GetStats() const;
+
+    /// Obtains the average color of the current region. Each channel is rounded to the nearest value.
+    ///
+    /// @return Average color, or 0 if the region is empty.
+    ///
+    Pixel GetMeanColor() const;
+
+    /// Obtains the histogram for the specified channel of the current region.
+    ///
+    /// @param channel  [in] Channel whose histogram is to be obtained.
+    /// @return Histogram of the channel values.
+    ///
+    const Histogram& GetHistogram(Channel channel) const { return m_histograms[channel]; }
+
+    /// Obtains the number of pixels in the current region.
+    ///
+    /// @return Number of pixels sampled.
+    ///
+    int GetCount() const { return m_count; }
+
+private:
+    /// Region of the image, with exclusive right and bottom edges.
+    ///
+    struct Rect {
+        int m_left;
+        int m_top;
+        int m_right;
+        int m_bottom;
+
+        bool IsEmpty() const { return m_left >= m_right || m_top >= m_bottom; }
+    };
+
+
+    /// Clips the specified region to the image.
+    ///
+    static Rect Clip(const Image& image, int left, int top, int right, int bottom);
+
+    /// Adds or subtracts the pixels in the portion of rect that lies outside of exclude.
+    ///
+    /// @param image    [in] Image being sampled.
+    /// @param rect     [in] Region whose pixels are to be accumulated.
+    /// @param exclude  [in] Region whose pixels are to be skipped. May be empty.
+    /// @param add      [in] true to add the pixels, false to subtract them.
+    ///
+    void AccumulateDifference(const Image& image, const Rect& rect, const Rect& exclude, bool add);
+
+    /// Adds or subtracts the pixels in the specified region.
+    ///
+    void AccumulateRect(const Image& image, const Rect& rect, bool add);
+
+    /// Adds or subtracts a span of pixels.
+    ///
+    /// @param pixels   [in] First pixel of the span.
+    /// @param count    [in] Number of pixels in the span.
+    /// @param add      [in] true to add the pixels, false to subtract them.
+    ///
+    void AccumulateSpan(const Pixel* pixels, int count, bool add);
+
+
+    Histogram m_histograms[kNumChannels] = {};          ///< Histogram of each channel.
+    std::uint64_t m_sums[kNumChannels] = {};            ///< Sum of each channel's values.
+    std::uint64_t m_sumSquares[kNumChannels] = {};      ///< Sum of the squares of each channel's values.
+    int m_count = 0;                                    ///< Number of pixels in the region.
+    Rect m_rect = { 0, 0, 0, 0 };                       ///< Region sampled.
+};
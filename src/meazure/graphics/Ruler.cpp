@@ -20,6 +20,7 @@
 #include <meazure/pch.h>
 #include "Ruler.h"
 #include "Colors.h"
+#include "FramePacer.h"
 #include <meazure/ui/Layout.h>
 #include <meazure/ui/LayeredWindows.h>
 
@@ -50,6 +51,7 @@ MeaRuler::MeaRuler(const MeaScreenProvider& screenProvider, const MeaUnitsProvid
     m_thk(0),
     m_mouseCaptured(false),
     m_opacity(255),
+    m_composited(false),
     m_origRulerBitmap(nullptr),
     m_origBackBitmap(nullptr) {
     // Initially hide all position indicators.
@@ -103,9 +105,13 @@ bool MeaRuler::Create(COLORREF borderColor, COLORREF backColor, BYTE opacity,
         return false;
     }
 
-    // If layered windows are available, set the ruler opacity.
+    // If layered windows are available, popup rulers are presented as
+    // layered windows using per-pixel alpha. They are rendered only
+    // when their contents change, so moving them does not require
+    // repainting.
     //
-    if (HaveLayeredWindows() && (parent == nullptr)) {
+    m_composited = HaveLayeredWindows() && (parent == nullptr);
+    if (m_composited) {
         ModifyStyleEx(0, WS_EX_LAYERED);
         SetOpacity(opacity);
     }
@@ -174,10 +180,15 @@ bool MeaRuler::Create(COLORREF borderColor, COLORREF backColor, BYTE opacity,
     //
     SetPosition((orientation == Horizontal) ? m_targetRect.top : m_targetRect.left);
 
+    if (m_composited) {
+        Render();
+    }
+
     return true;
 }
 
 void MeaRuler::OnDestroy() {
+    MeaFramePacer::Forget(*this);
     MeaGraphic::OnDestroy();
 
     m_hFont.DeleteObject();
@@ -194,6 +205,8 @@ void MeaRuler::OnDestroy() {
         m_backDC.DeleteDC();
         m_origBackBitmap = nullptr;
     }
+
+    m_surface.Free();
 }
 
 void MeaRuler::SetColors(COLORREF borderColor, COLORREF backColor) {
@@ -207,7 +220,13 @@ void MeaRuler::SetOpacity(BYTE opacity) {
     m_opacity = opacity;
 
     if (m_hWnd != nullptr) {
-        if (m_parent == nullptr) {
+        if (m_composited) {
+            // The content is unchanged, so it only needs to be composed
+            // again with the new opacity.
+            if (m_surface.IsAllocated()) {
+                Present();
+            }
+        } else if (m_parent == nullptr) {
             SetLayeredWindowAttributes(*this, 0, opacity, LWA_ALPHA);
         } else {
             Update();
@@ -236,8 +255,7 @@ void MeaRuler::SetPosition(int position) {
         m_labelPosition = (m_position < targetCenter.y) ? Top : Bottom;
 
         if (GetSafeHwnd() != nullptr) {
-            SetWindowPos(nullptr, m_targetRect.left, m_position, 0, 0,
-                SWP_NOSIZE | SWP_NOZORDER | SWP_NOACTIVATE | SWP_NOSENDCHANGING);
+            MeaFramePacer::Move(*this, m_targetRect.left, m_position);
         }
         break;
     case Vertical:
@@ -250,19 +268,32 @@ void MeaRuler::SetPosition(int position) {
         m_labelPosition = (m_position < targetCenter.x) ? Left : Right;
 
         if (GetSafeHwnd() != nullptr) {
-            SetWindowPos(nullptr, m_position, m_targetRect.top, 0, 0,
-                SWP_NOSIZE | SWP_NOZORDER | SWP_NOACTIVATE | SWP_NOSENDCHANGING);
+            MeaFramePacer::Move(*this, m_position, m_targetRect.top);
         }
         break;
     }
 
     if (origLabelPosition != m_labelPosition) {
-        Invalidate(FALSE);
+        if (m_composited) {
+            if (m_surface.IsAllocated()) {
+                Render();
+            }
+        } else {
+            Invalidate(FALSE);
+        }
     }
 }
 
 void MeaRuler::SetIndicator(IndicatorId indId, int pixel) {
-    if (GetSafeHwnd() != nullptr) {
+    if (m_composited && m_surface.IsAllocated()) {
+        // Only the lines at the old and new indicator positions are
+        // composed again.
+        int oldPixel = m_indicatorLoc[indId];
+        m_indicatorLoc[indId] = pixel;
+        ComposeIndicatorLine(oldPixel);
+        ComposeIndicatorLine(pixel);
+        m_surface.Present(*this);
+    } else if (!m_composited && (GetSafeHwnd() != nullptr)) {
         CClientDC dc(this);
         DrawIndicator(indId, dc);
         m_indicatorLoc[indId] = pixel;
@@ -309,7 +340,78 @@ void MeaRuler::DrawIndicator(IndicatorId indId, CDC& dc) {
     dc.SelectObject(origPen);
 }
 
-void MeaRuler::DrawRuler(CDC& dc) {
+void MeaRuler::Render() {
+    CRect clientRect;
+    GetClientRect(clientRect);
+    if (!m_surface.Allocate(clientRect.Size())) {
+        return;
+    }
+
+    // The indicators are composed separately so that they can be moved
+    // without drawing the ruler again.
+    //
+    DrawRuler(m_surface.GetContentDC(), false);
+    m_surface.Flush();
+
+    Present();
+}
+
+void MeaRuler::Present() {
+    MeaLayeredRaster::ApplyOpacity(m_surface.GetImage(), m_surface.GetContent(), m_opacity);
+    for (int indId = 0; indId < NumIndicators; indId++) {
+        ComposeIndicatorLine(m_indicatorLoc[indId]);
+    }
+
+    m_surface.Present(*this);
+}
+
+void MeaRuler::ComposeIndicatorLine(int pixel) {
+    const MeaLayeredRaster::Image& image = m_surface.GetImage();
+    const MeaLayeredRaster::Image& content = m_surface.GetContent();
+
+    // Indicators are drawn with an XOR pen, so indicators at the same
+    // position cancel each other.
+    //
+    int count = 0;
+    for (int indId = 0; indId < NumIndicators; indId++) {
+        if (m_indicatorLoc[indId] == pixel) {
+            count++;
+        }
+    }
+
+    // The line is restored from the content and then the indicator is
+    // drawn over it. As with DrawIndicator, the indicator does not
+    // include the last pixel of the line.
+    //
+    MeaLayeredRaster::Image line;
+    MeaLayeredRaster::Image contentLine;
+    MeaLayeredRaster::Image indicator;
+    MeaLayeredRaster::Image contentIndicator;
+
+    if (m_orientation == Horizontal) {
+        int x = pixel;
+        MeaLayout::ScreenToClientX(*this, x);
+        line = image.Sub(x, 0, 1, image.m_height);
+        contentLine = content.Sub(x, 0, 1, content.m_height);
+        indicator = image.Sub(x, 0, 1, image.m_height - 1);
+        contentIndicator = content.Sub(x, 0, 1, content.m_height - 1);
+    } else {
+        int y = pixel;
+        MeaLayout::ScreenToClientY(*this, y);
+        line = image.Sub(0, y, image.m_width, 1);
+        contentLine = content.Sub(0, y, content.m_width, 1);
+        indicator = image.Sub(0, y, image.m_width - 1, 1);
+        contentIndicator = content.Sub(0, y, content.m_width - 1, 1);
+    }
+
+    MeaLayeredRaster::ApplyOpacity(line, contentLine, m_opacity);
+    if ((count % 2) != 0) {
+        MeaLayeredRaster::ApplyOpacityDottedXor(indicator, contentIndicator, m_opacity,
+                                                MeaLayeredRaster::FromColorRef(m_borderColor));
+    }
+}
+
+void MeaRuler::DrawRuler(CDC& dc, bool drawIndicators) {
     // One of the major challenges in drawing the ruler is drawing the tick
     // marks in the correct location and with the appropriate appearance. This
     // is because the position of a tick mark might not necessarily land on an
@@ -333,8 +435,10 @@ void MeaRuler::DrawRuler(CDC& dc) {
 
     // Redraw the indicators
     //
-    for (int indId = 0; indId < NumIndicators; indId++) {
-        DrawIndicator(static_cast<IndicatorId>(indId), dc);
+    if (drawIndicators) {
+        for (int indId = 0; indId < NumIndicators; indId++) {
+            DrawIndicator(static_cast<IndicatorId>(indId), dc);
+        }
     }
 
     // Draw tick marks and labels
@@ -365,47 +469,65 @@ void MeaRuler::DrawRuler(CDC& dc) {
         CFont* oldFont = dc.SelectObject(&m_vFont);
 
         do {
+            // Collect the ticks within the window, then place them on pixels together.
+            //
+            m_tickPositions.clear();
+            m_tickNumbers.clear();
+            m_tickCoords.clear();
             for (p = 0.0, tick = 0, y = static_cast<int>(units->UnconvertCoord(MeaConvertY, this, p));
                     y >= virtRect.top && y < virtRect.bottom;
                     p += minorIncr.cy, tick++, y = static_cast<int>(units->UnconvertCoord(MeaConvertY, this, p))) {
-
                 if (y >= winRect.top && y < winRect.bottom) {
-                    isMajorTick = ((tick % majorTickCount) == 0);
-                    tickHeight = isMajorTick ? m_majorTickHeight.cx : m_minorTickHeight.cx;
-                    isExact = units->UnconvertCoord(MeaConvertY, this, p, ya, yb);
-
-                    MeaLayout::ScreenToClientY(*this, y);
-                    MeaLayout::ScreenToClientY(*this, ya);
-                    MeaLayout::ScreenToClientY(*this, yb);
-
-                    CPen* oldPen = dc.SelectObject(isExact ? &pen : &pen1);
-
-                    if (m_labelPosition == Left) {
-                        dc.MoveTo(clientRect.right, ya);
-                        dc.LineTo(clientRect.right - tickHeight, ya);
-                        if (!isExact) {
-                            dc.SelectObject(&pen2);
-                            dc.MoveTo(clientRect.right, yb);
-                            dc.LineTo(clientRect.right - tickHeight, yb);
-                        }
-                        if (isMajorTick) {
-                            dc.TextOut(clientRect.left + m_margin.cx, y, m_unitsProvider.Format(MeaY, p));
-                        }
-                    } else {
-                        dc.MoveTo(clientRect.left, ya);
-                        dc.LineTo(clientRect.left + tickHeight, ya);
-                        if (!isExact) {
-                            dc.SelectObject(&pen2);
-                            dc.MoveTo(clientRect.left, yb);
-                            dc.LineTo(clientRect.left + tickHeight, yb);
-                        }
-                        if (isMajorTick) {
-                            dc.TextOut(clientRect.left + tickHeight + m_margin.cx, y, m_unitsProvider.Format(MeaY, p));
-                        }
-                    }
+                    m_tickPositions.push_back(p);
+                    m_tickNumbers.push_back(tick);
+                    m_tickCoords.push_back(y);
+                }
+            }
 
-                    dc.SelectObject(oldPen);
+            m_tickPixels.resize(m_tickPositions.size());
+            units->UnconvertTicks(MeaConvertY, this, m_tickPositions.data(), m_tickPixels.data(),
+                                  m_tickPositions.size());
+
+            for (std::size_t i = 0; i < m_tickPositions.size(); i++) {
+                p = m_tickPositions[i];
+                y = m_tickCoords[i];
+                ya = m_tickPixels[i].m_c1;
+                yb = m_tickPixels[i].m_c2;
+                isExact = m_tickPixels[i].m_exact;
+                isMajorTick = ((m_tickNumbers[i] % majorTickCount) == 0);
+                tickHeight = isMajorTick ? m_majorTickHeight.cx : m_minorTickHeight.cx;
+
+                MeaLayout::ScreenToClientY(*this, y);
+                MeaLayout::ScreenToClientY(*this, ya);
+                MeaLayout::ScreenToClientY(*this, yb);
+
+                CPen* oldPen = dc.SelectObject(isExact ? &pen : &pen1);
+
+                if (m_labelPosition == Left) {
+                    dc.MoveTo(clientRect.right, ya);
+                    dc.LineTo(clientRect.right - tickHeight, ya);
+                    if (!isExact) {
+                        dc.SelectObject(&pen2);
+                        dc.MoveTo(clientRect.right, yb);
+                        dc.LineTo(clientRect.right - tickHeight, yb);
+                    }
+                    if (isMajorTick) {
+                        dc.TextOut(clientRect.left + m_margin.cx, y, m_unitsProvider.Format(MeaY, p));
+                    }
+                } else {
+                    dc.MoveTo(clientRect.left, ya);
+                    dc.LineTo(clientRect.left + tickHeight, ya);
+                    if (!isExact) {
+                        dc.SelectObject(&pen2);
+                        dc.MoveTo(clientRect.left, yb);
+                        dc.LineTo(clientRect.left + tickHeight, yb);
+                    }
+                    if (isMajorTick) {
+                        dc.TextOut(clientRect.left + tickHeight + m_margin.cx, y, m_unitsProvider.Format(MeaY, p));
+                    }
                 }
+
+                dc.SelectObject(oldPen);
             }
             minorIncr.cy = -minorIncr.cy;
         } while (minorIncr.cy < 0);
@@ -415,47 +537,65 @@ void MeaRuler::DrawRuler(CDC& dc) {
         CFont* oldFont = dc.SelectObject(&m_hFont);
 
         do {
+            // Collect the ticks within the window, then place them on pixels together.
+            //
+            m_tickPositions.clear();
+            m_tickNumbers.clear();
+            m_tickCoords.clear();
             for (p = 0.0, tick = 0, x = static_cast<int>(units->UnconvertCoord(MeaConvertX, this, p));
                     x >= virtRect.left && x < virtRect.right;
                     p += minorIncr.cx, tick++, x = static_cast<int>(units->UnconvertCoord(MeaConvertX, this, p))) {
-
                 if (x >= winRect.left && x < winRect.right) {
-                    isMajorTick = ((tick % majorTickCount) == 0);
-                    tickHeight = isMajorTick ? m_majorTickHeight.cy : m_minorTickHeight.cy;
-                    isExact = units->UnconvertCoord(MeaConvertX, this, p, xa, xb);
-
-                    MeaLayout::ScreenToClientX(*this, x);
-                    MeaLayout::ScreenToClientX(*this, xa);
-                    MeaLayout::ScreenToClientX(*this, xb);
-
-                    CPen* oldPen = dc.SelectObject(isExact ? &pen : &pen1);
-
-                    if (m_labelPosition == Top) {
-                        dc.MoveTo(xa, clientRect.bottom);
-                        dc.LineTo(xa, clientRect.bottom - tickHeight);
-                        if (!isExact) {
-                            dc.SelectObject(&pen2);
-                            dc.MoveTo(xb, clientRect.bottom);
-                            dc.LineTo(xb, clientRect.bottom - tickHeight);
-                        }
-                        if (isMajorTick) {
-                            dc.TextOut(x, clientRect.top + m_margin.cy, m_unitsProvider.Format(MeaX, p));
-                        }
-                    } else {
-                        dc.MoveTo(xa, clientRect.top);
-                        dc.LineTo(xa, clientRect.top + tickHeight);
-                        if (!isExact) {
-                            dc.SelectObject(&pen2);
-                            dc.MoveTo(xb, clientRect.top);
-                            dc.LineTo(xb, clientRect.top + tickHeight);
-                        }
-                        if (isMajorTick) {
-                            dc.TextOut(x, clientRect.top + tickHeight + m_margin.cy, m_unitsProvider.Format(MeaX, p));
-                        }
-                    }
+                    m_tickPositions.push_back(p);
+                    m_tickNumbers.push_back(tick);
+                    m_tickCoords.push_back(x);
+                }
+            }
 
-                    dc.SelectObject(oldPen);
+            m_tickPixels.resize(m_tickPositions.size());
+            units->UnconvertTicks(MeaConvertX, this, m_tickPositions.data(), m_tickPixels.data(),
+                                  m_tickPositions.size());
+
+            for (std::size_t i = 0; i < m_tickPositions.size(); i++) {
+                p = m_tickPositions[i];
+                x = m_tickCoords[i];
+                xa = m_tickPixels[i].m_c1;
+                xb = m_tickPixels[i].m_c2;
+                isExact = m_tickPixels[i].m_exact;
+                isMajorTick = ((m_tickNumbers[i] % majorTickCount) == 0);
+                tickHeight = isMajorTick ? m_majorTickHeight.cy : m_minorTickHeight.cy;
+
+                MeaLayout::ScreenToClientX(*this, x);
+                MeaLayout::ScreenToClientX(*this, xa);
+                MeaLayout::ScreenToClientX(*this, xb);
+
+                CPen* oldPen = dc.SelectObject(isExact ? &pen : &pen1);
+
+                if (m_labelPosition == Top) {
+                    dc.MoveTo(xa, clientRect.bottom);
+                    dc.LineTo(xa, clientRect.bottom - tickHeight);
+                    if (!isExact) {
+                        dc.SelectObject(&pen2);
+                        dc.MoveTo(xb, clientRect.bottom);
+                        dc.LineTo(xb, clientRect.bottom - tickHeight);
+                    }
+                    if (isMajorTick) {
+                        dc.TextOut(x, clientRect.top + m_margin.cy, m_unitsProvider.Format(MeaX, p));
+                    }
+                } else {
+                    dc.MoveTo(xa, clientRect.top);
+                    dc.LineTo(xa, clientRect.top + tickHeight);
+                    if (!isExact) {
+                        dc.SelectObject(&pen2);
+                        dc.MoveTo(xb, clientRect.top);
+                        dc.LineTo(xb, clientRect.top + tickHeight);
+                    }
+                    if (isMajorTick) {
+                        dc.TextOut(x, clientRect.top + tickHeight + m_margin.cy, m_unitsProvider.Format(MeaX, p));
+                    }
                 }
+
+                dc.SelectObject(oldPen);
             }
             minorIncr.cx = -minorIncr.cx;
         } while (minorIncr.cx < 0);
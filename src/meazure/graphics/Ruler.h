@@ -23,8 +23,10 @@
 #pragma once
 
 #include "Graphic.h"
+#include "LayeredSurface.h"
 #include <meazure/ui/ScreenProvider.h>
 #include <meazure/units/UnitsProvider.h>
+#include <vector>
 
 
 class MeaRuler;
@@ -207,8 +209,12 @@ public:
     ///
     void Update() {
         if (m_hWnd != nullptr) {
-            Invalidate(FALSE);
-            UpdateWindow();
+            if (m_composited) {
+                Render();
+            } else {
+                Invalidate(FALSE);
+                UpdateWindow();
+            }
         }
     }
 
@@ -290,10 +296,32 @@ private:
 
     /// Draws the ruler tick marks and number labels.
     ///
-    /// @param dc       [in] Specifies the device context to use
-    ///                 to draw the ruler.
+    /// @param dc               [in] Specifies the device context to use
+    ///                         to draw the ruler.
+    /// @param drawIndicators   [in] Indicates whether the position
+    ///                         indicators are drawn.
+    ///
+    void DrawRuler(CDC& dc, bool drawIndicators = true);
+
+    /// Draws the ruler into its layered window buffer and presents it.
+    /// Used when the ruler is presented as a layered window.
+    ///
+    void Render();
+
+    /// Composes the previously rendered ruler content with the ruler
+    /// opacity and the position indicators, and presents it as the
+    /// layered window image.
+    ///
+    void Present();
+
+    /// Composes the line of the layered window image at the specified
+    /// position from the ruler content, drawing an indicator on it if
+    /// one is located there.
+    ///
+    /// @param pixel    [in] Position of the line along the length of
+    ///                 the ruler, in screen coordinates.
     ///
-    void DrawRuler(CDC& dc);
+    void ComposeIndicatorLine(int pixel);
 
     /// Fills the ruler information structure so that it can be
     /// passed to the callback method.
@@ -325,10 +353,16 @@ private:
     bool m_mouseCaptured;                       ///< Indicates whether the mouse is currently captured by the ruler window.
     CSize m_pointerOffset;                      ///< Offset between pointer position and ruler edge.
     BYTE m_opacity;                             ///< Current ruler opacity setting (0 - 255).
+    bool m_composited;                          ///< Indicates if the ruler is a per-pixel alpha layered window.
     CDC m_rulerDC;                              ///< Ruler device context
     CDC m_backDC;                               ///< Background device context for alpha blending when the ruler is a child window
     CBitmap m_rulerBitmap;                      ///< Bitmap into which to draw the ruler when it is a child window
     CBitmap* m_origRulerBitmap;                 ///< Original bitmap for the ruler
     CBitmap m_backBitmap;                       ///< Bitmap for the background when alpha blending when the ruler is a child window
     CBitmap* m_origBackBitmap;              ///< Original background bitmap 
+    std::vector<double> m_tickPositions;        ///< Positions of the ticks being drawn, in the current units
+    std::vector<int> m_tickNumbers;             ///< Number of each tick counting from the origin
+    std::vector<int> m_tickCoords;              ///< Screen coordinate of each tick, in pixels
+    std::vector<MeaLinearUnits::TickPixels> m_tickPixels;   ///< Pixel placement of each tick
+    MeaLayeredSurface m_surface;                ///< Buffers for presenting the ruler as a layered window
 };
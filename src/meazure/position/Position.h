@@ -83,7 +83,7 @@ public:
     /// 
     /// @return Name of the tool that recorded this position.
     /// 
-    CString GetToolName() const { return m_toolName; }
+    const CString& GetToolName() const { return m_toolName; }
 
     /// Places a description on the position.
     ///
@@ -96,19 +96,19 @@ public:
     /// @return Description of the position or the empty string if
     ///         there is no description.
     ///
-    CString GetDesc() const { return m_desc; }
+    const CString& GetDesc() const { return m_desc; }
 
     /// Returns the timestamp indicating when this position was recorded.
     ///
     /// @return Timestamp for the position in ISO 8601 format.
     ///
-    CString GetTimeStamp() const { return m_timestamp; }
+    const CString& GetTimeStamp() const { return m_timestamp; }
 
     /// Returns the identifier of the desktop information object referenced by this position.
     /// 
     /// @return Desktop information identifier referenced by this position.
     ///  
-    MeaPositionDesktopRef GetDesktopRef() const { return m_desktopRef; }
+    const MeaPositionDesktopRef& GetDesktopRef() const { return m_desktopRef; }
 
     /// Returns the points representing the position.
     /// 
@@ -117,6 +117,12 @@ public:
     ///
     const PointMap& GetPoints() const { return m_points; }
 
+    /// Returns the data fields recorded for this position. Different tools record different fields.
+    ///
+    /// @return Bitwise OR of the MeaDataFieldId values of the recorded fields.
+    ///
+    UINT GetFieldMask() const { return m_fieldMask; }
+
     /// Returns the recorded width.
     /// 
     /// @return Recorded width
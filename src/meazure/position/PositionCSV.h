@@ -0,0 +1,47 @@
+/*
+ * Copyright 2022 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/// @file
+/// @brief Header file for the columns of positions written as comma separated values.
+
+#pragma once
+
+
+/// Columns of a position written as comma separated values (CSV). Both the position export writer
+/// (MeaPositionExportWriter) and the position log converter (MeaPositionLogConverter) write positions as CSV, and
+/// both use these definitions so that the files they produce have the same header and columns. The definitions
+/// do not depend on MFC or Windows and can be used on any platform.
+///
+namespace MeaPositionCSV {
+
+    /// Identifies a column. Columns are written in the order listed.
+    ///
+    enum class Field {
+        Tool, Timestamp, X1, Y1, X2, Y2, XV, YV, Width, Height, Distance, Area, Angle, DesktopId, Desc
+    };
+
+    constexpr int kFieldCount { 15 };           ///< Number of columns.
+
+    /// Names of the columns written in the header row, in Field order.
+    ///
+    inline constexpr const char* kFieldNames[kFieldCount] = {
+        "tool", "timestamp", "x1", "y1", "x2", "y2", "xv", "yv", "width", "height", "distance", "area", "angle",
+        "desktop id", "desc"
+    };
+};
@@ -32,6 +32,17 @@ MeaPositionCollection::~MeaPositionCollection() {
 void MeaPositionCollection::Add(MeaPosition* position) {
     int posIndex = Size();
     m_posMap[posIndex] = position;
+    m_columnsValid = false;
+}
+
+void MeaPositionCollection::Add(const std::vector<MeaPosition*>& positions) {
+    // Indices are assigned in increasing order, so each position is inserted at the end of the map.
+    //
+    int posIndex = Size();
+    for (MeaPosition* position : positions) {
+        m_posMap.emplace_hint(m_posMap.end(), posIndex++, position);
+    }
+    m_columnsValid = false;
 }
 
 void MeaPositionCollection::Set(int posIndex, MeaPosition* position) {
@@ -42,6 +53,7 @@ void MeaPositionCollection::Set(int posIndex, MeaPosition* position) {
 
     delete (*iter).second;
     (*iter).second = position;
+    m_columnsValid = false;
 }
 
 MeaPosition& MeaPositionCollection::Get(int posIndex) const {
@@ -76,6 +88,7 @@ void MeaPositionCollection::Delete(int posIndex) {
     // moved "down" one index.
     //
     m_posMap.erase(static_cast<int>(m_posMap.size()) - 1);
+    m_columnsValid = false;
 }
 
 void MeaPositionCollection::DeleteAll() {
@@ -83,6 +96,15 @@ void MeaPositionCollection::DeleteAll() {
         delete posEntry.second;
     }
     m_posMap.clear();
+    m_columnsValid = false;
+}
+
+const MeaPositionColumns& MeaPositionCollection::GetColumns() const {
+    if (!m_columnsValid) {
+        m_columns.Build(*this);
+        m_columnsValid = true;
+    }
+    return m_columns;
 }
 
 void MeaPositionCollection::Save(MeaXMLWriter& writer) const {
@@ -23,8 +23,10 @@
 #pragma once
 
 #include "Position.h"
+#include "PositionColumns.h"
 #include <meazure/xml/XMLWriter.h>
 #include <map>
+#include <vector>
 
 
 /// Represents a collection of positions. A position log consists
@@ -34,6 +36,8 @@
 class MeaPositionCollection {
 
 public:
+    MeaPositionCollection() : m_columnsValid(false) {}
+
     /// Destroys a position collection object and the positions objects it contains.
     ///
     ~MeaPositionCollection();
@@ -56,6 +60,12 @@ public:
     ///
     void Add(MeaPosition* position);
 
+    /// Adds the specified positions to the end of the collection, in order.
+    ///
+    /// @param positions    [in] Positions to add to the collection. The collection takes ownership of them.
+    ///
+    void Add(const std::vector<MeaPosition*>& positions);
+
     /// Replaces the specified position at the specified location in the collection.
     ///
     /// @param posIndex     [in] Zero based index indicating where in
@@ -75,6 +85,18 @@ public:
     ///
     MeaPosition& Get(int posIndex) const;
 
+    /// Calls the specified function for each position in the collection, in index order. This avoids the
+    /// lookup performed by Get when all positions are visited.
+    ///
+    /// @param func         [in] Function called with each position, as func(const MeaPosition&).
+    ///
+    template <typename Func>
+    void ForEach(Func func) const {
+        for (const auto& posEntry : m_posMap) {
+            func(static_cast<const MeaPosition&>(*posEntry.second));
+        }
+    }
+
     /// Removes the position object from the specified location in the
     /// collection and destroys the object.
     ///
@@ -89,6 +111,14 @@ public:
     ///
     void DeleteAll();
 
+    /// Returns a columnar copy of the positions for use by queries (see MeaPositionQuery). The columns are built
+    /// the first time they are requested after positions have been added, replaced or deleted. Positions that
+    /// are modified in place through Get are not detected; replace such a position using Set.
+    ///
+    /// @return Columns holding the values of the positions in the collection.
+    ///
+    const MeaPositionColumns& GetColumns() const;
+
     /// Saves all positions in the collection to the log file.
     ///
     /// @param writer       [in] Provides ability to write a position to the log.
@@ -98,5 +128,7 @@ public:
 private:
     typedef std::map<int, MeaPosition*> PositionMap;       ///< Maps indices to position objects.
 
-    PositionMap m_posMap;       ///< Collection of positions.
+    PositionMap m_posMap;                   ///< Collection of positions.
+    mutable MeaPositionColumns m_columns;   ///< Columnar copy of the positions, built on demand.
+    mutable bool m_columnsValid;            ///< Indicates if m_columns reflects the current positions.
 };
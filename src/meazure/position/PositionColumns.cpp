@@ -0,0 +1,138 @@
+/*
+ * Copyright 2022 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <meazure/pch.h>
+#include "PositionColumns.h"
+#include "PositionCollection.h"
+#include <meazure/utilities/TimeStamp.h>
+#include <stdexcept>
+
+
+namespace {
+    // Fields that have a value column. The order defines the index of each column.
+    //
+    constexpr MeaDataFieldId kValueFields[] = {
+        MeaWidthField, MeaHeightField, MeaDistanceField, MeaAreaField, MeaAngleField
+    };
+}
+
+
+void MeaPositionColumns::Build(const MeaPositionCollection& positions) {
+    unsigned int size = positions.Size();
+
+    m_tools.clear();
+    m_toolNames.clear();
+    m_times.clear();
+    m_desktops.clear();
+    m_desktopIds.clear();
+    m_masks.clear();
+
+    m_tools.reserve(size);
+    m_times.reserve(size);
+    m_desktops.reserve(size);
+    m_masks.reserve(size);
+    for (std::vector<double>& values : m_values) {
+        values.clear();
+        values.reserve(size);
+    }
+
+    // Positions are typically recorded in runs by the same tool on the same desktop, and positions recorded
+    // together share a time stamp, so the previous position is checked before searching or parsing.
+    //
+    int toolIndex = kNotFound;
+    int desktopIndex = kNotFound;
+    const CString* prevTimeStamp = nullptr;
+    time_t prevTime = kNoTime;
+
+    positions.ForEach([&](const MeaPosition& position) {
+        const CString& toolName = position.GetToolName();
+        if (toolIndex == kNotFound || m_toolNames[toolIndex] != toolName) {
+            toolIndex = FindTool(toolName);
+            if (toolIndex == kNotFound) {
+                toolIndex = static_cast<int>(m_toolNames.size());
+                m_toolNames.push_back(toolName);
+            }
+        }
+        m_tools.push_back(toolIndex);
+
+        const CString& timeStamp = position.GetTimeStamp();
+        if (prevTimeStamp == nullptr || *prevTimeStamp != timeStamp) {
+            try {
+                prevTime = MeaTimeStamp::Parse(timeStamp);
+            } catch (...) {
+                prevTime = kNoTime;
+            }
+            prevTimeStamp = &timeStamp;
+        }
+        m_times.push_back(prevTime);
+
+        const MeaGUID& desktopId = position.GetDesktopRef().GetId();
+        if (desktopIndex == kNotFound || m_desktopIds[desktopIndex] != desktopId) {
+            desktopIndex = FindDesktop(desktopId);
+            if (desktopIndex == kNotFound) {
+                desktopIndex = static_cast<int>(m_desktopIds.size());
+                m_desktopIds.push_back(desktopId);
+            }
+        }
+        m_desktops.push_back(desktopIndex);
+
+        m_masks.push_back(position.GetFieldMask());
+        m_values[ValueIndex(MeaWidthField)].push_back(position.GetWidth());
+        m_values[ValueIndex(MeaHeightField)].push_back(position.GetHeight());
+        m_values[ValueIndex(MeaDistanceField)].push_back(position.GetDistance());
+        m_values[ValueIndex(MeaAreaField)].push_back(position.GetArea());
+        m_values[ValueIndex(MeaAngleField)].push_back(position.GetAngle());
+    });
+}
+
+int MeaPositionColumns::FindTool(const CString& toolName) const {
+    for (std::size_t i = 0; i < m_toolNames.size(); i++) {
+        if (m_toolNames[i] == toolName) {
+            return static_cast<int>(i);
+        }
+    }
+    return kNotFound;
+}
+
+int MeaPositionColumns::FindDesktop(const MeaGUID& desktopId) const {
+    for (std::size_t i = 0; i < m_desktopIds.size(); i++) {
+        if (m_desktopIds[i] == desktopId) {
+            return static_cast<int>(i);
+        }
+    }
+    return kNotFound;
+}
+
+bool MeaPositionColumns::IsValueField(MeaDataFieldId field) {
+    for (MeaDataFieldId valueField : kValueFields) {
+        if (valueField == field) {
+            return true;
+        }
+    }
+    return false;
+}
+
+int MeaPositionColumns::ValueIndex(MeaDataFieldId field) {
+    for (int i = 0; i < kValueFieldCount; i++) {
+        if (kValueFields[i] == field) {
+            return i;
+        }
+    }
+    throw std::invalid_argument("MeaPositionColumns::ValueIndex field does not have a value column");
+}
@@ -0,0 +1,153 @@
+/*
+ * Copyright 2022 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/// @file
+/// @brief Header file for the columnar cache of position values.
+
+#pragma once
+
+#include <meazure/ui/DataFieldId.h>
+#include <meazure/utilities/GUID.h>
+#include <array>
+#include <vector>
+#include <limits>
+#include <time.h>
+
+
+class MeaPositionCollection;
+
+
+/// Columnar copy of the values of a position collection used to query and summarize positions. Each value is
+/// held in its own array indexed by position, so that a filter or aggregate over a single value reads a
+/// contiguous block of memory rather than visiting each position object. Strings that are compared by queries
+/// (tool names and desktop identifiers) are interned and represented by small integers, and time stamps are
+/// parsed once when the columns are built.
+///
+/// The columns are a snapshot of the collection. The collection rebuilds them on demand after positions are
+/// added, replaced or deleted (see MeaPositionCollection::GetColumns).
+///
+class MeaPositionColumns {
+
+public:
+    static constexpr int kNotFound { -1 };      ///< Returned when a tool or desktop is not in the columns.
+    static constexpr time_t kNoTime { std::numeric_limits<time_t>::min() };  ///< Time of an unparsable time stamp.
+
+
+    /// Replaces the contents of the columns with the values of the specified positions. Storage allocated for a
+    /// previous build is reused.
+    ///
+    /// @param positions    [in] Positions to copy into the columns.
+    ///
+    void Build(const MeaPositionCollection& positions);
+
+    /// Returns the number of positions in the columns.
+    ///
+    /// @return Number of positions.
+    ///
+    unsigned int Size() const { return static_cast<unsigned int>(m_masks.size()); }
+
+    /// Returns the interned tool name of each position.
+    ///
+    /// @return Index into the tool names for each position.
+    ///
+    const std::vector<int>& GetTools() const { return m_tools; }
+
+    /// Returns the tool name with the specified index.
+    ///
+    /// @param toolIndex    [in] Index of a tool name obtained from GetTools or FindTool.
+    ///
+    /// @return Tool name.
+    ///
+    const CString& GetToolName(int toolIndex) const { return m_toolNames[toolIndex]; }
+
+    /// Locates the specified tool name.
+    ///
+    /// @param toolName     [in] Name of the tool (e.g. "LineTool").
+    ///
+    /// @return Index of the tool name, or kNotFound if no position was recorded by the tool.
+    ///
+    int FindTool(const CString& toolName) const;
+
+    /// Returns the time at which each position was recorded.
+    ///
+    /// @return Seconds since the Epoch for each position, or kNoTime if the time stamp could not be parsed.
+    ///
+    const std::vector<time_t>& GetTimes() const { return m_times; }
+
+    /// Returns the interned desktop identifier of each position.
+    ///
+    /// @return Index into the desktop identifiers for each position.
+    ///
+    const std::vector<int>& GetDesktops() const { return m_desktops; }
+
+    /// Locates the specified desktop.
+    ///
+    /// @param desktopId    [in] Identifier of the desktop information object.
+    ///
+    /// @return Index of the desktop, or kNotFound if no position refers to the desktop.
+    ///
+    int FindDesktop(const MeaGUID& desktopId) const;
+
+    /// Returns the data fields recorded for each position.
+    ///
+    /// @return Mask of MeaDataFieldId values for each position.
+    ///
+    const std::vector<UINT>& GetFieldMasks() const { return m_masks; }
+
+    /// Returns the values of the specified field for each position. The value of a position that did not record
+    /// the field is 0.0. Use GetFieldMasks to determine if the field was recorded.
+    ///
+    /// @param field        [in] One of MeaWidthField, MeaHeightField, MeaDistanceField, MeaAreaField or
+    ///                     MeaAngleField.
+    ///
+    /// @return Value of the field for each position.
+    /// @throws std::invalid_argument if the field is not one of the supported fields.
+    ///
+    const std::vector<double>& GetValues(MeaDataFieldId field) const { return m_values[ValueIndex(field)]; }
+
+    /// Indicates whether the specified field has a value column.
+    ///
+    /// @param field        [in] Data field to test.
+    ///
+    /// @return <b>true</b> if GetValues can be called with the field.
+    ///
+    static bool IsValueField(MeaDataFieldId field);
+
+private:
+    static constexpr int kValueFieldCount { 5 };        ///< Number of value columns.
+
+
+    /// Obtains the index of the value column for the specified field.
+    ///
+    /// @param field        [in] Data field whose column is to be located.
+    ///
+    /// @return Index into m_values.
+    /// @throws std::invalid_argument if the field is not one of the supported fields.
+    ///
+    static int ValueIndex(MeaDataFieldId field);
+
+
+    std::vector<int> m_tools;                   ///< Index into m_toolNames for each position.
+    std::vector<CString> m_toolNames;           ///< Distinct tool names, in order of first use.
+    std::vector<time_t> m_times;                ///< Recording time of each position.
+    std::vector<int> m_desktops;                ///< Index into m_desktopIds for each position.
+    std::vector<MeaGUID> m_desktopIds;          ///< Distinct desktop identifiers, in order of first use.
+    std::vector<UINT> m_masks;                  ///< Recorded data fields for each position.
+    std::array<std::vector<double>, kValueFieldCount> m_values;    ///< Value columns, indexed by ValueIndex.
+};
@@ -0,0 +1,175 @@
+/*
+ * Copyright 2022 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <meazure/pch.h>
+#include "PositionExportWriter.h"
+#include <meazure/ui/DataFieldId.h>
+#include <meazure/utilities/NumberFormat.h>
+#include <meazure/utilities/StringUtils.h>
+
+
+MeaPositionExportWriter::MeaPositionExportWriter(std::ostream& out, const MeaPositionProvider& provider) :
+    m_out(out), m_provider(provider) {
+    // Room is left for the row that fills the buffer, so that it does not need to grow.
+    m_chunk.reserve(kChunkSize + kChunkSize / 4);
+}
+
+void MeaPositionExportWriter::Export() {
+    m_chunk.clear();
+
+    for (int field = 0; field < MeaPositionCSV::kFieldCount; field++) {
+        if (field > 0) {
+            AppendChar(',');
+        }
+        m_chunk.append(MeaPositionCSV::kFieldNames[field]);
+    }
+    EndRow();
+
+    m_provider.GetPositions().ForEach([this](const MeaPosition& position) {
+        for (int field = 0; field < MeaPositionCSV::kFieldCount; field++) {
+            if (field > 0) {
+                AppendChar(',');
+            }
+            AppendField(position, static_cast<MeaPositionCSV::Field>(field));
+        }
+        EndRow();
+    });
+
+    Flush();
+    m_out.flush();
+}
+
+void MeaPositionExportWriter::AppendField(const MeaPosition& position, MeaPositionCSV::Field field) {
+    static const UINT kPropertyFields[] = { MeaWidthField, MeaHeightField, MeaDistanceField, MeaAreaField,
+                                            MeaAngleField };
+
+    switch (field) {
+    case MeaPositionCSV::Field::Tool:
+        AppendText(position.GetToolName());
+        break;
+    case MeaPositionCSV::Field::Timestamp:
+        AppendText(position.GetTimeStamp());
+        break;
+    case MeaPositionCSV::Field::X1:
+    case MeaPositionCSV::Field::Y1:
+    case MeaPositionCSV::Field::X2:
+    case MeaPositionCSV::Field::Y2:
+    case MeaPositionCSV::Field::XV:
+    case MeaPositionCSV::Field::YV:
+    {
+        // Point names are single characters. The point map is searched directly rather than with a lookup,
+        // which would create a CString key for every field of every position.
+        static const TCHAR kPointNames[] = { _T('1'), _T('2'), _T('v') };
+        int coord = static_cast<int>(field) - static_cast<int>(MeaPositionCSV::Field::X1);
+        TCHAR name = kPointNames[coord / 2];
+
+        for (const auto& pointEntry : position.GetPoints()) {
+            if (pointEntry.first.GetLength() == 1 && pointEntry.first[0] == name) {
+                AppendNumber((coord % 2 == 0) ? pointEntry.second.x : pointEntry.second.y);
+                break;
+            }
+        }
+        break;
+    }
+    case MeaPositionCSV::Field::Width:
+    case MeaPositionCSV::Field::Height:
+    case MeaPositionCSV::Field::Distance:
+    case MeaPositionCSV::Field::Area:
+    case MeaPositionCSV::Field::Angle:
+    {
+        int property = static_cast<int>(field) - static_cast<int>(MeaPositionCSV::Field::Width);
+        if ((position.GetFieldMask() & kPropertyFields[property]) != 0) {
+            const double values[] = {
+                position.GetWidth(), position.GetHeight(), position.GetDistance(), position.GetArea(),
+                position.GetAngle()
+            };
+            AppendNumber(values[property]);
+        }
+        break;
+    }
+    case MeaPositionCSV::Field::DesktopId:
+        m_chunk.append(GetDesktopText(position.GetDesktopRef().GetId()));
+        break;
+    case MeaPositionCSV::Field::Desc:
+        AppendText(position.GetDesc());
+        break;
+    }
+}
+
+void MeaPositionExportWriter::AppendText(const CString& str) {
+    PCTSTR chars = str;
+    int len = str.GetLength();
+
+    bool needsQuotes = false;
+    for (int i = 0; i < len && !needsQuotes; i++) {
+        TCHAR ch = chars[i];
+        needsQuotes = (ch == _T(',') || ch == _T('"') || ch == _T('\r') || ch == _T('\n'));
+    }
+
+    if (!needsQuotes) {
+        MeaStringUtils::AppendUTF8(m_chunk, chars, len);
+        return;
+    }
+
+    // Quotes within a quoted field are doubled.
+    AppendChar('"');
+    int start = 0;
+    for (int i = 0; i < len; i++) {
+        if (chars[i] == _T('"')) {
+            MeaStringUtils::AppendUTF8(m_chunk, chars + start, i + 1 - start);
+            AppendChar('"');
+            start = i + 1;
+        }
+    }
+    MeaStringUtils::AppendUTF8(m_chunk, chars + start, len - start);
+    AppendChar('"');
+}
+
+void MeaPositionExportWriter::AppendNumber(double value) {
+    MeaNumberFormat::Buffer buffer;
+    m_chunk.append(MeaNumberFormat::FormatTrimmed(buffer, value));
+}
+
+void MeaPositionExportWriter::EndRow() {
+    AppendChar('\n');
+    if (m_chunk.size() >= kChunkSize) {
+        Flush();
+    }
+}
+
+void MeaPositionExportWriter::Flush() {
+    if (!m_chunk.empty()) {
+        m_out.write(m_chunk.data(), static_cast<std::streamsize>(m_chunk.size()));
+        m_chunk.clear();
+    }
+}
+
+const std::string& MeaPositionExportWriter::GetDesktopText(const MeaGUID& id) {
+    for (const auto& entry : m_desktopText) {
+        if (entry.first == id) {
+            return entry.second;
+        }
+    }
+
+    std::string text;
+    CString idStr = id.ToString();
+    MeaStringUtils::AppendUTF8(text, idStr, idStr.GetLength());
+    m_desktopText.emplace_back(id, std::move(text));
+    return m_desktopText.back().second;
+}
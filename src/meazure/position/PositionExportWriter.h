@@ -0,0 +1,112 @@
+/*
+ * Copyright 2022 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/// @file
+/// @brief Header file for exporting positions as comma separated values.
+
+#pragma once
+
+#include "PositionCSV.h"
+#include "PositionProvider.h"
+#include <meazure/utilities/GUID.h>
+#include <ostream>
+#include <string>
+#include <vector>
+#include <utility>
+#include <cstddef>
+
+
+/// Exports the positions of a position provider as comma separated values (CSV) for analysis in other tools,
+/// such as spreadsheets and dataframes. Because positions are obtained from a MeaPositionProvider, both recorded
+/// and loaded positions can be exported. A header row naming the fields is followed by one row per position, so
+/// that each field is a column that can be loaded directly into a dataframe.
+///
+/// The columns are: tool, timestamp, x1, y1, x2, y2, xv, yv, width, height, distance, area, angle, desktop id and
+/// desc, as defined by MeaPositionCSV. Points and measurements that were not recorded for a position are left
+/// empty. Text is written as UTF-8 and numbers are written in the same format as in a position log file.
+///
+/// Output is streamed. Fields are encoded directly into a fixed size chunk buffer, which is written to the stream
+/// each time it fills, so no string is created per position and memory use does not grow with the number of
+/// positions.
+///
+class MeaPositionExportWriter {
+
+public:
+    static constexpr std::size_t kChunkSize { 64 * 1024 };     ///< Size at which buffered output is written.
+
+
+    /// Constructs an export writer.
+    ///
+    /// @param out          [in] Stream to which the positions are written. Should be opened in binary mode so
+    ///                     that line endings are not translated.
+    /// @param provider     [in] Provides the positions to export.
+    ///
+    MeaPositionExportWriter(std::ostream& out, const MeaPositionProvider& provider);
+
+    /// Writes the header row and the positions.
+    ///
+    void Export();
+
+private:
+    /// Appends the value of the specified field of a position to the chunk buffer. Nothing is appended if the
+    /// position does not have a value for the field.
+    ///
+    /// @param position     [in] Position whose field is to be written.
+    /// @param field        [in] Field to write.
+    ///
+    void AppendField(const MeaPosition& position, MeaPositionCSV::Field field);
+
+    /// Appends the specified text to the chunk buffer as a CSV field, quoting it if necessary.
+    ///
+    /// @param str          [in] Text to append.
+    ///
+    void AppendText(const CString& str);
+
+    /// Appends the specified number to the chunk buffer.
+    ///
+    /// @param value        [in] Number to append.
+    ///
+    void AppendNumber(double value);
+
+    /// Appends the specified character to the chunk buffer.
+    ///
+    void AppendChar(char ch) { m_chunk.push_back(ch); }
+
+    /// Ends a row, writing the chunk buffer to the stream if it is full.
+    ///
+    void EndRow();
+
+    /// Writes the contents of the chunk buffer to the stream and empties the buffer.
+    ///
+    void Flush();
+
+    /// Obtains the UTF-8 text of the specified desktop identifier. Identifiers are converted once and cached,
+    /// since a log typically contains few desktops and many positions.
+    ///
+    /// @param id           [in] Desktop identifier.
+    /// @return Text of the identifier.
+    ///
+    const std::string& GetDesktopText(const MeaGUID& id);
+
+
+    std::ostream& m_out;                            ///< Stream to which the positions are written.
+    const MeaPositionProvider& m_provider;          ///< Provides the positions to export.
+    std::string m_chunk;                            ///< Output accumulated since the last write.
+    std::vector<std::pair<MeaGUID, std::string>> m_desktopText;     ///< Cached desktop identifier text.
+};
@@ -0,0 +1,1003 @@
+/*
+ * Copyright 2022 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "PositionLogConverter.h"
+#include "PositionCSV.h"
+#include <meazure/units/UnitsConversion.h>
+#include <meazure/xml/XMLDocument.h>
+#include <meazure/utilities/NumberFormat.h>
+#include <meazure/utilities/NumberParse.h>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <set>
+#include <sstream>
+#include <thread>
+
+
+namespace {
+    typedef MeaXMLDocument::Element Element;
+    typedef MeaPositionLogConverter::Desktop Desktop;
+    typedef MeaPositionLogConverter::Screen Screen;
+    typedef MeaPositionLogConverter::Position Position;
+    typedef MeaUnitsConversion::Origin Origin;
+
+    constexpr double kPi = 3.14159265358979323846;
+
+    constexpr const char* kDtdUrl = "https://www.cthing.com/dtd/PositionLog1.dtd";
+
+    /// Tool names in the order of their binary identifiers.
+    constexpr const char* kToolNames[] = {
+        "CursorTool", "LineTool", "PointTool", "RectTool", "CircleTool", "AngleTool", "WindowTool"
+    };
+
+    /// Point names in the order of their binary flags and columns.
+    constexpr const char* kPointNames[] = { "1", "2", "v" };
+
+
+    /// Conversion factors from pixels to units (see MeaUnitsConversion::FromPixels).
+    ///
+    struct Factors {
+        double m_cx;
+        double m_cy;
+    };
+
+    /// Screen rectangle in pixels. The right and bottom edges are exclusive.
+    ///
+    struct PixelRect {
+        double m_left;
+        double m_top;
+        double m_right;
+        double m_bottom;
+    };
+
+    /// Converts a location from pixels to units, as MeaUnitsTransform::ConvertCoord does.
+    ///
+    void Convert(const Origin& origin, double px, double py, const Factors& f, double& x, double& y) {
+        x = origin.ConvertX(px, f.m_cx);
+        y = origin.ConvertY(py, f.m_cy);
+    }
+
+    /// Recovers the pixel location from which a location in units was converted. Recorded values are rounded
+    /// when written, so the result is rounded to the nearest pixel rather than truncated.
+    ///
+    void Unconvert(const Origin& origin, double x, double y, const Factors& f, double& px, double& py) {
+        px = std::round(origin.UnconvertX(x, f.m_cx));
+        py = std::round(origin.UnconvertY(y, f.m_cy));
+    }
+
+    /// Pixel geometry of a desktop recovered from its recorded coordinates.
+    ///
+    struct PixelDesktop {
+        std::vector<Factors> m_ppi;         ///< Resolution of each screen, in pixels per inch.
+        std::vector<PixelRect> m_rects;     ///< Rectangle of each screen, in pixels.
+        std::size_t m_primary { 0 };        ///< Index of the primary screen.
+    };
+
+
+    [[noreturn]] void Fail(const std::string& message) {
+        throw MeaPositionLogConverterException(message);
+    }
+
+    const std::string& GetRequired(const Element& element, const char* name) {
+        const std::string* value = element.GetAttribute(name);
+        if (value == nullptr) {
+            Fail("missing attribute " + std::string(name) + " on element " + element.m_name);
+        }
+        return *value;
+    }
+
+    std::string GetOptional(const Element& element, const char* name, const char* defaultValue = "") {
+        const std::string* value = element.GetAttribute(name);
+        return (value == nullptr) ? std::string(defaultValue) : *value;
+    }
+
+    double GetDbl(const Element& element, const char* name) {
+        const std::string& str = GetRequired(element, name);
+        double value;
+        if (MeaNumberParse::ParseDbl(str, value) != MeaNumberParse::Result::Ok) {
+            Fail("invalid number '" + str + "' for attribute " + name + " on element " + element.m_name);
+        }
+        return value;
+    }
+
+    bool GetBool(const Element& element, const char* name) {
+        return GetOptional(element, name, "false") == "true";
+    }
+
+    void ParseInfo(const Element& infoElement, MeaPositionLogConverter::Log& log) {
+        for (const Element& element : infoElement.m_children) {
+            if (element.m_name == "title") {
+                log.m_title = element.m_text;
+            } else if (element.m_name == "desc") {
+                log.m_desc = element.m_text;
+            } else if (element.m_name == "created") {
+                log.m_created = GetRequired(element, "date");
+            } else if (element.m_name == "generator") {
+                log.m_generatorName = GetRequired(element, "name");
+                log.m_generatorVersion = GetRequired(element, "version");
+                log.m_generatorBuild = GetRequired(element, "build");
+            } else if (element.m_name == "machine") {
+                log.m_machine = GetRequired(element, "name");
+            }
+        }
+    }
+
+    Desktop ParseDesktop(const Element& desktopElement) {
+        Desktop desktop;
+        desktop.m_id = GetRequired(desktopElement, "id");
+
+        for (const Element& element : desktopElement.m_children) {
+            if (element.m_name == "units") {
+                desktop.m_lengthUnits = GetRequired(element, "length");
+                desktop.m_angleUnits = GetOptional(element, "angle", "deg");
+            } else if (element.m_name == "customUnits") {
+                desktop.m_customName = GetRequired(element, "name");
+                desktop.m_customAbbrev = GetRequired(element, "abbrev");
+                desktop.m_customBasis = GetRequired(element, "scaleBasis");
+                desktop.m_customFactor = GetDbl(element, "scaleFactor");
+            } else if (element.m_name == "origin") {
+                desktop.m_originX = GetDbl(element, "xoffset");
+                desktop.m_originY = GetDbl(element, "yoffset");
+                desktop.m_invertY = GetBool(element, "invertY");
+            } else if (element.m_name == "size") {
+                desktop.m_sizeX = GetDbl(element, "x");
+                desktop.m_sizeY = GetDbl(element, "y");
+            } else if (element.m_name == "screens") {
+                for (const Element& screenElement : element.m_children) {
+                    if (screenElement.m_name != "screen") {
+                        continue;
+                    }
+
+                    Screen screen;
+                    screen.m_desc = GetRequired(screenElement, "desc");
+                    screen.m_primary = GetBool(screenElement, "primary");
+                    for (const Element& child : screenElement.m_children) {
+                        if (child.m_name == "rect") {
+                            screen.m_top = GetDbl(child, "top");
+                            screen.m_bottom = GetDbl(child, "bottom");
+                            screen.m_left = GetDbl(child, "left");
+                            screen.m_right = GetDbl(child, "right");
+                        } else if (child.m_name == "resolution") {
+                            screen.m_resX = GetDbl(child, "x");
+                            screen.m_resY = GetDbl(child, "y");
+                            screen.m_manualRes = GetBool(child, "manual");
+                        }
+                    }
+                    desktop.m_screens.push_back(screen);
+                }
+            }
+        }
+
+        if (desktop.m_lengthUnits.empty()) {
+            Fail("desktop " + desktop.m_id + " does not specify its units");
+        }
+        if (desktop.m_screens.empty()) {
+            Fail("desktop " + desktop.m_id + " does not have any screens");
+        }
+        return desktop;
+    }
+
+    Position ParsePosition(const Element& positionElement) {
+        Position position;
+        position.m_desktopRef = GetRequired(positionElement, "desktopRef");
+        position.m_tool = GetRequired(positionElement, "tool");
+        position.m_date = GetRequired(positionElement, "date");
+
+        for (const Element& element : positionElement.m_children) {
+            if (element.m_name == "desc") {
+                position.m_desc = element.m_text;
+            } else if (element.m_name == "points") {
+                for (const Element& pointElement : element.m_children) {
+                    if (pointElement.m_name == "point") {
+                        MeaPositionLogConverter::Point point;
+                        point.m_name = GetRequired(pointElement, "name");
+                        point.m_x = GetDbl(pointElement, "x");
+                        point.m_y = GetDbl(pointElement, "y");
+                        position.m_points.push_back(point);
+                    }
+                }
+            } else if (element.m_name == "properties") {
+                for (const Element& property : element.m_children) {
+                    if (property.m_name == "width") {
+                        position.m_width = GetDbl(property, "value");
+                        position.m_properties |= MeaPositionLogConverter::kWidth;
+                    } else if (property.m_name == "height") {
+                        position.m_height = GetDbl(property, "value");
+                        position.m_properties |= MeaPositionLogConverter::kHeight;
+                    } else if (property.m_name == "distance") {
+                        position.m_distance = GetDbl(property, "value");
+                        position.m_properties |= MeaPositionLogConverter::kDistance;
+                    } else if (property.m_name == "area") {
+                        position.m_area = GetDbl(property, "value");
+                        position.m_properties |= MeaPositionLogConverter::kArea;
+                    } else if (property.m_name == "angle") {
+                        position.m_angle = GetDbl(property, "value");
+                        position.m_properties |= MeaPositionLogConverter::kAngle;
+                    }
+                }
+            }
+        }
+
+        return position;
+    }
+
+
+    std::size_t FindPrimary(const Desktop& desktop) {
+        for (std::size_t i = 0; i < desktop.m_screens.size(); i++) {
+            if (desktop.m_screens[i].m_primary) {
+                return i;
+            }
+        }
+        return 0;
+    }
+
+    /// Obtains the conversion factors of each screen of the specified desktop and the resolution from which
+    /// they were computed. The recorded resolution is the reciprocal of the factors, except for pixels, where
+    /// it is the resolution in pixels per inch.
+    ///
+    void GetSourceFactors(const Desktop& desktop, std::vector<Factors>& factors, std::vector<Factors>& ppi) {
+        double unitsPerInch = MeaUnitsConversion::UnitsPerInch(desktop.m_lengthUnits);
+        bool pixels = (desktop.m_lengthUnits == "px");
+
+        if (desktop.m_lengthUnits == "custom") {
+            if (desktop.m_customFactor <= 0.0) {
+                Fail("desktop " + desktop.m_id + " has an invalid custom units scale factor");
+            }
+            if (desktop.m_customBasis == "in") {
+                unitsPerInch = MeaUnitsConversion::kInchesPerInch / desktop.m_customFactor;
+            } else if (desktop.m_customBasis == "cm") {
+                unitsPerInch = MeaUnitsConversion::kCentimetersPerInch / desktop.m_customFactor;
+            } else {
+                Fail("desktop " + desktop.m_id + " uses pixel based custom units, which do not record the screen "
+                     "resolution");
+            }
+        } else if (!pixels && unitsPerInch == 0.0) {
+            Fail("desktop " + desktop.m_id + " uses unknown units " + desktop.m_lengthUnits);
+        }
+
+        for (const Screen& screen : desktop.m_screens) {
+            if (screen.m_resX <= 0.0 || screen.m_resY <= 0.0) {
+                Fail("desktop " + desktop.m_id + " has a screen with an invalid resolution");
+            }
+            if (pixels) {
+                factors.push_back({ 1.0, 1.0 });
+                ppi.push_back({ screen.m_resX, screen.m_resY });
+            } else {
+                factors.push_back({ 1.0 / screen.m_resX, 1.0 / screen.m_resY });
+                ppi.push_back({ screen.m_resX * unitsPerInch, screen.m_resY * unitsPerInch });
+            }
+        }
+    }
+
+    /// Locates the screen containing the specified pixel, or the nearest screen if the pixel is not on any
+    /// screen, using the rule of MeaUnitsTransform::FindNearestScreen.
+    ///
+    std::size_t FindScreen(const PixelDesktop& pixels, double x, double y) {
+        std::size_t nearest = pixels.m_primary;
+        double nearestDist = -1.0;
+
+        for (std::size_t i = 0; i < pixels.m_rects.size(); i++) {
+            const PixelRect& rect = pixels.m_rects[i];
+            double dist = MeaUnitsConversion::ScreenDistanceSq(rect.m_left, rect.m_top, rect.m_right, rect.m_bottom,
+                                                               x, y);
+            if (dist == 0.0) {
+                return i;
+            }
+            if (nearestDist < 0.0 || dist < nearestDist) {
+                nearest = i;
+                nearestDist = dist;
+            }
+        }
+
+        return nearest;
+    }
+
+    /// Recovers the pixel geometry of the specified desktop and the origin with which its coordinates were
+    /// recorded.
+    ///
+    Origin RecoverPixels(const Desktop& desktop, const std::vector<Factors>& factors, PixelDesktop& pixels) {
+        pixels.m_primary = FindPrimary(desktop);
+        const Factors& primaryFactors = factors[pixels.m_primary];
+        double virtualHeight = std::round(desktop.m_sizeY / primaryFactors.m_cy);
+
+        auto decodeRects = [&](const Origin& origin) {
+            pixels.m_rects.clear();
+            for (std::size_t i = 0; i < desktop.m_screens.size(); i++) {
+                const Screen& screen = desktop.m_screens[i];
+                PixelRect rect;
+                Unconvert(origin, screen.m_left, screen.m_top, factors[i], rect.m_left, rect.m_top);
+                Unconvert(origin, screen.m_right, screen.m_bottom, factors[i], rect.m_right, rect.m_bottom);
+                if (rect.m_top > rect.m_bottom) {
+                    std::swap(rect.m_top, rect.m_bottom);
+                }
+                pixels.m_rects.push_back(rect);
+            }
+        };
+
+        // The origin is recorded with MeaUnitsTransform::ConvertPos, using the factors of the screen that
+        // MeaUnitsTransform::FindFromPixels selects for it. The log does not record which screen that was, and
+        // the screen rectangles cannot be recovered without the origin. Each screen is therefore assumed in
+        // turn, and the first one that the same selection rule picks for the resulting origin is used.
+        for (std::size_t i = 0; i < factors.size(); i++) {
+            double originX = std::round(desktop.m_originX / factors[i].m_cx);
+            double originY = std::round(desktop.m_originY / factors[i].m_cy);
+            Origin origin(originX, originY, desktop.m_invertY, virtualHeight);
+            decodeRects(origin);
+            if (FindScreen(pixels, originX, originY) == i) {
+                return origin;
+            }
+        }
+
+        Origin origin(std::round(desktop.m_originX / primaryFactors.m_cx),
+                      std::round(desktop.m_originY / primaryFactors.m_cy), desktop.m_invertY, virtualHeight);
+        decodeRects(origin);
+        return origin;
+    }
+
+    /// Locates the screen whose recorded rectangle contains the specified coordinates, or the primary screen.
+    ///
+    std::size_t FindScreenByCoord(const Desktop& desktop, std::size_t primary, double x, double y) {
+        for (std::size_t i = 0; i < desktop.m_screens.size(); i++) {
+            const Screen& screen = desktop.m_screens[i];
+            double top = std::min(screen.m_top, screen.m_bottom);
+            double bottom = std::max(screen.m_top, screen.m_bottom);
+            if (x >= screen.m_left && x < screen.m_right && y >= top && y < bottom) {
+                return i;
+            }
+        }
+        return primary;
+    }
+
+    /// Converts a desktop and the positions that reference it to the target configuration.
+    ///
+    void ConvertDesktop(Desktop& desktop, std::vector<Position*>& positions,
+                        const MeaPositionLogConverter::Target& target) {
+        std::vector<Factors> sourceFactors;
+        std::vector<Factors> ppi;
+        GetSourceFactors(desktop, sourceFactors, ppi);
+
+        PixelDesktop pixels;
+        Origin sourceOrigin = RecoverPixels(desktop, sourceFactors, pixels);
+
+        bool targetPixels = (target.m_lengthUnits == "px");
+        double targetUnitsPerInch = MeaUnitsConversion::UnitsPerInch(target.m_lengthUnits);
+        std::vector<Factors> targetFactors;
+        for (const Factors& res : ppi) {
+            if (targetPixels) {
+                targetFactors.push_back({ 1.0, 1.0 });
+            } else {
+                targetFactors.push_back({ MeaUnitsConversion::FromPixels(targetUnitsPerInch, res.m_cx),
+                                          MeaUnitsConversion::FromPixels(targetUnitsPerInch, res.m_cy) });
+            }
+        }
+
+        double virtualTop = pixels.m_rects.front().m_top;
+        double virtualBottom = pixels.m_rects.front().m_bottom;
+        double virtualLeft = pixels.m_rects.front().m_left;
+        double virtualRight = pixels.m_rects.front().m_right;
+        for (const PixelRect& rect : pixels.m_rects) {
+            virtualTop = std::min(virtualTop, rect.m_top);
+            virtualBottom = std::max(virtualBottom, rect.m_bottom);
+            virtualLeft = std::min(virtualLeft, rect.m_left);
+            virtualRight = std::max(virtualRight, rect.m_right);
+        }
+
+        double originX = std::round(target.m_originX);
+        double originY = std::round(target.m_originY);
+        Origin targetOrigin(originX, originY, target.m_invertY, virtualBottom - virtualTop);
+
+        auto convertCoord = [&](double px, double py, double& x, double& y) {
+            const Factors& factors = targetFactors[FindScreen(pixels, px, py)];
+            Convert(targetOrigin, px, py, factors, x, y);
+            return factors;
+        };
+
+        // Positions
+        double angleScale = 1.0;
+        if (desktop.m_angleUnits == "deg" && target.m_angleUnits == "rad") {
+            angleScale = kPi / 180.0;
+        } else if (desktop.m_angleUnits == "rad" && target.m_angleUnits == "deg") {
+            angleScale = 180.0 / kPi;
+        }
+        if (desktop.m_invertY != target.m_invertY) {
+            angleScale = -angleScale;
+        }
+
+        for (Position* position : positions) {
+            Factors sourceScale = sourceFactors[pixels.m_primary];
+            Factors targetScale = targetFactors[pixels.m_primary];
+            bool first = true;
+
+            for (MeaPositionLogConverter::Point& point : position->m_points) {
+                std::size_t screen = FindScreenByCoord(desktop, pixels.m_primary, point.m_x, point.m_y);
+                double px;
+                double py;
+                Unconvert(sourceOrigin, point.m_x, point.m_y, sourceFactors[screen], px, py);
+                Factors factors = convertCoord(px, py, point.m_x, point.m_y);
+
+                // Lengths are scaled using the screen on which the first point lies.
+                if (first) {
+                    sourceScale = sourceFactors[screen];
+                    targetScale = factors;
+                    first = false;
+                }
+            }
+
+            double kx = targetScale.m_cx / sourceScale.m_cx;
+            double ky = targetScale.m_cy / sourceScale.m_cy;
+            double width = position->m_width;
+            double height = position->m_height;
+
+            position->m_width *= kx;
+            position->m_height *= ky;
+            position->m_area *= kx * ky;
+            if (kx == ky) {
+                position->m_distance *= kx;
+            } else if ((position->m_properties & (MeaPositionLogConverter::kWidth | MeaPositionLogConverter::kHeight))
+                        == (MeaPositionLogConverter::kWidth | MeaPositionLogConverter::kHeight) &&
+                       std::hypot(width, height) > 0.0) {
+                // The distance is the diagonal of the width and height, which scale differently.
+                position->m_distance *= std::hypot(position->m_width, position->m_height) / std::hypot(width, height);
+            } else {
+                position->m_distance *= kx;
+            }
+            position->m_angle *= angleScale;
+        }
+
+        // Desktop
+        for (std::size_t i = 0; i < desktop.m_screens.size(); i++) {
+            Screen& screen = desktop.m_screens[i];
+            const PixelRect& rect = pixels.m_rects[i];
+            convertCoord(rect.m_left, rect.m_top, screen.m_left, screen.m_top);
+            convertCoord(rect.m_right, rect.m_bottom, screen.m_right, screen.m_bottom);
+
+            if (targetPixels) {
+                screen.m_resX = ppi[i].m_cx;
+                screen.m_resY = ppi[i].m_cy;
+            } else {
+                screen.m_resX = 1.0 / targetFactors[i].m_cx;
+                screen.m_resY = 1.0 / targetFactors[i].m_cy;
+            }
+        }
+
+        const Factors& originFactors = targetFactors[FindScreen(pixels, originX, originY)];
+        desktop.m_originX = originFactors.m_cx * originX;
+        desktop.m_originY = originFactors.m_cy * originY;
+        desktop.m_invertY = target.m_invertY;
+
+        double x1;
+        double y1;
+        double x2;
+        double y2;
+        convertCoord(virtualLeft, virtualTop, x1, y1);
+        convertCoord(virtualRight, virtualBottom, x2, y2);
+        desktop.m_sizeX = std::fabs(x1 - x2);
+        desktop.m_sizeY = std::fabs(y1 - y2);
+
+        desktop.m_lengthUnits = target.m_lengthUnits;
+        desktop.m_angleUnits = target.m_angleUnits;
+        desktop.m_customName.clear();
+        desktop.m_customAbbrev.clear();
+        desktop.m_customBasis.clear();
+        desktop.m_customFactor = 0.0;
+    }
+
+
+    /// Streams text with the XML special characters escaped.
+    ///
+    struct Escaped {
+        const std::string& m_str;
+    };
+
+    std::ostream& operator<<(std::ostream& out, const Escaped& escaped) {
+        for (char ch : escaped.m_str) {
+            switch (ch) {
+            case '&':   out << "&amp;";     break;
+            case '<':   out << "&lt;";      break;
+            case '>':   out << "&gt;";      break;
+            case '\'':  out << "&apos;";    break;
+            case '"':   out << "&quot;";    break;
+            default:    out << ch;          break;
+            }
+        }
+        return out;
+    }
+
+    /// Streams a number in the format used by MeaStringUtils::DblToStr.
+    ///
+    struct Number {
+        double m_value;
+    };
+
+    std::ostream& operator<<(std::ostream& out, const Number& number) {
+        MeaNumberFormat::Buffer buffer;
+        return out << MeaNumberFormat::FormatTrimmed(buffer, number.m_value);
+    }
+
+    /// Streams a CSV field, quoted if necessary.
+    ///
+    struct CSVField {
+        const std::string& m_str;
+    };
+
+    std::ostream& operator<<(std::ostream& out, const CSVField& field) {
+        if (field.m_str.find_first_of(",\"\r\n") == std::string::npos) {
+            return out << field.m_str;
+        }
+        out << '"';
+        for (char ch : field.m_str) {
+            if (ch == '"') {
+                out << '"';
+            }
+            out << ch;
+        }
+        return out << '"';
+    }
+
+    const MeaPositionLogConverter::Point* FindPoint(const Position& position, const char* name) {
+        for (const MeaPositionLogConverter::Point& point : position.m_points) {
+            if (point.m_name == name) {
+                return &point;
+            }
+        }
+        return nullptr;
+    }
+
+    /// Writes the specified column of a position as a CSV field. Nothing is written if the position does not have
+    /// a value for the column.
+    ///
+    void WriteCSVField(std::ostream& out, const Position& position, MeaPositionCSV::Field field) {
+        typedef MeaPositionCSV::Field Field;
+
+        switch (field) {
+        case Field::Tool:
+            out << CSVField { position.m_tool };
+            break;
+        case Field::Timestamp:
+            out << CSVField { position.m_date };
+            break;
+        case Field::X1:
+        case Field::Y1:
+        case Field::X2:
+        case Field::Y2:
+        case Field::XV:
+        case Field::YV:
+        {
+            int coord = static_cast<int>(field) - static_cast<int>(Field::X1);
+            const MeaPositionLogConverter::Point* point = FindPoint(position, kPointNames[coord / 2]);
+            if (point != nullptr) {
+                out << Number { (coord % 2 == 0) ? point->m_x : point->m_y };
+            }
+            break;
+        }
+        case Field::Width:
+        case Field::Height:
+        case Field::Distance:
+        case Field::Area:
+        case Field::Angle:
+        {
+            const unsigned int flags[] = {
+                MeaPositionLogConverter::kWidth, MeaPositionLogConverter::kHeight,
+                MeaPositionLogConverter::kDistance, MeaPositionLogConverter::kArea, MeaPositionLogConverter::kAngle
+            };
+            const double values[] = {
+                position.m_width, position.m_height, position.m_distance, position.m_area, position.m_angle
+            };
+            int property = static_cast<int>(field) - static_cast<int>(Field::Width);
+            if ((position.m_properties & flags[property]) != 0) {
+                out << Number { values[property] };
+            }
+            break;
+        }
+        case Field::DesktopId:
+            out << CSVField { position.m_desktopRef };
+            break;
+        case Field::Desc:
+            out << CSVField { position.m_desc };
+            break;
+        }
+    }
+
+    void PutUInt32(std::ostream& out, std::uint32_t value) {
+        char bytes[4];
+        for (int i = 0; i < 4; i++) {
+            bytes[i] = static_cast<char>((value >> (8 * i)) & 0xFF);
+        }
+        out.write(bytes, sizeof(bytes));
+    }
+
+    void PutUInt64(std::ostream& out, std::uint64_t value) {
+        char bytes[8];
+        for (int i = 0; i < 8; i++) {
+            bytes[i] = static_cast<char>((value >> (8 * i)) & 0xFF);
+        }
+        out.write(bytes, sizeof(bytes));
+    }
+
+    void PutDouble(std::ostream& out, double value) {
+        std::uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        PutUInt64(out, bits);
+    }
+
+    /// Parses an ISO 8601 time stamp of the form yyyy-mm-ddThh:mm:ssZ, as written by MeaTimeStamp::Make.
+    ///
+    /// @return Seconds since 1970-01-01T00:00:00Z, or zero if the time stamp cannot be parsed.
+    ///
+    std::int64_t ParseTimeStamp(const std::string& str) {
+        int year;
+        int month;
+        int day;
+        int hour;
+        int minute;
+        int second;
+        auto field = [&str](std::size_t pos, std::size_t len, int& value) {
+            return pos + len <= str.size() &&
+                   MeaNumberParse::ParseInt(std::string_view(str).substr(pos, len), value) == MeaNumberParse::Result::Ok;
+        };
+        if (str.size() != 20 || !field(0, 4, year) || !field(5, 2, month) || !field(8, 2, day) ||
+                !field(11, 2, hour) || !field(14, 2, minute) || !field(17, 2, second)) {
+            return 0;
+        }
+
+        // Days from the civil date (H. Hinnant's algorithm).
+        year -= (month <= 2) ? 1 : 0;
+        std::int64_t era = (year >= 0 ? year : year - 399) / 400;
+        std::int64_t yearOfEra = year - era * 400;
+        std::int64_t dayOfYear = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+        std::int64_t dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+        std::int64_t days = era * 146097 + dayOfEra - 719468;
+
+        return days * 86400 + hour * 3600 + minute * 60 + second;
+    }
+}
+
+
+MeaPositionLogConverter::Log MeaPositionLogConverter::Parse(std::string_view text) {
+    MeaXMLDocument document(text);
+    const Element& root = document.GetRoot();
+    if (root.m_name != "positionLog") {
+        Fail("not a position log file");
+    }
+
+    Log log;
+    for (const Element& section : root.m_children) {
+        if (section.m_name == "info") {
+            ParseInfo(section, log);
+        } else if (section.m_name == "desktops") {
+            for (const Element& element : section.m_children) {
+                if (element.m_name == "desktop") {
+                    log.m_desktops.push_back(ParseDesktop(element));
+                }
+            }
+        } else if (section.m_name == "positions") {
+            for (const Element& element : section.m_children) {
+                if (element.m_name == "position") {
+                    log.m_positions.push_back(ParsePosition(element));
+                }
+            }
+        }
+    }
+
+    return log;
+}
+
+void MeaPositionLogConverter::Convert(Log& log, const Target& target) {
+    if (target.m_lengthUnits != "px" && MeaUnitsConversion::UnitsPerInch(target.m_lengthUnits) == 0.0) {
+        Fail("unsupported target length units " + target.m_lengthUnits);
+    }
+    if (target.m_angleUnits != "deg" && target.m_angleUnits != "rad") {
+        Fail("unsupported target angle units " + target.m_angleUnits);
+    }
+
+    std::vector<std::vector<Position*>> desktopPositions(log.m_desktops.size());
+    for (Position& position : log.m_positions) {
+        auto iter = std::find_if(log.m_desktops.begin(), log.m_desktops.end(),
+                                 [&position](const Desktop& desktop) { return desktop.m_id == position.m_desktopRef; });
+        if (iter == log.m_desktops.end()) {
+            Fail("position references unknown desktop " + position.m_desktopRef);
+        }
+        desktopPositions[iter - log.m_desktops.begin()].push_back(&position);
+    }
+
+    for (std::size_t i = 0; i < log.m_desktops.size(); i++) {
+        ConvertDesktop(log.m_desktops[i], desktopPositions[i], target);
+    }
+}
+
+void MeaPositionLogConverter::Write(std::ostream& out, const Log& log, Format format) {
+    switch (format) {
+    case Format::XML:
+        WriteXML(out, log);
+        break;
+    case Format::CSV:
+        WriteCSV(out, log);
+        break;
+    case Format::Binary:
+        WriteBinary(out, log);
+        break;
+    }
+}
+
+void MeaPositionLogConverter::WriteXML(std::ostream& out, const Log& log) {
+    out << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
+    out << "<!DOCTYPE positionLog SYSTEM \"" << kDtdUrl << "\">\n";
+    out << "<positionLog version=\"1\">\n";
+
+    out << "    <info>\n";
+    out << "        <title>" << Escaped { log.m_title } << "</title>\n";
+    if (!log.m_created.empty()) {
+        out << "        <created date=\"" << Escaped { log.m_created } << "\"/>\n";
+    }
+    if (!log.m_generatorName.empty()) {
+        out << "        <generator name=\"" << Escaped { log.m_generatorName } << "\" version=\""
+            << Escaped { log.m_generatorVersion } << "\" build=\"" << Escaped { log.m_generatorBuild } << "\"/>\n";
+    }
+    if (!log.m_machine.empty()) {
+        out << "        <machine name=\"" << Escaped { log.m_machine } << "\"/>\n";
+    }
+    if (!log.m_desc.empty()) {
+        out << "        <desc>" << Escaped { log.m_desc } << "</desc>\n";
+    }
+    out << "    </info>\n";
+
+    out << "    <desktops>\n";
+    for (const Desktop& desktop : log.m_desktops) {
+        out << "        <desktop id=\"" << Escaped { desktop.m_id } << "\">\n";
+        out << "            <units length=\"" << Escaped { desktop.m_lengthUnits } << "\" angle=\""
+            << Escaped { desktop.m_angleUnits } << "\"/>\n";
+        if (desktop.m_lengthUnits == "custom") {
+            out << "            <customUnits name=\"" << Escaped { desktop.m_customName } << "\" abbrev=\""
+                << Escaped { desktop.m_customAbbrev } << "\" scaleBasis=\"" << Escaped { desktop.m_customBasis }
+                << "\" scaleFactor=\"" << Number { desktop.m_customFactor } << "\"/>\n";
+        }
+        out << "            <origin xoffset=\"" << Number { desktop.m_originX } << "\" yoffset=\""
+            << Number { desktop.m_originY } << "\" invertY=\"" << (desktop.m_invertY ? "true" : "false") << "\"/>\n";
+        out << "            <size x=\"" << Number { desktop.m_sizeX } << "\" y=\"" << Number { desktop.m_sizeY }
+            << "\"/>\n";
+        out << "            <screens>\n";
+        for (const Screen& screen : desktop.m_screens) {
+            out << "                <screen desc=\"" << Escaped { screen.m_desc } << "\" primary=\""
+                << (screen.m_primary ? "true" : "false") << "\">\n";
+            out << "                    <rect top=\"" << Number { screen.m_top } << "\" bottom=\""
+                << Number { screen.m_bottom } << "\" left=\"" << Number { screen.m_left } << "\" right=\""
+                << Number { screen.m_right } << "\"/>\n";
+            out << "                    <resolution x=\"" << Number { screen.m_resX } << "\" y=\""
+                << Number { screen.m_resY } << "\" manual=\"" << (screen.m_manualRes ? "true" : "false")
+                << "\"/>\n";
+            out << "                </screen>\n";
+        }
+        out << "            </screens>\n";
+        out << "        </desktop>\n";
+    }
+    out << "    </desktops>\n";
+
+    out << "    <positions>\n";
+    for (const Position& position : log.m_positions) {
+        out << "        <position desktopRef=\"" << Escaped { position.m_desktopRef } << "\" tool=\""
+            << Escaped { position.m_tool } << "\" date=\"" << Escaped { position.m_date } << "\">\n";
+        if (!position.m_desc.empty()) {
+            out << "            <desc>" << Escaped { position.m_desc } << "</desc>\n";
+        }
+        out << "            <points>\n";
+        for (const Point& point : position.m_points) {
+            out << "                <point name=\"" << Escaped { point.m_name } << "\" x=\"" << Number { point.m_x }
+                << "\" y=\"" << Number { point.m_y } << "\"/>\n";
+        }
+        out << "            </points>\n";
+        out << "            <properties>\n";
+        static const std::pair<unsigned int, const char*> properties[] = {
+            { kWidth, "width" }, { kHeight, "height" }, { kDistance, "distance" }, { kArea, "area" },
+            { kAngle, "angle" }
+        };
+        const double values[] = {
+            position.m_width, position.m_height, position.m_distance, position.m_area, position.m_angle
+        };
+        for (std::size_t i = 0; i < std::size(properties); i++) {
+            if ((position.m_properties & properties[i].first) != 0) {
+                out << "                <" << properties[i].second << " value=\"" << Number { values[i] }
+                    << "\"/>\n";
+            }
+        }
+        out << "            </properties>\n";
+        out << "        </position>\n";
+    }
+    out << "    </positions>\n";
+
+    out << "</positionLog>\n";
+}
+
+void MeaPositionLogConverter::WriteCSV(std::ostream& out, const Log& log) {
+    for (int field = 0; field < MeaPositionCSV::kFieldCount; field++) {
+        if (field > 0) {
+            out << ',';
+        }
+        out << MeaPositionCSV::kFieldNames[field];
+    }
+    out << '\n';
+
+    for (const Position& position : log.m_positions) {
+        for (int field = 0; field < MeaPositionCSV::kFieldCount; field++) {
+            if (field > 0) {
+                out << ',';
+            }
+            WriteCSVField(out, position, static_cast<MeaPositionCSV::Field>(field));
+        }
+        out << '\n';
+    }
+}
+
+void MeaPositionLogConverter::WriteBinary(std::ostream& out, const Log& log) {
+    // All positions of a converted log share the target units, so the units of the first desktop describe the
+    // whole file.
+    char units[8] = {};
+    std::string angleUnits = "deg";
+    if (!log.m_desktops.empty()) {
+        const std::string& lengthUnits = log.m_desktops.front().m_lengthUnits;
+        std::memcpy(units, lengthUnits.data(), std::min(lengthUnits.size(), sizeof(units)));
+        angleUnits = log.m_desktops.front().m_angleUnits;
+    }
+
+    out.write("MPLB", 4);
+    PutUInt32(out, 1);
+    out.write(units, sizeof(units));
+    PutUInt32(out, (angleUnits == "rad") ? 1 : 0);
+    PutUInt32(out, static_cast<std::uint32_t>(log.m_positions.size()));
+
+    for (const Position& position : log.m_positions) {
+        auto tool = std::find_if(std::begin(kToolNames), std::end(kToolNames),
+                                 [&position](const char* name) { return position.m_tool == name; });
+        PutUInt32(out, (tool == std::end(kToolNames)) ? 0xFFFFFFFF :
+                       static_cast<std::uint32_t>(tool - std::begin(kToolNames)));
+
+        double coords[6] = {};
+        std::uint32_t flags = position.m_properties << 3;
+        for (std::size_t i = 0; i < std::size(kPointNames); i++) {
+            const Point* point = FindPoint(position, kPointNames[i]);
+            if (point != nullptr) {
+                flags |= 1U << i;
+                coords[2 * i] = point->m_x;
+                coords[2 * i + 1] = point->m_y;
+            }
+        }
+        PutUInt32(out, flags);
+        PutUInt64(out, static_cast<std::uint64_t>(ParseTimeStamp(position.m_date)));
+
+        for (double coord : coords) {
+            PutDouble(out, coord);
+        }
+        PutDouble(out, (position.m_properties & kWidth) ? position.m_width : 0.0);
+        PutDouble(out, (position.m_properties & kHeight) ? position.m_height : 0.0);
+        PutDouble(out, (position.m_properties & kDistance) ? position.m_distance : 0.0);
+        PutDouble(out, (position.m_properties & kArea) ? position.m_area : 0.0);
+        PutDouble(out, (position.m_properties & kAngle) ? position.m_angle : 0.0);
+    }
+}
+
+std::vector<std::string> MeaPositionLogConverter::ConvertFiles(const std::vector<std::string>& inputs,
+                                                               const std::string& outputDir, const Target& target,
+                                                               Format format, unsigned int threadCount) {
+    namespace fs = std::filesystem;
+
+    static const char* const extensions[] = { ".mpl", ".csv", ".bin" };
+    const char* extension = extensions[static_cast<int>(format)];
+
+    std::vector<std::string> errors(inputs.size());
+    std::vector<fs::path> outputs(inputs.size());
+    std::set<fs::path> outputNames;
+
+    // An output file must never replace an input file, for example when an XML log is converted into the
+    // directory that holds it. Inputs are compared by their canonical paths, and each output is also checked
+    // against its own input with fs::equivalent to catch hard links.
+    std::set<fs::path> inputNames;
+    for (const std::string& input : inputs) {
+        std::error_code ec;
+        fs::path canonical = fs::weakly_canonical(input, ec);
+        inputNames.insert(ec ? fs::path(input) : canonical);
+    }
+
+    for (std::size_t i = 0; i < inputs.size(); i++) {
+        outputs[i] = fs::path(outputDir) / fs::path(inputs[i]).stem();
+        outputs[i] += extension;
+        if (!outputNames.insert(outputs[i]).second) {
+            errors[i] = "output file " + outputs[i].string() + " is also written for another input";
+            continue;
+        }
+
+        std::error_code ec;
+        fs::path canonical = fs::weakly_canonical(outputs[i], ec);
+        if ((!ec && inputNames.count(canonical) > 0) || fs::equivalent(outputs[i], inputs[i], ec)) {
+            errors[i] = "output file " + outputs[i].string() + " would replace an input file";
+        }
+    }
+
+    auto convertFile = [&](std::size_t i) {
+        try {
+            std::ifstream in(inputs[i], std::ios::binary);
+            if (!in) {
+                errors[i] = "cannot open file";
+                return;
+            }
+            std::string text((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+            Log log = Parse(text);
+            Convert(log, target);
+
+            // The converted log is written to a temporary file that replaces the output file only once it is
+            // complete, so that a failed write does not leave a truncated file in place of an existing one.
+            fs::path tempOutput = outputs[i];
+            tempOutput += ".tmp";
+
+            std::ofstream out(tempOutput, std::ios::binary);
+            if (!out) {
+                errors[i] = "cannot create " + tempOutput.string();
+                return;
+            }
+            Write(out, log, format);
+            out.close();
+
+            std::error_code ec;
+            if (!out) {
+                errors[i] = "error writing " + tempOutput.string();
+            } else {
+                fs::rename(tempOutput, outputs[i], ec);
+                if (ec) {
+                    errors[i] = "cannot replace " + outputs[i].string() + ": " + ec.message();
+                }
+            }
+            if (!errors[i].empty()) {
+                fs::remove(tempOutput, ec);
+            }
+        } catch (const std::exception& ex) {
+            errors[i] = ex.what();
+        }
+    };
+
+    if (threadCount == 0) {
+        threadCount = std::max(1U, std::thread::hardware_concurrency());
+    }
+    threadCount = static_cast<unsigned int>(std::min<std::size_t>(threadCount, inputs.size()));
+
+    // Each thread takes the next unprocessed file, so that a few large files do not leave threads idle.
+    std::atomic<std::size_t> next(0);
+    auto worker = [&]() {
+        for (std::size_t i = next++; i < inputs.size(); i = next++) {
+            if (errors[i].empty()) {
+                convertFile(i);
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (unsigned int i = 1; i < threadCount; i++) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    return errors;
+}
@@ -0,0 +1,253 @@
+/*
+ * Copyright 2022 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/// @file
+/// @brief Header file for the portable position log conversion core.
+
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <ostream>
+#include <stdexcept>
+
+
+/// Exception thrown when a position log cannot be read or converted by MeaPositionLogConverter.
+///
+class MeaPositionLogConverterException : public std::runtime_error {
+
+public:
+    /// Constructs the exception.
+    ///
+    /// @param message  [in] Description of the problem.
+    ///
+    explicit MeaPositionLogConverterException(const std::string& message) : std::runtime_error(message) {}
+};
+
+
+/// Reads position log files (.mpl), re-expresses their positions in a different units and origin configuration,
+/// and writes the result as a position log, CSV or binary file. This is the processing core of the headless
+/// MeazureConvert tool. It does not depend on MFC, Windows or Xerces so that archives of logs can be processed
+/// on any platform.
+///
+/// Coordinates in a log are recorded in the units, origin and y-axis orientation of the position's desktop.
+/// Conversion reverses that transformation to recover the screen pixel of each point, using the per screen
+/// resolution recorded in the desktop, and then applies the target configuration. The conversion factors and
+/// the origin rules are those of MeaLinearUnits::FromPixels and MeaUnitsTransform. Recorded points are always
+/// whole pixels, so recovered pixels are rounded to remove the error introduced when the log was written.
+///
+/// Desktops recorded in custom units whose scale is based on pixels do not record the screen resolution and
+/// cannot be converted. Custom units cannot be used as a target.
+///
+class MeaPositionLogConverter {
+
+public:
+    /// Output file formats.
+    ///
+    enum class Format {
+        XML,        ///< Position log file, readable by Meazure.
+        CSV,        ///< Comma separated values, one row per position.
+        Binary      ///< Fixed size little-endian records. See WriteBinary for the layout.
+    };
+
+    /// Target units and origin configuration.
+    ///
+    struct Target {
+        std::string m_lengthUnits { "px" };     ///< Length units: px, pt, tp, in, cm, mm or pc.
+        std::string m_angleUnits { "deg" };     ///< Angle units: deg or rad.
+        double m_originX { 0.0 };               ///< Origin location, in pixels from the top left of the desktop.
+        double m_originY { 0.0 };               ///< Origin location, in pixels from the top left of the desktop.
+        bool m_invertY { false };               ///< Whether the y-axis increases upward.
+    };
+
+    /// Physical screen of a desktop.
+    ///
+    struct Screen {
+        std::string m_desc;                     ///< Name of the screen.
+        bool m_primary { false };               ///< Whether this is the primary screen.
+        double m_top { 0.0 };                   ///< Screen rectangle, in the desktop's coordinates.
+        double m_bottom { 0.0 };                ///< Screen rectangle, in the desktop's coordinates.
+        double m_left { 0.0 };                  ///< Screen rectangle, in the desktop's coordinates.
+        double m_right { 0.0 };                 ///< Screen rectangle, in the desktop's coordinates.
+        double m_resX { 0.0 };                  ///< Resolution as units per pixel, or pixels per inch for pixels.
+        double m_resY { 0.0 };                  ///< Resolution as units per pixel, or pixels per inch for pixels.
+        bool m_manualRes { false };             ///< Whether the resolution was calibrated by the user.
+    };
+
+    /// Environment in which positions were recorded.
+    ///
+    struct Desktop {
+        std::string m_id;                       ///< Identifier referenced by positions.
+        std::string m_lengthUnits;              ///< Length units identifier (e.g. "px").
+        std::string m_angleUnits { "deg" };     ///< Angle units identifier (e.g. "deg").
+        std::string m_customName;               ///< Name of custom units, if used.
+        std::string m_customAbbrev;             ///< Abbreviation of custom units, if used.
+        std::string m_customBasis;              ///< Scale basis of custom units (px, in or cm), if used.
+        double m_customFactor { 0.0 };          ///< Scale factor of custom units, if used.
+        double m_originX { 0.0 };               ///< Origin location, in the desktop's units.
+        double m_originY { 0.0 };               ///< Origin location, in the desktop's units.
+        bool m_invertY { false };               ///< Whether the y-axis increases upward.
+        double m_sizeX { 0.0 };                 ///< Size of the virtual desktop, in the desktop's units.
+        double m_sizeY { 0.0 };                 ///< Size of the virtual desktop, in the desktop's units.
+        std::vector<Screen> m_screens;          ///< Screens comprising the desktop.
+    };
+
+    /// Named point of a position.
+    ///
+    struct Point {
+        std::string m_name;                     ///< Point name: "1", "2" or "v".
+        double m_x { 0.0 };                     ///< Coordinates, in the desktop's coordinates.
+        double m_y { 0.0 };                     ///< Coordinates, in the desktop's coordinates.
+    };
+
+    /// Measurement properties of a position. Each is only meaningful if its flag is set in m_properties.
+    ///
+    enum PropertyFlag : unsigned int {
+        kWidth = 0x01,
+        kHeight = 0x02,
+        kDistance = 0x04,
+        kArea = 0x08,
+        kAngle = 0x10
+    };
+
+    /// Recorded tool position.
+    ///
+    struct Position {
+        std::string m_desktopRef;               ///< Identifier of the position's desktop.
+        std::string m_tool;                     ///< Name of the measurement tool (e.g. "LineTool").
+        std::string m_date;                     ///< ISO 8601 time stamp.
+        std::string m_desc;                     ///< Description of the position.
+        std::vector<Point> m_points;            ///< Tool points in document order.
+        unsigned int m_properties { 0 };        ///< PropertyFlag values for the properties that are present.
+        double m_width { 0.0 };                 ///< Width, in the desktop's units.
+        double m_height { 0.0 };                ///< Height, in the desktop's units.
+        double m_distance { 0.0 };              ///< Distance, in the desktop's units.
+        double m_area { 0.0 };                  ///< Area, in the desktop's units squared.
+        double m_angle { 0.0 };                 ///< Angle, in the desktop's angle units.
+    };
+
+    /// Contents of a position log file.
+    ///
+    struct Log {
+        std::string m_title;                    ///< Log title.
+        std::string m_desc;                     ///< Log description.
+        std::string m_created;                  ///< ISO 8601 time stamp of the log's creation.
+        std::string m_generatorName;            ///< Name of the application that wrote the log.
+        std::string m_generatorVersion;         ///< Version of the application that wrote the log.
+        std::string m_generatorBuild;           ///< Build number of the application that wrote the log.
+        std::string m_machine;                  ///< Name of the machine on which the log was written.
+        std::vector<Desktop> m_desktops;        ///< Desktops referenced by the positions.
+        std::vector<Position> m_positions;      ///< Positions in document order.
+    };
+
+
+    /// Parses the specified position log. Attribute defaults specified by the position log DTD are applied.
+    ///
+    /// @param text     [in] Contents of a position log file, in UTF-8.
+    /// @return Contents of the log.
+    ///
+    /// @throws MeaXMLDocumentException if the log is not well formed XML.
+    /// @throws MeaPositionLogConverterException if the log is not a position log.
+    ///
+    static Log Parse(std::string_view text);
+
+    /// Re-expresses all desktops and positions of the specified log in the target configuration. Custom
+    /// units settings and display precisions are removed from the desktops.
+    ///
+    /// @param log      [in, out] Log to convert.
+    /// @param target   [in] Target units and origin configuration.
+    ///
+    /// @throws MeaPositionLogConverterException if the target is invalid, a desktop cannot be converted or a
+    ///         position references an unknown desktop.
+    ///
+    static void Convert(Log& log, const Target& target);
+
+    /// Writes the specified log in the specified format.
+    ///
+    /// @param out      [in] Stream to write. Must be opened in binary mode for Format::Binary.
+    /// @param log      [in] Log to write.
+    /// @param format   [in] Output format.
+    ///
+    static void Write(std::ostream& out, const Log& log, Format format);
+
+    /// Writes the specified log as a position log file.
+    ///
+    /// @param out      [in] Stream to write.
+    /// @param log      [in] Log to write.
+    ///
+    static void WriteXML(std::ostream& out, const Log& log);
+
+    /// Writes the specified log as comma separated values, using the same columns as the position export
+    /// writer (see MeaPositionCSV). The first row names the columns. Each subsequent row is a position. Points
+    /// and properties that a position does not have are left empty.
+    ///
+    /// @param out      [in] Stream to write.
+    /// @param log      [in] Log to write.
+    ///
+    static void WriteCSV(std::ostream& out, const Log& log);
+
+    /// Writes the positions of the specified log as fixed size binary records. All values are little-endian.
+    /// The file begins with a 24 byte header:
+    ///
+    /// <pre>
+    ///     char[4]     magic "MPLB"
+    ///     uint32      format version (1)
+    ///     char[8]     length units identifier, padded with zeros
+    ///     uint32      angle units (0 = deg, 1 = rad)
+    ///     uint32      number of positions
+    /// </pre>
+    ///
+    /// Each position is a 104 byte record:
+    ///
+    /// <pre>
+    ///     uint32      tool (0 = Cursor, 1 = Line, 2 = Point, 3 = Rect, 4 = Circle, 5 = Angle, 6 = Window,
+    ///                 0xFFFFFFFF = unknown)
+    ///     uint32      flags: 0x01 point 1, 0x02 point 2, 0x04 point v, then the PropertyFlag values
+    ///                 shifted left by 3 bits
+    ///     int64       time stamp, in seconds since 1970-01-01T00:00:00Z
+    ///     double[11]  x1, y1, x2, y2, xv, yv, width, height, distance, area, angle
+    /// </pre>
+    ///
+    /// Values that are not present are written as zero. Descriptions are not written.
+    ///
+    /// @param out      [in] Stream to write, opened in binary mode.
+    /// @param log      [in] Log to write.
+    ///
+    static void WriteBinary(std::ostream& out, const Log& log);
+
+    /// Reads, converts and writes the specified files. Files are processed in parallel by the specified number
+    /// of threads. Each output file is written to the output directory with the name of its input file and the
+    /// extension for the format (.mpl, .csv or .bin). A file is not converted if its output would replace one of
+    /// the input files. Each output is written to a temporary file that is renamed once it is complete, so that
+    /// an existing output file is not truncated by a failed conversion.
+    ///
+    /// @param inputs       [in] Pathnames of the position log files to convert.
+    /// @param outputDir    [in] Directory in which to write the converted files.
+    /// @param target       [in] Target units and origin configuration.
+    /// @param format       [in] Output format.
+    /// @param threadCount  [in] Number of threads to use. Zero uses one thread per hardware thread.
+    ///
+    /// @return Error message for each input file, in the order of the inputs. A file that was converted
+    ///         successfully has an empty message.
+    ///
+    static std::vector<std::string> ConvertFiles(const std::vector<std::string>& inputs,
+                                                 const std::string& outputDir, const Target& target,
+                                                 Format format, unsigned int threadCount);
+};
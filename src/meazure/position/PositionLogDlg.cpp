@@ -156,6 +156,10 @@ void MeaPositionLogDlg::PositionAdded(int /* posIndex */) {
     UpdateEnable();
 }
 
+void MeaPositionLogDlg::PositionsAdded(int /* firstIndex */, int /* count */) {
+    PositionAdded(MeaPositionLogMgr::Instance().NumPositions() - 1);
+}
+
 void MeaPositionLogDlg::PositionReplaced(int /* posIndex */) {
     UpdatePositionInfo();
 }
@@ -71,6 +71,11 @@ public:
     /// @param posIndex     [in] Index of the new position.
     virtual void PositionAdded(int posIndex) override;
 
+    /// Called when a batch of new positions is recorded.
+    /// @param firstIndex   [in] Index of the first new position.
+    /// @param count        [in] Number of new positions.
+    virtual void PositionsAdded(int firstIndex, int count) override;
+
     /// Called when an existing position is replaced with a new position.
     /// @param posIndex     [in] Index of the replaced position.
     virtual void PositionReplaced(int posIndex) override;
@@ -23,13 +23,16 @@
 #include "PositionLogDlg.h"
 #include "PositionSaveDlg.h"
 #include "PositionLogWriter.h"
+#include "PositionExportWriter.h"
 #include <meazure/tools/ToolMgr.h>
 #include <meazure/tools/Tool.h>
 #include <meazure/utilities/NumericUtils.h>
 #include <meazure/utilities/Geometry.h>
 #include <meazure/utilities/StringUtils.h>
+#include <meazure/utilities/TimeStamp.h>
 #include <xercesc/framework/LocalFileInputSource.hpp>
 #include <cassert>
+#include <vector>
 
 
 MeaPositionLogMgr::MeaPositionLogMgr(token) :
@@ -117,6 +120,19 @@ void MeaPositionLogMgr::RecordPosition() {
     }
 }
 
+void MeaPositionLogMgr::RecordPositions(const std::vector<MeaPositionRecorder::Measurement>& measurements) {
+    if (measurements.empty()) {
+        return;
+    }
+
+    // The log is only marked as modified once the batch has been added, since a failure leaves it unchanged.
+    //
+    MeaPositionRecorder::RecordBatch(m_positions, measurements, RecordDesktopInfo(),
+                                     MeaTimeStamp::Make(time(nullptr)), MeaUnitsMgr::Instance(), m_observer);
+
+    m_modified = true;
+}
+
 void MeaPositionLogMgr::ReplacePosition(int posIndex) {
     MeaPosition* position = new MeaPosition(RecordDesktopInfo());
     MeaToolMgr::Instance().RecordPosition(*position);
@@ -214,16 +230,33 @@ void MeaPositionLogMgr::ShowPosition(unsigned int posIndex) {
         toolMgr.UpdateTools(MeaUpdateReason::UnitsChanged);
     }
 
+    // Determine the origin and y-axis orientation of the position. The
+    // points are converted using these settings directly, rather than
+    // relying on them having been applied to the current settings.
+    //
+    MeaUnitsContext context(unitsMgr.GetContext());
+    context.m_invertY = desktopInfo.IsInvertY();
+    POINT newOrigin = unitsMgr.GetTransform(context)->UnconvertCoord(desktopInfo.GetOrigin());
+    context.m_origin = newOrigin;
+
+    const MeaPosition::PointMap& points = position.GetPoints();
+    std::vector<MeaFPoint> coords;
+    std::vector<POINT> pixels(points.size());
+
+    coords.reserve(points.size());
+    for (const auto& pointEntry : points) {
+        coords.push_back(pointEntry.second);
+    }
+
+    unitsMgr.GetTransform(context)->UnconvertCoords(coords.data(), pixels.data(), coords.size());
+
     // Set the origin and y-axis orientation.
     //
-    bool invertY = desktopInfo.IsInvertY();
-    if ((invertY && !unitsMgr.IsInvertY()) || (!invertY && unitsMgr.IsInvertY())) {
-        unitsMgr.SetInvertY(invertY);
+    if (context.m_invertY != unitsMgr.IsInvertY()) {
+        unitsMgr.SetInvertY(context.m_invertY);
         toolMgr.UpdateTools();
     }
 
-    POINT newOrigin = unitsMgr.UnconvertCoord(desktopInfo.GetOrigin());
-
     if ((newOrigin.x != unitsMgr.GetOrigin().x) || (newOrigin.y != unitsMgr.GetOrigin().y)) {
         unitsMgr.SetOrigin(newOrigin);
         toolMgr.UpdateTools(MeaUpdateReason::OriginChanged);
@@ -232,9 +265,10 @@ void MeaPositionLogMgr::ShowPosition(unsigned int posIndex) {
     // Show the points.
     //
     MeaRadioTool::PointMap toolPoints;
+    auto pixelIter = pixels.begin();
 
-    for (const auto& pointEntry : position.GetPoints()) {
-        toolPoints[pointEntry.first] = unitsMgr.UnconvertCoord(pointEntry.second);
+    for (const auto& pointEntry : points) {
+        toolPoints[pointEntry.first] = *pixelIter++;
     }
 
     toolMgr.SetPosition(toolPoints);
@@ -369,6 +403,35 @@ bool MeaPositionLogMgr::Save(bool askPathname) {
     return true;
 }
 
+bool MeaPositionLogMgr::Export() {
+    CFileDialog dlg(FALSE, kExportExt, nullptr, OFN_HIDEREADONLY | OFN_OVERWRITEPROMPT, kExportFilter);
+    dlg.m_ofn.lpstrInitialDir = m_initialDir;
+
+    if (dlg.DoModal() != IDOK) {
+        return false;
+    }
+
+    CString pathname = dlg.GetPathName();
+
+    std::ofstream exportStream;
+    exportStream.exceptions(std::ios::failbit | std::ios::badbit);
+
+    try {
+        exportStream.open(MeaStringUtils::ACPtoUTF8(pathname), std::ios::out | std::ios::trunc | std::ios::binary);
+
+        MeaPositionExportWriter exportWriter(exportStream, *this);
+        exportWriter.Export();
+    } catch (const std::ofstream::failure& e) {
+        CString errStr(e.what());
+        CString msg;
+        msg.Format(IDS_MEA_NO_EXPORT_LOG, static_cast<PCTSTR>(errStr));
+        MessageBox(*AfxGetMainWnd(), msg, nullptr, MB_OK | MB_ICONERROR);
+        return false;
+    }
+
+    return true;
+}
+
 bool MeaPositionLogMgr::Load(PCTSTR pathname) {
     // If there is a modified set of positions, ask the user if
     // they should be saved before loading a new set.
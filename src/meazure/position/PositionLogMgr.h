@@ -27,6 +27,7 @@
 #include "PositionScreen.h"
 #include "PositionDesktop.h"
 #include "PositionProvider.h"
+#include "PositionRecorder.h"
 #include <meazure/units/Units.h>
 #include <meazure/units/UnitsProvider.h>
 #include <meazure/utilities/Geometry.h>
@@ -41,6 +42,7 @@
 #include <map>
 #include <stdexcept>
 #include <fstream>
+#include <vector>
 
 
 class MeaPositionSaveDlg;
@@ -67,6 +69,18 @@ public:
     ///
     void RecordPosition();
 
+    /// Records a batch of positions without involving the radio tool. The measurements for each position are
+    /// computed from its points in the current units (see MeaPositionRecorder), so no tool is moved, displayed
+    /// or strobed. The positions share the current desktop information and timestamp. They are added to the
+    /// log together and the observer is notified once. If any of the positions cannot be recorded, none are
+    /// added.
+    ///
+    /// @param measurements     [in] Positions to record.
+    ///
+    /// @throws std::invalid_argument if the points of a measurement do not correspond to any of the tools.
+    ///
+    void RecordPositions(const std::vector<MeaPositionRecorder::Measurement>& measurements);
+
     /// Replaces the specified position list entry with the
     /// current radio tool position.
     ///
@@ -151,6 +165,13 @@ public:
     ///
     bool Save(bool askPathname);
 
+    /// Exports the recorded positions to a CSV file for use in a spreadsheet or data analysis tool. The user
+    /// is asked for the pathname. Exporting does not affect the log file or its modified state.
+    ///
+    /// @return <b>true</b> if exported, false if canceled or unable to export.
+    ///
+    bool Export();
+
     /// If there are positions that have not been saved, ask the
     /// user if they should be saved. Called before the app exits or
     /// a load will destroy the unsaved positions.
@@ -242,6 +263,8 @@ private:
     static constexpr int kChunkSize { 1024 };       ///< Log file parsing buffer allocation increment.
     static constexpr PCTSTR kExt { _T("mpl") };    ///< Log file suffix.
     static constexpr PCTSTR kFilter { _T("Meazure Position Log Files (*.mpl)|*.mpl|All Files (*.*)|*.*||") };  ///< File dialog filter string.
+    static constexpr PCTSTR kExportExt { _T("csv") };   ///< Export file suffix.
+    static constexpr PCTSTR kExportFilter { _T("CSV Files (*.csv)|*.csv|All Files (*.*)|*.*||") };  ///< Export file dialog filter string.
 
 
     /// Constructs a file save dialog tailored to saving position log files.
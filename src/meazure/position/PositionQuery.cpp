@@ -0,0 +1,243 @@
+/*
+ * Copyright 2022 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <meazure/pch.h>
+#include "PositionQuery.h"
+#include "PositionCollection.h"
+#include <meazure/utilities/TimeStamp.h>
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+
+
+MeaPositionQuery::MeaPositionQuery(const MeaPositionCollection& positions) :
+    m_positions(positions),
+    m_filterTime(false),
+    m_start(0),
+    m_end(0),
+    m_filterDesktop(false),
+    m_desktopId(_T("00000000-0000-0000-0000-000000000000")) {
+}
+
+MeaPositionQuery& MeaPositionQuery::Tool(const CString& toolName) {
+    m_toolName = toolName;
+    return *this;
+}
+
+MeaPositionQuery& MeaPositionQuery::TimeRange(time_t start, time_t end) {
+    m_filterTime = true;
+    m_start = start;
+    m_end = end;
+    return *this;
+}
+
+MeaPositionQuery& MeaPositionQuery::TimeRange(const CString& start, const CString& end) {
+    time_t startTime;
+    time_t endTime;
+
+    try {
+        startTime = MeaTimeStamp::Parse(start);
+        endTime = MeaTimeStamp::Parse(end);
+    } catch (...) {
+        throw std::invalid_argument("MeaPositionQuery::TimeRange invalid time stamp");
+    }
+
+    return TimeRange(startTime, endTime);
+}
+
+MeaPositionQuery& MeaPositionQuery::Desktop(const MeaGUID& desktopId) {
+    m_filterDesktop = true;
+    m_desktopId = desktopId;
+    return *this;
+}
+
+MeaPositionQuery& MeaPositionQuery::Range(MeaDataFieldId field, double minValue, double maxValue) {
+    if (!MeaPositionColumns::IsValueField(field)) {
+        throw std::invalid_argument("MeaPositionQuery::Range field does not have values");
+    }
+
+    m_ranges.push_back({ field, minValue, maxValue });
+    return *this;
+}
+
+void MeaPositionQuery::Reset() {
+    m_toolName.Empty();
+    m_filterTime = false;
+    m_filterDesktop = false;
+    m_ranges.clear();
+}
+
+std::vector<unsigned int> MeaPositionQuery::Select() const {
+    const MeaPositionColumns& columns = m_positions.GetColumns();
+    unsigned int size = columns.Size();
+    std::vector<unsigned int> selection;
+
+    // Tool and desktop filters are resolved to their interned indices so that each position is tested with an
+    // integer comparison. A tool or desktop that is not in the columns cannot select any positions.
+    //
+    int toolIndex = MeaPositionColumns::kNotFound;
+    if (!m_toolName.IsEmpty()) {
+        toolIndex = columns.FindTool(m_toolName);
+        if (toolIndex == MeaPositionColumns::kNotFound) {
+            return selection;
+        }
+    }
+
+    int desktopIndex = MeaPositionColumns::kNotFound;
+    if (m_filterDesktop) {
+        desktopIndex = columns.FindDesktop(m_desktopId);
+        if (desktopIndex == MeaPositionColumns::kNotFound) {
+            return selection;
+        }
+    }
+
+    // Start with all positions and narrow the selection one filter at a time. Each pass reads a single column.
+    //
+    selection.resize(size);
+    std::iota(selection.begin(), selection.end(), 0U);
+
+    auto narrow = [&selection](auto predicate) {
+        selection.erase(std::remove_if(selection.begin(), selection.end(),
+                                       [&predicate](unsigned int i) { return !predicate(i); }), selection.end());
+    };
+
+    if (toolIndex != MeaPositionColumns::kNotFound) {
+        const std::vector<int>& tools = columns.GetTools();
+        narrow([&tools, toolIndex](unsigned int i) { return tools[i] == toolIndex; });
+    }
+
+    if (desktopIndex != MeaPositionColumns::kNotFound) {
+        const std::vector<int>& desktops = columns.GetDesktops();
+        narrow([&desktops, desktopIndex](unsigned int i) { return desktops[i] == desktopIndex; });
+    }
+
+    if (m_filterTime) {
+        const std::vector<time_t>& times = columns.GetTimes();
+        narrow([&times, this](unsigned int i) {
+            return times[i] != MeaPositionColumns::kNoTime && times[i] >= m_start && times[i] <= m_end;
+        });
+    }
+
+    const std::vector<UINT>& masks = columns.GetFieldMasks();
+    for (const ValueRange& range : m_ranges) {
+        const std::vector<double>& values = columns.GetValues(range.m_field);
+        narrow([&masks, &values, &range](unsigned int i) {
+            return (masks[i] & range.m_field) != 0 && values[i] >= range.m_min && values[i] <= range.m_max;
+        });
+    }
+
+    return selection;
+}
+
+std::vector<double> MeaPositionQuery::SelectValues(MeaDataFieldId field) const {
+    const MeaPositionColumns& columns = m_positions.GetColumns();
+    const std::vector<double>& values = columns.GetValues(field);
+    const std::vector<UINT>& masks = columns.GetFieldMasks();
+
+    std::vector<unsigned int> selection = Select();
+    std::vector<double> selectedValues;
+    selectedValues.reserve(selection.size());
+
+    for (unsigned int i : selection) {
+        if ((masks[i] & field) != 0) {
+            selectedValues.push_back(values[i]);
+        }
+    }
+
+    return selectedValues;
+}
+
+MeaPositionQuery::Summary MeaPositionQuery::Summarize(MeaDataFieldId field) const {
+    std::vector<double> values = SelectValues(field);
+    Summary summary { static_cast<unsigned int>(values.size()), 0.0, 0.0, 0.0 };
+
+    if (!values.empty()) {
+        double sum = 0.0;
+        double minValue = values[0];
+        double maxValue = values[0];
+        for (double value : values) {
+            sum += value;
+            minValue = std::min(minValue, value);
+            maxValue = std::max(maxValue, value);
+        }
+
+        summary.m_mean = sum / static_cast<double>(values.size());
+        summary.m_min = minValue;
+        summary.m_max = maxValue;
+    }
+
+    return summary;
+}
+
+bool MeaPositionQuery::Percentile(MeaDataFieldId field, double percent, double& value) const {
+    if (!(percent >= 0.0 && percent <= 100.0)) {
+        throw std::invalid_argument("MeaPositionQuery::Percentile percent out of range");
+    }
+
+    std::vector<double> values = SelectValues(field);
+    if (values.empty()) {
+        return false;
+    }
+
+    // The percentile lies between the values at the two ranks closest to it. Partial sorts locate just those
+    // two values.
+    //
+    double rank = percent / 100.0 * static_cast<double>(values.size() - 1);
+    std::size_t lowerRank = static_cast<std::size_t>(rank);
+    double fraction = rank - static_cast<double>(lowerRank);
+
+    std::nth_element(values.begin(), values.begin() + lowerRank, values.end());
+    double lowerValue = values[lowerRank];
+
+    if (fraction > 0.0) {
+        double upperValue = *std::min_element(values.begin() + lowerRank + 1, values.end());
+        value = lowerValue + fraction * (upperValue - lowerValue);
+    } else {
+        value = lowerValue;
+    }
+
+    return true;
+}
+
+MeaPositionQuery::Histogram MeaPositionQuery::MakeHistogram(MeaDataFieldId field, unsigned int binCount) const {
+    if (binCount == 0) {
+        throw std::invalid_argument("MeaPositionQuery::MakeHistogram binCount must be greater than 0");
+    }
+
+    std::vector<double> values = SelectValues(field);
+    Histogram histogram { 0.0, 0.0, std::vector<unsigned int>(binCount, 0) };
+
+    if (values.empty()) {
+        return histogram;
+    }
+
+    auto range = std::minmax_element(values.begin(), values.end());
+    histogram.m_min = *range.first;
+    histogram.m_binWidth = (*range.second - *range.first) / binCount;
+
+    for (double value : values) {
+        unsigned int bin = 0;
+        if (histogram.m_binWidth > 0.0) {
+            bin = std::min(static_cast<unsigned int>((value - histogram.m_min) / histogram.m_binWidth), binCount - 1);
+        }
+        histogram.m_counts[bin]++;
+    }
+
+    return histogram;
+}
@@ -0,0 +1,203 @@
+/*
+ * Copyright 2022 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/// @file
+/// @brief Header file for filtering and summarizing positions.
+
+#pragma once
+
+#include <meazure/ui/DataFieldId.h>
+#include <meazure/utilities/GUID.h>
+#include <vector>
+#include <time.h>
+
+
+class MeaPositionCollection;
+
+
+/// Selects positions from a collection using a set of filters and computes statistics over the values of the
+/// selected positions. Filters are specified by chaining calls, for example:
+///
+/// <pre>
+///     MeaPositionQuery query(positions);
+///     query.Tool(_T("RectTool")).Range(MeaWidthField, 100.0, 200.0);
+///     MeaPositionQuery::Summary summary = query.Summarize(MeaHeightField);
+/// </pre>
+///
+/// A position is selected if it satisfies every filter. Queries are evaluated against the columns of the
+/// collection (see MeaPositionCollection::GetColumns), so the filters and aggregates scan arrays of values rather
+/// than position objects. A query refers to the collection and reflects changes made to it after the query was
+/// constructed.
+///
+class MeaPositionQuery {
+
+public:
+    /// Statistics for the values of a field.
+    ///
+    struct Summary {
+        unsigned int m_count;   ///< Number of values. The remaining members are 0.0 if there are no values.
+        double m_mean;          ///< Arithmetic mean of the values.
+        double m_min;           ///< Smallest value.
+        double m_max;           ///< Largest value.
+    };
+
+    /// Distribution of the values of a field over bins of equal width spanning the smallest to the largest value.
+    /// The largest value is counted in the last bin.
+    ///
+    struct Histogram {
+        double m_min;                           ///< Lower bound of the first bin.
+        double m_binWidth;                      ///< Width of each bin. 0.0 if all values are the same.
+        std::vector<unsigned int> m_counts;     ///< Number of values in each bin.
+    };
+
+
+    /// Constructs a query that selects all positions in the specified collection.
+    ///
+    /// @param positions    [in] Collection to query. Must outlive the query.
+    ///
+    explicit MeaPositionQuery(const MeaPositionCollection& positions);
+
+    /// Selects positions recorded by the specified tool. Replaces any previous tool filter.
+    ///
+    /// @param toolName     [in] Name of the tool (e.g. "LineTool").
+    ///
+    /// @return This query.
+    ///
+    MeaPositionQuery& Tool(const CString& toolName);
+
+    /// Selects positions recorded within the specified time range, inclusive. Replaces any previous time filter.
+    /// Positions whose time stamp cannot be parsed are not selected.
+    ///
+    /// @param start        [in] Earliest recording time, in seconds since the Epoch.
+    /// @param end          [in] Latest recording time, in seconds since the Epoch.
+    ///
+    /// @return This query.
+    ///
+    MeaPositionQuery& TimeRange(time_t start, time_t end);
+
+    /// Selects positions recorded within the specified time range, inclusive. Replaces any previous time filter.
+    ///
+    /// @param start        [in] Earliest recording time as an ISO 8601 time stamp (see MeaTimeStamp::Parse).
+    /// @param end          [in] Latest recording time as an ISO 8601 time stamp.
+    ///
+    /// @return This query.
+    /// @throws std::invalid_argument if either time stamp cannot be parsed.
+    ///
+    MeaPositionQuery& TimeRange(const CString& start, const CString& end);
+
+    /// Selects positions recorded on the specified desktop. Replaces any previous desktop filter.
+    ///
+    /// @param desktopId    [in] Identifier of the desktop information object.
+    ///
+    /// @return This query.
+    ///
+    MeaPositionQuery& Desktop(const MeaGUID& desktopId);
+
+    /// Selects positions that recorded the specified field with a value in the specified range, inclusive.
+    /// Multiple ranges may be specified, including more than one for the same field. To leave one end of the
+    /// range open, use std::numeric_limits<double>::lowest() or max().
+    ///
+    /// @param field        [in] One of MeaWidthField, MeaHeightField, MeaDistanceField, MeaAreaField or
+    ///                     MeaAngleField.
+    /// @param minValue     [in] Smallest value selected.
+    /// @param maxValue     [in] Largest value selected.
+    ///
+    /// @return This query.
+    /// @throws std::invalid_argument if the field is not one of the supported fields.
+    ///
+    MeaPositionQuery& Range(MeaDataFieldId field, double minValue, double maxValue);
+
+    /// Removes all filters so that the query selects all positions.
+    ///
+    void Reset();
+
+    /// Obtains the positions selected by the query.
+    ///
+    /// @return Indices of the selected positions in the collection, in increasing order.
+    ///
+    std::vector<unsigned int> Select() const;
+
+    /// Counts the positions selected by the query.
+    ///
+    /// @return Number of selected positions.
+    ///
+    unsigned int Count() const { return static_cast<unsigned int>(Select().size()); }
+
+    /// Computes the count, mean, minimum and maximum of a field over the selected positions. Positions that did
+    /// not record the field are not included.
+    ///
+    /// @param field        [in] Field to summarize. See Range for the supported fields.
+    ///
+    /// @return Statistics for the field.
+    /// @throws std::invalid_argument if the field is not one of the supported fields.
+    ///
+    Summary Summarize(MeaDataFieldId field) const;
+
+    /// Computes a percentile of a field over the selected positions, interpolating linearly between the two
+    /// closest values. Positions that did not record the field are not included.
+    ///
+    /// @param field        [in] Field to examine. See Range for the supported fields.
+    /// @param percent      [in] Percentile to compute, from 0.0 (smallest value) to 100.0 (largest value).
+    /// @param value        [out] Value at the percentile. Only modified if <b>true</b> is returned.
+    ///
+    /// @return <b>true</b> if the value was computed, <b>false</b> if no selected position recorded the field.
+    /// @throws std::invalid_argument if the field is not supported or the percent is outside 0.0 to 100.0.
+    ///
+    bool Percentile(MeaDataFieldId field, double percent, double& value) const;
+
+    /// Computes the distribution of a field over the selected positions. Positions that did not record the
+    /// field are not included.
+    ///
+    /// @param field        [in] Field to examine. See Range for the supported fields.
+    /// @param binCount     [in] Number of bins in the histogram.
+    ///
+    /// @return Histogram of the field. All counts are 0 if no selected position recorded the field.
+    /// @throws std::invalid_argument if the field is not supported or the bin count is 0.
+    ///
+    Histogram MakeHistogram(MeaDataFieldId field, unsigned int binCount) const;
+
+private:
+    /// Value range filter.
+    ///
+    struct ValueRange {
+        MeaDataFieldId m_field;     ///< Field to test.
+        double m_min;               ///< Smallest value selected.
+        double m_max;               ///< Largest value selected.
+    };
+
+
+    /// Obtains the values of a field for the selected positions that recorded the field.
+    ///
+    /// @param field        [in] Field whose values are to be obtained.
+    ///
+    /// @return Values of the field, in position order.
+    /// @throws std::invalid_argument if the field is not one of the supported fields.
+    ///
+    std::vector<double> SelectValues(MeaDataFieldId field) const;
+
+
+    const MeaPositionCollection& m_positions;   ///< Collection being queried.
+    CString m_toolName;                         ///< Tool to select. Empty to select all tools.
+    bool m_filterTime;                          ///< Indicates if m_start and m_end are used.
+    time_t m_start;                             ///< Earliest recording time selected.
+    time_t m_end;                               ///< Latest recording time selected.
+    bool m_filterDesktop;                       ///< Indicates if m_desktopId is used.
+    MeaGUID m_desktopId;                        ///< Desktop to select.
+    std::vector<ValueRange> m_ranges;           ///< Value range filters.
+};
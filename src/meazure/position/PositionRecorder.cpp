@@ -0,0 +1,184 @@
+/*
+ * Copyright 2022 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <meazure/pch.h>
+#include "PositionRecorder.h"
+#include "PositionCollection.h"
+#include "PositionLogObserver.h"
+#include <meazure/tools/AngleTool.h>
+#include <meazure/tools/CircleTool.h>
+#include <meazure/tools/CursorTool.h>
+#include <meazure/tools/LineTool.h>
+#include <meazure/tools/PointTool.h>
+#include <meazure/tools/RectTool.h>
+#include <meazure/tools/WindowTool.h>
+#include <meazure/utilities/Geometry.h>
+#include <initializer_list>
+#include <memory>
+#include <stdexcept>
+
+
+void MeaPositionRecorder::RecordPoint(MeaPosition& position, PCTSTR toolName, const POINT& point,
+                                      const MeaUnitsProvider& unitsProvider) {
+    position.SetToolName(toolName);
+    position.RecordXY1(unitsProvider.ConvertCoord(point));
+}
+
+void MeaPositionRecorder::RecordSegment(MeaPosition& position, PCTSTR toolName, const POINT& point1,
+                                        const POINT& point2, const MeaUnitsProvider& unitsProvider) {
+    // Convert the pixel locations to the current units.
+    //
+    MeaFPoint p1 = unitsProvider.ConvertCoord(point1);
+    MeaFPoint p2 = unitsProvider.ConvertCoord(point2);
+    MeaFSize wh = unitsProvider.GetWidthHeight(point1, point2);
+
+    // Save the positions and the name of the tool in the position object.
+    //
+    position.SetToolName(toolName);
+    position.RecordXY1(p1);
+    position.RecordXY2(p2);
+    position.RecordWH(wh);
+    position.RecordDistance(wh);
+    position.RecordRectArea(wh);
+
+    double angle = MeaGeometry::CalcAngle(p1, p2);
+    position.RecordAngle(unitsProvider.ConvertAngle(angle));
+}
+
+void MeaPositionRecorder::RecordCircle(MeaPosition& position, PCTSTR toolName, const POINT& center,
+                                       const POINT& perimeter, const MeaUnitsProvider& unitsProvider) {
+    // Convert the pixel locations to the current units.
+    //
+    MeaFPoint p1 = unitsProvider.ConvertCoord(center);
+    MeaFPoint p2 = unitsProvider.ConvertCoord(perimeter);
+
+    // The radius is truncated to whole pixels, as it is when the circle is drawn.
+    //
+    int radius = static_cast<int>(MeaGeometry::CalcLength(center, perimeter));
+    POINT topLeft { center.x - radius, center.y - radius };
+    POINT bottomRight { center.x + radius, center.y + radius };
+    MeaFSize wh = unitsProvider.GetWidthHeight(topLeft, bottomRight);
+
+    double r = wh.cx / 2.0;
+
+    // Save the positions and the name of the tool in the position object.
+    //
+    position.SetToolName(toolName);
+    position.RecordXYV(p1);
+    position.RecordXY1(p2);
+    position.RecordWH(wh);
+    position.RecordDistance(r);
+    position.RecordCircleArea(r);
+
+    double angle = MeaGeometry::CalcAngle(p1, p2);
+    position.RecordAngle(unitsProvider.ConvertAngle(angle));
+}
+
+void MeaPositionRecorder::RecordAngle(MeaPosition& position, PCTSTR toolName, const POINT& point1,
+                                      const POINT& point2, const POINT& vertex,
+                                      const MeaUnitsProvider& unitsProvider) {
+    // Convert the pixel locations to the current units.
+    //
+    MeaFPoint p1 = unitsProvider.ConvertCoord(point1);
+    MeaFPoint p2 = unitsProvider.ConvertCoord(point2);
+    MeaFPoint v = unitsProvider.ConvertCoord(vertex);
+
+    // Save the positions and the name of the tool in the position object.
+    //
+    position.SetToolName(toolName);
+    position.RecordXY1(p1);
+    position.RecordXY2(p2);
+    position.RecordXYV(v);
+
+    // Compute the angle and save it in the position object.
+    //
+    double angle = MeaGeometry::CalcAngle(v, p1, p2);
+    position.RecordAngle(unitsProvider.ConvertAngle(angle));
+}
+
+void MeaPositionRecorder::Record(MeaPosition& position, const Measurement& measurement,
+                                 const MeaUnitsProvider& unitsProvider) {
+    const CString& toolName = measurement.m_toolName;
+    const PointMap& points = measurement.m_points;
+
+    // The tool must be given exactly the points that it records.
+    //
+    auto requirePoints = [&points](std::initializer_list<PCTSTR> names) {
+        if (points.size() != names.size()) {
+            throw std::invalid_argument("MeaPositionRecorder::Record points do not match the tool");
+        }
+        for (PCTSTR name : names) {
+            if (points.find(name) == points.end()) {
+                throw std::invalid_argument("MeaPositionRecorder::Record points do not match the tool");
+            }
+        }
+    };
+
+    if (toolName == MeaPointTool::kToolName || toolName == MeaCursorTool::kToolName) {
+        requirePoints({ _T("1") });
+        RecordPoint(position, toolName, points.at(_T("1")), unitsProvider);
+    } else if (toolName == MeaLineTool::kToolName || toolName == MeaRectTool::kToolName ||
+               toolName == MeaWindowTool::kToolName) {
+        requirePoints({ _T("1"), _T("2") });
+        RecordSegment(position, toolName, points.at(_T("1")), points.at(_T("2")), unitsProvider);
+    } else if (toolName == MeaCircleTool::kToolName) {
+        requirePoints({ _T("1"), _T("v") });
+        RecordCircle(position, toolName, points.at(_T("v")), points.at(_T("1")), unitsProvider);
+    } else if (toolName == MeaAngleTool::kToolName) {
+        requirePoints({ _T("1"), _T("2"), _T("v") });
+        RecordAngle(position, toolName, points.at(_T("1")), points.at(_T("2")), points.at(_T("v")), unitsProvider);
+    } else {
+        throw std::invalid_argument("MeaPositionRecorder::Record unrecognized tool");
+    }
+
+    if (!measurement.m_desc.IsEmpty()) {
+        position.SetDesc(measurement.m_desc);
+    }
+}
+
+void MeaPositionRecorder::RecordBatch(MeaPositionCollection& positions, const std::vector<Measurement>& measurements,
+                                      const MeaPositionDesktopRef& desktopRef, PCTSTR timestamp,
+                                      const MeaUnitsProvider& unitsProvider, MeaPositionLogObserver* observer) {
+    if (measurements.empty()) {
+        return;
+    }
+
+    // Compute all positions before adding any, so that a failure leaves the collection unchanged.
+    //
+    std::vector<std::unique_ptr<MeaPosition>> recorded;
+    recorded.reserve(measurements.size());
+
+    for (const Measurement& measurement : measurements) {
+        recorded.push_back(std::make_unique<MeaPosition>(desktopRef, measurement.m_toolName, timestamp));
+        Record(*recorded.back(), measurement, unitsProvider);
+    }
+
+    std::vector<MeaPosition*> added;
+    added.reserve(recorded.size());
+    for (std::unique_ptr<MeaPosition>& position : recorded) {
+        added.push_back(position.release());
+    }
+
+    int firstIndex = static_cast<int>(positions.Size());
+    positions.Add(added);
+
+    if (observer != nullptr) {
+        observer->PositionsAdded(firstIndex, static_cast<int>(added.size()));
+    }
+}
@@ -0,0 +1,139 @@
+/*
+ * Copyright 2022 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/// @file
+/// @brief Header file for computing the measurements recorded in a position.
+
+#pragma once
+
+#include "Position.h"
+#include <meazure/units/UnitsProvider.h>
+#include <map>
+#include <vector>
+
+
+class MeaPositionCollection;
+class MeaPositionLogObserver;
+
+
+/// Computes the measurements recorded in a position from the pixel locations of a tool's points. The radio
+/// tools record their positions through these functions, and they can also be used to record positions without
+/// a tool (e.g. when capturing positions programmatically), with identical results.
+///
+/// Points are named as in MeaRadioTool::PointMap: "1" and "2" for the end points of a tool and "v" for a vertex
+/// or center point. The points required and the measurements recorded depend on the tool:
+///
+/// <ul>
+///     <li>Point and Cursor tools &mdash; "1", a single point.</li>
+///     <li>Line, Rectangle and Window tools &mdash; "1" and "2", two end points, for which the width, height,
+///         distance, area and angle are recorded.</li>
+///     <li>Circle tool &mdash; "v" and "1", the center and a perimeter point of a circle, for which the bounding
+///         width and height, radius, area and angle are recorded.</li>
+///     <li>Angle tool &mdash; "1", "2" and "v", the end points and vertex of an angle.</li>
+/// </ul>
+///
+namespace MeaPositionRecorder {
+
+    typedef std::map<CString, POINT> PointMap;      ///< Maps a point name to its location, in pixels.
+
+
+    /// A position to record: the name of the tool and the locations of its points.
+    ///
+    struct Measurement {
+        CString m_toolName;         ///< Name of the tool that the position represents (e.g. "LineTool").
+        PointMap m_points;          ///< Locations of the tool's points, in pixels.
+        CString m_desc;             ///< Description of the position. May be empty.
+    };
+
+
+    /// Records a single point.
+    ///
+    /// @param position         [in, out] Position into which the measurements are recorded.
+    /// @param toolName         [in] Name of the tool.
+    /// @param point            [in] Location of the point, in pixels.
+    /// @param unitsProvider    [in] Converts pixels to the current units.
+    ///
+    void RecordPoint(MeaPosition& position, PCTSTR toolName, const POINT& point,
+                     const MeaUnitsProvider& unitsProvider);
+
+    /// Records two end points and the width, height, distance, rectangular area and angle they define.
+    ///
+    /// @param position         [in, out] Position into which the measurements are recorded.
+    /// @param toolName         [in] Name of the tool.
+    /// @param point1           [in] Location of the first point, in pixels.
+    /// @param point2           [in] Location of the second point, in pixels.
+    /// @param unitsProvider    [in] Converts pixels to the current units.
+    ///
+    void RecordSegment(MeaPosition& position, PCTSTR toolName, const POINT& point1, const POINT& point2,
+                       const MeaUnitsProvider& unitsProvider);
+
+    /// Records the center and a perimeter point of a circle, and the bounding width and height, radius,
+    /// circular area and angle of the circle.
+    ///
+    /// @param position         [in, out] Position into which the measurements are recorded.
+    /// @param toolName         [in] Name of the tool.
+    /// @param center           [in] Location of the center of the circle, in pixels.
+    /// @param perimeter        [in] Location of a point on the perimeter of the circle, in pixels.
+    /// @param unitsProvider    [in] Converts pixels to the current units.
+    ///
+    void RecordCircle(MeaPosition& position, PCTSTR toolName, const POINT& center, const POINT& perimeter,
+                      const MeaUnitsProvider& unitsProvider);
+
+    /// Records the end points and vertex of an angle, and the angle they define.
+    ///
+    /// @param position         [in, out] Position into which the measurements are recorded.
+    /// @param toolName         [in] Name of the tool.
+    /// @param point1           [in] Location of the end of the first leg of the angle, in pixels.
+    /// @param point2           [in] Location of the end of the second leg of the angle, in pixels.
+    /// @param vertex           [in] Location of the vertex of the angle, in pixels.
+    /// @param unitsProvider    [in] Converts pixels to the current units.
+    ///
+    void RecordAngle(MeaPosition& position, PCTSTR toolName, const POINT& point1, const POINT& point2,
+                     const POINT& vertex, const MeaUnitsProvider& unitsProvider);
+
+    /// Records the specified measurement. The measurements recorded are determined by the tool named in the
+    /// measurement.
+    ///
+    /// @param position         [in, out] Position into which the measurements are recorded.
+    /// @param measurement      [in] Tool name, points and description to record.
+    /// @param unitsProvider    [in] Converts pixels to the current units.
+    ///
+    /// @throws std::invalid_argument if the tool is not a measurement tool, or the points are not exactly those
+    ///         of the tool.
+    ///
+    void Record(MeaPosition& position, const Measurement& measurement, const MeaUnitsProvider& unitsProvider);
+
+    /// Records a batch of measurements and adds the resulting positions to the end of a collection, in order.
+    /// All positions are computed before any are added, so if any of the measurements cannot be recorded, the
+    /// collection is left unchanged. The observer is notified once for the whole batch. Nothing is added and
+    /// the observer is not notified if the batch is empty.
+    ///
+    /// @param positions        [in, out] Collection to which the positions are added.
+    /// @param measurements     [in] Measurements to record.
+    /// @param desktopRef       [in] Desktop information shared by the positions.
+    /// @param timestamp        [in] Time stamp shared by the positions.
+    /// @param unitsProvider    [in] Converts pixels to the current units.
+    /// @param observer         [in] Notified of the positions added, or nullptr.
+    ///
+    /// @throws std::invalid_argument if any of the measurements cannot be recorded (see Record).
+    ///
+    void RecordBatch(MeaPositionCollection& positions, const std::vector<Measurement>& measurements,
+                     const MeaPositionDesktopRef& desktopRef, PCTSTR timestamp,
+                     const MeaUnitsProvider& unitsProvider, MeaPositionLogObserver* observer);
+};
@@ -22,6 +22,7 @@
 #include "Preferences.h"
 #include <meazure/resource.h>
 #include <meazure/utilities/NumericUtils.h>
+#include <meazure/utilities/NumberParse.h>
 
 #ifdef _DEBUG
 #define new DEBUG_NEW
@@ -349,7 +350,7 @@ bool MeaCalibrationPrefs::GetFieldValue(UINT fieldId, double& value) {
 
         field->GetWindowText(str);
         if (!str.IsEmpty()) {
-            double v = _tcstod(str, nullptr);
+            double v = MeaNumberParse::ToDbl(static_cast<PCTSTR>(str));
             if (IsMetric()) {
                 if ((fieldId == IDC_CAL_H_FIELD) || (fieldId == IDC_CAL_W_FIELD)) {
                     v /= 2.54;
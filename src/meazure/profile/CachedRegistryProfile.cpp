@@ -0,0 +1,174 @@
+/*
+ * Copyright 2022 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <meazure/pch.h>
+#include "CachedRegistryProfile.h"
+#include <meazure/VersionInfo.h>
+#include <meazure/utilities/NumberFormat.h>
+#include <meazure/utilities/NumberParse.h>
+
+
+MeaCachedRegistryProfile::MeaCachedRegistryProfile(MeaRegistryProvider& registry) :
+    MeaProfile(),
+    m_registry(registry) {
+
+    CString curVer;
+    curVer.Format(_T("%d.0"), MeaVersionInfo::Instance().GetProfileFileMajor());
+
+    m_saveVersion = curVer;
+
+    // Read the current version of the profile. If it is not present, fall back on the original version.
+    //
+    MeaRegistryValues values;
+    if (m_registry.ReadSection(curVer, values)) {
+        m_loadVersion = curVer;
+    } else if (m_registry.ReadSection(_T("1.0"), values)) {
+        m_loadVersion = _T("1.0");
+    } else {
+        m_loadVersion = curVer;
+    }
+
+    for (MeaRegistryValue& value : values) {
+        CString name = value.m_name;
+        m_loadValues.insert_or_assign(name, std::move(value));
+    }
+}
+
+MeaCachedRegistryProfile::~MeaCachedRegistryProfile() {
+    Flush();
+}
+
+bool MeaCachedRegistryProfile::WriteBool(PCTSTR key, bool value) {
+    Write(MeaRegistryValue(key, value ? 1 : 0));
+    return true;
+}
+
+bool MeaCachedRegistryProfile::WriteInt(PCTSTR key, int value) {
+    Write(MeaRegistryValue(key, value));
+    return true;
+}
+
+bool MeaCachedRegistryProfile::WriteDbl(PCTSTR key, double value) {
+    MeaNumberFormat::Buffer buffer;
+    std::string_view vstr = MeaNumberFormat::FormatFixed(buffer, value, 6);
+    Write(MeaRegistryValue(key, CString(vstr.data(), static_cast<int>(vstr.size()))));
+    return true;
+}
+
+bool MeaCachedRegistryProfile::WriteStr(PCTSTR key, PCTSTR value) {
+    Write(MeaRegistryValue(key, value));
+    return true;
+}
+
+bool MeaCachedRegistryProfile::ReadBool(PCTSTR key, bool defaultValue) {
+    const MeaRegistryValue* value = Find(key, REG_DWORD);
+    return (value == nullptr) ? defaultValue : (value->m_intValue != 0);
+}
+
+UINT MeaCachedRegistryProfile::ReadInt(PCTSTR key, int defaultValue) {
+    const MeaRegistryValue* value = Find(key, REG_DWORD);
+    return (value == nullptr) ? defaultValue : value->m_intValue;
+}
+
+double MeaCachedRegistryProfile::ReadDbl(PCTSTR key, double defaultValue) {
+    const MeaRegistryValue* value = Find(key, REG_SZ);
+    if (value == nullptr || value->m_strValue.IsEmpty()) {
+        return defaultValue;
+    }
+    return MeaNumberParse::ToDbl(static_cast<PCTSTR>(value->m_strValue));
+}
+
+CString MeaCachedRegistryProfile::ReadStr(PCTSTR key, PCTSTR defaultValue) {
+    const MeaRegistryValue* value = Find(key, REG_SZ);
+    return (value == nullptr) ? CString(defaultValue) : value->m_strValue;
+}
+
+bool MeaCachedRegistryProfile::UserInitiated() {
+    return false;
+}
+
+int MeaCachedRegistryProfile::GetVersion() {
+    return MeaNumberParse::ToInt(static_cast<PCTSTR>(m_loadVersion));
+}
+
+bool MeaCachedRegistryProfile::Flush() {
+    if (m_dirtyValues.empty()) {
+        return true;
+    }
+
+    MeaRegistryValues values;
+    values.reserve(m_dirtyValues.size());
+    for (const auto& entry : m_dirtyValues) {
+        values.push_back(entry.second);
+    }
+
+    if (!m_registry.WriteSection(m_saveVersion, values)) {
+        return false;
+    }
+
+    // The registry now holds the written values. If they were written to the section that was read, they become
+    // the baseline against which subsequent writes are compared.
+    //
+    if (m_saveVersion == m_loadVersion) {
+        for (auto& entry : m_dirtyValues) {
+            m_loadValues.insert_or_assign(entry.first, std::move(entry.second));
+        }
+    }
+    m_dirtyValues.clear();
+
+    return true;
+}
+
+void MeaCachedRegistryProfile::Write(const MeaRegistryValue& value) {
+    if (m_saveVersion == m_loadVersion) {
+        ValueMap::const_iterator iter = m_loadValues.find(value.m_name);
+        if (iter != m_loadValues.end() && iter->second.SameValue(value)) {
+            m_dirtyValues.erase(value.m_name);
+            return;
+        }
+    }
+
+    m_dirtyValues.insert_or_assign(value.m_name, value);
+}
+
+const MeaRegistryValue* MeaCachedRegistryProfile::Find(PCTSTR key, DWORD type) const {
+    const MeaRegistryValue* value = nullptr;
+
+    CString name(key);
+    ValueMap::const_iterator iter;
+
+    // Values written to a different version of the profile than the one read are not visible to reads, as is
+    // the case when accessing the registry directly.
+    //
+    if (m_saveVersion == m_loadVersion) {
+        iter = m_dirtyValues.find(name);
+        if (iter != m_dirtyValues.end()) {
+            value = &iter->second;
+        }
+    }
+
+    if (value == nullptr) {
+        iter = m_loadValues.find(name);
+        if (iter != m_loadValues.end()) {
+            value = &iter->second;
+        }
+    }
+
+    return (value != nullptr && value->m_type == type) ? value : nullptr;
+}
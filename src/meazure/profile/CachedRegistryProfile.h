@@ -0,0 +1,153 @@
+/*
+ * Copyright 2022 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/// @file
+/// @brief Header file for the cached registry profile.
+
+#pragma once
+
+#include "Profile.h"
+#include <meazure/utilities/RegistryProvider.h>
+#include <map>
+
+
+/// Persists the application state to the registry through an in-memory cache. Rather than accessing the
+/// registry for each value, the entire profile section is read from the registry when the profile is created,
+/// and all reads are served from memory. Writes are held in memory and only values that differ from those
+/// already in the registry are written, in a single batch, when the profile is flushed or destroyed. The
+/// number of registry accesses made at startup and shutdown is therefore independent of the number of
+/// settings persisted by the application.
+///
+/// Values are stored in the same registry location and with the same types as MeaRegistryProfile, so the two
+/// profiles are interchangeable.
+///
+class MeaCachedRegistryProfile : public MeaProfile {
+
+public:
+    /// Creates an instance of the profile and reads the profile values from the registry.
+    ///
+    /// @param registry  [in] Provider for reading and writing the Windows Registry
+    ///
+    MeaCachedRegistryProfile(MeaRegistryProvider& registry);
+
+    /// Writes any pending values to the registry and destroys the profile.
+    ///
+    virtual ~MeaCachedRegistryProfile();
+
+    /// Writes a boolean value to the specified key.
+    ///
+    /// @param key      [in] Profile key to write
+    /// @param value    [in] Boolean value for the key
+    ///
+    virtual bool WriteBool(PCTSTR key, bool value) override;
+
+    /// Writes an integer value to the specified key.
+    ///
+    /// @param key      [in] Profile key to write
+    /// @param value    [in] Integer value for the key
+    ///
+    virtual bool WriteInt(PCTSTR key, int value) override;
+
+    /// Writes a double value to the specified key.
+    ///
+    /// @param key      [in] Profile key to write
+    /// @param value    [in] Double value for the key
+    ///
+    virtual bool WriteDbl(PCTSTR key, double value) override;
+
+    /// Writes a string value to the specified key.
+    ///
+    /// @param key      [in] Profile key to write
+    /// @param value    [in] String value for the key
+    ///
+    virtual bool WriteStr(PCTSTR key, PCTSTR value) override;
+
+    /// Reads a boolean value from the specified key.
+    ///
+    /// @param key              [in] Profile key to read
+    /// @param defaultValue     [in] Default value to use if the key is not found in the profile.
+    virtual bool ReadBool(PCTSTR key, bool defaultValue) override;
+
+    /// Reads an unsigned integer value from the specified key.
+    ///
+    /// @param key              [in] Profile key to read
+    /// @param defaultValue     [in] Default value to use if the key is not found in the profile.
+    virtual UINT ReadInt(PCTSTR key, int defaultValue) override;
+
+    /// Reads a double value from the specified key.
+    ///
+    /// @param key              [in] Profile key to read
+    /// @param defaultValue     [in] Default value to use if the key is not found in the profile.
+    virtual double ReadDbl(PCTSTR key, double defaultValue) override;
+
+    /// Reads a string value from the specified key.
+    ///
+    /// @param key              [in] Profile key to read
+    /// @param defaultValue     [in] Default value to use if the key is not found in the profile.
+    virtual CString ReadStr(PCTSTR key, PCTSTR defaultValue) override;
+
+    /// Indicates whether the profile is being written at
+    /// the user's request (i.e. a file profile).
+    ///
+    /// @return Always <b>false</b> because a registry profile
+    ///         is not written at the user's request.
+    ///
+    virtual bool UserInitiated() override;
+
+    /// Returns the profile format version number.
+    ///
+    /// @return Profile format version number.
+    ///
+    virtual int GetVersion() override;
+
+    /// Writes the values that have changed since the profile was read or last flushed to the registry in a
+    /// single batch.
+    ///
+    /// @return <b>true</b> if the values were successfully written or there was nothing to write.
+    ///
+    bool Flush();
+
+private:
+    typedef std::map<CString, MeaRegistryValue> ValueMap;
+
+
+    /// Records a value to be written to the registry. The value is not recorded if it is the same as the value
+    /// already in the registry.
+    ///
+    /// @param value    [in] Value to write
+    ///
+    void Write(const MeaRegistryValue& value);
+
+    /// Locates the current value for the specified key. A value written using this profile takes precedence
+    /// over the value read from the registry.
+    ///
+    /// @param key      [in] Profile key to locate
+    /// @param type     [in] Required registry value type (REG_DWORD or REG_SZ)
+    ///
+    /// @return Value for the key, or nullptr if there is no value of the required type.
+    ///
+    const MeaRegistryValue* Find(PCTSTR key, DWORD type) const;
+
+
+    MeaRegistryProvider& m_registry;    ///< Access to the Windows Registry
+    CString m_loadVersion;              ///< Profile format version read.
+    CString m_saveVersion;              ///< Profile format version written.
+    ValueMap m_loadValues;              ///< Values read from the registry
+    ValueMap m_dirtyValues;             ///< Values written but not yet flushed to the registry
+};
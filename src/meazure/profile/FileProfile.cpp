@@ -22,6 +22,7 @@
 #include <meazure/VersionInfo.h>
 #include <meazure/utilities/TimeStamp.h>
 #include <meazure/utilities/StringUtils.h>
+#include <meazure/utilities/NumberParse.h>
 #include <meazure/xml/XMLWriter.h>
 #include <cassert>
 #include <cstring>
@@ -30,6 +31,7 @@
 MeaFileProfile::MeaFileProfile(PCTSTR pathname, Mode mode) :
     m_pathname(pathname),
     m_mode(mode),
+    m_committed(false),
     m_readVersion(1) {
 
     m_title.Format(_T("%s Profile File"), static_cast<PCTSTR>(AfxGetAppName()));
@@ -37,7 +39,7 @@ MeaFileProfile::MeaFileProfile(PCTSTR pathname, Mode mode) :
     if (m_mode == ProfWrite) {
         m_writeStream.exceptions(std::ios::failbit | std::ios::badbit);
         m_writeStream.open(MeaStringUtils::ACPtoUTF8(m_pathname), std::ios::out | std::ios::trunc);
-        m_writer = std::make_unique<MeaXMLWriter>(m_writeStream);
+        m_writer = std::make_unique<MeaXMLWriter>(m_writeBuffer);
 
         WriteFileStart();
     } else {
@@ -46,49 +48,45 @@ MeaFileProfile::MeaFileProfile(PCTSTR pathname, Mode mode) :
 }
 
 MeaFileProfile::~MeaFileProfile() {
-    if (m_mode == ProfWrite) {
-        try {
-            WriteFileEnd();
-        } catch (...) {
-            assert(false);
-        }
+    try {
+        Commit();
+    } catch (...) {
+        assert(false);
+    }
+}
+
+void MeaFileProfile::Commit() {
+    if (m_mode == ProfWrite && !m_committed) {
+        m_committed = true;
+        WriteFileEnd();
+        m_writeStream.close();
     }
 }
 
 bool MeaFileProfile::WriteBool(PCTSTR key, bool value) {
-    m_writer->StartElement(key)
-        .AddAttribute(_T("value"), (value ? _T("true") : _T("false")))
-        .EndElement();
+    m_store.Set(key, value ? _T("true") : _T("false"));
     return true;
 }
 
 bool MeaFileProfile::WriteInt(PCTSTR key, int value) {
-    m_writer->StartElement(key)
-        .AddAttribute(_T("value"), value)
-        .EndElement();
+    m_store.Set(key, MeaStringUtils::IntToStr(value));
     return true;
 }
 
 bool MeaFileProfile::WriteDbl(PCTSTR key, double value) {
-    m_writer->StartElement(key)
-        .AddAttribute(_T("value"), value)
-        .EndElement();
+    m_store.Set(key, MeaStringUtils::DblToStr(value));
     return true;
 }
 
 bool MeaFileProfile::WriteStr(PCTSTR key, PCTSTR value) {
-    m_writer->StartElement(key)
-        .AddAttribute(_T("value"), value)
-        .EndElement();
+    m_store.Set(key, value);
     return true;
 }
 
 bool MeaFileProfile::ReadBool(PCTSTR key, bool defaultValue) {
-    std::map<CString, CString>::const_iterator iter;
-
-    iter = m_valueMap.find(key);
-    if (iter != m_valueMap.end()) {
-        CString val = (*iter).second;
+    const CString* value = m_store.Get(key);
+    if (value != nullptr) {
+        CString val = *value;
         val.MakeLower();
         return ((val == _T("true")) || (val == _T("1")) || (val == _T("yes")));
     }
@@ -96,31 +94,25 @@ bool MeaFileProfile::ReadBool(PCTSTR key, bool defaultValue) {
 }
 
 UINT MeaFileProfile::ReadInt(PCTSTR key, int defaultValue) {
-    std::map<CString, CString>::const_iterator iter;
-
-    iter = m_valueMap.find(key);
-    if (iter != m_valueMap.end()) {
-        return _ttoi((*iter).second);
+    const CString* value = m_store.Get(key);
+    if (value != nullptr) {
+        return MeaNumberParse::ToInt(static_cast<PCTSTR>(*value));
     }
     return defaultValue;
 }
 
 double MeaFileProfile::ReadDbl(PCTSTR key, double defaultValue) {
-    std::map<CString, CString>::const_iterator iter;
-
-    iter = m_valueMap.find(key);
-    if (iter != m_valueMap.end()) {
-        return _tcstod((*iter).second, nullptr);
+    const CString* value = m_store.Get(key);
+    if (value != nullptr) {
+        return MeaNumberParse::ToDbl(static_cast<PCTSTR>(*value));
     }
     return defaultValue;
 }
 
 CString MeaFileProfile::ReadStr(PCTSTR key, PCTSTR defaultValue) {
-    std::map<CString, CString>::const_iterator iter;
-
-    iter = m_valueMap.find(key);
-    if (iter != m_valueMap.end()) {
-        return (*iter).second;
+    const CString* value = m_store.Get(key);
+    if (value != nullptr) {
+        return *value;
     }
     return defaultValue;
 }
@@ -169,9 +161,19 @@ void MeaFileProfile::WriteFileStart() {
 }
 
 void MeaFileProfile::WriteFileEnd() {
+    for (const MeaProfileStore::Entry& entry : m_store.GetEntries()) {
+        m_writer->StartElement(entry.m_key)
+            .AddAttribute(_T("value"), entry.m_value)
+            .EndElement();
+    }
+
     m_writer->EndElement();         // data
     m_writer->EndElement();         // profile
     m_writer->EndDocument();
+
+    std::string content = m_writeBuffer.str();
+    m_writeStream.write(content.data(), content.size());
+    m_writeStream.flush();
 }
 
 void MeaFileProfile::ParseFile(PCTSTR pathname) {
@@ -188,7 +190,7 @@ void MeaFileProfile::StartElement(const CString& container, const CString& eleme
     } else if ((container == _T("data")) || (m_readVersion == 1)) {
         CString value;
         attrs.GetValueStr(_T("value"), value);
-        m_valueMap[elementName] = value;
+        m_store.Set(elementName, value);
     }
 }
 
@@ -23,14 +23,17 @@
 #pragma once
 
 #include "Profile.h"
+#include "ProfileStore.h"
 #include <meazure/xml/XMLParser.h>
 #include <meazure/xml/XMLWriter.h>
-#include <map>
 #include <memory>
 #include <fstream>
+#include <sstream>
 
 
-/// Persists the application state to an XML file.
+/// Persists the application state to an XML file. Values are held in an in-memory store. When reading, the
+/// profile file is parsed once into the store. When writing, values are staged in the store and the entire
+/// profile file is serialized and written in a single operation when Commit is called.
 ///
 class MeaFileProfile : public MeaProfile, public MeaXMLParserHandler {
 
@@ -52,10 +55,18 @@ public:
     ///
     MeaFileProfile(PCTSTR pathname, Mode mode);
 
-    /// Closes the profile file and destroys the object instance.
+    /// Closes the profile file and destroys the object instance. If a profile opened for writing has not been
+    /// committed, the values are written to the file but any error is ignored. Call Commit to detect errors.
     ///
     virtual ~MeaFileProfile();
 
+    /// Writes the profile values to the file and closes the file. Has no effect if the profile was opened for
+    /// reading or has already been committed.
+    ///
+    /// @throws std::ofstream::failure if the file cannot be written.
+    ///
+    void Commit();
+
     /// Writes a boolean value to the specified key.
     ///
     /// @param key      [in] Profile key to write
@@ -162,7 +173,8 @@ private:
     ///
     void WriteFileStart();
 
-    /// Write the XML boilerplate at the end of the XML profile file.
+    /// Writes the staged profile values and the XML boilerplate at the end of the XML profile file, and then
+    /// writes the entire profile to the file.
     ///
     void WriteFileEnd();
 
@@ -178,9 +190,11 @@ private:
 
     CString m_pathname;             ///< Pathname of the file.
     std::ofstream m_writeStream;    ///< Output stream for the profile.
+    std::ostringstream m_writeBuffer;   ///< Profile XML is built in this buffer and written to the file at once.
     MeaXMLWriterPtr m_writer;       ///< Writer for the profile.
     Mode m_mode;                    ///< Opening mode for the profile file.
+    bool m_committed;               ///< Indicates the profile has been written to the file.
     int m_readVersion;              ///< Profile format version number read from the profile file.
     CString m_title;                ///< Title for the profile file.
-    std::map<CString, CString>  m_valueMap;     ///< Maps profile keys to values.
+    MeaProfileStore m_store;        ///< Profile keys and values.
 };
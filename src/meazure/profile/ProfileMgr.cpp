@@ -159,6 +159,7 @@ void MeaProfileMgr::Save() {
             MeaFileProfile profile(pathname, MeaFileProfile::ProfWrite);
 
             static_cast<AppFrame*>(AfxGetMainWnd())->SaveProfile(profile);
+            profile.Commit();
         } catch (const std::ofstream::failure& e) {
             CString errStr(e.what());
             CString msg;
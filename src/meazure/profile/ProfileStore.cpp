@@ -0,0 +1,84 @@
+/*
+ * Copyright 2022 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <meazure/pch.h>
+#include "ProfileStore.h"
+
+
+MeaProfileStore::MeaProfileStore(std::size_t expectedSize) {
+    std::size_t numSlots = 16;
+    while (numSlots < 2 * expectedSize) {
+        numSlots *= 2;
+    }
+
+    m_slots.assign(numSlots, kNoKey);
+    m_entries.reserve(expectedSize);
+}
+
+MeaProfileStore::KeyId MeaProfileStore::Intern(PCTSTR key) {
+    std::uint32_t hash = Hash(key);
+    std::size_t slot = FindSlot(key, hash);
+    if (m_slots[slot] != kNoKey) {
+        return m_slots[slot];
+    }
+
+    KeyId id = static_cast<KeyId>(m_entries.size());
+    m_entries.emplace_back(key, hash);
+    m_slots[slot] = id;
+
+    // Keep the load factor at or below one half so that probe sequences stay short.
+    if (2 * m_entries.size() > m_slots.size()) {
+        Grow();
+    }
+
+    return id;
+}
+
+void MeaProfileStore::Clear() {
+    m_entries.clear();
+    m_slots.assign(m_slots.size(), kNoKey);
+}
+
+std::size_t MeaProfileStore::FindSlot(PCTSTR key, std::uint32_t hash) const {
+    std::size_t mask = m_slots.size() - 1;
+    std::size_t slot = hash & mask;
+
+    while (m_slots[slot] != kNoKey) {
+        const Entry& entry = m_entries[m_slots[slot]];
+        if (entry.m_hash == hash && entry.m_key == key) {
+            break;
+        }
+        slot = (slot + 1) & mask;
+    }
+
+    return slot;
+}
+
+void MeaProfileStore::Grow() {
+    m_slots.assign(m_slots.size() * 2, kNoKey);
+
+    std::size_t mask = m_slots.size() - 1;
+    for (KeyId id = 0; id < m_entries.size(); id++) {
+        std::size_t slot = m_entries[id].m_hash & mask;
+        while (m_slots[slot] != kNoKey) {
+            slot = (slot + 1) & mask;
+        }
+        m_slots[slot] = id;
+    }
+}
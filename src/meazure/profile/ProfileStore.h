@@ -0,0 +1,134 @@
+/*
+ * Copyright 2022 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/// @file
+/// @brief Header file for the in-memory profile key/value store.
+
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <type_traits>
+
+
+/// Flat in-memory store of profile values. Keys are interned: each distinct key is stored once and is
+/// identified by a small integer ID, which is its position in the store. Keys are located through an open
+/// addressing hash table so that a lookup hashes the caller's characters directly without creating a
+/// temporary string. Entries are kept in the order in which their keys were first added, so that a profile
+/// written from the store lists its values in the order the application saved them.
+///
+class MeaProfileStore {
+
+public:
+    /// Represents a key and its value.
+    ///
+    struct Entry {
+        Entry(PCTSTR key, std::uint32_t hash) : m_key(key), m_hash(hash) {}
+
+        CString m_key;              ///< Key name.
+        CString m_value;            ///< Value for the key.
+        std::uint32_t m_hash;       ///< Hash of the key name.
+    };
+
+    typedef std::vector<Entry> Entries;
+
+
+    /// Constructs an empty store.
+    ///
+    /// @param expectedSize     [in] Number of keys expected to be stored. Used to size the hash table so that
+    ///                         it does not need to grow while a profile is loaded or saved.
+    ///
+    explicit MeaProfileStore(std::size_t expectedSize = 256);
+
+    /// Sets the value for the specified key, adding the key if necessary.
+    ///
+    /// @param key      [in] Key whose value is to be set.
+    /// @param value    [in] Value for the key.
+    ///
+    void Set(PCTSTR key, PCTSTR value) { m_entries[Intern(key)].m_value = value; }
+
+    /// Obtains the value for the specified key.
+    ///
+    /// @param key      [in] Key whose value is to be obtained.
+    /// @return Value for the key, or nullptr if the key is not in the store.
+    ///
+    const CString* Get(PCTSTR key) const {
+        KeyId id = m_slots[FindSlot(key, Hash(key))];
+        return (id == kNoKey) ? nullptr : &m_entries[id].m_value;
+    }
+
+    /// Obtains all entries in the order their keys were added.
+    ///
+    /// @return Entries in the store.
+    ///
+    const Entries& GetEntries() const { return m_entries; }
+
+    /// Obtains the number of keys in the store.
+    ///
+    /// @return Number of keys.
+    ///
+    std::size_t GetSize() const { return m_entries.size(); }
+
+    /// Removes all keys from the store.
+    ///
+    void Clear();
+
+private:
+    typedef unsigned int KeyId;     ///< Identifier for an interned key.
+
+    static constexpr KeyId kNoKey = static_cast<KeyId>(-1);     ///< Marks an empty hash table slot.
+
+
+    /// Computes the hash of the specified key name (32-bit FNV-1a).
+    ///
+    /// @param name     [in] Key name.
+    /// @return Hash of the name.
+    ///
+    static std::uint32_t Hash(PCTSTR name) {
+        std::uint32_t hash = 2166136261U;
+        for (; *name != _T('\0'); name++) {
+            hash = (hash ^ static_cast<std::uint32_t>(static_cast<std::make_unsigned_t<TCHAR>>(*name))) * 16777619U;
+        }
+        return hash;
+    }
+
+    /// Adds the specified key to the store if it is not already present.
+    ///
+    /// @param key      [in] Key to intern.
+    /// @return Identifier for the key.
+    ///
+    KeyId Intern(PCTSTR key);
+
+    /// Locates the hash table slot for the specified key. The slot either holds the key or is empty.
+    ///
+    /// @param key      [in] Key to locate.
+    /// @param hash     [in] Hash of the key.
+    /// @return Index of the slot in the hash table.
+    ///
+    std::size_t FindSlot(PCTSTR key, std::uint32_t hash) const;
+
+    /// Doubles the size of the hash table and reinserts the keys.
+    ///
+    void Grow();
+
+
+    Entries m_entries;                  ///< Keys and values in the order they were added.
+    std::vector<KeyId> m_slots;         ///< Open addressing hash table of key identifiers. Size is a power of 2.
+};
@@ -20,6 +20,7 @@
 #include <meazure/pch.h>
 #include "RegistryProfile.h"
 #include <meazure/VersionInfo.h>
+#include <meazure/utilities/NumberFormat.h>
 
 
 MeaRegistryProfile::MeaRegistryProfile(MeaRegistryProvider& registry) : MeaProfile(), m_registry(registry) {
@@ -44,10 +45,9 @@ bool MeaRegistryProfile::WriteInt(PCTSTR key, int value) {
 }
 
 bool MeaRegistryProfile::WriteDbl(PCTSTR key, double value) {
-    CString vstr;
-
-    vstr.Format(_T("%f"), value);
-    return m_registry.WriteString(m_saveVersion, key, vstr) == TRUE;
+    MeaNumberFormat::Buffer buffer;
+    std::string_view vstr = MeaNumberFormat::FormatFixed(buffer, value, 6);
+    return m_registry.WriteString(m_saveVersion, key, CString(vstr.data(), static_cast<int>(vstr.size()))) == TRUE;
 }
 
 bool MeaRegistryProfile::WriteStr(PCTSTR key, PCTSTR value) {
@@ -262,6 +262,11 @@
 #define ID_MEA_EXTNAMEFMT               32870
 #define ID_MEA_EXTHEXFMT                32871
 #define ID_MEA_SUPPLEMENTAL             32874
+#define ID_MEA_SAMPLE1                  32875
+#define ID_MEA_SAMPLE3                  32876
+#define ID_MEA_SAMPLE5                  32877
+#define ID_MEA_SAMPLE9                  32878
+#define ID_MEA_EXPORT_POSITIONS         32879
 #define IDS_MEA_PIXELS                  61204
 #define IDS_MEA_CM                      61205
 #define IDS_MEA_MM                      61206
@@ -426,6 +431,7 @@
 #define IDS_MEA_CIRCLE_STATUS           61367
 #define IDS_MEA_PREC_MIN                61368
 #define IDS_MEA_PREC_VALUE              61369
+#define IDS_MEA_NO_EXPORT_LOG           61370
 
 // Next default values for new objects
 // 
@@ -433,7 +439,7 @@
 #ifndef APSTUDIO_READONLY_SYMBOLS
 #define _APS_3D_CONTROLS                     1
 #define _APS_NEXT_RESOURCE_VALUE        169
-#define _APS_NEXT_COMMAND_VALUE         32875
+#define _APS_NEXT_COMMAND_VALUE         32880
 #define _APS_NEXT_CONTROL_VALUE         1185
 #define _APS_NEXT_SYMED_VALUE           129
 #endif
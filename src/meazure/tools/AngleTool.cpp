@@ -20,6 +20,7 @@
 #include <meazure/pch.h>
 #include "AngleTool.h"
 #include "ToolMgr.h"
+#include <meazure/position/PositionRecorder.h>
 #include <meazure/resource.h>
 #include <meazure/graphics/Colors.h>
 #include <meazure/utilities/Geometry.h>
@@ -277,10 +278,12 @@ void MeaAngleTool::Update(MeaUpdateReason reason) {
         // Display the results of the measurement in
         // the data display fields.
         //
-        m_mgr.ShowXY1(m_point1, p1);
-        m_mgr.ShowXY2(m_point2, p2);
-        m_mgr.ShowXYV(m_vertex, v);
-        m_mgr.ShowAngle(angle);
+        MeaMeasurementSnapshot snapshot;
+        snapshot.SetXY1(m_point1, p1)
+                .SetXY2(m_point2, p2)
+                .SetXYV(m_vertex, v)
+                .SetAngle(m_unitsProvider.ConvertAngle(angle));
+        m_mgr.ShowMeasurement(snapshot);
 
         // The screen information depends on the
         // current position.
@@ -404,23 +407,7 @@ const POINT& MeaAngleTool::GetPosition() const {
 }
 
 void MeaAngleTool::RecordPosition(MeaPosition& position) const {
-    // Convert the pixel locations to the current units.
-    //
-    MeaFPoint p1 = m_unitsProvider.ConvertCoord(m_point1);
-    MeaFPoint p2 = m_unitsProvider.ConvertCoord(m_point2);
-    MeaFPoint v = m_unitsProvider.ConvertCoord(m_vertex);
-
-    // Save the positions and the name of this tool in the position object.
-    //
-    position.SetToolName(kToolName);
-    position.RecordXY1(p1);
-    position.RecordXY2(p2);
-    position.RecordXYV(v);
-
-    // Compute the angle and save it in the position object.
-    //
-    double angle = MeaGeometry::CalcAngle(v, p1, p2);
-    position.RecordAngle(m_unitsProvider.ConvertAngle(angle));
+    MeaPositionRecorder::RecordAngle(position, kToolName, m_point1, m_point2, m_vertex, m_unitsProvider);
 }
 
 void MeaAngleTool::IncPosition(MeaDataFieldId which) {
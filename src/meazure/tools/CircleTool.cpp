@@ -20,6 +20,7 @@
 #include <meazure/pch.h>
 #include "CircleTool.h"
 #include "ToolMgr.h"
+#include <meazure/position/PositionRecorder.h>
 #include <meazure/utilities/Geometry.h>
 #include <meazure/utilities/StringUtils.h>
 #include <meazure/resource.h>
@@ -247,12 +248,14 @@ void MeaCircleTool::Update(MeaUpdateReason reason) {
         // Display the results of the measurement in
         // the data display fields.
         //
-        m_mgr.ShowXYV(m_center, p1);
-        m_mgr.ShowXY1(m_perimeter, p2);
-        m_mgr.ShowWH(wh);
-        m_mgr.ShowDistance(r);
-        m_mgr.ShowAngle(MeaGeometry::CalcAngle(p1, p2));
-        m_mgr.ShowCircleArea(r);
+        MeaMeasurementSnapshot snapshot;
+        snapshot.SetXYV(m_center, p1)
+                .SetXY1(m_perimeter, p2)
+                .SetWH(wh)
+                .SetDistance(r)
+                .SetAngle(m_unitsProvider.ConvertAngle(MeaGeometry::CalcAngle(p1, p2)))
+                .SetCircleArea(r);
+        m_mgr.ShowMeasurement(snapshot);
 
         // The screen information depends on the
         // current position.
@@ -375,29 +378,7 @@ const POINT& MeaCircleTool::GetPosition() const {
 }
 
 void MeaCircleTool::RecordPosition(MeaPosition& position) const {
-    // Convert the pixel locations to the current units.
-    //
-    MeaFPoint p1 = m_unitsProvider.ConvertCoord(m_center);
-    MeaFPoint p2 = m_unitsProvider.ConvertCoord(m_perimeter);
-
-    int radius = m_circle.GetRadius();
-    CPoint topLeft(m_center.x - radius, m_center.y - radius);
-    CPoint bottomRight(m_center.x + radius, m_center.y + radius);
-    MeaFSize wh = m_unitsProvider.GetWidthHeight(topLeft, bottomRight);
-
-    double r = wh.cx / 2.0;
-
-    // Save the positions and the name of this tool in the position object.
-    //
-    position.SetToolName(kToolName);
-    position.RecordXYV(p1);
-    position.RecordXY1(p2);
-    position.RecordWH(wh);
-    position.RecordDistance(r);
-    position.RecordCircleArea(r);
-
-    double angle = MeaGeometry::CalcAngle(p1, p2);
-    position.RecordAngle(m_unitsProvider.ConvertAngle(angle));
+    MeaPositionRecorder::RecordCircle(position, kToolName, m_center, m_perimeter, m_unitsProvider);
 }
 
 void MeaCircleTool::IncPosition(MeaDataFieldId which) {
@@ -20,6 +20,7 @@
 #include <meazure/pch.h>
 #include "CursorTool.h"
 #include "ToolMgr.h"
+#include <meazure/position/PositionRecorder.h>
 #include <hooks/hooks.h>
 #include <meazure/resource.h>
 #include <meazure/graphics/Colors.h>
@@ -115,7 +116,7 @@ void MeaCursorTool::Update(MeaUpdateReason reason) {
 
         // Display the measurement.
         //
-        m_mgr.ShowXY1(m_cursorPos, cursorPos);
+        m_mgr.ShowMeasurement(MeaMeasurementSnapshot().SetXY1(m_cursorPos, cursorPos));
 
         // The screen information depends on the pointer position.
         //
@@ -163,8 +164,7 @@ const POINT& MeaCursorTool::GetPosition() const {
 }
 
 void MeaCursorTool::RecordPosition(MeaPosition& position) const {
-    position.SetToolName(kToolName);
-    position.RecordXY1(m_unitsProvider.ConvertCoord(m_cursorPos));
+    MeaPositionRecorder::RecordPoint(position, kToolName, m_cursorPos, m_unitsProvider);
 }
 
 PCTSTR MeaCursorTool::GetToolName() const {
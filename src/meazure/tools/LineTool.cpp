@@ -20,6 +20,7 @@
 #include <meazure/pch.h>
 #include "LineTool.h"
 #include "ToolMgr.h"
+#include <meazure/position/PositionRecorder.h>
 #include <meazure/utilities/Geometry.h>
 #include <meazure/utilities/StringUtils.h>
 #include <meazure/resource.h>
@@ -220,13 +221,15 @@ void MeaLineTool::Update(MeaUpdateReason reason) {
         // Display the results of the measurement in
         // the data display fields.
         //
-        m_mgr.ShowXY1(m_point1, p1);
-        m_mgr.ShowXY2(m_point2, p2);
-        m_mgr.ShowWH(wh);
-        m_mgr.ShowDistance(wh);
-        m_mgr.ShowAngle(MeaGeometry::CalcAngle(p1, p2));
-        m_mgr.ShowAspect(wh);
-        m_mgr.ShowRectArea(wh);
+        MeaMeasurementSnapshot snapshot;
+        snapshot.SetXY1(m_point1, p1)
+                .SetXY2(m_point2, p2)
+                .SetWH(wh)
+                .SetDistance(wh)
+                .SetAngle(m_unitsProvider.ConvertAngle(MeaGeometry::CalcAngle(p1, p2)))
+                .SetAspect(wh)
+                .SetRectArea(wh);
+        m_mgr.ShowMeasurement(snapshot);
 
         // The screen information depends on the
         // current position.
@@ -326,23 +329,7 @@ const POINT& MeaLineTool::GetPosition() const {
 }
 
 void MeaLineTool::RecordPosition(MeaPosition& position) const {
-    // Convert the pixel locations to the current units.
-    //
-    MeaFPoint p1 = m_unitsProvider.ConvertCoord(m_point1);
-    MeaFPoint p2 = m_unitsProvider.ConvertCoord(m_point2);
-    MeaFSize wh = m_unitsProvider.GetWidthHeight(m_point1, m_point2);
-
-    // Save the positions and the name of this tool in the position object.
-    //
-    position.SetToolName(kToolName);
-    position.RecordXY1(p1);
-    position.RecordXY2(p2);
-    position.RecordWH(wh);
-    position.RecordDistance(wh);
-    position.RecordRectArea(wh);
-
-    double angle = MeaGeometry::CalcAngle(p1, p2);
-    position.RecordAngle(m_unitsProvider.ConvertAngle(angle));
+    MeaPositionRecorder::RecordSegment(position, kToolName, m_point1, m_point2, m_unitsProvider);
 }
 
 void MeaLineTool::IncPosition(MeaDataFieldId which) {
@@ -20,6 +20,7 @@
 #include <meazure/pch.h>
 #include "PointTool.h"
 #include "ToolMgr.h"
+#include <meazure/position/PositionRecorder.h>
 #include <meazure/utilities/Geometry.h>
 #include <meazure/utilities/StringUtils.h>
 #include <meazure/resource.h>
@@ -166,7 +167,7 @@ void MeaPointTool::Update(MeaUpdateReason reason) {
         // Display the results of the measurement in
         // the data display fields.
         //
-        m_mgr.ShowXY1(m_center, center);
+        m_mgr.ShowMeasurement(MeaMeasurementSnapshot().SetXY1(m_center, center));
 
         // The screen information depends on the
         // current position.
@@ -231,11 +232,7 @@ const POINT& MeaPointTool::GetPosition() const {
 }
 
 void MeaPointTool::RecordPosition(MeaPosition& position) const {
-    // Convert the pixel locations to the current units and record
-    // the position and the name of this tool in the position object.
-    //
-    position.SetToolName(kToolName);
-    position.RecordXY1(m_unitsProvider.ConvertCoord(m_center));
+    MeaPositionRecorder::RecordPoint(position, kToolName, m_center, m_unitsProvider);
 }
 
 void MeaPointTool::IncPosition(MeaDataFieldId which) {
@@ -22,6 +22,7 @@
 #include <meazure/ui/StatusBar.h>
 #include <meazure/ui/ScreenMgr.h>
 #include <meazure/units/UnitsMgr.h>
+#include <hooks/hooks.h>
 
 
 MeaToolMgr::MeaToolMgr(token) :
@@ -69,6 +70,8 @@ MeaToolMgr::MeaToolMgr(token) :
 
 MeaToolMgr::~MeaToolMgr() {
     try {
+        m_framePacer.Stop();
+
         for (const auto& toolEntry : m_tools) {
             delete toolEntry.second;
         }
@@ -85,6 +88,14 @@ void MeaToolMgr::SetPositionToCursor(MeaDataFieldId xfield, MeaDataFieldId yfiel
     SetPosition(yfield, point.y);
 }
 
+void MeaToolMgr::OnMouseHook(WPARAM wParam, LPARAM /* lParam */) {
+    MeaMouseSample sample;
+
+    if (MeaReadMouseSample(sample)) {
+        m_currentRadioTool->OnMouseHook(wParam, MAKELPARAM(sample.m_pos.x, sample.m_pos.y));
+    }
+}
+
 void MeaToolMgr::SaveProfile(MeaProfile& profile) {
     for (const auto& toolEntry : m_tools) {
         toolEntry.second->SaveProfile(profile);
@@ -35,6 +35,7 @@
 #include "RulerTool.h"
 #include "GridTool.h"
 #include "OriginTool.h"
+#include <meazure/graphics/FramePacer.h>
 #include <meazure/ui/DataDisplay.h>
 #include <meazure/utilities/Singleton.h>
 #include <meazure/position/Position.h>
@@ -86,6 +87,29 @@ public:
         m_dataDisplay = dataDisplay;
     }
 
+    /// Starts applying the moves and repaints of the tool windows once per display frame.
+    ///
+    /// @param frameWnd     [in] Window that is sent the MeaFrameMsg message at the start of each frame. The
+    ///                     window's message handler must call OnFrame.
+    ///
+    void StartFramePacing(CWnd* frameWnd) {
+        m_framePacer.Start(frameWnd);
+    }
+
+    /// Applies any pending tool window updates and stops pacing them. Subsequent updates are applied
+    /// immediately.
+    ///
+    void StopFramePacing() {
+        m_framePacer.Stop();
+    }
+
+    /// Applies the tool window updates collected for the current display frame. Called when the frame window
+    /// receives the MeaFrameMsg message.
+    ///
+    void OnFrame() {
+        m_framePacer.OnFrame();
+    }
+
     /// Makes the specified radio tool the current measurement tool.
     ///
     /// @param toolName     [in] Name of the radio tool to set.
@@ -262,14 +286,15 @@ public:
     ///
     void StrobeTool() const { m_currentRadioTool->Strobe(); }
 
-    /// Called by the OS when the mouse pointer is moved.
+    /// Called when the mouse hook reports that the mouse pointer has moved.
+    /// Pointer movement is coalesced by the hook, so only the most recent
+    /// pointer position is passed to the current radio tool. Nothing is done
+    /// if that position has already been processed.
     ///
     /// @param wParam   [in] OS Message ID
-    /// @param lParam   [in] MOUSEHOOKSTRUCT
+    /// @param lParam   [in] Pointer position when the message was posted
     ///
-    void OnMouseHook(WPARAM wParam, LPARAM lParam) {
-        m_currentRadioTool->OnMouseHook(wParam, lParam);
-    }
+    void OnMouseHook(WPARAM wParam, LPARAM lParam);
 
     /// Sets the position of the current radio tool. The
     /// position of a specific part of the tool is set.
@@ -387,126 +412,25 @@ public:
         }
     }
 
-    /// Displays the specified point in the X1/Y1 fields
-    /// of the data display and on the rulers, if they
-    /// are visible.
-    ///
-    /// @param point    [in] Point, in pixels.
-    /// @param cpoint   [in] Point, in the current units.
-    ///
-    void ShowXY1(const POINT& point, const MeaFPoint& cpoint) {
-        if (m_dataDisplay != nullptr) {
-            m_dataDisplay->ShowXY1(point, cpoint);
-        }
-        m_rulerTool->SetIndicator(MeaRuler::IndicatorId::Ind1, point);
-    }
-
-    /// Displays the specified point in the X2/Y2 fields
-    /// of the data display and on the rulers, if they
-    /// are visible.
-    ///
-    /// @param point    [in] Point, in pixels.
-    /// @param cpoint   [in] Point, in the current units.
-    ///
-    void ShowXY2(const POINT& point, const MeaFPoint& cpoint) {
-        if (m_dataDisplay != nullptr) {
-            m_dataDisplay->ShowXY2(point, cpoint);
-        }
-        m_rulerTool->SetIndicator(MeaRuler::IndicatorId::Ind2, point);
-    }
-
-    /// Displays the specified point in the XV/YV fields
-    /// of the data display and on the rulers, if they
-    /// are visible.
-    ///
-    /// @param point    [in] Point, in pixels.
-    /// @param cpoint   [in] Point, in the current units.
-    ///
-    void ShowXYV(const POINT& point, const MeaFPoint& cpoint) {
-        if (m_dataDisplay != nullptr) {
-            m_dataDisplay->ShowXYV(point, cpoint);
-        }
-        m_rulerTool->SetIndicator(MeaRuler::IndicatorId::Ind3, point);
-    }
-
-    /// Displays the specified size in the width and height
-    /// fields of the data display.
-    ///
-    /// @param size     [in] Width and height, in the current units
-    ///
-    void ShowWH(const MeaFSize& size) {
-        if (m_dataDisplay != nullptr) {
-            m_dataDisplay->ShowWH(size);
-        }
-    }
-
-    /// Displays a distance calculated from the specified size
-    /// in the distance field of the data display.
+    /// Displays the specified measurement in the Region section of the
+    /// data display and the coordinates it contains on the rulers, if
+    /// they are visible. Only the data display fields whose text changes
+    /// are updated.
     ///
-    /// @param size     [in] The distance is calculated from
-    ///                 this parameter, in the current units
+    /// @param snapshot     [in] Measurement values, in the current units.
     ///
-    void ShowDistance(const MeaFSize& size) {
+    void ShowMeasurement(const MeaMeasurementSnapshot& snapshot) {
         if (m_dataDisplay != nullptr) {
-            m_dataDisplay->ShowDistance(size);
+            m_dataDisplay->ShowMeasurement(snapshot);
         }
-    }
-
-    /// Displays the specified value in the distance field of
-    /// the data display.
-    ///
-    /// @param dist     [in] The distance, in the current units
-    ///
-    void ShowDistance(double dist) {
-        if (m_dataDisplay != nullptr) {
-            m_dataDisplay->ShowDistance(dist);
+        if (snapshot.Has(MeaX1Field)) {
+            m_rulerTool->SetIndicator(MeaRuler::IndicatorId::Ind1, snapshot.GetPoint(MeaX1Field, MeaY1Field));
         }
-    }
-
-    /// Displays the specified angle in the angle field of
-    /// the data display.
-    ///
-    /// @param angle    [in] Angle value, in the current angular units.
-    ///
-    void ShowAngle(double angle) {
-        if (m_dataDisplay != nullptr) {
-            m_dataDisplay->ShowAngle(angle);
+        if (snapshot.Has(MeaX2Field)) {
+            m_rulerTool->SetIndicator(MeaRuler::IndicatorId::Ind2, snapshot.GetPoint(MeaX2Field, MeaY2Field));
         }
-    }
-
-    /// Displays the aspect ratio of the specified size in the aspect ratio field of
-    /// the data display.
-    ///
-    /// @param size    [in] Width and height of the bounding rectangle.
-    ///
-    void ShowAspect(const MeaFSize& size) {
-        if (m_dataDisplay != nullptr) {
-            m_dataDisplay->ShowAspect(size);
-        }
-    }
-
-    /// Displays the rectangular area calculated from the
-    /// specified width and height in the area field of the
-    /// data display.
-    ///
-    /// @param size     [in] Width and height from which the
-    ///                 rectangular area is calculated, in current units.
-    ///
-    void ShowRectArea(const MeaFSize& size) {
-        if (m_dataDisplay != nullptr) {
-            m_dataDisplay->ShowRectArea(size);
-        }
-    }
-
-    /// Displays the area of a circle with the specified radius
-    /// in the area field of the data display.
-    ///
-    /// @param radius       [in] Radius from which the circle's
-    ///                     area is calculated, in the current units.
-    ///
-    void ShowCircleArea(double radius) {
-        if (m_dataDisplay != nullptr) {
-            m_dataDisplay->ShowCircleArea(radius);
+        if (snapshot.Has(MeaXVField)) {
+            m_rulerTool->SetIndicator(MeaRuler::IndicatorId::Ind3, snapshot.GetPoint(MeaXVField, MeaYVField));
         }
     }
 
@@ -572,4 +496,5 @@ private:
     MeaRulerTool* m_rulerTool;          ///< Screen rulers.
     MeaGridTool* m_gridTool;            ///< Screen grid.
     MeaOriginTool* m_originTool;        ///< Origin marker.
+    MeaFramePacer m_framePacer;         ///< Applies tool window moves and repaints once per display frame.
 };
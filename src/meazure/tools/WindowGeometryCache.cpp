@@ -0,0 +1,170 @@
+/*
+ * Copyright 2022 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <meazure/pch.h>
+#include "WindowGeometryCache.h"
+#include <cassert>
+
+
+MeaWindowGeometryCache* MeaWindowGeometryCache::m_active = nullptr;
+
+
+MeaWindowGeometryCache::MeaWindowGeometryCache() :
+    m_eventHook(nullptr),
+    m_root(nullptr),
+    m_snapshotTime(0),
+    m_valid(false) {}
+
+MeaWindowGeometryCache::~MeaWindowGeometryCache() {
+    try {
+        Stop();
+    } catch (...) {
+        assert(false);
+    }
+}
+
+void MeaWindowGeometryCache::Start() {
+    m_active = this;
+    m_valid = false;
+
+    // Events are delivered through the message loop of this thread. If the hook cannot be installed, the
+    // snapshot is still retaken when it reaches its maximum age.
+    //
+    if (m_eventHook == nullptr) {
+        m_eventHook = SetWinEventHook(EVENT_OBJECT_CREATE, EVENT_OBJECT_LOCATIONCHANGE, nullptr, WinEventProc,
+                                      0, 0, WINEVENT_OUTOFCONTEXT | WINEVENT_SKIPOWNPROCESS);
+    }
+}
+
+void MeaWindowGeometryCache::Stop() {
+    if (m_eventHook != nullptr) {
+        UnhookWinEvent(m_eventHook);
+        m_eventHook = nullptr;
+    }
+    if (m_active == this) {
+        m_active = nullptr;
+    }
+
+    m_valid = false;
+    m_root = nullptr;
+    m_windows.clear();
+    m_rects.clear();
+    m_ids.clear();
+    m_index.Clear();
+}
+
+HWND MeaWindowGeometryCache::FindDeepest(HWND root, const POINT& pt) {
+    if (!m_valid || (root != m_root) || (GetTickCount() - m_snapshotTime > kMaxAge)) {
+        Snapshot(root);
+    }
+
+    int id = m_index.FindTopmost(pt.x, pt.y);
+    if (id == MeaWindowIndex::kNotFound) {
+        return root;
+    }
+
+    // A window destroyed since the snapshot was taken means the snapshot is out of date.
+    //
+    if (!IsWindow(m_windows[id])) {
+        Snapshot(root);
+        id = m_index.FindTopmost(pt.x, pt.y);
+        if (id == MeaWindowIndex::kNotFound) {
+            return root;
+        }
+    }
+
+    return m_windows[id];
+}
+
+void MeaWindowGeometryCache::Snapshot(HWND root) {
+    m_root = root;
+    m_snapshotTime = GetTickCount();
+    m_windows.clear();
+    m_rects.clear();
+    m_ids.clear();
+
+    EnumChildWindows(root, EnumChildProc, reinterpret_cast<LPARAM>(this));
+
+    m_index.Build(m_rects);
+    for (std::size_t i = 0; i < m_windows.size(); i++) {
+        m_ids.emplace(m_windows[i], static_cast<int>(i));
+    }
+
+    m_valid = true;
+}
+
+void MeaWindowGeometryCache::OnWindowEvent(DWORD event, HWND hwnd) {
+    if (!m_valid) {
+        return;
+    }
+
+    auto iter = m_ids.find(hwnd);
+    bool inSnapshot = (hwnd == m_root) || (iter != m_ids.end());
+
+    switch (event) {
+    case EVENT_OBJECT_LOCATIONCHANGE:
+        // Moving a window moves its descendants, which do not report their own location changes, so only a
+        // window without children can be updated in place.
+        //
+        if (iter != m_ids.end() && GetWindow(hwnd, GW_CHILD) == nullptr) {
+            RECT rect;
+            if (!GetWindowRect(hwnd, &rect)) {
+                SetRectEmpty(&rect);
+            }
+            m_index.Update(iter->second, MeaWindowIndex::Rect { rect.left, rect.top, rect.right, rect.bottom });
+        } else if (inSnapshot) {
+            Invalidate();
+        }
+        break;
+    case EVENT_OBJECT_CREATE:
+        if (IsChild(m_root, hwnd)) {
+            Invalidate();
+        }
+        break;
+    case EVENT_OBJECT_DESTROY:
+    case EVENT_OBJECT_REORDER:
+        if (inSnapshot) {
+            Invalidate();
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+BOOL CALLBACK MeaWindowGeometryCache::EnumChildProc(HWND hwnd, LPARAM lParam) {
+    MeaWindowGeometryCache* cache = reinterpret_cast<MeaWindowGeometryCache*>(lParam);
+
+    RECT rect;
+    if (!GetWindowRect(hwnd, &rect)) {
+        SetRectEmpty(&rect);
+    }
+
+    cache->m_windows.push_back(hwnd);
+    cache->m_rects.push_back(MeaWindowIndex::Rect { rect.left, rect.top, rect.right, rect.bottom });
+    return TRUE;
+}
+
+void CALLBACK MeaWindowGeometryCache::WinEventProc(HWINEVENTHOOK /* hook */, DWORD event, HWND hwnd,
+                                                   LONG idObject, LONG idChild, DWORD /* eventThread */,
+                                                   DWORD /* eventTime */) {
+    if ((m_active != nullptr) && (hwnd != nullptr) && (idObject == OBJID_WINDOW) && (idChild == CHILDID_SELF)) {
+        m_active->OnWindowEvent(event, hwnd);
+    }
+}
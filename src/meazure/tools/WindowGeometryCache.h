@@ -0,0 +1,113 @@
+/*
+ * Copyright 2022 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/// @file
+/// @brief Header file for the cache of window geometry used by the Window tool.
+
+#pragma once
+
+#include <meazure/utilities/WindowIndex.h>
+#include <unordered_map>
+#include <vector>
+
+
+/// Snapshot of the rectangles of the descendants of a window, used by the Window tool to locate the deepest
+/// window under the mouse pointer. Walking the window hierarchy of a complex application on every pointer move
+/// is expensive, so the descendants of the window under the pointer are enumerated once and their rectangles
+/// are placed in a MeaWindowIndex. Subsequent lookups within the same window are answered from the index.
+///
+/// The snapshot is kept current using a WinEvent hook. When a window without children moves or is resized, its
+/// rectangle is updated in the index. Any other change to the windows in the snapshot (a window is created,
+/// destroyed or reordered, or a window with children moves) causes the snapshot to be retaken on the next
+/// lookup. Because events from Meazure's own windows are not monitored, and events can be missed, a snapshot
+/// is also retaken once it reaches a maximum age.
+///
+class MeaWindowGeometryCache {
+
+public:
+    MeaWindowGeometryCache();
+
+    /// Stops monitoring window events.
+    ///
+    ~MeaWindowGeometryCache();
+
+    /// Starts monitoring window events. Must be called before using FindDeepest.
+    ///
+    void Start();
+
+    /// Stops monitoring window events and discards the snapshot.
+    ///
+    void Stop();
+
+    /// Locates the deepest descendant of the specified window that contains the specified point. This is the
+    /// last window containing the point in the order descendants are visited by EnumChildWindows.
+    ///
+    /// @param root     [in] Window whose descendants are searched.
+    /// @param pt       [in] Point to locate, in screen coordinates.
+    ///
+    /// @return Deepest descendant containing the point, or root if no descendant contains it.
+    ///
+    HWND FindDeepest(HWND root, const POINT& pt);
+
+    /// Discards the snapshot so that it is retaken on the next lookup.
+    ///
+    void Invalidate() { m_valid = false; }
+
+private:
+    static constexpr DWORD kMaxAge { 500 };     ///< Maximum age of a snapshot, in milliseconds.
+
+    /// Enumerates the descendants of the specified window and indexes their rectangles.
+    ///
+    /// @param root     [in] Window whose descendants are indexed.
+    ///
+    void Snapshot(HWND root);
+
+    /// Updates the snapshot following a change to a window.
+    ///
+    /// @param event    [in] WinEvent identifier.
+    /// @param hwnd     [in] Window that has changed.
+    ///
+    void OnWindowEvent(DWORD event, HWND hwnd);
+
+    /// Called by the win32 EnumChildWindows function for each descendant of the window being indexed.
+    ///
+    /// @param hwnd     [in] Descendant window.
+    /// @param lParam   [in] <b>this</b> pointer
+    ///
+    /// @return TRUE to continue the enumeration.
+    ///
+    static BOOL CALLBACK EnumChildProc(HWND hwnd, LPARAM lParam);
+
+    /// Called by the OS when a window event occurs. See the win32 WinEventProc documentation.
+    ///
+    static void CALLBACK WinEventProc(HWINEVENTHOOK hook, DWORD event, HWND hwnd, LONG idObject, LONG idChild,
+                                      DWORD eventThread, DWORD eventTime);
+
+
+    static MeaWindowGeometryCache* m_active;    ///< Cache receiving window events, or nullptr.
+
+    HWINEVENTHOOK m_eventHook;                  ///< Window event hook, or nullptr.
+    HWND m_root;                                ///< Window whose descendants are in the snapshot.
+    DWORD m_snapshotTime;                       ///< Tick count when the snapshot was taken.
+    bool m_valid;                               ///< Indicates whether the snapshot can be used.
+    std::vector<HWND> m_windows;                ///< Descendant windows, in enumeration order.
+    std::vector<MeaWindowIndex::Rect> m_rects;  ///< Rectangles of the descendant windows, in enumeration order.
+    std::unordered_map<HWND, int> m_ids;        ///< Index identifier of each descendant window.
+    MeaWindowIndex m_index;                     ///< Spatial index of the descendant window rectangles.
+};
@@ -20,6 +20,7 @@
 #include <meazure/pch.h>
 #include "WindowTool.h"
 #include "ToolMgr.h"
+#include <meazure/position/PositionRecorder.h>
 #include <meazure/utilities/Geometry.h>
 #include <meazure/graphics/Colors.h>
 #include <meazure/resource.h>
@@ -84,8 +85,9 @@ void MeaWindowTool::Enable() {
     //
     m_mgr.SetStatus(IDS_MEA_WIN_STATUS);
 
-    // Start monitoring the mouse pointer.
+    // Start monitoring the mouse pointer and the windows under it.
     //
+    m_geometryCache.Start();
     MeaEnableMouseHook();
 
     // Display the rectangle and data window.
@@ -107,6 +109,8 @@ void MeaWindowTool::Disable() {
         MeaDisableMouseHook();
     assert(ret);
 
+    m_geometryCache.Stop();
+
     m_dataWin.Hide();
     m_rectangle.Hide();
 
@@ -138,13 +142,15 @@ void MeaWindowTool::Update(MeaUpdateReason reason) {
 
         // Display the measurement information.
         //
-        m_mgr.ShowXY1(m_point1, p1);
-        m_mgr.ShowXY2(m_point2, p2);
-        m_mgr.ShowWH(wh);
-        m_mgr.ShowDistance(wh);
-        m_mgr.ShowAngle(MeaGeometry::CalcAngle(p1, p2));
-        m_mgr.ShowAspect(wh);
-        m_mgr.ShowRectArea(wh);
+        MeaMeasurementSnapshot snapshot;
+        snapshot.SetXY1(m_point1, p1)
+                .SetXY2(m_point2, p2)
+                .SetWH(wh)
+                .SetDistance(wh)
+                .SetAngle(m_unitsProvider.ConvertAngle(MeaGeometry::CalcAngle(p1, p2)))
+                .SetAspect(wh)
+                .SetRectArea(wh);
+        m_mgr.ShowMeasurement(snapshot);
 
         // Update the screen information based on the
         // mouse pointer's location.
@@ -187,23 +193,7 @@ const POINT& MeaWindowTool::GetPosition() const {
 }
 
 void MeaWindowTool::RecordPosition(MeaPosition& position) const {
-    // Convert the pixel locations to the current units.
-    //
-    MeaFPoint p1 = m_unitsProvider.ConvertCoord(m_point1);
-    MeaFPoint p2 = m_unitsProvider.ConvertCoord(m_point2);
-    MeaFSize wh = m_unitsProvider.GetWidthHeight(m_point1, m_point2);
-
-    // Save the positions and the name of this tool in the position object.
-    //
-    position.SetToolName(kToolName);
-    position.RecordXY1(p1);
-    position.RecordXY2(p2);
-    position.RecordWH(wh);
-    position.RecordDistance(wh);
-    position.RecordRectArea(wh);
-
-    double angle = MeaGeometry::CalcAngle(p1, p2);
-    position.RecordAngle(m_unitsProvider.ConvertAngle(angle));
+    MeaPositionRecorder::RecordSegment(position, kToolName, m_point1, m_point2, m_unitsProvider);
 }
 
 PCTSTR MeaWindowTool::GetToolName() const {
@@ -245,8 +235,7 @@ bool MeaWindowTool::FindWindow() {
         CWP_SKIPINVISIBLE | CWP_SKIPTRANSPARENT);
 
     if (hWnd2 != nullptr) {
-        m_hiliteWnd = hWnd2;
-        EnumChildWindows(m_hiliteWnd, EnumChildProc, reinterpret_cast<LPARAM>(this));
+        m_hiliteWnd = m_geometryCache.FindDeepest(hWnd2, m_pointerPos);
     }
 
     // If we have found a window, obtain its dimensions.
@@ -274,19 +263,3 @@ bool MeaWindowTool::FindWindow() {
 
     return ret;
 }
-
-BOOL CALLBACK MeaWindowTool::EnumChildProc(HWND hwnd, LPARAM lParam) {
-    MeaWindowTool* tool = reinterpret_cast<MeaWindowTool*>(lParam);
-
-    CRect rect;
-    POINT pt;
-
-    // Determine if the mouse pointer is within the window rectangle.
-    //
-    GetWindowRect(hwnd, rect);
-    GetCursorPos(&pt);
-    if (rect.PtInRect(pt)) {
-        tool->m_hiliteWnd = hwnd;
-    }
-    return TRUE;
-}
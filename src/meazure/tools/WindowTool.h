@@ -23,6 +23,7 @@
 #pragma once
 
 #include "RadioTool.h"
+#include "WindowGeometryCache.h"
 #include <meazure/graphics/Rectangle.h>
 #include <meazure/ui/DataWin.h>
 #include <meazure/position/Position.h>
@@ -144,17 +145,6 @@ public:
     virtual void ColorsChanged() override;
 
 private:
-    /// Called by the win32 EnumChildWindows function when it enumerates
-    /// child windows. Also tests to see if the child window is under the
-    /// cursor.
-    ///
-    /// @param hwnd     [in] Child window to test
-    /// @param lParam   [in] <b>this</b> pointer
-    ///
-    /// @return TRUE if enumeration should continue.
-    ///
-    static BOOL CALLBACK EnumChildProc(HWND hwnd, LPARAM lParam);
-
     /// Creates the tool's graphical components. The components include
     /// the window rectangle and the data window. The Enable() method must
     /// be called to make the tool visible.
@@ -163,6 +153,8 @@ private:
 
     /// Attempts to locate a window under the mouse pointer. The window
     /// hierarchy is searched to identify the deepest window in the hierarchy.
+    /// The descendants of the window under the pointer are located using
+    /// the window geometry cache rather than by enumerating them each time.
     ///
     /// @return <b>true</b> if the pointer has moved over a new window.
     ///
@@ -176,4 +168,5 @@ private:
     HWND m_currentWnd;          ///< Window currently highlighted
     HWND m_hiliteWnd;           ///< Window to highlight
     MeaDataWin m_dataWin;       ///< Data window tooltip
+    MeaWindowGeometryCache m_geometryCache;     ///< Descendant windows of the window under the pointer
 };
@@ -20,7 +20,7 @@
 #include <meazure/pch.h>
 #include "AppFrame.h"
 #include <meazure/resource.h>
-#include <meazure/profile/RegistryProfile.h>
+#include <meazure/profile/CachedRegistryProfile.h>
 #include <meazure/prefs/Preferences.h>
 #include "Layout.h"
 #include "ScreenMgr.h"
@@ -117,7 +117,7 @@ int AppFrame::OnCreate(LPCREATESTRUCT lpCreateStruct) {
     // Restore the state of the program from the registry.
     //
     MeaRegistry registry;
-    MeaRegistryProfile profile(registry);
+    MeaCachedRegistryProfile profile(registry);
     LoadProfile(profile);
 
     // Tell everyone to initialize its view
@@ -354,7 +354,7 @@ void AppFrame::OnReportIssue() {
 void AppFrame::OnEndSession(BOOL bEnding) {
     if (bEnding) {
         MeaRegistry registry;
-        MeaRegistryProfile profile(registry);
+        MeaCachedRegistryProfile profile(registry);
         SaveProfile(profile);
     }
 
@@ -363,7 +363,7 @@ void AppFrame::OnEndSession(BOOL bEnding) {
 
 void AppFrame::OnClose() {
     MeaRegistry registry;
-    MeaRegistryProfile profile(registry);
+    MeaCachedRegistryProfile profile(registry);
     SaveProfile(profile);
 
     CFrameWnd::OnClose();
@@ -50,11 +50,13 @@ BEGIN_MESSAGE_MAP(AppView, CWnd)
     ON_COMMAND_RANGE(ID_MEA_DEGREES, ID_MEA_RADIANS, OnAngles)
     ON_COMMAND_RANGE(ID_MEA_CURSOR, ID_MEA_WINDOW, OnRadioTool)
     ON_COMMAND_RANGE(ID_MEA_RGBFMT, ID_MEA_EXTHEXFMT, OnColorFmt)
+    ON_COMMAND_RANGE(ID_MEA_SAMPLE1, ID_MEA_SAMPLE9, OnColorSample)
     ON_MESSAGE(MeaDataChangeMsg, OnDataChange)
     ON_MESSAGE(MeaPrefsApplyMsg, OnPrefsApply)
     ON_MESSAGE(MeaShowCalPrefsMsg, OnShowCalPrefs)
     ON_MESSAGE(MeaGetPositionMsg, OnGetPosition)
     ON_MESSAGE(MeaHPTimerMsg, OnHPTimer)
+    ON_MESSAGE(MeaFrameMsg, OnFrame)
     ON_WM_CREATE()
     ON_UPDATE_COMMAND_UI(ID_MEA_UNITS_CM, OnUpdateUnits)
     ON_UPDATE_COMMAND_UI(ID_MEA_DEGREES, OnUpdateAngles)
@@ -106,6 +108,8 @@ BEGIN_MESSAGE_MAP(AppView, CWnd)
     ON_COMMAND(ID_MEA_SAVE_POSITIONS, OnSavePositions)
     ON_COMMAND(ID_MEA_SAVE_POSITIONS_AS, OnSavePositionsAs)
     ON_UPDATE_COMMAND_UI(ID_MEA_SAVE_POSITIONS, OnUpdateSavePositions)
+    ON_COMMAND(ID_MEA_EXPORT_POSITIONS, OnExportPositions)
+    ON_UPDATE_COMMAND_UI(ID_MEA_EXPORT_POSITIONS, OnUpdateSavePositions)
     ON_COMMAND(ID_MEA_MANAGE_POSITIONS, OnManagePositions)
     ON_COMMAND(ID_MEA_ZOOM_IN, OnZoomIn)
     ON_UPDATE_COMMAND_UI(ID_MEA_ZOOM_IN, OnUpdateZoomIn)
@@ -137,6 +141,10 @@ BEGIN_MESSAGE_MAP(AppView, CWnd)
     ON_UPDATE_COMMAND_UI(ID_MEA_BASICHEXFMT, OnUpdateColorFmt)
     ON_UPDATE_COMMAND_UI(ID_MEA_EXTNAMEFMT, OnUpdateColorFmt)
     ON_UPDATE_COMMAND_UI(ID_MEA_EXTHEXFMT, OnUpdateColorFmt)
+    ON_UPDATE_COMMAND_UI(ID_MEA_SAMPLE1, OnUpdateColorSample)
+    ON_UPDATE_COMMAND_UI(ID_MEA_SAMPLE3, OnUpdateColorSample)
+    ON_UPDATE_COMMAND_UI(ID_MEA_SAMPLE5, OnUpdateColorSample)
+    ON_UPDATE_COMMAND_UI(ID_MEA_SAMPLE9, OnUpdateColorSample)
     ON_UPDATE_COMMAND_UI(ID_MEA_UNITS_PICAS, OnUpdateUnits)
     ON_UPDATE_COMMAND_UI(ID_MEA_SAVE_POSITIONS_AS, OnUpdateSavePositions)
     ON_COMMAND(ID_MEA_UNITS_CUSTOM, OnCustomUnits)
@@ -360,6 +368,7 @@ int AppView::OnCreate(LPCREATESTRUCT lpCreateStruct) {
     m_snapshotTimer.Create(this);
 
     MeaToolMgr& toolMgr = MeaToolMgr::Instance();
+    toolMgr.StartFramePacing(this);
 
     // Display screen information
     //
@@ -720,6 +729,48 @@ void AppView::OnColorFmt(UINT nID) {
     }
 }
 
+void AppView::OnUpdateColorSample(CCmdUI* pCmdUI) {
+    pCmdUI->Enable();
+
+    switch (pCmdUI->m_nID) {
+    case ID_MEA_SAMPLE1:
+        pCmdUI->SetRadio(m_magnifier.GetSampleSize() == 1);
+        break;
+    case ID_MEA_SAMPLE3:
+        pCmdUI->SetRadio(m_magnifier.GetSampleSize() == 3);
+        break;
+    case ID_MEA_SAMPLE5:
+        pCmdUI->SetRadio(m_magnifier.GetSampleSize() == 5);
+        break;
+    case ID_MEA_SAMPLE9:
+        pCmdUI->SetRadio(m_magnifier.GetSampleSize() == 9);
+        break;
+    default:
+        assert(false);
+        break;
+    }
+}
+
+void AppView::OnColorSample(UINT nID) {
+    switch (nID) {
+    case ID_MEA_SAMPLE1:
+        m_magnifier.SetSampleSize(1);
+        break;
+    case ID_MEA_SAMPLE3:
+        m_magnifier.SetSampleSize(3);
+        break;
+    case ID_MEA_SAMPLE5:
+        m_magnifier.SetSampleSize(5);
+        break;
+    case ID_MEA_SAMPLE9:
+        m_magnifier.SetSampleSize(9);
+        break;
+    default:
+        assert(false);
+        break;
+    }
+}
+
 void AppView::OnInvertY() {
     MeaUnitsMgr::Instance().SetInvertY(!MeaUnitsMgr::Instance().IsInvertY());
     MeaToolMgr::Instance().UpdateTools();
@@ -779,6 +830,10 @@ void AppView::OnSavePositionsAs() {
     MeaPositionLogMgr::Instance().Save(true);
 }
 
+void AppView::OnExportPositions() {
+    MeaPositionLogMgr::Instance().Export();
+}
+
 void AppView::OnUpdateSavePositions(CCmdUI* pCmdUI) {
     pCmdUI->Enable(MeaPositionLogMgr::Instance().HavePositions());
 }
@@ -1069,6 +1124,7 @@ LRESULT AppView::OnDataChange(WPARAM wParam, LPARAM lParam) {
 }
 
 void AppView::OnDestroy() {
+    MeaToolMgr::Instance().StopFramePacing();
     MeaToolMgr::Instance().DisableRadioTools();
     m_magnifier.Disable();
     CWnd::OnDestroy();
@@ -1289,6 +1345,11 @@ void AppView::OnCopyRegion() {
     }
 }
 
+LRESULT AppView::OnFrame(WPARAM, LPARAM) {
+    MeaToolMgr::Instance().OnFrame();
+    return 0;
+}
+
 LRESULT AppView::OnHPTimer(WPARAM, LPARAM) {
     // Get the screen region to copy.
     //
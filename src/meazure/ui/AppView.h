@@ -138,6 +138,12 @@ protected:
     /// 
     afx_msg void OnColorFmt(UINT nID);
 
+    /// Called when a new color sample size is requested.
+    /// 
+    /// @param nID      [in] ID of the color sample menu item.
+    /// 
+    afx_msg void OnColorSample(UINT nID);
+
     /// Called when data is entered into a field in the data display or
     /// a spin button is used. Tells the current tool to set a new position.
     /// 
@@ -181,6 +187,15 @@ protected:
     /// 
     afx_msg LRESULT OnHPTimer(WPARAM wParam, LPARAM lParam);
 
+    /// Called at the start of a display frame when tool windows
+    /// are waiting to be moved or repainted.
+    /// 
+    /// @param wParam   [in] Not used
+    /// @param lParam   [in] Not used.
+    /// @return Always returns 0.
+    /// 
+    afx_msg LRESULT OnFrame(WPARAM wParam, LPARAM lParam);
+
     /// Creates the view and the data display. Also enables the
     /// appropriate tools.
     /// 
@@ -353,6 +368,12 @@ protected:
     /// 
     afx_msg void OnUpdateColorFmt(CCmdUI* pCmdUI);
 
+    /// Updates the state of the color sample size menu item before it is displayed.
+    /// 
+    /// @param pCmdUI   [in] UI command object for updating the menu item.
+    /// 
+    afx_msg void OnUpdateColorSample(CCmdUI* pCmdUI);
+
     /// Called to toggle between paused and running states on the magnifier window.
     /// 
     afx_msg void OnRunState();
@@ -460,6 +481,10 @@ protected:
     /// 
     afx_msg void OnSavePositionsAs();
 
+    /// Called to export the positions to a CSV file.
+    /// 
+    afx_msg void OnExportPositions();
+
     /// Called to update the state of the position save menu items. If there are
     /// no positions currently in memory, the menu items are disabled.
     /// 
@@ -22,7 +22,7 @@
 #include "Layout.h"
 #include "ScreenMgr.h"
 #include <meazure/resource.h>
-#include <meazure/utilities/NumericUtils.h>
+#include <meazure/utilities/NumberFormat.h>
 #include <meazure/utilities/Geometry.h>
 #include <stdio.h>
 #include <AfxPriv.h>
@@ -445,69 +445,78 @@ void MeaDataDisplay::Disable(MeaSection section) {
     }
 }
 
-void MeaDataDisplay::ShowXY1(const POINT& point, const MeaFPoint& cpoint) {
+void MeaDataDisplay::ShowMeasurement(const MeaMeasurementSnapshot& snapshot) {
     MeaUnitsMgr& unitsMgr = MeaUnitsMgr::Instance();
+    const MeaUnits::DisplayPrecisions& linearPrecisions = unitsMgr.GetLinearUnits()->GetDisplayPrecisions();
+    const MeaUnits::DisplayPrecisions& angularPrecisions = unitsMgr.GetAngularUnits()->GetDisplayPrecisions();
+
+    MeaDataPresenter::Precisions precisions {};
+    auto setPrecision = [&precisions](MeaDataFieldId fieldId, int precision) {
+        precisions[MeaMeasurementSnapshot::FieldIndex(fieldId)] = precision;
+    };
+    setPrecision(MeaX1Field, linearPrecisions[MeaX]);
+    setPrecision(MeaY1Field, linearPrecisions[MeaY]);
+    setPrecision(MeaX2Field, linearPrecisions[MeaX]);
+    setPrecision(MeaY2Field, linearPrecisions[MeaY]);
+    setPrecision(MeaXVField, linearPrecisions[MeaX]);
+    setPrecision(MeaYVField, linearPrecisions[MeaY]);
+    setPrecision(MeaWidthField, linearPrecisions[MeaW]);
+    setPrecision(MeaHeightField, linearPrecisions[MeaH]);
+    setPrecision(MeaDistanceField, linearPrecisions[MeaD]);
+    setPrecision(MeaAngleField, angularPrecisions[MeaA]);
+    setPrecision(MeaAspectField, kAspectPrecision);
+    setPrecision(MeaAreaField, linearPrecisions[MeaAr]);
+
+    MeaDataPresenter::Changes changes = m_presenter.Present(snapshot, precisions);
+    MeaNumberFormat::Buffer buffer;
+
+    for (unsigned int fields = changes.m_text | changes.m_pixels; fields != 0; fields &= fields - 1) {
+        MeaDataFieldId fieldId = static_cast<MeaDataFieldId>(fields & (~fields + 1));
+        DataItem* item = GetRegionItem(fieldId);
+        if (item == nullptr) {
+            continue;
+        }
 
-    m_x1.SetSpinPos(point.x);
-    m_y1.SetSpinPos(point.y);
-
-    m_x1.SetText(unitsMgr.Format(MeaX, cpoint.x));
-    m_y1.SetText(unitsMgr.Format(MeaY, cpoint.y));
-}
-
-void MeaDataDisplay::ShowXY2(const POINT& point, const MeaFPoint& cpoint) {
-    MeaUnitsMgr& unitsMgr = MeaUnitsMgr::Instance();
-
-    m_x2.SetSpinPos(point.x);
-    m_y2.SetSpinPos(point.y);
-
-    m_x2.SetText(unitsMgr.Format(MeaX, cpoint.x));
-    m_y2.SetText(unitsMgr.Format(MeaY, cpoint.y));
-}
-
-void MeaDataDisplay::ShowXYV(const POINT& point, const MeaFPoint& cpoint) {
-    MeaUnitsMgr& unitsMgr = MeaUnitsMgr::Instance();
-
-    m_xv.SetSpinPos(point.x);
-    m_yv.SetSpinPos(point.y);
-
-    m_xv.SetText(unitsMgr.Format(MeaX, cpoint.x));
-    m_yv.SetText(unitsMgr.Format(MeaY, cpoint.y));
-}
-
-void MeaDataDisplay::ShowWH(const MeaFSize& size) {
-    MeaUnitsMgr& unitsMgr = MeaUnitsMgr::Instance();
-
-    m_width.SetText(unitsMgr.Format(MeaW, size.cx));
-    m_height.SetText(unitsMgr.Format(MeaH, size.cy));
-}
-
-void MeaDataDisplay::ShowDistance(const MeaFSize& size) {
-    m_length.SetText(MeaUnitsMgr::Instance().Format(MeaD, MeaGeometry::CalcLength(size.cx, size.cy)));
-}
-
-void MeaDataDisplay::ShowDistance(double dist) {
-    m_length.SetText(MeaUnitsMgr::Instance().Format(MeaD, dist));
-}
-
-void MeaDataDisplay::ShowAngle(double angle) {
-    m_angle.SetText(MeaUnitsMgr::Instance().FormatConvertAngle(angle));
-}
-
-void MeaDataDisplay::ShowAspect(const MeaFSize& size) {
-    double aspectRatio = (size.cy == 0) ? 0.0 : ((double)size.cx / (double)size.cy);
-
-    CString vstr;
-    vstr.Format(_T("%0.*f"), kAspectPrecision, aspectRatio);
-    m_aspect.SetText(vstr);
-}
-
-void MeaDataDisplay::ShowRectArea(const MeaFSize& size) {
-    m_area.SetText(MeaUnitsMgr::Instance().Format(MeaAr, size.cx * size.cy));
+        if ((changes.m_pixels & fieldId) != 0) {
+            item->SetSpinPos(snapshot.GetPixels(fieldId));
+        }
+        if ((changes.m_text & fieldId) != 0) {
+            int precision = precisions[MeaMeasurementSnapshot::FieldIndex(fieldId)];
+            std::string_view vstr = MeaNumberFormat::FormatFixed(buffer, snapshot.GetValue(fieldId), precision);
+            item->SetText(CString(vstr.data(), static_cast<int>(vstr.size())));
+        }
+    }
 }
 
-void MeaDataDisplay::ShowCircleArea(double radius) {
-    m_area.SetText(MeaUnitsMgr::Instance().Format(MeaAr, MeaNumericUtils::PI * radius * radius));
+MeaDataDisplay::DataItem* MeaDataDisplay::GetRegionItem(MeaDataFieldId fieldId) {
+    switch (fieldId) {
+    case MeaX1Field:
+        return &m_x1;
+    case MeaY1Field:
+        return &m_y1;
+    case MeaX2Field:
+        return &m_x2;
+    case MeaY2Field:
+        return &m_y2;
+    case MeaXVField:
+        return &m_xv;
+    case MeaYVField:
+        return &m_yv;
+    case MeaWidthField:
+        return &m_width;
+    case MeaHeightField:
+        return &m_height;
+    case MeaDistanceField:
+        return &m_length;
+    case MeaAngleField:
+        return &m_angle;
+    case MeaAspectField:
+        return &m_aspect;
+    case MeaAreaField:
+        return &m_area;
+    default:
+        return nullptr;
+    }
 }
 
 void MeaDataDisplay::ShowScreenName(const CString& name) {
@@ -556,6 +565,8 @@ void MeaDataDisplay::EnableRegionFields(UINT enableFields, UINT editableFields)
     m_angle.Enable((enableFields & MeaAngleField) != 0);
     m_aspect.Enable((enableFields & MeaAspectField) != 0);
     m_area.Enable((enableFields & MeaAreaField) != 0);
+
+    m_presenter.Invalidate();
 }
 
 void MeaDataDisplay::EnableScreenFields(UINT enableFields, UINT editableFields) {
@@ -649,6 +660,9 @@ LRESULT MeaDataDisplay::OnFieldEntry(WPARAM wParam, LPARAM id) {
         break;
     }
 
+    // The field now shows what the user typed, so have the tool's next snapshot redisplay it.
+    m_presenter.Invalidate(static_cast<unsigned int>(id));
+
     GetParent()->SendMessage(MeaDataChangeMsg, static_cast<WPARAM>(pixels) + wParam, id);
     assert(field != nullptr);
     const_cast<MeaNumberField*>(field)->SetFocus();
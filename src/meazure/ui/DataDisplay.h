@@ -27,6 +27,8 @@
 #include "Label.h"
 #include "Themes.h"
 #include "ImageButton.h"
+#include "MeasurementSnapshot.h"
+#include "DataPresenter.h"
 #include <meazure/Messages.h>
 #include <meazure/profile/Profile.h>
 #include <meazure/units/UnitsMgr.h>
@@ -205,58 +207,12 @@ public:
             m_regionSectionRect.Height() : m_screenSectionRect.Height() + m_sectionSpacing);
     }
 
-    /// Displays the specified X1, Y1 coordinates.
-    /// @param point    [in] Coordinates, in pixels.
-    /// @param cpoint   [in] Coordinates, in current units.
-    /// 
-    void ShowXY1(const POINT& point, const MeaFPoint& cpoint);
-
-    /// Displays the specified X2, Y2 coordinates.
-    /// @param point    [in] Coordinates, in pixels.
-    /// @param cpoint   [in] Coordinates, in current units.
-    /// 
-    void ShowXY2(const POINT& point, const MeaFPoint& cpoint);
-
-    /// Displays the specified vertex or center X, Y coordinates.
-    /// @param point    [in] Coordinates, in pixels.
-    /// @param cpoint   [in] Coordinates, in current units.
-    /// 
-    void ShowXYV(const POINT& point, const MeaFPoint& cpoint);
-
-    /// Displays the specified width and height.
-    /// @param size     [in] Width and height, in current units.
-    /// 
-    void ShowWH(const MeaFSize& size);
-
-    /// Displays a diagonal distance calculated from the specified width and height.
-    /// @param size     [in] Width and height, in current units.
-    /// 
-    void ShowDistance(const MeaFSize& size);
-
-    /// Displays the specified distance.
-    /// @param dist     [in] Distance, in current units.
-    /// 
-    void ShowDistance(double dist);
-
-    /// Displays the specified angle.
-    /// @param angle    [in] Angle, in current angular units.
-    /// 
-    void ShowAngle(double angle);
-
-    /// Displays the aspect ratio of the specified width and height (i.e. width/height).
-    /// @param size    [in] Width and height, in current units.
-    /// 
-    void ShowAspect(const MeaFSize& size);
-
-    /// Displays the rectangular area calculated from the specified width and height.
-    /// @param size     [in] Width and height, in current units.
-    /// 
-    void ShowRectArea(const MeaFSize& size);
-
-    /// Displays the circular area calculated from the specified radius.
-    /// @param radius   [in] Radius, in current units.
-    /// 
-    void ShowCircleArea(double radius);
+    /// Displays the measurement values in the specified snapshot. Only the
+    /// fields whose displayed text changes are formatted and updated.
+    ///
+    /// @param snapshot     [in] Values to display, in current units.
+    ///
+    void ShowMeasurement(const MeaMeasurementSnapshot& snapshot);
 
     /// Displays the specified string as the name for the current monitor.
     /// This helps identify the screen information in multiple monitor
@@ -564,6 +520,14 @@ private:
     ///
     bool CreateScreenSection();
 
+    /// Obtains the Region section data item for the specified field.
+    ///
+    /// @param fieldId  [in] Field whose data item is to be obtained.
+    ///
+    /// @return Data item for the field, or nullptr if the field is not in the Region section.
+    ///
+    DataItem* GetRegionItem(MeaDataFieldId fieldId);
+
 
     MeaDataSection m_regionSection;     ///< Measurement tool display section.
     MeaDataSection m_screenSection;     ///< Screen information display section.
@@ -597,4 +561,5 @@ private:
     DataItem m_screenResY;              ///< Screen Y resolution data item.
     MeaImageButton m_calBtn;            ///< Calibration warning button.
     Fields m_fields;                    ///< Set of all text fields.
+    MeaDataPresenter m_presenter;       ///< Determines which Region section fields need updating.
 };
@@ -0,0 +1,59 @@
+/*
+ * Copyright 2022 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <meazure/pch.h>
+#include "DataPresenter.h"
+#include <meazure/utilities/NumberFormat.h>
+
+
+MeaDataPresenter::MeaDataPresenter() : m_textValid(0), m_pixelsValid(0), m_values(), m_precisions(), m_pixels() {}
+
+MeaDataPresenter::Changes MeaDataPresenter::Present(const MeaMeasurementSnapshot& snapshot,
+                                                    const Precisions& precisions) {
+    Changes changes { 0, 0 };
+
+    for (unsigned int fields = snapshot.GetFields(); fields != 0; fields &= fields - 1) {
+        MeaDataFieldId fieldId = static_cast<MeaDataFieldId>(fields & (~fields + 1));
+        int index = MeaMeasurementSnapshot::FieldIndex(fieldId);
+        double value = snapshot.GetValue(fieldId);
+        int precision = precisions[index];
+
+        if ((m_textValid & fieldId) == 0 || m_precisions[index] != precision ||
+                !MeaNumberFormat::SameFixed(m_values[index], value, precision)) {
+            changes.m_text |= fieldId;
+            m_precisions[index] = precision;
+            m_textValid |= fieldId;
+        }
+
+        // Values within the same rounding interval display the same text, so tracking the latest value is
+        // equivalent to tracking the displayed one.
+        m_values[index] = value;
+
+        if ((fieldId & MeaMeasurementSnapshot::kCoordinateFields) != 0) {
+            int pixels = snapshot.GetPixels(fieldId);
+            if ((m_pixelsValid & fieldId) == 0 || m_pixels[index] != pixels) {
+                changes.m_pixels |= fieldId;
+                m_pixels[index] = pixels;
+                m_pixelsValid |= fieldId;
+            }
+        }
+    }
+
+    return changes;
+}
@@ -0,0 +1,80 @@
+/*
+ * Copyright 2022 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/// @file
+/// @brief Header file for the class that decides which data display fields need to be redrawn.
+
+#pragma once
+
+#include "MeasurementSnapshot.h"
+#include <array>
+
+
+/// Compares each measurement snapshot with the previously presented snapshot to determine which fields of the data
+/// display must be updated. A field needs its text updated only if the text it would display differs from the text
+/// currently displayed. Because field values are displayed with a fixed number of decimal places, this is decided
+/// numerically using MeaNumberFormat::SameFixed, so fields that do not change are neither formatted nor sent to
+/// their controls.
+///
+/// The presenter does not know the actual contents of the controls. If a control's text is changed by other means
+/// (e.g. the user edits a field), the field must be invalidated so that it is updated by the next snapshot.
+///
+class MeaDataPresenter {
+
+public:
+    /// Number of decimal places displayed for each field, indexed by MeaMeasurementSnapshot::FieldIndex.
+    ///
+    typedef std::array<int, MeaMeasurementSnapshot::kFieldCount> Precisions;
+
+    /// Fields that must be updated to display a snapshot.
+    ///
+    struct Changes {
+        unsigned int m_text;        ///< Mask of the fields whose text must be updated.
+        unsigned int m_pixels;      ///< Mask of the coordinate fields whose spin control position must be updated.
+    };
+
+
+    MeaDataPresenter();
+
+    /// Determines which fields must be updated to display the specified snapshot and records the snapshot as the
+    /// one presented.
+    ///
+    /// @param snapshot     [in] Values to display.
+    /// @param precisions   [in] Number of decimal places displayed for each field.
+    ///
+    /// @return Fields that must be updated.
+    ///
+    Changes Present(const MeaMeasurementSnapshot& snapshot, const Precisions& precisions);
+
+    /// Forgets the presented values of the specified fields so that they are updated by the next snapshot.
+    ///
+    /// @param fields   [in] Mask of MeaDataFieldId values to invalidate. By default, all fields are invalidated.
+    ///
+    void Invalidate(unsigned int fields = ~0U) {
+        m_textValid &= ~fields;
+        m_pixelsValid &= ~fields;
+    }
+
+private:
+    unsigned int m_textValid;                               ///< Fields whose presented value is known.
+    unsigned int m_pixelsValid;                             ///< Fields whose presented position is known.
+    double m_values[MeaMeasurementSnapshot::kFieldCount];   ///< Presented values.
+    int m_precisions[MeaMeasurementSnapshot::kFieldCount];  ///< Precisions with which the values were presented.
+    int m_pixels[MeaMeasurementSnapshot::kFieldCount];      ///< Presented coordinate field positions.
+};
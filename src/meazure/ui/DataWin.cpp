@@ -20,6 +20,7 @@
 #include <meazure/pch.h>
 #include "DataWin.h"
 #include "LayeredWindows.h"
+#include <meazure/graphics/FramePacer.h>
 #include <meazure/tools/ToolMgr.h>
 #include <meazure/ui/Layout.h>
 #include <meazure/utilities/Geometry.h>
@@ -43,6 +44,7 @@ MeaDataWin::MeaDataWin(const MeaScreenProvider& screenProvider, const MeaUnitsPr
     m_screenProvider(screenProvider),
     m_unitsProvider(unitsProvider),
     m_parent(nullptr),
+    m_composited(false),
     m_textHeight(0),
     m_winHeight(0),
     m_dataOffset(0),
@@ -77,10 +79,16 @@ bool MeaDataWin::Create(BYTE opacity,
                         const CWnd* parent) {
     m_parent = parent;
 
+    // Floating data windows are presented as layered windows using
+    // per-pixel alpha, so they are rendered only when the data they
+    // display changes. Moving them does not require repainting.
+    //
+    m_composited = HaveLayeredWindows() && (parent == nullptr);
+
     // Create the window.
     //
     bool ret = CreateEx(
-                    (HaveLayeredWindows() && (parent == nullptr)) ? WS_EX_LAYERED : 0,
+                    m_composited ? WS_EX_LAYERED : 0,
                     AfxRegisterWndClass(CS_HREDRAW | CS_VREDRAW, 0),
                     "",
                     ((parent == nullptr) ? WS_POPUP : WS_CHILD) | WS_BORDER,
@@ -192,14 +200,22 @@ bool MeaDataWin::Create(BYTE opacity,
 }
 
 void MeaDataWin::OnDestroy() {
+    MeaFramePacer::Forget(*this);
     CWnd::OnDestroy();
 
+    m_surface.Free();
     m_font.DeleteObject();
 }
 
 void MeaDataWin::Show() {
     if ((m_armed || (m_parent != nullptr)) && (m_hWnd != nullptr)) {
         SetWindowPos(nullptr, 0, 0, CalcWidth(), m_winHeight, SWP_NOMOVE | SWP_NOZORDER | SWP_NOACTIVATE);
+        if (m_composited) {
+            Render();
+        }
+        if (!IsWindowVisible()) {
+            MeaFramePacer::Flush();
+        }
         ShowWindow(SW_SHOWNOACTIVATE);
     }
 }
@@ -208,8 +224,7 @@ void MeaDataWin::Strobe() {
     if (m_hWnd && IsWindowVisible()) {
         m_flashCount = 1;
         m_drawState = Inverted;
-        Invalidate(FALSE);
-        UpdateWindow();
+        Redraw();
         SetTimer(ID_MEA_DATAWIN_TIMER, m_flashInterval, nullptr);
     }
 }
@@ -218,7 +233,13 @@ void MeaDataWin::SetOpacity(BYTE opacity) {
     m_opacity = opacity;
 
     if (m_hWnd != nullptr) {
-        if (m_parent == nullptr) {
+        if (m_composited) {
+            // The content is unchanged, so it only needs to be composed
+            // again with the new opacity.
+            if (m_surface.IsAllocated()) {
+                Present();
+            }
+        } else if (m_parent == nullptr) {
             SetLayeredWindowAttributes(*this, 0, opacity, LWA_ALPHA);
         } else {
             Invalidate(FALSE);
@@ -297,10 +318,17 @@ void MeaDataWin::Update(const CRect& rect) {
             x -= winRect.Width();
         }
 
-        SetWindowPos(nullptr, x, y, 0, 0, SWP_NOSIZE | SWP_NOZORDER | SWP_NOACTIVATE);
+        // The move and repaint are applied at the next display frame, together with the tool's crosshairs.
+        MeaFramePacer::Move(*this, x, y);
 
-        Invalidate(FALSE);
-        UpdateWindow();
+        if (m_composited) {
+            if (GetDisplayedData() != m_renderedData) {
+                Render();
+            }
+        } else {
+            Invalidate(FALSE);
+            MeaFramePacer::Repaint(*this);
+        }
     }
 }
 
@@ -343,6 +371,57 @@ void MeaDataWin::OnPaint() {
     }
 }
 
+void MeaDataWin::Redraw() {
+    if (m_composited) {
+        Render();
+    } else {
+        Invalidate(FALSE);
+        UpdateWindow();
+    }
+}
+
+void MeaDataWin::Render() {
+    CRect winRect;
+    GetWindowRect(winRect);
+    if (!m_surface.Allocate(winRect.Size())) {
+        return;
+    }
+
+    // The layered window image includes the nonclient area, so the
+    // border is drawn along with the client area.
+    //
+    CDC& dc = m_surface.GetContentDC();
+    CRect clientRect;
+    GetClientRect(clientRect);
+    ClientToScreen(clientRect);
+
+    CBrush borderBrush;
+    borderBrush.CreateSysColorBrush(COLOR_WINDOWFRAME);
+    dc.FrameRect(CRect(CPoint(0, 0), winRect.Size()), &borderBrush);
+
+    CPoint origOrigin = dc.SetViewportOrg(clientRect.TopLeft() - winRect.TopLeft());
+    DrawWin(dc);
+    dc.SetViewportOrg(origOrigin);
+    m_surface.Flush();
+
+    m_renderedData = GetDisplayedData();
+
+    Present();
+}
+
+void MeaDataWin::Present() {
+    MeaLayeredRaster::ApplyOpacity(m_surface.GetImage(), m_surface.GetContent(), m_opacity);
+    m_surface.Present(*this);
+}
+
+CString MeaDataWin::GetDisplayedData() const {
+    CString data;
+    data.Format(_T("%s\n%s\n%s\n%s\n%s\n%s\n%d"), static_cast<PCTSTR>(m_xData), static_cast<PCTSTR>(m_yData),
+                static_cast<PCTSTR>(m_wData), static_cast<PCTSTR>(m_hData), static_cast<PCTSTR>(m_dData),
+                static_cast<PCTSTR>(m_aData), static_cast<int>(m_drawState));
+    return data;
+}
+
 void MeaDataWin::DrawWin(CDC& dc) {
     CRect clientRect;
     bool haveLine = false;
@@ -410,8 +489,7 @@ void MeaDataWin::DrawWin(CDC& dc) {
 void MeaDataWin::OnTimer(UINT_PTR timerId) {
     KillTimer(timerId);
     m_drawState = (m_drawState == Normal) ? Inverted : Normal;
-    Invalidate(FALSE);
-    UpdateWindow();
+    Redraw();
     if (--m_flashCount > 0) {
         SetTimer(timerId, m_flashInterval, nullptr);
     }
@@ -22,6 +22,8 @@
 
 #pragma once
 
+#include <meazure/graphics/CrossHair.h>
+#include <meazure/graphics/LayeredSurface.h>
 #include <meazure/profile/Profile.h>
 #include <meazure/utilities/Geometry.h>
 #include "ScreenProvider.h"
@@ -131,13 +133,11 @@ public:
 
     /// Displays the currently set data in the window.
     ///
-    /// @param centerWin    [in] The data window is displayed
-    ///                     adjacent to a corner of this window.
+    /// @param crossHair    [in] The data window is displayed adjacent
+    ///                     to a corner of this crosshair.
     ///
-    void Update(const CWnd& centerWin) {
-        CRect rect;
-        centerWin.GetWindowRect(rect);
-        Update(rect);
+    void Update(const MeaCrossHair& crossHair) {
+        Update(crossHair.GetTargetRect());
     }
 
     /// Displays the currently set data in the window.
@@ -255,6 +255,31 @@ private:
     ///
     void DrawWin(CDC& dc);
 
+    /// Updates the appearance of the data window. A data window
+    /// presented as a layered window is rendered and presented
+    /// immediately. Otherwise, the window is repainted.
+    ///
+    void Redraw();
+
+    /// Draws the data window, including its border, into its layered
+    /// window buffer and presents it. Used when the data window is
+    /// presented as a layered window.
+    ///
+    void Render();
+
+    /// Composes the previously rendered data window content with the
+    /// window opacity and presents it as the layered window image.
+    ///
+    void Present();
+
+    /// Obtains the data that determines the appearance of the window.
+    /// Used to avoid rendering the layered window when the displayed
+    /// data has not changed.
+    ///
+    /// @return Displayed data and draw state.
+    ///
+    CString GetDisplayedData() const;
+
 
     const MeaScreenProvider& m_screenProvider;  ///< Screen information provider
     const MeaUnitsProvider& m_unitsProvider;    ///< Units information provider
@@ -271,6 +296,8 @@ private:
     CString m_dData;                            ///< Distance data converted to a string.
     CString m_aData;                            ///< Angle data converted to a string.
     const CWnd* m_parent;                       ///< Parent window or nullptr if data window is floating.
+    bool m_composited;                          ///< Indicates if the window is presented as a layered window
+                                                ///< using per-pixel alpha.
     CFont m_font;                               ///< Font for the data display.
     LONG m_textHeight;                          ///< Height of the text, in pixels.
     LONG m_winHeight;                           ///< Height of the data window, in pixels.
@@ -278,4 +305,6 @@ private:
     DrawState m_drawState;                      ///< Indicates how the data window should be drawn.
     int m_flashCount;                           ///< Window flash interval, in milliseconds.
     BYTE m_opacity;                             ///< Data window opacity, 0 (transparent) to 255 (opaque).
+    MeaLayeredSurface m_surface;                ///< Buffers for presenting the window as a layered window.
+    CString m_renderedData;                     ///< Data displayed by the layered window image.
 };
@@ -0,0 +1,99 @@
+/*
+ * Copyright 2022 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <meazure/pch.h>
+#include "DibSurface.h"
+#include <cassert>
+
+
+MeaDibSurface::MeaDibSurface() :
+    m_memDC(nullptr),
+    m_bitmap(nullptr),
+    m_oldBitmap(nullptr),
+    m_bits(nullptr),
+    m_width(0),
+    m_height(0) {}
+
+MeaDibSurface::~MeaDibSurface() {
+    Release();
+}
+
+bool MeaDibSurface::Reserve(HDC hDC, int width, int height) {
+    if (m_memDC != nullptr && width <= m_width && height <= m_height) {
+        return true;
+    }
+
+    Release();
+
+    m_memDC = ::CreateCompatibleDC(hDC);
+    if (m_memDC == nullptr) {
+        return false;
+    }
+
+    BITMAPINFO bmi = {};
+    bmi.bmiHeader.biSize = sizeof(BITMAPINFOHEADER);
+    bmi.bmiHeader.biWidth = width;
+    bmi.bmiHeader.biHeight = -height;           // Top-down
+    bmi.bmiHeader.biPlanes = 1;
+    bmi.bmiHeader.biBitCount = 32;
+    bmi.bmiHeader.biCompression = BI_RGB;
+
+    void* bits = nullptr;
+    m_bitmap = ::CreateDIBSection(m_memDC, &bmi, DIB_RGB_COLORS, &bits, nullptr, 0);
+    if (m_bitmap == nullptr) {
+        Release();
+        return false;
+    }
+
+    m_oldBitmap = ::SelectObject(m_memDC, m_bitmap);
+    m_bits = static_cast<MeaMagnifierRenderer::Pixel*>(bits);
+    m_width = width;
+    m_height = height;
+
+    return true;
+}
+
+void MeaDibSurface::Release() {
+    if (m_memDC != nullptr) {
+        if (m_oldBitmap != nullptr) {
+            ::SelectObject(m_memDC, m_oldBitmap);
+        }
+        ::DeleteDC(m_memDC);
+    }
+    if (m_bitmap != nullptr) {
+        ::DeleteObject(m_bitmap);
+    }
+
+    m_memDC = nullptr;
+    m_bitmap = nullptr;
+    m_oldBitmap = nullptr;
+    m_bits = nullptr;
+    m_width = 0;
+    m_height = 0;
+}
+
+MeaMagnifierRenderer::Image MeaDibSurface::GetImage(int width, int height) const {
+    assert(m_bits != nullptr);
+    assert(width <= m_width && height <= m_height);
+
+    // GDI may batch drawing operations. Ensure they have been applied before the pixels are accessed.
+    ::GdiFlush();
+
+    return MeaMagnifierRenderer::Image { m_bits, width, height, m_width };
+}
@@ -0,0 +1,86 @@
+/*
+ * Copyright 2022 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/// @file
+/// @brief Header file for a persistent off-screen drawing surface.
+
+#pragma once
+
+#include <meazure/graphics/MagnifierRenderer.h>
+
+
+/// Off-screen drawing surface consisting of a memory device context and a top-down 32 bits per pixel DIB
+/// section selected into it. The surface can be drawn on using GDI through its device context, and its pixels
+/// can be read and written directly. The surface is kept from one use to the next and is only reallocated
+/// when a larger size is needed, so that it can be used for every frame of an animation without creating
+/// and destroying GDI objects.
+///
+class MeaDibSurface {
+
+public:
+    /// Constructs an empty surface. Call Reserve to allocate the surface.
+    ///
+    MeaDibSurface();
+
+    /// Releases the GDI objects used by the surface.
+    ///
+    ~MeaDibSurface();
+
+    MeaDibSurface(const MeaDibSurface&) = delete;
+    MeaDibSurface& operator=(const MeaDibSurface&) = delete;
+
+    /// Ensures that the surface is at least the specified size. If the surface is already large enough, it is
+    /// reused. The contents of the surface are undefined after this call.
+    ///
+    /// @param hDC      [in] Device context with which the memory device context is to be compatible.
+    /// @param width    [in] Minimum width of the surface, in pixels.
+    /// @param height   [in] Minimum height of the surface, in pixels.
+    ///
+    /// @return <b>true</b> if the surface is available.
+    ///
+    bool Reserve(HDC hDC, int width, int height);
+
+    /// Releases the GDI objects used by the surface.
+    ///
+    void Release();
+
+    /// Obtains the memory device context for the surface.
+    ///
+    /// @return Memory device context, or nullptr if the surface has not been reserved.
+    ///
+    HDC GetDC() const { return m_memDC; }
+
+    /// Obtains a view of the specified portion of the surface's pixels. Any pending GDI drawing on the surface
+    /// is completed before the view is returned.
+    ///
+    /// @param width    [in] Width of the view, in pixels. Must not exceed the reserved width.
+    /// @param height   [in] Height of the view, in pixels. Must not exceed the reserved height.
+    ///
+    /// @return View of the top left portion of the surface.
+    ///
+    MeaMagnifierRenderer::Image GetImage(int width, int height) const;
+
+private:
+    HDC m_memDC;                ///< Memory device context.
+    HBITMAP m_bitmap;           ///< DIB section selected into the memory device context.
+    HGDIOBJ m_oldBitmap;        ///< Bitmap originally selected into the memory device context.
+    MeaMagnifierRenderer::Pixel* m_bits;    ///< Pixels of the DIB section.
+    int m_width;                ///< Width of the DIB section, in pixels.
+    int m_height;               ///< Height of the DIB section, in pixels.
+};
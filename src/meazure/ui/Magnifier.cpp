@@ -43,6 +43,7 @@ m_curPos(0, 0),
 m_enabled(true),
 m_runState(kDefRunState),
 m_colorFmt(kDefColorFmt),
+m_sampleSize(kDefSampleSize),
 m_zoomIndex(kDefZoomIndex),
 m_showGrid(kDefShowGrid),
 m_magHeight(0) {}
@@ -170,6 +171,7 @@ void MeaMagnifier::SaveProfile(MeaProfile& profile) {
         profile.WriteInt(_T("ZoomIndex"), m_zoomIndex);
         profile.WriteBool(_T("MagGrid"), m_showGrid);
         profile.WriteInt(_T("ColorFmt"), m_colorFmt);
+        profile.WriteInt(_T("ColorSample"), m_sampleSize);
     }
 }
 
@@ -178,6 +180,7 @@ void MeaMagnifier::LoadProfile(MeaProfile& profile) {
         SetZoomIndex(profile.ReadInt(_T("ZoomIndex"), m_zoomIndex));
         SetShowGrid(profile.ReadBool(_T("MagGrid"), m_showGrid));
         SetColorFmt(static_cast<MeaMagnifier::ColorFmt>(profile.ReadInt(_T("ColorFmt"), m_colorFmt)));
+        SetSampleSize(profile.ReadInt(_T("ColorSample"), m_sampleSize));
     }
 }
 
@@ -185,9 +188,15 @@ void MeaMagnifier::MasterReset() {
     SetZoomIndex(kDefZoomIndex);
     SetShowGrid(kDefShowGrid);
     SetColorFmt(kDefColorFmt);
+    SetSampleSize(kDefSampleSize);
     SetRunState(kDefRunState);
 }
 
+void MeaMagnifier::SetSampleSize(int size) {
+    m_sampleSize = (size < 1) ? 1 : (size | 1);
+    Update();
+}
+
 void MeaMagnifier::Enable() {
     if (!m_enabled) {
         m_enabled = true;
@@ -276,9 +285,6 @@ void MeaMagnifier::OnPaint() {
 }
 
 void MeaMagnifier::Draw(HDC hDC) {
-    int srcLen, j;
-    int xCoord, yCoord;
-
     //
     // Center the magnifier around cursor
     //
@@ -292,21 +298,13 @@ void MeaMagnifier::Draw(HDC hDC) {
     CRect rect;
     GetClientRect(rect);
 
-    CRect dstRect(0, 0, rect.Width(), rect.Width());
-    int dstWidth = dstRect.Width();
-    int dstHeight = dstRect.Height();
-
-    //
-    // Create a memory context
-    //
-    HDC memDC = ::CreateCompatibleDC(hDC);
-    HBITMAP memBmp = ::CreateCompatibleBitmap(hDC, dstWidth, dstHeight);
-    HGDIOBJ memBmpOld = ::SelectObject(memDC, memBmp);
+    int dstWidth = rect.Width();
+    int dstHeight = rect.Width();
 
     //
     // Calculate the size of the source rectangle
     //
-    srcLen = (dstWidth / kZoomFactorArr[m_zoomIndex]) / 2;
+    int srcLen = (dstWidth / kZoomFactorArr[m_zoomIndex]) / 2;
     if (srcLen == 0) {
         srcLen = 1;
     }
@@ -315,91 +313,66 @@ void MeaMagnifier::Draw(HDC hDC) {
     int srcWidth = srcRect.Width();
     int srcHeight = srcRect.Height();
 
-    // Get the screen corresponding to the current position.
-    //
-    MeaScreenMgr& mgr = MeaScreenMgr::Instance();
-    CRect screenRect = mgr.GetScreenRect(mgr.GetScreenIter(m_curPos));
-
-    //
-    // Determine if the source rectangle extends beyond the screen, and if so,
-    // clear the edges to black and set the clip region.
-    //
-    if (srcRect.left < screenRect.left || srcRect.right > screenRect.right ||
-            srcRect.top < screenRect.top || srcRect.bottom > screenRect.bottom) {
-        RECT clipRect;
-
-        clipRect.left = (srcRect.left < screenRect.left) ? screenRect.left : srcRect.left;
-        clipRect.top = (srcRect.top < screenRect.top) ? screenRect.top : srcRect.top;
-        clipRect.right = (srcRect.right > screenRect.right) ? screenRect.right : srcRect.right;
-        clipRect.bottom = (srcRect.bottom > screenRect.bottom) ? screenRect.bottom : srcRect.bottom;
-
-        clipRect.left = (clipRect.left - srcRect.left) * dstWidth / srcWidth;
-        clipRect.right = (clipRect.right - srcRect.left) * dstWidth / srcWidth;
-        clipRect.top = (clipRect.top - srcRect.top) * dstHeight / srcHeight;
-        clipRect.bottom = (clipRect.bottom - srcRect.top) * dstHeight / srcHeight;
-
-        ::BitBlt(memDC, dstRect.left, dstRect.top, dstRect.right, dstRect.bottom, 0, 0, 0, BLACKNESS);
-
-        CRgn rgn;
-        rgn.CreateRectRgnIndirect(&clipRect);
-        ::SelectClipRgn(memDC, rgn);
+    if (dstWidth < srcWidth || dstHeight < srcHeight ||
+            !m_captureSurface.Reserve(hDC, srcWidth, srcHeight) ||
+            !m_backSurface.Reserve(hDC, dstWidth, dstHeight)) {
+        return;
     }
 
     //
-    // Blt the screen to the magnifier.
+    // Capture the source rectangle from the screen. This is the only access
+    // to the screen for the frame. Both the magnified image and the color of
+    // the center pixel are derived from the captured pixels.
     //
-    ::SetStretchBltMode(hDC, COLORONCOLOR);
     HDC screenDC = ::GetDC(nullptr);
-    COLORREF colorValue = ::GetPixel(screenDC, m_curPos.x, m_curPos.y);
-    ::StretchBlt(memDC, 0, 0, dstWidth, dstHeight, screenDC, srcRect.left, srcRect.top, srcWidth, srcHeight, SRCCOPY);
+    ::BitBlt(m_captureSurface.GetDC(), 0, 0, srcWidth, srcHeight, screenDC, srcRect.left, srcRect.top, SRCCOPY);
     ::ReleaseDC(nullptr, screenDC);
 
-    ::FrameRect(memDC, dstRect, static_cast<HBRUSH>(GetStockObject(BLACK_BRUSH)));
+    MeaMagnifierRenderer::Image srcImage = m_captureSurface.GetImage(srcWidth, srcHeight);
 
     //
-    // Draw the grid on the image.
+    // Blank the portion of the source rectangle that extends beyond the
+    // screen containing the current position.
     //
-    if (m_showGrid && (kZoomFactorArr[m_zoomIndex] >= kMinGridFactor)) {
-        CPen gridPen(PS_SOLID, 1, RGB(0, 0, 0));
-        HGDIOBJ hOld = ::SelectObject(memDC, gridPen);
-
-        for (j = 0; j < srcWidth; j++) {
-            xCoord = j * dstWidth / srcWidth;
-            ::MoveToEx(memDC, xCoord, 0, nullptr);
-            ::LineTo(memDC, xCoord, dstHeight);
-        }
-        for (j = 0; j < srcHeight; j++) {
-            yCoord = j * dstHeight / srcHeight;
-            ::MoveToEx(memDC, 0, yCoord, nullptr);
-            ::LineTo(memDC, dstWidth, yCoord);
-        }
-        ::DeleteObject(::SelectObject(memDC, hOld));
+    MeaScreenMgr& mgr = MeaScreenMgr::Instance();
+    CRect screenRect = mgr.GetScreenRect(mgr.GetScreenIter(m_curPos));
+
+    if (srcRect.left < screenRect.left || srcRect.right > screenRect.right ||
+            srcRect.top < screenRect.top || srcRect.bottom > screenRect.bottom) {
+        MeaMagnifierRenderer::ClearOutside(srcImage,
+                                           screenRect.left - srcRect.left, screenRect.top - srcRect.top,
+                                           screenRect.right - srcRect.left, screenRect.bottom - srcRect.top);
     }
 
     //
-    // Draw the center marker on the image.
+    // Determine the color to report. When sampling more than a single pixel,
+    // the color is the average of the on-screen pixels in the sample region.
     //
-    xCoord = srcWidth / 2;
-    yCoord = srcHeight / 2;
-
-    CRect centerRect(
-        xCoord * dstWidth / srcWidth,                   // Left
-        yCoord * dstHeight / srcHeight,                 // Top
-        (xCoord + 1) * dstWidth / srcWidth + 1,         // Right
-        (yCoord + 1) * dstHeight / srcHeight + 1        // Bottom
-    );
-
-    CBrush brush(RGB(0xFF, 0, 0));
-    ::FrameRect(memDC, &centerRect, brush);
-
-    ::BitBlt(hDC, dstRect.left, dstRect.top, dstRect.right, dstRect.bottom, memDC, 0, 0, SRCCOPY);
+    int centerX = m_curPos.x - srcRect.left;
+    int centerY = m_curPos.y - srcRect.top;
+    MeaMagnifierRenderer::Pixel colorPixel;
+
+    if (m_sampleSize > 1) {
+        int halfSize = m_sampleSize / 2;
+        CRect sampleRect(centerX - halfSize, centerY - halfSize, centerX + halfSize + 1, centerY + halfSize + 1);
+        CRect onScreenRect(screenRect);
+        onScreenRect.OffsetRect(-srcRect.left, -srcRect.top);
+        sampleRect &= onScreenRect;
+
+        m_sampler.Sample(srcImage, sampleRect.left, sampleRect.top, sampleRect.right, sampleRect.bottom);
+        colorPixel = m_sampler.GetMeanColor();
+    } else {
+        colorPixel = srcImage.Row(centerY)[centerX];
+    }
+    COLORREF colorValue = MeaMagnifierRenderer::ToColorRef(colorPixel);
 
     //
-    // Clean up blt objects
+    // Render the magnified image into the back buffer and display it.
     //
-    ::SelectObject(memDC, memBmpOld);
-    ::DeleteObject(memBmp);
-    ::DeleteDC(memDC);
+    bool showGrid = m_showGrid && (kZoomFactorArr[m_zoomIndex] >= kMinGridFactor);
+    m_renderer.Render(srcImage, m_backSurface.GetImage(dstWidth, dstHeight), showGrid);
+
+    ::BitBlt(hDC, 0, 0, dstWidth, dstHeight, m_backSurface.GetDC(), 0, 0, SRCCOPY);
 
     //
     // Report the color information
@@ -26,9 +26,12 @@
 #include "TextField.h"
 #include "Themes.h"
 #include "ImageButton.h"
+#include "DibSurface.h"
 #include <meazure/Messages.h>
 #include <meazure/utilities/Timer.h>
 #include <meazure/profile/Profile.h>
+#include <meazure/graphics/MagnifierRenderer.h>
+#include <meazure/graphics/RegionSampler.h>
 
 
 /// Provides a screen magnifier window complete with freeze frame, optional
@@ -77,6 +80,7 @@ public:
     static constexpr bool kDefShowGrid { true };                ///< Indicates whether the grid should be display by default.
     static constexpr ColorFmt kDefColorFmt { RGBFmt };          ///< Default color display format.
     static constexpr RunState kDefRunState { RunState::Run };   ///< Default magnifier display mode.
+    static constexpr int kDefSampleSize { 1 };                  ///< Default color sample size, in pixels.
 
 
     /// Constructs a magnifier. To use the magnifier the Create
@@ -194,6 +198,22 @@ public:
     ///
     ColorFmt GetColorFmt() const { return m_colorFmt; }
 
+    /// Sets the size of the square region of pixels, centered on the
+    /// current position, whose average color is displayed. A size of
+    /// 1 displays the color of the pixel at the current position.
+    ///
+    /// @param size     [in] Width and height of the sampled region, in
+    ///                 pixels. Even sizes are rounded up to the next odd
+    ///                 size so that the region is centered.
+    ///
+    void SetSampleSize(int size);
+
+    /// Returns the size of the region whose average color is displayed.
+    ///
+    /// @return Width and height of the sampled region, in pixels.
+    ///
+    int GetSampleSize() const { return m_sampleSize; }
+
     /// Set the display mode of the magnifier to either running
     /// or frozen.
     ///
@@ -283,7 +303,10 @@ private:
 
 
     /// Reads an appropriately sized region around the cursor and
-    /// zooms it into the magnifier window.
+    /// zooms it into the magnifier window. The region is captured
+    /// into an off-screen surface, rendered into a back buffer and
+    /// then copied to the window. Both surfaces are kept from one
+    /// frame to the next.
     ///
     /// @param hDC      [in] Magnifier window device context.
     ///
@@ -303,6 +326,7 @@ private:
     MeaImageButton m_runStateBtn;   ///< Magnifier pause button.
     MeaTimer m_timer;               ///< Refresh timer.
     ColorFmt m_colorFmt;            ///< Pixel color display format.
+    int m_sampleSize;               ///< Width and height of the region whose average color is displayed.
     MeaLabel m_swatchLabel;         ///< Label for the pixel color swatch.
     MeaTextField m_swatchField;     ///< Text field to display the pixel color.
     CWnd m_swatchWin;               ///< Window for the pixel color swatch.
@@ -312,4 +336,8 @@ private:
     int m_zoomIndex;                ///< Currently selected zoom factor index.
     bool m_showGrid;                ///< Indicates whether the grid should be displayed, if possible.
     int m_magHeight;                ///< Height of the magnifier, in pixels.
+    MeaDibSurface m_captureSurface; ///< Screen region captured for the current frame.
+    MeaDibSurface m_backSurface;    ///< Back buffer into which the magnified image is rendered.
+    MeaMagnifierRenderer m_renderer;    ///< Renders the magnified image.
+    MeaRegionSampler m_sampler;     ///< Computes the average color of the sampled region.
 };
@@ -0,0 +1,197 @@
+/*
+ * Copyright 2022 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/// @file
+/// @brief Header file for the measurement snapshot passed from the radio tools to the data display.
+
+#pragma once
+
+#include "DataFieldId.h"
+#include <meazure/utilities/Geometry.h>
+#include <meazure/utilities/NumericUtils.h>
+
+
+/// Values displayed in the Region section of the data display for a single update of a radio tool. A tool builds
+/// a snapshot containing the fields it measures and passes it to the data display in one call. Once passed, the
+/// snapshot is not modified. This allows the data display to compare it with the previous snapshot and update only
+/// those fields whose text would change.
+///
+/// All values are in the current units. The positions of the coordinate fields are also recorded in pixels so that
+/// their spin controls can be positioned.
+///
+class MeaMeasurementSnapshot {
+
+public:
+    static constexpr int kFieldCount = 16;      ///< Number of data field identifiers.
+
+    /// Fields that hold coordinates and have a position in pixels.
+    static constexpr unsigned int kCoordinateFields =
+        MeaX1Field | MeaY1Field | MeaX2Field | MeaY2Field | MeaXVField | MeaYVField;
+
+
+    MeaMeasurementSnapshot() : m_fields(0), m_values(), m_pixels() {}
+
+    /// Sets the X1, Y1 coordinates.
+    /// @param point    [in] Coordinates, in pixels.
+    /// @param cpoint   [in] Coordinates, in current units.
+    /// @return This snapshot.
+    ///
+    MeaMeasurementSnapshot& SetXY1(const POINT& point, const MeaFPoint& cpoint) {
+        return SetXY(MeaX1Field, MeaY1Field, point, cpoint);
+    }
+
+    /// Sets the X2, Y2 coordinates.
+    /// @param point    [in] Coordinates, in pixels.
+    /// @param cpoint   [in] Coordinates, in current units.
+    /// @return This snapshot.
+    ///
+    MeaMeasurementSnapshot& SetXY2(const POINT& point, const MeaFPoint& cpoint) {
+        return SetXY(MeaX2Field, MeaY2Field, point, cpoint);
+    }
+
+    /// Sets the vertex or center X, Y coordinates.
+    /// @param point    [in] Coordinates, in pixels.
+    /// @param cpoint   [in] Coordinates, in current units.
+    /// @return This snapshot.
+    ///
+    MeaMeasurementSnapshot& SetXYV(const POINT& point, const MeaFPoint& cpoint) {
+        return SetXY(MeaXVField, MeaYVField, point, cpoint);
+    }
+
+    /// Sets the width and height.
+    /// @param size     [in] Width and height, in current units.
+    /// @return This snapshot.
+    ///
+    MeaMeasurementSnapshot& SetWH(const MeaFSize& size) {
+        Set(MeaWidthField, size.cx);
+        return Set(MeaHeightField, size.cy);
+    }
+
+    /// Sets the distance to the diagonal of the specified width and height.
+    /// @param size     [in] Width and height, in current units.
+    /// @return This snapshot.
+    ///
+    MeaMeasurementSnapshot& SetDistance(const MeaFSize& size) {
+        return Set(MeaDistanceField, MeaGeometry::CalcLength(size.cx, size.cy));
+    }
+
+    /// Sets the distance.
+    /// @param dist     [in] Distance, in current units.
+    /// @return This snapshot.
+    ///
+    MeaMeasurementSnapshot& SetDistance(double dist) {
+        return Set(MeaDistanceField, dist);
+    }
+
+    /// Sets the angle.
+    /// @param angle    [in] Angle, in current angular units.
+    /// @return This snapshot.
+    ///
+    MeaMeasurementSnapshot& SetAngle(double angle) {
+        return Set(MeaAngleField, angle);
+    }
+
+    /// Sets the aspect ratio to that of the specified width and height (i.e. width/height).
+    /// @param size     [in] Width and height, in current units.
+    /// @return This snapshot.
+    ///
+    MeaMeasurementSnapshot& SetAspect(const MeaFSize& size) {
+        return Set(MeaAspectField, (size.cy == 0.0) ? 0.0 : (size.cx / size.cy));
+    }
+
+    /// Sets the area to that of the rectangle with the specified width and height.
+    /// @param size     [in] Width and height, in current units.
+    /// @return This snapshot.
+    ///
+    MeaMeasurementSnapshot& SetRectArea(const MeaFSize& size) {
+        return Set(MeaAreaField, size.cx * size.cy);
+    }
+
+    /// Sets the area to that of the circle with the specified radius.
+    /// @param radius   [in] Radius, in current units.
+    /// @return This snapshot.
+    ///
+    MeaMeasurementSnapshot& SetCircleArea(double radius) {
+        return Set(MeaAreaField, MeaNumericUtils::PI * radius * radius);
+    }
+
+    /// Obtains the fields contained in the snapshot.
+    /// @return Mask of MeaDataFieldId values.
+    ///
+    unsigned int GetFields() const { return m_fields; }
+
+    /// Indicates whether the snapshot contains the specified field.
+    /// @param fieldId  [in] Field to test.
+    /// @return <b>true</b> if the field has been set.
+    ///
+    bool Has(MeaDataFieldId fieldId) const { return (m_fields & fieldId) != 0; }
+
+    /// Obtains the value of the specified field.
+    /// @param fieldId  [in] Field whose value is to be obtained.
+    /// @return Value of the field, in current units.
+    ///
+    double GetValue(MeaDataFieldId fieldId) const { return m_values[FieldIndex(fieldId)]; }
+
+    /// Obtains the position of the specified coordinate field.
+    /// @param fieldId  [in] Coordinate field whose position is to be obtained.
+    /// @return Position, in pixels. Zero for fields that are not coordinates.
+    ///
+    int GetPixels(MeaDataFieldId fieldId) const { return m_pixels[FieldIndex(fieldId)]; }
+
+    /// Obtains the position of the pair of coordinate fields.
+    /// @param xFieldId     [in] X coordinate field.
+    /// @param yFieldId     [in] Y coordinate field.
+    /// @return Position, in pixels.
+    ///
+    POINT GetPoint(MeaDataFieldId xFieldId, MeaDataFieldId yFieldId) const {
+        return { GetPixels(xFieldId), GetPixels(yFieldId) };
+    }
+
+    /// Converts the specified field identifier to an index from 0 to kFieldCount - 1.
+    /// @param fieldId  [in] Field identifier.
+    /// @return Index of the field.
+    ///
+    static int FieldIndex(MeaDataFieldId fieldId) {
+        int index = 0;
+        for (unsigned int mask = fieldId; mask > 1; mask >>= 1) {
+            index++;
+        }
+        return index;
+    }
+
+private:
+    MeaMeasurementSnapshot& Set(MeaDataFieldId fieldId, double value) {
+        m_fields |= fieldId;
+        m_values[FieldIndex(fieldId)] = value;
+        return *this;
+    }
+
+    MeaMeasurementSnapshot& SetXY(MeaDataFieldId xFieldId, MeaDataFieldId yFieldId, const POINT& point,
+                                  const MeaFPoint& cpoint) {
+        m_pixels[FieldIndex(xFieldId)] = point.x;
+        m_pixels[FieldIndex(yFieldId)] = point.y;
+        Set(xFieldId, cpoint.x);
+        return Set(yFieldId, cpoint.y);
+    }
+
+
+    unsigned int m_fields;              ///< Mask of the fields that have been set.
+    double m_values[kFieldCount];       ///< Field values, indexed by FieldIndex.
+    int m_pixels[kFieldCount];          ///< Coordinate field positions in pixels, indexed by FieldIndex.
+};
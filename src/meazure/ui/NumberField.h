@@ -23,6 +23,8 @@
 #pragma once
 
 #include "TextField.h"
+#include <meazure/utilities/NumberFormat.h>
+#include <meazure/utilities/NumberParse.h>
 
 
 /// Provides a text field control that allows only numeric entries.
@@ -61,9 +63,9 @@ public:
     /// @param value    [in] Integer value to display in the field.
     ///
     void SetValue(int value) {
-        CString str;
-        str.Format(_T("%d"), value);
-        SetWindowText(str);
+        MeaNumberFormat::Buffer buffer;
+        std::string_view str = MeaNumberFormat::FormatInt(buffer, value);
+        SetWindowText(CString(str.data(), static_cast<int>(str.size())));
     }
 
     /// Displays a double precision value in the field.
@@ -71,9 +73,9 @@ public:
     /// @param value    [in] Double value to display in the field.
     ///
     void SetValue(double value) {
-        CString str;
-        str.Format(_T("%f"), value);
-        SetWindowText(str);
+        MeaNumberFormat::Buffer buffer;
+        std::string_view str = MeaNumberFormat::FormatFixed(buffer, value, 6);
+        SetWindowText(CString(str.data(), static_cast<int>(str.size())));
     }
 
     /// Obtains the value contained in the text field as an integer.
@@ -88,7 +90,7 @@ public:
         if (str.IsEmpty()) {
             return false;
         }
-        value = _ttoi(str);
+        value = MeaNumberParse::ToInt(static_cast<PCTSTR>(str));
         return true;
     }
 
@@ -104,7 +106,7 @@ public:
         if (str.IsEmpty()) {
             return false;
         }
-        value = _tcstod(str, nullptr);
+        value = MeaNumberParse::ToDbl(static_cast<PCTSTR>(str));
         return true;
     }
 
@@ -170,9 +170,10 @@ private:
 
 
 MeaScreenMgr::MeaScreenMgr(token) :
-    MeaSingleton_T<MeaScreenMgr>(), m_sizeChanged(false) {
+    MeaSingleton_T<MeaScreenMgr>(), m_sizeChanged(false), m_layoutVersion(0) {
     EnumDisplayMonitors(nullptr, nullptr, CreateScreens, reinterpret_cast<LPARAM>(this));
     assert(m_screens.size() > 0);
+    BuildScreenIndex();
 
     m_virtualRect.left = GetSystemMetrics(SM_XVIRTUALSCREEN);
     m_virtualRect.top = GetSystemMetrics(SM_YVIRTUALSCREEN);
@@ -257,6 +258,8 @@ void MeaScreenMgr::LoadProfile(MeaProfile& profile) {
                 }
             }
         }
+
+        m_layoutVersion++;
     }
 }
 
@@ -274,6 +277,8 @@ void MeaScreenMgr::MasterReset() const {
             screen->SetCalInInches(kDefCalInInches);
         }
     }
+
+    m_layoutVersion++;
 }
 
 const CPoint& MeaScreenMgr::GetCenter() const {
@@ -358,6 +363,14 @@ MeaScreenMgr::ScreenIter MeaScreenMgr::GetScreenIter(const CWnd* wnd) const {
 }
 
 MeaScreenMgr::ScreenIter MeaScreenMgr::GetScreenIter(const POINT& point) const {
+    // Most points lie on a screen and are located using the index. Points
+    // between or beyond the screens are assigned to the nearest screen by
+    // the system.
+    int index = m_screenIndex.Find(point.x, point.y);
+    if (index != MeaRectIndex::kNotFound) {
+        return m_indexedScreens[index];
+    }
+
     HMONITOR mon = MonitorFromPoint(point, MONITOR_DEFAULTTONEAREST);
     assert(mon != nullptr);
 
@@ -389,6 +402,7 @@ const MeaFSize& MeaScreenMgr::GetScreenRes(const ScreenIter& iter) const {
 
 void MeaScreenMgr::SetScreenRes(const ScreenIter& iter, bool useManualRes, const MeaFSize* manualRes) const {
     (*iter).second->SetScreenRes(useManualRes, manualRes);
+    m_layoutVersion++;
 }
 
 bool MeaScreenMgr::IsManualRes(const ScreenIter& iter) const { 
@@ -420,6 +434,19 @@ void MeaScreenMgr::SetCalInInches(const ScreenIter& iter, bool calInInches) cons
     (*iter).second->SetCalInInches(calInInches);
 }
 
+void MeaScreenMgr::BuildScreenIndex() {
+    std::vector<MeaFRect> rects;
+
+    m_indexedScreens.clear();
+    for (ScreenIter iter = m_screens.begin(); iter != m_screens.end(); ++iter) {
+        const CRect& rect = (*iter).second->GetRect();
+        rects.emplace_back(rect.top, rect.bottom, rect.left, rect.right);
+        m_indexedScreens.push_back(iter);
+    }
+
+    m_screenIndex.Build(rects);
+}
+
 BOOL CALLBACK MeaScreenMgr::CreateScreens(HMONITOR hMonitor, HDC /* hdcMonitor */, LPRECT monitorRect,
                                           LPARAM userData) {
     MeaScreenMgr* mgr = reinterpret_cast<MeaScreenMgr*>(userData);
@@ -26,6 +26,8 @@
 #include "ScreenProvider.h"
 #include <meazure/profile/Profile.h>
 #include <meazure/utilities/Geometry.h>
+#include <meazure/utilities/RectIndex.h>
+#include <vector>
 
 
 /// Provides information on the display monitor(s). One of the primary
@@ -251,6 +253,13 @@ public:
     ///
     CPoint LimitPosition(const CPoint& pt) const override;
 
+    /// Returns a value that changes whenever the resolution of a screen
+    /// changes.
+    ///
+    /// @return Screen layout version.
+    ///
+    unsigned int GetLayoutVersion() const override { return m_layoutVersion; }
+
 private:
     /// Called by the constructor via EnumDisplayMonitors.
     /// Instantiates a Screen object for each display monitor
@@ -275,8 +284,15 @@ private:
     ///
     Screen* GetScreen(const POINT& point) const;
 
+    /// Builds the index used to locate the screen containing a point.
+    ///
+    void BuildScreenIndex();
+
 
     Screens m_screens;       ///< Display monitors.
     CRect m_virtualRect;    ///< Bounding box of all screen rectangles.
     bool m_sizeChanged;     ///< Virtual screen rectangle changed since last run.
+    std::vector<ScreenIter> m_indexedScreens;   ///< Screens in the order given to m_screenIndex.
+    MeaRectIndex m_screenIndex;                 ///< Locates the screen containing a point.
+    mutable unsigned int m_layoutVersion;       ///< Incremented whenever a screen resolution changes.
 };
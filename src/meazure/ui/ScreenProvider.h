@@ -191,4 +191,13 @@ struct MeaScreenProvider {
     ///         to be on a screen.
     ///
     virtual CPoint LimitPosition(const CPoint& pt) const = 0;
+
+    /// Returns a value that changes whenever the screen layout or the
+    /// resolution of a screen changes. Clients that cache information
+    /// derived from the screens compare the value against the one they
+    /// saw when the cache was built to determine whether it is stale.
+    ///
+    /// @return Screen layout version.
+    ///
+    virtual unsigned int GetLayoutVersion() const = 0;
 };
@@ -19,14 +19,41 @@
 
 #include <meazure/pch.h>
 #include "Units.h"
+#include "UnitsConversion.h"
 #include <meazure/utilities/NumericUtils.h>
+#include <meazure/utilities/NumberFormat.h>
 #include <cmath>
+#include <iterator>
 
 
 //*************************************************************************
 // MeaUnits
 //*************************************************************************
 
+MeaUnitsContext MeaUnits::m_defaultContext;
+
+namespace {
+    /// Profile names of the angular precisions, indexed by MeaAngularMeasurementId.
+    constexpr PCTSTR kAngularPrecisionNames[] = {
+        _T("angle")     // MeaA
+    };
+
+    /// Profile names of the linear precisions, indexed by MeaLinearMeasurementId.
+    constexpr PCTSTR kLinearPrecisionNames[] = {
+        _T("x"),        // MeaX
+        _T("y"),        // MeaY
+        _T("w"),        // MeaW
+        _T("h"),        // MeaH
+        _T("d"),        // MeaD
+        _T("area"),     // MeaAr
+        _T("rx"),       // MeaRx
+        _T("ry")        // MeaRy
+    };
+
+    static_assert(std::size(kAngularPrecisionNames) == MeaA + 1, "Angular precision names do not match the ids");
+    static_assert(std::size(kLinearPrecisionNames) == MeaRy + 1, "Linear precision names do not match the ids");
+}
+
 
 MeaUnits::MeaUnits(PCTSTR unitsStr) : m_unitsStr(unitsStr) {}
 
@@ -45,28 +72,36 @@ void MeaUnits::LoadProfile(MeaProfile& profile) {
 }
 
 void MeaUnits::SavePrecision(MeaProfile& profile) {
-    unsigned int i;
-
-    for (i = 0; i < m_displayPrecisions.size(); i++) {
-        CString tag;
+    std::size_t count = m_displayPrecisions.size();
+    if (count > m_precisionKeys.size()) {
+        count = m_precisionKeys.size();
+    }
 
-        tag.Format(_T("Precision-%s-%s"),
-                    static_cast<PCTSTR>(m_displayPrecisionNames[i]),
-                    static_cast<PCTSTR>(m_unitsStr));
-        profile.WriteInt(tag, m_displayPrecisions[i]);
+    for (std::size_t i = 0; i < count; i++) {
+        profile.WriteInt(m_precisionKeys[i], m_displayPrecisions[i]);
     }
 }
 
 void MeaUnits::LoadPrecision(MeaProfile& profile) {
-    unsigned int i;
+    std::size_t count = m_displayPrecisions.size();
+    if (count > m_precisionKeys.size()) {
+        count = m_precisionKeys.size();
+    }
 
-    for (i = 0; i < m_displayPrecisions.size(); i++) {
-        CString tag;
+    for (std::size_t i = 0; i < count; i++) {
+        m_displayPrecisions[i] = profile.ReadInt(m_precisionKeys[i], m_displayPrecisions[i]);
+    }
+}
 
-        tag.Format(_T("Precision-%s-%s"),
-                    static_cast<PCTSTR>(m_displayPrecisionNames[i]),
-                    static_cast<PCTSTR>(m_unitsStr));
-        m_displayPrecisions[i] = profile.ReadInt(tag, m_displayPrecisions[i]);
+void MeaUnits::SetPrecisionNames(const PCTSTR* names, std::size_t count) {
+    m_displayPrecisionNames.assign(names, names + count);
+
+    m_precisionKeys.clear();
+    m_precisionKeys.reserve(count);
+    for (std::size_t i = 0; i < count; i++) {
+        CString key;
+        key.Format(_T("Precision-%s-%s"), names[i], static_cast<PCTSTR>(m_unitsStr));
+        m_precisionKeys.push_back(key);
     }
 }
 
@@ -79,20 +114,21 @@ void MeaUnits::MasterReset() {
 // MeaAngularUnits
 //*************************************************************************
 
-bool MeaAngularUnits::m_supplementalAngle = false;
-
-
 MeaAngularUnits::MeaAngularUnits(MeaAngularUnitsId unitsId, PCTSTR unitsStr) :
     MeaUnits(unitsStr), m_unitsId(unitsId) {
-    AddPrecisionName(_T("angle"));      // MeaA
+    SetPrecisionNames(kAngularPrecisionNames, std::size(kAngularPrecisionNames));
 }
 
 MeaAngularUnits::~MeaAngularUnits() {}
 
 CString MeaAngularUnits::Format(MeaAngularMeasurementId id, double value) const {
-    CString vstr;
-    vstr.Format(_T("%0.*f"), GetDisplayPrecisions()[id], value);
-    return vstr;
+    MeaNumberFormat::Buffer buffer;
+    std::string_view vstr = MeaNumberFormat::FormatFixed(buffer, value, GetDisplayPrecisions()[id]);
+    return CString(vstr.data(), static_cast<int>(vstr.size()));
+}
+
+double MeaAngularUnits::ConvertAngle(double angle, const MeaUnitsContext& context) const {
+    return FromRadians(context.m_supplementalAngle ? std::copysign(MeaNumericUtils::PI, angle) - angle : angle);
 }
 
 
@@ -106,9 +142,8 @@ MeaDegreeUnits::MeaDegreeUnits() : MeaAngularUnits(MeaDegreesId, _T("deg")) {
 
 MeaDegreeUnits::~MeaDegreeUnits() {}
 
-double MeaDegreeUnits::ConvertAngle(double angle) const {
-    double theta = IsSupplementalAngle() ? std::copysign(MeaNumericUtils::PI, angle) - angle : angle;
-    return 360.0 * theta / (2.0 * MeaNumericUtils::PI);
+double MeaDegreeUnits::FromRadians(double angle) const {
+    return 360.0 * angle / (2.0 * MeaNumericUtils::PI);
 }
 
 
@@ -122,8 +157,8 @@ MeaRadianUnits::MeaRadianUnits() : MeaAngularUnits(MeaRadiansId, _T("rad")) {
 
 MeaRadianUnits::~MeaRadianUnits() {}
 
-double MeaRadianUnits::ConvertAngle(double angle) const {
-    return IsSupplementalAngle() ? std::copysign(MeaNumericUtils::PI, angle) - angle : angle;
+double MeaRadianUnits::FromRadians(double angle) const {
+    return angle;
 }
 
 
@@ -131,20 +166,12 @@ double MeaRadianUnits::ConvertAngle(double angle) const {
 // MeaLinearUnits
 //*************************************************************************
 
-bool MeaLinearUnits::m_invertY = false;
-CPoint MeaLinearUnits::m_originOffset;
+unsigned int MeaLinearUnits::m_conversionVersion = 0;
 
 
 MeaLinearUnits::MeaLinearUnits(MeaLinearUnitsId unitsId, PCTSTR unitsStr, const MeaScreenProvider& screenProvider) :
     MeaUnits(unitsStr), m_unitsId(unitsId), m_screenProvider(screenProvider), m_majorTickCount(10) {
-    AddPrecisionName(_T("x"));      // MeaX
-    AddPrecisionName(_T("y"));      // MeaY
-    AddPrecisionName(_T("w"));      // MeaW
-    AddPrecisionName(_T("h"));      // MeaH
-    AddPrecisionName(_T("d"));      // MeaD
-    AddPrecisionName(_T("area"));   // MeaAr
-    AddPrecisionName(_T("rx"));     // MeaRx
-    AddPrecisionName(_T("ry"));     // MeaRy
+    SetPrecisionNames(kLinearPrecisionNames, std::size(kLinearPrecisionNames));
 }
 
 MeaLinearUnits::~MeaLinearUnits() {}
@@ -154,89 +181,103 @@ bool MeaLinearUnits::RequiresRes() const {
 }
 
 CString MeaLinearUnits::Format(MeaLinearMeasurementId id, double value) const {
-    CString vstr;
-    vstr.Format(_T("%0.*f"), GetDisplayPrecisions()[id], value);
-    return vstr;
+    MeaNumberFormat::Buffer buffer;
+    std::string_view vstr = MeaNumberFormat::FormatFixed(buffer, value, GetDisplayPrecisions()[id]);
+    return CString(vstr.data(), static_cast<int>(vstr.size()));
 }
 
 MeaFPoint MeaLinearUnits::ConvertCoord(const POINT& pos) const {
-    MeaFPoint fpos;
-    MeaFSize fromPixels = FromPixels(m_screenProvider.GetScreenRes(m_screenProvider.GetScreenIter(pos)));
+    return CurrentTransform().ConvertCoord(pos);
+}
 
-    fpos.x = fromPixels.cx * (pos.x - m_originOffset.x);
+void MeaLinearUnits::ConvertCoords(const POINT* points, MeaFPoint* coords, std::size_t count) const {
+    CurrentTransform().ConvertCoords(points, coords, count);
+}
 
-    if (m_invertY) {
-        if ((m_originOffset.x == 0) && (m_originOffset.y == 0)) {
-            fpos.y = fromPixels.cy * (m_screenProvider.GetVirtualRect().Height() - 1 - pos.y);
-        } else {
-            fpos.y = fromPixels.cy * (m_originOffset.y - pos.y);
-        }
-    } else {
-        fpos.y = fromPixels.cy * (pos.y - m_originOffset.y);
-    }
+double MeaLinearUnits::ConvertCoord(MeaConvertDir dir, const CWnd* wnd, int pos) const {
+    return GetAxisConversion(dir, wnd).Convert(pos);
+}
 
-    return fpos;
+double MeaLinearUnits::UnconvertCoord(MeaConvertDir dir, const CWnd* wnd, double pos) const {
+    return GetAxisConversion(dir, wnd).Unconvert(pos);
 }
 
-double MeaLinearUnits::ConvertCoord(MeaConvertDir dir, const CWnd* wnd, int pos) const {
-    MeaFSize fromPixels = FromPixels(m_screenProvider.GetScreenRes(m_screenProvider.GetScreenIter(wnd)));
+POINT MeaLinearUnits::UnconvertCoord(const MeaFPoint& pos) const {
+    return CurrentTransform().UnconvertCoord(pos);
+}
 
-    if (dir == MeaConvertX) {
-        return fromPixels.cx * (pos - m_originOffset.x);
-    }
+void MeaLinearUnits::UnconvertCoords(const MeaFPoint* coords, POINT* points, std::size_t count) const {
+    CurrentTransform().UnconvertCoords(coords, points, count);
+}
 
-    if (m_invertY) {
-        if ((m_originOffset.x == 0) && (m_originOffset.y == 0)) {
-            return fromPixels.cy * (m_screenProvider.GetVirtualRect().Height() - 1 - pos);
-        }
-        return fromPixels.cy * (m_originOffset.y - pos);
-    }
-    return fromPixels.cy * (pos - m_originOffset.y);
+bool MeaLinearUnits::UnconvertCoord(MeaConvertDir dir, const CWnd* wnd, double pos, int& c1, int& c2) const {
+    double la = FindTickPixels(GetAxisConversion(dir, wnd), pos, c1, c2);
+    return MeaNumberFormat::SameFixed(pos, la, GetDisplayPrecisions()[MeaX]);
 }
 
-double MeaLinearUnits::UnconvertCoord(MeaConvertDir dir, const CWnd* wnd, double pos) const {
-    MeaFSize fromPixels = FromPixels(m_screenProvider.GetScreenRes(m_screenProvider.GetScreenIter(wnd)));
+void MeaLinearUnits::UnconvertTicks(MeaConvertDir dir, const CWnd* wnd, const double* positions, TickPixels* ticks,
+                                    std::size_t count) const {
+    constexpr std::size_t kChunkSize = 64;
+    double converted[kChunkSize];
+    bool exact[kChunkSize];
 
-    if (dir == MeaConvertX) {
-        return pos / fromPixels.cx + m_originOffset.x;
-    }
+    AxisConversion axis = GetAxisConversion(dir, wnd);
+    int precision = GetDisplayPrecisions()[MeaX];
 
-    if (m_invertY) {
-        if ((m_originOffset.x == 0) && (m_originOffset.y == 0)) {
-            return  (m_screenProvider.GetVirtualRect().Height() - 1) - pos / fromPixels.cy;
+    for (std::size_t start = 0; start < count; start += kChunkSize) {
+        std::size_t chunkCount = (count - start < kChunkSize) ? count - start : kChunkSize;
+
+        for (std::size_t i = 0; i < chunkCount; i++) {
+            TickPixels& tick = ticks[start + i];
+            converted[i] = FindTickPixels(axis, positions[start + i], tick.m_c1, tick.m_c2);
+        }
+
+        MeaNumberFormat::SameFixed(positions + start, converted, exact, chunkCount, precision);
+
+        for (std::size_t i = 0; i < chunkCount; i++) {
+            ticks[start + i].m_exact = exact[i];
         }
-        return  m_originOffset.y - pos / fromPixels.cy;
     }
-    return pos / fromPixels.cy + m_originOffset.y;
 }
 
-POINT MeaLinearUnits::UnconvertCoord(const MeaFPoint& pos) const {
-    POINT point;
-    MeaFSize fromPixels = FromPixels(FindResFromCoord(pos));
+MeaLinearUnits::AxisConversion MeaLinearUnits::GetAxisConversion(MeaConvertDir dir, const CWnd* wnd) const {
+    MeaFSize fromPixels = FromPixels(m_screenProvider.GetScreenRes(m_screenProvider.GetScreenIter(wnd)));
+    const POINT& origin = m_defaultContext.m_origin;
+    AxisConversion axis;
 
-    point.x = static_cast<long>(pos.x / fromPixels.cx + m_originOffset.x);
+    if (dir == MeaConvertX) {
+        axis.m_factor = fromPixels.cx;
+        axis.m_sign = 1;
+        axis.m_offset = -origin.x;
+        axis.m_base = origin.x;
+        return axis;
+    }
 
-    if (m_invertY) {
-        if ((m_originOffset.x == 0) && (m_originOffset.y == 0)) {
-            point.y = static_cast<long>((m_screenProvider.GetVirtualRect().Height() - 1) - pos.y / fromPixels.cy);
+    axis.m_factor = fromPixels.cy;
+    if (m_defaultContext.m_invertY) {
+        axis.m_sign = -1;
+        if ((origin.x == 0) && (origin.y == 0)) {
+            axis.m_offset = m_screenProvider.GetVirtualRect().Height() - 1;
         } else {
-            point.y = static_cast<long>(m_originOffset.y - pos.y / fromPixels.cy);
+            axis.m_offset = origin.y;
         }
+        axis.m_base = axis.m_offset;
     } else {
-        point.y = static_cast<long>(pos.y / fromPixels.cy + m_originOffset.y);
+        axis.m_sign = 1;
+        axis.m_offset = -origin.y;
+        axis.m_base = origin.y;
     }
-
-    return point;
+    return axis;
 }
 
-bool MeaLinearUnits::UnconvertCoord(MeaConvertDir dir, const CWnd* wnd, double pos, int& c1, int& c2) const {
-    int p1 = static_cast<int>(UnconvertCoord(dir, wnd, pos));
+double MeaLinearUnits::FindTickPixels(const AxisConversion& axis, double pos, int& c1, int& c2) {
+    int p1 = static_cast<int>(axis.Unconvert(pos));
     int p2 = p1 - 1;
     int p3 = p1 + 1;
 
-    double l1 = ConvertCoord(dir, wnd, p1);
-    double l2 = ConvertCoord(dir, wnd, p2);
-    double l3 = ConvertCoord(dir, wnd, p3);
+    double l1 = axis.Convert(p1);
+    double l2 = axis.Convert(p2);
+    double l3 = axis.Convert(p3);
     double la;
 
     double d1 = fabs(pos - l1);
@@ -265,17 +306,15 @@ bool MeaLinearUnits::UnconvertCoord(MeaConvertDir dir, const CWnd* wnd, double p
         }
     }
 
-    return (Format(MeaX, pos) == Format(MeaX, la));
+    return la;
 }
 
 MeaFPoint MeaLinearUnits::ConvertPos(const POINT& pos) const {
-    MeaFSize fromPixels = FromPixels(m_screenProvider.GetScreenRes(m_screenProvider.GetScreenIter(pos)));
-    return MeaFPoint(fromPixels.cx * pos.x, fromPixels.cy * pos.y);
+    return CurrentTransform().ConvertPos(pos);
 }
 
 POINT MeaLinearUnits::UnconvertPos(const MeaFPoint& pos) const {
-    MeaFSize fromPixels = FromPixels(FindResFromPos(pos));
-    return CPoint(static_cast<long>(pos.x / fromPixels.cx), static_cast<long>(pos.y / fromPixels.cy));
+    return CurrentTransform().UnconvertPos(pos);
 }
 
 MeaFSize MeaLinearUnits::ConvertRes(const MeaFSize& res) const {
@@ -286,40 +325,45 @@ MeaFSize MeaLinearUnits::GetResFromPixels(const MeaFSize& res) const {
     return FromPixels(res);
 }
 
-const MeaFSize& MeaLinearUnits::FindResFromCoord(const MeaFPoint& pos) const {
-    if (m_screenProvider.GetNumScreens() != 1) {
-        MeaScreenProvider::ScreenIter iter;
+std::shared_ptr<const MeaUnitsTransform> MeaLinearUnits::GetTransform(const MeaUnitsContext& context) const {
+    if (context.SameLinear(m_defaultContext)) {
+        return GetTransform();
+    }
+    return BuildTransform(context);
+}
 
-        for (iter = m_screenProvider.GetScreenIter(); !m_screenProvider.AtEnd(iter); ++iter) {
-            const CRect& srect = m_screenProvider.GetScreenRect(iter);
-            MeaFPoint tl = ConvertCoord(srect.TopLeft());
-            MeaFPoint br = ConvertCoord(srect.BottomRight());
+const MeaUnitsTransform& MeaLinearUnits::CurrentTransform() const {
+    unsigned int screenVersion = m_screenProvider.GetLayoutVersion();
 
-            if ((tl.x <= pos.x) && (br.x > pos.x) && (tl.y <= pos.y) && (br.y > pos.y)) {
-                return m_screenProvider.GetScreenRes(iter);
-            }
-        }
+    if (m_transform && m_transformScreenVersion == screenVersion &&
+            m_transformConversionVersion == m_conversionVersion) {
+        return *m_transform;
     }
 
-    return m_screenProvider.GetScreenRes(m_screenProvider.GetScreenIter());
-}
-
-const MeaFSize& MeaLinearUnits::FindResFromPos(const MeaFPoint& pos) const {
-    if (m_screenProvider.GetNumScreens() != 1) {
-        MeaScreenProvider::ScreenIter iter;
+    // A new transform is created rather than modifying the current one, so that
+    // transforms previously handed out by GetTransform remain unchanged.
+    m_transform = BuildTransform(m_defaultContext);
+    m_transformScreenVersion = screenVersion;
+    m_transformConversionVersion = m_conversionVersion;
 
-        for (iter = m_screenProvider.GetScreenIter(); !m_screenProvider.AtEnd(iter); ++iter) {
-            const CRect& srect = m_screenProvider.GetScreenRect(iter);
-            MeaFPoint tl = ConvertPos(srect.TopLeft());
-            MeaFPoint br = ConvertPos(srect.BottomRight());
+    return *m_transform;
+}
 
-            if ((tl.x <= pos.x) && (br.x > pos.x) && (tl.y <= pos.y) && (br.y > pos.y)) {
-                return m_screenProvider.GetScreenRes(iter);
-            }
-        }
+std::shared_ptr<const MeaUnitsTransform> MeaLinearUnits::BuildTransform(const MeaUnitsContext& context) const {
+    MeaUnitsTransform::Screens screens;
+    for (MeaScreenProvider::ScreenIter iter = m_screenProvider.GetScreenIter(); !m_screenProvider.AtEnd(iter);
+            ++iter) {
+        const CRect& srect = m_screenProvider.GetScreenRect(iter);
+        MeaUnitsTransform::Screen screen;
+        screen.m_rect = MeaFRect(srect.top, srect.bottom, srect.left, srect.right);
+        screen.m_fromPixels = FromPixels(m_screenProvider.GetScreenRes(iter));
+        screens.push_back(screen);
     }
 
-    return m_screenProvider.GetScreenRes(m_screenProvider.GetScreenIter());
+    MeaFSize defaultFromPixels = FromPixels(m_screenProvider.GetScreenRes(m_screenProvider.GetScreenIter()));
+
+    return std::make_shared<const MeaUnitsTransform>(screens, defaultFromPixels, context,
+                                                     m_screenProvider.GetVirtualRect().Height());
 }
 
 SIZE MeaLinearUnits::ConvertToPixels(const MeaFSize& res, double value, int minPixels) const {
@@ -390,7 +434,8 @@ MeaPointUnits::MeaPointUnits(const MeaScreenProvider& screenProvider) :
 MeaPointUnits::~MeaPointUnits() {}
 
 MeaFSize MeaPointUnits::FromPixels(const MeaFSize& res) const {
-    return MeaFSize(72.0 / res.cx, 72.0 / res.cy);
+    return MeaFSize(MeaUnitsConversion::FromPixels(MeaUnitsConversion::kPointsPerInch, res.cx),
+                    MeaUnitsConversion::FromPixels(MeaUnitsConversion::kPointsPerInch, res.cy));
 }
 
 
@@ -413,7 +458,8 @@ MeaPicaUnits::MeaPicaUnits(const MeaScreenProvider& screenProvider) :
 MeaPicaUnits::~MeaPicaUnits() {}
 
 MeaFSize MeaPicaUnits::FromPixels(const MeaFSize& res) const {
-    return MeaFSize(6.0 / res.cx, 6.0 / res.cy);
+    return MeaFSize(MeaUnitsConversion::FromPixels(MeaUnitsConversion::kPicasPerInch, res.cx),
+                    MeaUnitsConversion::FromPixels(MeaUnitsConversion::kPicasPerInch, res.cy));
 }
 
 
@@ -436,7 +482,8 @@ MeaTwipUnits::MeaTwipUnits(const MeaScreenProvider& screenProvider) :
 MeaTwipUnits::~MeaTwipUnits() {}
 
 MeaFSize MeaTwipUnits::FromPixels(const MeaFSize& res) const {
-    return MeaFSize(1440.0 / res.cx, 1440.0 / res.cy);
+    return MeaFSize(MeaUnitsConversion::FromPixels(MeaUnitsConversion::kTwipsPerInch, res.cx),
+                    MeaUnitsConversion::FromPixels(MeaUnitsConversion::kTwipsPerInch, res.cy));
 }
 
 
@@ -459,7 +506,8 @@ MeaInchUnits::MeaInchUnits(const MeaScreenProvider& screenProvider) :
 MeaInchUnits::~MeaInchUnits() {}
 
 MeaFSize MeaInchUnits::FromPixels(const MeaFSize& res) const {
-    return MeaFSize(1.0 / res.cx, 1.0 / res.cy);
+    return MeaFSize(MeaUnitsConversion::FromPixels(MeaUnitsConversion::kInchesPerInch, res.cx),
+                    MeaUnitsConversion::FromPixels(MeaUnitsConversion::kInchesPerInch, res.cy));
 }
 
 
@@ -482,7 +530,8 @@ MeaCentimeterUnits::MeaCentimeterUnits(const MeaScreenProvider& screenProvider)
 MeaCentimeterUnits::~MeaCentimeterUnits() {}
 
 MeaFSize MeaCentimeterUnits::FromPixels(const MeaFSize& res) const {
-    return MeaFSize(2.54 / res.cx, 2.54 / res.cy);
+    return MeaFSize(MeaUnitsConversion::FromPixels(MeaUnitsConversion::kCentimetersPerInch, res.cx),
+                    MeaUnitsConversion::FromPixels(MeaUnitsConversion::kCentimetersPerInch, res.cy));
 }
 
 
@@ -505,7 +554,8 @@ MeaMillimeterUnits::MeaMillimeterUnits(const MeaScreenProvider& screenProvider)
 MeaMillimeterUnits::~MeaMillimeterUnits() {}
 
 MeaFSize MeaMillimeterUnits::FromPixels(const MeaFSize& res) const {
-    return MeaFSize(25.4 / res.cx, 25.4 / res.cy);
+    return MeaFSize(MeaUnitsConversion::FromPixels(MeaUnitsConversion::kMillimetersPerInch, res.cx),
+                    MeaUnitsConversion::FromPixels(MeaUnitsConversion::kMillimetersPerInch, res.cy));
 }
 
 
@@ -574,12 +624,14 @@ MeaFSize MeaCustomUnits::FromPixels(const MeaFSize& res) const {
         fromPixels.cy = 1.0 / m_scaleFactor;
         break;
     case InchBasis:
-        fromPixels.cx = 1.0 / (res.cx * m_scaleFactor);
-        fromPixels.cy = 1.0 / (res.cy * m_scaleFactor);
+        fromPixels.cx = MeaUnitsConversion::FromPixels(MeaUnitsConversion::kInchesPerInch, res.cx * m_scaleFactor);
+        fromPixels.cy = MeaUnitsConversion::FromPixels(MeaUnitsConversion::kInchesPerInch, res.cy * m_scaleFactor);
         break;
     case CentimeterBasis:
-        fromPixels.cx = 2.54 / (res.cx * m_scaleFactor);
-        fromPixels.cy = 2.54 / (res.cy * m_scaleFactor);
+        fromPixels.cx = MeaUnitsConversion::FromPixels(MeaUnitsConversion::kCentimetersPerInch,
+                                                       res.cx * m_scaleFactor);
+        fromPixels.cy = MeaUnitsConversion::FromPixels(MeaUnitsConversion::kCentimetersPerInch,
+                                                       res.cy * m_scaleFactor);
         break;
     }
 
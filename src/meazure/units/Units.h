@@ -23,9 +23,13 @@
 #pragma once
 
 #include <vector>
+#include <memory>
+#include <cstddef>
 #include <meazure/ui/ScreenProvider.h>
 #include <meazure/profile/Profile.h>
 #include <meazure/utilities/Geometry.h>
+#include "UnitsContext.h"
+#include "UnitsTransform.h"
 
 
 /// Identifiers for linear measurement units.
@@ -101,6 +105,14 @@ public:
     ///
     virtual ~MeaUnits();
 
+    /// Returns the default conversion context. The default context holds the
+    /// application's current origin, y-axis orientation and angle mode, and
+    /// is used by the conversion methods that do not take a context.
+    ///
+    /// @return Default conversion context.
+    ///
+    static const MeaUnitsContext& GetDefaultContext() { return m_defaultContext; }
+
     /// Persists the state of a units class instance to the specified
     /// profile object.
     ///
@@ -186,14 +198,16 @@ protected:
     ///
     explicit MeaUnits(PCTSTR unitsStr);
 
-    /// Adds the specified identifying name to the list of
-    /// precision names.
+    /// Sets the identifying names of the precisions and builds the profile
+    /// key for each precision. The keys have the form
+    /// "Precision-<name>-<units>" and are built once so that saving and
+    /// loading the precisions does not format any strings.
     ///
-    /// @param name     [in] Identifying name for the precision.
+    /// @param names    [in] Identifying names for the precisions, indexed
+    ///                 by measurement identifier.
+    /// @param count    [in] Number of names.
     ///
-    void AddPrecisionName(PCTSTR name) {
-        m_displayPrecisionNames.push_back(name);
-    }
+    void SetPrecisionNames(const PCTSTR* names, std::size_t count);
 
     /// Adds the specified precision value to both the list
     /// of current precisions and the list of default precisions.
@@ -205,10 +219,14 @@ protected:
         m_displayPrecisions.push_back(precision);
     }
 
+
+    static MeaUnitsContext m_defaultContext;        ///< Conversion settings used when no context is specified.
+
 private:
     DisplayPrecisions m_defaultPrecisions;          ///< Default precisions for all measurement types.
     DisplayPrecisions m_displayPrecisions;          ///< Current precisions for all measurement types.
     DisplayPrecisionNames m_displayPrecisionNames;  ///< Names for all precision values.
+    std::vector<CString> m_precisionKeys;           ///< Profile keys for all precision values.
     CString m_unitsStr;                             ///< Name for the units.
 };
 
@@ -242,13 +260,15 @@ public:
     /// 
     /// @param showSupplemental     [in] true to show supplemental angle instead of included angle
     /// 
-    static void SetSupplementalAngle(boolean showSupplemental) { m_supplementalAngle = showSupplemental; }
+    static void SetSupplementalAngle(boolean showSupplemental) {
+        m_defaultContext.m_supplementalAngle = (showSupplemental != 0);
+    }
 
     /// Indicates whether the included angle is shown (default) or the supplemental angle.
     /// 
     /// @return true if the supplemental angle is shown.
     ///  
-    static bool IsSupplementalAngle() { return m_supplementalAngle; }
+    static bool IsSupplementalAngle() { return m_defaultContext.m_supplementalAngle; }
 
     /// Formats the specified angular measurement value using the
     /// precision for the specified measurement ID.
@@ -263,13 +283,24 @@ public:
     CString Format(MeaAngularMeasurementId id, double value) const;
 
     /// Converts the specified angle value from its native radians
-    /// to the desired units.
+    /// to the desired units using the default context.
+    ///
+    /// @param angle    [in] Value to be converted.
+    ///
+    /// @return Angle value converted to the desired units.
+    ///
+    double ConvertAngle(double angle) const { return ConvertAngle(angle, m_defaultContext); }
+
+    /// Converts the specified angle value from its native radians
+    /// to the desired units using the angle mode of the specified
+    /// context.
     ///
     /// @param angle    [in] Value to be converted.
+    /// @param context  [in] Determines whether the supplemental angle is shown.
     ///
     /// @return Angle value converted to the desired units.
     ///
-    virtual double ConvertAngle(double angle) const = 0;
+    double ConvertAngle(double angle, const MeaUnitsContext& context) const;
 
 protected:
     /// Constructs an angular-based unit.
@@ -279,8 +310,16 @@ protected:
     ///
     MeaAngularUnits(MeaAngularUnitsId unitsId, PCTSTR unitsStr);
 
+    /// Converts the specified angle value from radians to the
+    /// desired units.
+    ///
+    /// @param angle    [in] Value to be converted.
+    ///
+    /// @return Angle value converted to the desired units.
+    ///
+    virtual double FromRadians(double angle) const = 0;
+
 private:
-    static bool m_supplementalAngle;    ///< Indicates if the supplemental rather than included angle should be shown.
     MeaAngularUnitsId m_unitsId;        ///< Identifier for the units.
 };
 
@@ -298,6 +337,7 @@ public:
     ///
     ~MeaDegreeUnits();
 
+protected:
     /// Converts the specified angle value from its native radians
     /// to degrees.
     ///
@@ -305,7 +345,7 @@ public:
     ///
     /// @return Angle value in degrees.
     ///
-    virtual double ConvertAngle(double angle) const override;
+    virtual double FromRadians(double angle) const override;
 };
 
 
@@ -322,6 +362,7 @@ public:
     ///
     ~MeaRadianUnits();
 
+protected:
     /// Passthru method returning the specified
     /// angle in radians.
     ///
@@ -329,7 +370,7 @@ public:
     ///
     /// @return Angle value in radians.
     ///
-    virtual double ConvertAngle(double angle) const override;
+    virtual double FromRadians(double angle) const override;
 };
 
 
@@ -366,7 +407,10 @@ public:
     ///                     display screen and making positive y pointing
     ///                     upward.
     ///
-    static void SetInvertY(bool invertY) { m_invertY = invertY; }
+    static void SetInvertY(bool invertY) {
+        m_defaultContext.m_invertY = invertY;
+        m_conversionVersion++;
+    }
 
     /// Returns the orientation of the y-axis.
     ///
@@ -378,7 +422,7 @@ public:
     ///         actual location of the origin is determined by the SetOrigin
     ///         method.
     ///
-    static bool IsInvertY() { return m_invertY; }
+    static bool IsInvertY() { return m_defaultContext.m_invertY; }
 
     /// Moves the origin of the coordinate system to the specified point. The
     /// orientation of the axes is not effected by this method. To change the
@@ -387,13 +431,16 @@ public:
     /// @param origin   [in] New location for the origin of the coordinate system.
     ///                 in pixels.
     ///
-    static void SetOrigin(const POINT& origin) { m_originOffset = origin; }
+    static void SetOrigin(const POINT& origin) {
+        m_defaultContext.m_origin = origin;
+        m_conversionVersion++;
+    }
 
     /// Returns the location of the origin of the coordinate system.
     ///
     /// @return Location of the origin of the coordinate system, in pixels.
     ///
-    static const POINT& GetOrigin() { return m_originOffset; }
+    static const POINT& GetOrigin() { return m_defaultContext.m_origin; }
 
     /// Internally all measurements are in pixels. Measurement units based
     /// solely on pixels do not require the use of the screen resolution for
@@ -420,6 +467,33 @@ public:
     ///
     CString Format(MeaLinearMeasurementId id, double value) const;
 
+    /// Obtains the transform between pixels and these units for the current
+    /// screens, origin and y-axis orientation. A new transform is built when
+    /// any of these change. The transform is immutable, so it can be handed
+    /// to other threads and used there without locking. It continues to
+    /// describe the settings in effect when it was obtained.
+    ///
+    /// @return Transform for the current settings.
+    ///
+    std::shared_ptr<const MeaUnitsTransform> GetTransform() const {
+        CurrentTransform();
+        return m_transform;
+    }
+
+    /// Obtains the transform between pixels and these units for the current
+    /// screens and the origin and y-axis orientation of the specified context.
+    /// If the context matches the default context, the current transform is
+    /// returned. Otherwise a new transform is built, leaving the default
+    /// context and the current transform untouched. The transform must be
+    /// obtained on the thread that owns the screen information, but may then
+    /// be used on any thread.
+    ///
+    /// @param context  [in] Origin and y-axis orientation for the conversion.
+    ///
+    /// @return Transform for the specified context.
+    ///
+    std::shared_ptr<const MeaUnitsTransform> GetTransform(const MeaUnitsContext& context) const;
+
     /// Converts the specified coordinate from pixels to the desired units.
     /// This conversion takes into account the location of the origin and the
     /// orientation of the y-axis.
@@ -432,6 +506,33 @@ public:
     ///         
     MeaFPoint ConvertCoord(const POINT& pos) const;
 
+    /// Converts the specified coordinates from pixels to the desired units.
+    /// The results are identical to calling ConvertCoord for each point.
+    /// Consecutive points on the same screen are converted together using
+    /// the conversion factors for that screen, so the screen is only located
+    /// when a point lies on a different screen than its predecessor.
+    ///
+    /// @param points   [in] Coordinates in pixels to convert.
+    /// @param coords   [out] Coordinates converted to the desired units. Must
+    ///                 have room for count points.
+    /// @param count    [in] Number of points to convert.
+    ///
+    void ConvertCoords(const POINT* points, MeaFPoint* coords, std::size_t count) const;
+
+    /// Converts the specified coordinates from pixels to the desired units
+    /// using the origin and y-axis orientation of the specified context.
+    ///
+    /// @param points   [in] Coordinates in pixels to convert.
+    /// @param coords   [out] Coordinates converted to the desired units. Must
+    ///                 have room for count points.
+    /// @param count    [in] Number of points to convert.
+    /// @param context  [in] Origin and y-axis orientation for the conversion.
+    ///
+    void ConvertCoords(const POINT* points, MeaFPoint* coords, std::size_t count,
+                       const MeaUnitsContext& context) const {
+        GetTransform(context)->ConvertCoords(points, coords, count);
+    }
+
     /// Converts the specified position from pixels to the desired units.
     /// This conversion does not take into account the location of the origin
     /// nor does it compensate for the orientation of the y-axis.
@@ -481,10 +582,35 @@ public:
     /// @param c2       [out] Closest integral pixel value above the converted
     ///                 coordinate.
     ///
-    /// @return <b>true</b> if the conversion to pixels was exact.
+    /// @return <b>true</b> if the conversion to pixels was exact, that is, if the
+    ///         coordinate and the coordinate of the closest pixel are the same
+    ///         when displayed with the x coordinate precision.
     ///
     bool UnconvertCoord(MeaConvertDir dir, const CWnd* wnd, double pos, int& c1, int& c2) const;
 
+    /// Pixel placement of a coordinate, as determined by UnconvertCoord.
+    ///
+    struct TickPixels {
+        int m_c1;           ///< Closest integral pixel value to the converted coordinate.
+        int m_c2;           ///< Integral pixel value on the other side of the converted coordinate.
+        bool m_exact;       ///< Indicates if the conversion to pixels was exact.
+    };
+
+    /// Converts a series of coordinates on the specified axis from the current
+    /// units to pixels, as UnconvertCoord does for a single coordinate. The
+    /// screen resolution is determined once for all the coordinates. This is
+    /// used to place the tick marks on a ruler.
+    ///
+    /// @param dir          [in] Axis on which the conversion should take place.
+    /// @param wnd          [in] Window used to determine the screen resolution.
+    /// @param positions    [in] Coordinates to convert to pixels.
+    /// @param ticks        [out] Pixel placement of each coordinate. Must have
+    ///                     room for count entries.
+    /// @param count        [in] Number of coordinates to convert.
+    ///
+    void UnconvertTicks(MeaConvertDir dir, const CWnd* wnd, const double* positions, TickPixels* ticks,
+                        std::size_t count) const;
+
     /// Converts from the current units to pixels. The conversion takes into account
     /// the location of the origin and the orientation of the y-axis.
     ///
@@ -496,6 +622,32 @@ public:
     ///
     POINT UnconvertCoord(const MeaFPoint& pos) const;
 
+    /// Converts the specified coordinates from the current units to pixels.
+    /// The results are identical to calling UnconvertCoord for each point.
+    /// Consecutive points on the same screen are converted together using
+    /// the conversion factors for that screen.
+    ///
+    /// @param coords   [in] Coordinates in the current units to convert.
+    /// @param points   [out] Coordinates converted to pixels. Must have room
+    ///                 for count points.
+    /// @param count    [in] Number of points to convert.
+    ///
+    void UnconvertCoords(const MeaFPoint* coords, POINT* points, std::size_t count) const;
+
+    /// Converts the specified coordinates from the current units to pixels
+    /// using the origin and y-axis orientation of the specified context.
+    ///
+    /// @param coords   [in] Coordinates in the current units to convert.
+    /// @param points   [out] Coordinates converted to pixels. Must have room
+    ///                 for count points.
+    /// @param count    [in] Number of points to convert.
+    /// @param context  [in] Origin and y-axis orientation for the conversion.
+    ///
+    void UnconvertCoords(const MeaFPoint* coords, POINT* points, std::size_t count,
+                         const MeaUnitsContext& context) const {
+        GetTransform(context)->UnconvertCoords(coords, points, count);
+    }
+
     /// Converts from the current units to pixels. The conversion does not take into
     /// account the location of the origin nor the orientation of the y-axis.
     ///
@@ -565,40 +717,76 @@ protected:
     ///
     double ConvertCoord(MeaConvertDir dir, const CWnd* wnd, int pos) const;
 
-    /// In a multiple monitor environment there are multiple screen resolutions,
-    /// one set per monitor. Therefore, to determine the a resolution, a screen must
-    /// be determined. This method uses the specified position to determined a screen
-    /// and thus a resolution. The method compensates for the location of the origin
-    /// and the orientation of the y-axis.
+    /// Discards the current transform. Must be called by derived classes whenever
+    /// the values returned by FromPixels change.
     ///
-    /// @param pos      [in] Position used to determine a screen and thus a resolution,
-    ///                 in the current units.
+    void InvalidateTransform() { m_transform.reset(); }
+
+protected:
+    const MeaScreenProvider& m_screenProvider;  ///< Screen information provider
+
+private:
+    /// Conversion along one axis between pixels and the current units for the
+    /// screen containing a window. A coordinate c and pixel p are related by
+    /// c = factor * (sign * p + offset) and p = sign * (c / factor) + base.
+    /// The offset is applied to the integral pixel value so that the results
+    /// are the same as applying the origin and y-axis orientation case by case.
     ///
-    /// @return Screen resolution, in the current units.
+    struct AxisConversion {
+        double m_factor;    ///< Conversion factor from pixels to the current units.
+        long m_sign;        ///< -1 if the axis is inverted, otherwise 1.
+        long m_offset;      ///< Offset applied to pixels before scaling.
+        long m_base;        ///< Offset applied to unscaled coordinates.
+
+        double Convert(int pos) const { return m_factor * (m_sign * pos + m_offset); }
+
+        double Unconvert(double pos) const { return m_sign * (pos / m_factor) + m_base; }
+    };
+
+
+    /// Obtains the conversion along the specified axis for the screen
+    /// containing the specified window, using the default context.
+    ///
+    /// @param dir      [in] Axis on which the conversion takes place.
+    /// @param wnd      [in] Window used to determine the screen resolution.
     ///
-    const MeaFSize& FindResFromCoord(const MeaFPoint& pos) const;
+    /// @return Conversion along the axis.
+    ///
+    AxisConversion GetAxisConversion(MeaConvertDir dir, const CWnd* wnd) const;
 
-    /// In a multiple monitor environment there are multiple screen resolutions,
-    /// one set per monitor. Therefore, to determine the a resolution, a screen must
-    /// be determined. This method uses the specified position to determined a screen
-    /// and thus a resolution. The method does not compensate for the location of the
-    /// origin nor the orientation of the y-axis.
+    /// Determines the pixels bounding the specified coordinate.
     ///
-    /// @param pos      [in] Position used to determine a screen and thus a resolution,
-    ///                 in the current units.
+    /// @param axis     [in] Conversion along the axis of the coordinate.
+    /// @param pos      [in] Coordinate to convert to pixels.
+    /// @param c1       [out] Closest integral pixel value to the coordinate.
+    /// @param c2       [out] Integral pixel value on the other side of the coordinate.
     ///
-    /// @return Screen resolution, in the current units.
+    /// @return Coordinate of the pixel c1, in the current units.
     ///
-    const MeaFSize& FindResFromPos(const MeaFPoint& pos) const;
+    static double FindTickPixels(const AxisConversion& axis, double pos, int& c1, int& c2);
 
-protected:
-    const MeaScreenProvider& m_screenProvider;  ///< Screen information provider
+    /// Obtains the transform for the current settings, rebuilding it if the
+    /// screens, origin or y-axis orientation have changed since it was built.
+    ///
+    /// @return Current transform.
+    ///
+    const MeaUnitsTransform& CurrentTransform() const;
 
-private:
-    static CPoint m_originOffset;               ///< Offset of the origin from the system origin, in pixels.
-    static bool m_invertY;                      ///< Indicates if the y-axis direction is inverted.
+    /// Builds a transform for the current screens and the specified context.
+    ///
+    /// @param context  [in] Origin and y-axis orientation for the transform.
+    ///
+    /// @return New transform.
+    ///
+    std::shared_ptr<const MeaUnitsTransform> BuildTransform(const MeaUnitsContext& context) const;
+
+
+    static unsigned int m_conversionVersion;    ///< Incremented when the default origin or y-axis orientation changes.
     MeaLinearUnitsId m_unitsId;                 ///< Linear units identifier.
     int m_majorTickCount;                       ///< Number of minor ruler tick marks between major tick marks.
+    mutable std::shared_ptr<const MeaUnitsTransform> m_transform;   ///< Transform for the current settings.
+    mutable unsigned int m_transformScreenVersion { 0 };        ///< Screen layout version of the transform.
+    mutable unsigned int m_transformConversionVersion { 0 };    ///< Origin and y-axis version of the transform.
 };
 
 
@@ -931,7 +1119,10 @@ public:
     ///
     /// @param scaleBasis       [in] Conversion basis.
     ///
-    void SetScaleBasis(ScaleBasis scaleBasis) { m_scaleBasis = scaleBasis; }
+    void SetScaleBasis(ScaleBasis scaleBasis) {
+        m_scaleBasis = scaleBasis;
+        InvalidateTransform();
+    }
 
     /// Sets the conversion basis using a string identifier.
     ///
@@ -951,7 +1142,10 @@ public:
     /// @param scaleFactor  [in] Conversion factor from the conversion
     ///                     basis to the custom units.
     ///
-    void SetScaleFactor(double scaleFactor) { m_scaleFactor = scaleFactor; }
+    void SetScaleFactor(double scaleFactor) {
+        m_scaleFactor = scaleFactor;
+        InvalidateTransform();
+    }
 
     /// Returns the X and Y factors to convert from pixels to the
     /// custom units. In other words, multiplying the values returned
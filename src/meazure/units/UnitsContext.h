@@ -0,0 +1,52 @@
+/*
+ * Copyright 2022 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/// @file
+/// @brief Header file for the settings that govern the conversion of measurements.
+
+#pragma once
+
+
+/// Settings that determine how measurements are converted for display: the location of the origin, the
+/// orientation of the y-axis and whether the supplemental angle is shown. A context is a plain value. The
+/// units classes keep a default context that reflects the application's current settings, and the conversion
+/// methods that take a context can be used to convert measurements recorded under other settings without
+/// changing the default.
+///
+struct MeaUnitsContext {
+    POINT m_origin { 0, 0 };            ///< Location of the origin of the coordinate system, in pixels.
+    bool m_invertY { false };           ///< Indicates if the positive y-axis points upward.
+    bool m_supplementalAngle { false }; ///< Indicates if the supplemental rather than included angle is shown.
+
+    /// Indicates whether the linear conversion settings of this context match those of the specified context.
+    /// The angle mode does not affect linear conversions and is not compared.
+    ///
+    /// @param other    [in] Context to compare.
+    /// @return <b>true</b> if the origin and y-axis orientation are the same.
+    ///
+    bool SameLinear(const MeaUnitsContext& other) const {
+        return m_origin.x == other.m_origin.x && m_origin.y == other.m_origin.y && m_invertY == other.m_invertY;
+    }
+
+    bool operator==(const MeaUnitsContext& other) const {
+        return SameLinear(other) && m_supplementalAngle == other.m_supplementalAngle;
+    }
+
+    bool operator!=(const MeaUnitsContext& other) const { return !(*this == other); }
+};
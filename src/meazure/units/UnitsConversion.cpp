@@ -0,0 +1,52 @@
+/*
+ * Copyright 2022 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "UnitsConversion.h"
+#include <utility>
+
+
+double MeaUnitsConversion::UnitsPerInch(const std::string& units) {
+    static const std::pair<const char*, double> kTable[] = {
+        { "pt", kPointsPerInch }, { "tp", kTwipsPerInch }, { "in", kInchesPerInch },
+        { "cm", kCentimetersPerInch }, { "mm", kMillimetersPerInch }, { "pc", kPicasPerInch }
+    };
+
+    for (const auto& entry : kTable) {
+        if (units == entry.first) {
+            return entry.second;
+        }
+    }
+    return 0.0;
+}
+
+MeaUnitsConversion::Origin::Origin(double originX, double originY, bool invertY, double virtualHeight) :
+        m_originX(originX) {
+    // When the y-axis is inverted and the origin has not been moved, the origin
+    // is placed at the bottom of the virtual screen.
+    if (!invertY) {
+        m_signY = 1.0;
+        m_offsetY = -originY;
+    } else if ((originX == 0.0) && (originY == 0.0)) {
+        m_signY = -1.0;
+        m_offsetY = virtualHeight - 1.0;
+    } else {
+        m_signY = -1.0;
+        m_offsetY = originY;
+    }
+}
@@ -0,0 +1,141 @@
+/*
+ * Copyright 2022 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/// @file
+/// @brief Header file for the portable rules that convert between pixels and linear units.
+
+#pragma once
+
+#include <string>
+
+
+/// Rules for converting between pixels and linear units that are shared by the application's units
+/// (MeaLinearUnits and MeaUnitsTransform) and the position log converter (MeaPositionLogConverter). Keeping the
+/// rules in one place ensures that converted logs match the values the application records. The functions do
+/// not depend on MFC or Windows and can be used on any platform.
+///
+namespace MeaUnitsConversion {
+
+    constexpr double kInchesPerInch { 1.0 };            ///< Inches per inch.
+    constexpr double kPointsPerInch { 72.0 };           ///< Points per inch.
+    constexpr double kTwipsPerInch { 1440.0 };          ///< Twips per inch.
+    constexpr double kPicasPerInch { 6.0 };             ///< Picas per inch.
+    constexpr double kCentimetersPerInch { 2.54 };      ///< Centimeters per inch.
+    constexpr double kMillimetersPerInch { 25.4 };      ///< Millimeters per inch.
+
+
+    /// Obtains the number of units per inch for the length units with the specified abbreviation, as written
+    /// in position log files (e.g. "mm").
+    ///
+    /// @param units    [in] Abbreviation of the length units.
+    /// @return Units per inch, or 0 for pixels and unknown units.
+    ///
+    double UnitsPerInch(const std::string& units);
+
+    /// Computes the factor that converts pixels to units on a screen with the specified resolution.
+    ///
+    /// @param unitsPerInch     [in] Number of units per inch.
+    /// @param res              [in] Resolution of the screen, in pixels per inch.
+    ///
+    /// @return Conversion factor from pixels to the units.
+    ///
+    constexpr double FromPixels(double unitsPerInch, double res) {
+        return unitsPerInch / res;
+    }
+
+    /// Computes the square of the distance from a pixel to a screen, using the rule the system uses for a
+    /// point between monitors: the screen whose edge is closest to the point is the nearest.
+    ///
+    /// @param left     [in] Left edge of the screen, in pixels.
+    /// @param top      [in] Top edge of the screen, in pixels.
+    /// @param right    [in] Right edge of the screen, in pixels. Exclusive.
+    /// @param bottom   [in] Bottom edge of the screen, in pixels. Exclusive.
+    /// @param x        [in] X coordinate of the pixel.
+    /// @param y        [in] Y coordinate of the pixel.
+    ///
+    /// @return Square of the distance, which is 0 if the pixel is on the screen.
+    ///
+    constexpr double ScreenDistanceSq(double left, double top, double right, double bottom, double x, double y) {
+        double dx = (x < left) ? left - x : ((x >= right) ? x - right + 1 : 0.0);
+        double dy = (y < top) ? top - y : ((y >= bottom) ? y - bottom + 1 : 0.0);
+        return dx * dx + dy * dy;
+    }
+
+
+    /// Location of the origin and orientation of the y-axis, reduced to an offset and sign applied in pixel
+    /// space: x' = fx * (x - originX) and y' = fy * (signY * y + offsetY), where fx and fy are the conversion
+    /// factors from pixels to the units. Pixel coordinates are whole numbers, so the results are the same as
+    /// applying the origin and y-axis orientation case by case.
+    ///
+    class Origin {
+
+    public:
+        /// Constructs the reduced form of an origin.
+        ///
+        /// @param originX          [in] X coordinate of the origin, in pixels.
+        /// @param originY          [in] Y coordinate of the origin, in pixels.
+        /// @param invertY          [in] true if the y-axis increases upward.
+        /// @param virtualHeight    [in] Height of the virtual screen, in pixels. When the y-axis is inverted
+        ///                         and the origin is at the system origin, the origin is placed at the bottom
+        ///                         of the virtual screen.
+        ///
+        Origin(double originX, double originY, bool invertY, double virtualHeight);
+
+        /// Converts an x coordinate from pixels to the units.
+        ///
+        /// @param x            [in] X coordinate, in pixels.
+        /// @param fromPixels   [in] Conversion factor from pixels to the units.
+        /// @return X coordinate in the units.
+        ///
+        double ConvertX(double x, double fromPixels) const { return fromPixels * (x - m_originX); }
+
+        /// Converts a y coordinate from pixels to the units.
+        ///
+        /// @param y            [in] Y coordinate, in pixels.
+        /// @param fromPixels   [in] Conversion factor from pixels to the units.
+        /// @return Y coordinate in the units.
+        ///
+        double ConvertY(double y, double fromPixels) const { return fromPixels * (m_signY * y + m_offsetY); }
+
+        /// Converts an x coordinate from the units to pixels. The conversion divides by the factor rather than
+        /// multiplying by its reciprocal so that the result matches that of a direct conversion. The result is
+        /// not rounded to a whole pixel.
+        ///
+        /// @param x            [in] X coordinate in the units.
+        /// @param fromPixels   [in] Conversion factor from pixels to the units.
+        /// @return X coordinate, in pixels.
+        ///
+        double UnconvertX(double x, double fromPixels) const { return x / fromPixels + m_originX; }
+
+        /// Converts a y coordinate from the units to pixels in the same manner as UnconvertX.
+        ///
+        /// @param y            [in] Y coordinate in the units.
+        /// @param fromPixels   [in] Conversion factor from pixels to the units.
+        /// @return Y coordinate, in pixels.
+        ///
+        double UnconvertY(double y, double fromPixels) const {
+            return m_signY * (y / fromPixels) - m_signY * m_offsetY;
+        }
+
+    private:
+        double m_originX;       ///< X coordinate of the origin, in pixels.
+        double m_signY;         ///< -1 if the y-axis is inverted, otherwise 1.
+        double m_offsetY;       ///< Offset applied to y coordinates, in pixels.
+    };
+};
@@ -304,6 +304,15 @@ public:
     ///
     const POINT& GetOrigin() const override { return MeaLinearUnits::GetOrigin(); }
 
+    /// Returns the current origin, y-axis orientation and angle mode as a
+    /// conversion context. A copy of the context can be modified and passed
+    /// to the conversion methods that take a context without changing the
+    /// current settings.
+    ///
+    /// @return Current conversion context.
+    ///
+    const MeaUnitsContext& GetContext() const { return MeaUnits::GetDefaultContext(); }
+
     /// Uses the current linear measurement units to convert the two specified
     /// points from pixels to the current units, and then calculates the
     /// width and height of the rectangle formed by the two points.
@@ -404,6 +413,40 @@ public:
         return m_currentLinearUnits->ConvertCoord(pos);
     }
 
+    /// Obtains the immutable transform between pixels and the current linear
+    /// units. The transform may be used from any thread. See
+    /// MeaLinearUnits::GetTransform.
+    ///
+    /// @return Transform for the current units and settings.
+    ///
+    std::shared_ptr<const MeaUnitsTransform> GetTransform() const {
+        return m_currentLinearUnits->GetTransform();
+    }
+
+    /// Obtains the immutable transform between pixels and the current linear
+    /// units for the origin and y-axis orientation of the specified context.
+    /// See MeaLinearUnits::GetTransform(const MeaUnitsContext&).
+    ///
+    /// @param context  [in] Origin and y-axis orientation for the conversion.
+    ///
+    /// @return Transform for the current units and the specified context.
+    ///
+    std::shared_ptr<const MeaUnitsTransform> GetTransform(const MeaUnitsContext& context) const {
+        return m_currentLinearUnits->GetTransform(context);
+    }
+
+    /// Converts the specified coordinates from pixels to the current units.
+    /// See MeaLinearUnits::ConvertCoords.
+    ///
+    /// @param points   [in] Coordinates in pixels to convert.
+    /// @param coords   [out] Coordinates converted to the current units. Must
+    ///                 have room for count points.
+    /// @param count    [in] Number of points to convert.
+    ///
+    void ConvertCoords(const POINT* points, MeaFPoint* coords, std::size_t count) const {
+        m_currentLinearUnits->ConvertCoords(points, coords, count);
+    }
+
     /// Converts from the current units to pixels. The conversion takes into account
     /// the location of the origin and the orientation of the y-axis.
     ///
@@ -417,6 +460,18 @@ public:
         return m_currentLinearUnits->UnconvertCoord(pos);
     }
 
+    /// Converts the specified coordinates from the current units to pixels.
+    /// See MeaLinearUnits::UnconvertCoords.
+    ///
+    /// @param coords   [in] Coordinates in the current units to convert.
+    /// @param points   [out] Coordinates converted to pixels. Must have room
+    ///                 for count points.
+    /// @param count    [in] Number of points to convert.
+    ///
+    void UnconvertCoords(const MeaFPoint* coords, POINT* points, std::size_t count) const {
+        m_currentLinearUnits->UnconvertCoords(coords, points, count);
+    }
+
     /// Converts the specified position from pixels to the desired units.
     /// This conversion does not take into account the location of the origin
     /// nor does it compensate for the orientation of the y-axis.
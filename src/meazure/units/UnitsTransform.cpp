@@ -0,0 +1,160 @@
+/*
+ * Copyright 2022 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <meazure/pch.h>
+#include "UnitsTransform.h"
+#include <utility>
+
+
+MeaUnitsTransform::MeaUnitsTransform(const Screens& screens, const MeaFSize& defaultFromPixels,
+                                     const MeaUnitsContext& context, long virtualHeight) :
+        m_defaultFromPixels(defaultFromPixels),
+        m_origin(context.m_origin.x, context.m_origin.y, context.m_invertY, virtualHeight) {
+    std::vector<MeaFRect> posRects;
+
+    m_fromPixels.reserve(screens.size());
+    m_pixelRects.reserve(screens.size());
+    m_coordRects.reserve(screens.size());
+    posRects.reserve(screens.size());
+
+    for (const Screen& screen : screens) {
+        const MeaFRect& srect = screen.m_rect;
+        const MeaFSize& fromPixels = screen.m_fromPixels;
+
+        m_fromPixels.push_back(fromPixels);
+        m_pixelRects.push_back(srect);
+
+        // Both corners of a screen are converted using the screen's own
+        // resolution. An inverted y-axis swaps the top and bottom of the
+        // converted rectangle, so they are put back in order.
+        POINT topLeft = { static_cast<long>(srect.left), static_cast<long>(srect.top) };
+        POINT bottomRight = { static_cast<long>(srect.right), static_cast<long>(srect.bottom) };
+        MeaFPoint tl = Convert(topLeft, fromPixels);
+        MeaFPoint br = Convert(bottomRight, fromPixels);
+        if (tl.y > br.y) {
+            std::swap(tl.y, br.y);
+        }
+        m_coordRects.emplace_back(tl.y, br.y, tl.x, br.x);
+
+        posRects.emplace_back(fromPixels.cy * srect.top, fromPixels.cy * srect.bottom,
+                              fromPixels.cx * srect.left, fromPixels.cx * srect.right);
+    }
+
+    m_pixelIndex.Build(m_pixelRects);
+    m_coordIndex.Build(m_coordRects);
+    m_posIndex.Build(posRects);
+}
+
+void MeaUnitsTransform::ConvertCoords(const POINT* points, MeaFPoint* coords, std::size_t count) const {
+    bool singleScreen = (m_fromPixels.size() == 1);
+    std::size_t start = 0;
+
+    // Consecutive points on the same screen are converted as a run using that
+    // screen's factors, so a screen is only located when a run ends.
+    while (start < count) {
+        std::size_t end = start + 1;
+        const MeaFSize* fromPixels;
+
+        int screen = singleScreen ? 0 : m_pixelIndex.Find(points[start].x, points[start].y);
+        if (screen == MeaRectIndex::kNotFound) {
+            fromPixels = &FindFromPixels(points[start]);
+        } else if (singleScreen) {
+            fromPixels = &m_fromPixels.front();
+            end = count;
+        } else {
+            fromPixels = &m_fromPixels[screen];
+            const MeaFRect& rect = m_pixelRects[screen];
+            while (end < count && points[end].x >= rect.left && points[end].x < rect.right &&
+                   points[end].y >= rect.top && points[end].y < rect.bottom) {
+                end++;
+            }
+        }
+
+        const MeaFSize factors = *fromPixels;
+        for (std::size_t i = start; i < end; i++) {
+            coords[i] = Convert(points[i], factors);
+        }
+
+        start = end;
+    }
+}
+
+void MeaUnitsTransform::UnconvertCoords(const MeaFPoint* coords, POINT* points, std::size_t count) const {
+    std::size_t start = 0;
+
+    while (start < count) {
+        std::size_t end = start + 1;
+        const MeaFSize* fromPixels = &m_defaultFromPixels;
+
+        int screen = m_coordIndex.Find(coords[start]);
+        if (screen != MeaRectIndex::kNotFound) {
+            fromPixels = &m_fromPixels[screen];
+            const MeaFRect& rect = m_coordRects[screen];
+            while (end < count && coords[end].x >= rect.left && coords[end].x < rect.right &&
+                   coords[end].y >= rect.top && coords[end].y < rect.bottom) {
+                end++;
+            }
+        }
+
+        const MeaFSize factors = *fromPixels;
+        for (std::size_t i = start; i < end; i++) {
+            points[i] = Unconvert(coords[i], factors);
+        }
+
+        start = end;
+    }
+}
+
+const MeaFSize& MeaUnitsTransform::FindFromPixels(const POINT& pos) const {
+    if (m_fromPixels.size() == 1) {
+        return m_fromPixels.front();
+    }
+
+    int screen = m_pixelIndex.Find(pos.x, pos.y);
+    if (screen == MeaRectIndex::kNotFound) {
+        screen = FindNearestScreen(pos);
+    }
+    return (screen == MeaRectIndex::kNotFound) ? m_defaultFromPixels : m_fromPixels[screen];
+}
+
+const MeaFSize& MeaUnitsTransform::FindFromPixelsByCoord(const MeaFPoint& pos) const {
+    int screen = m_coordIndex.Find(pos);
+    return (screen == MeaRectIndex::kNotFound) ? m_defaultFromPixels : m_fromPixels[screen];
+}
+
+const MeaFSize& MeaUnitsTransform::FindFromPixelsByPos(const MeaFPoint& pos) const {
+    int screen = m_posIndex.Find(pos);
+    return (screen == MeaRectIndex::kNotFound) ? m_defaultFromPixels : m_fromPixels[screen];
+}
+
+int MeaUnitsTransform::FindNearestScreen(const POINT& pos) const {
+    int nearest = MeaRectIndex::kNotFound;
+    double nearestDist = 0.0;
+
+    for (std::size_t i = 0; i < m_pixelRects.size(); i++) {
+        const MeaFRect& rect = m_pixelRects[i];
+        double dist = MeaUnitsConversion::ScreenDistanceSq(rect.left, rect.top, rect.right, rect.bottom, pos.x, pos.y);
+        if (nearest == MeaRectIndex::kNotFound || dist < nearestDist) {
+            nearest = static_cast<int>(i);
+            nearestDist = dist;
+        }
+    }
+
+    return nearest;
+}
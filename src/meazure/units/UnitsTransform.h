@@ -0,0 +1,188 @@
+/*
+ * Copyright 2022 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/// @file
+/// @brief Header file for the precomputed conversion between pixels and linear units.
+
+#pragma once
+
+#include <vector>
+#include <cstddef>
+#include <meazure/utilities/Geometry.h>
+#include <meazure/utilities/RectIndex.h>
+#include "UnitsContext.h"
+#include "UnitsConversion.h"
+
+
+/// Immutable conversion between pixels and a set of linear units for the current screen layout. A transform
+/// captures the conversion factors of each screen, the location of the origin and the orientation of the
+/// y-axis at the time it is built, and locates screens using precomputed indices. Converting through a
+/// transform requires neither virtual calls nor access to the screen provider.
+///
+/// Because a transform never changes once constructed, it can be shared and used concurrently by any number
+/// of threads without locking. A new transform is built whenever the units, screens, origin or y-axis
+/// orientation change (see MeaLinearUnits::GetTransform).
+///
+class MeaUnitsTransform {
+
+public:
+    /// Extent and conversion factors of a screen.
+    ///
+    struct Screen {
+        MeaFRect m_rect;            ///< Screen rectangle, in pixels.
+        MeaFSize m_fromPixels;      ///< Factors to convert from pixels to the units on the screen.
+    };
+
+    typedef std::vector<Screen> Screens;
+
+
+    /// Constructs a transform.
+    ///
+    /// @param screens              [in] Screens comprising the desktop.
+    /// @param defaultFromPixels    [in] Conversion factors for coordinates that are not on any screen.
+    /// @param context              [in] Location of the origin and orientation of the y-axis.
+    /// @param virtualHeight        [in] Height of the virtual screen, in pixels. When the y-axis is inverted
+    ///                             and the origin is at the system origin, the origin is placed at the bottom
+    ///                             of the virtual screen.
+    ///
+    MeaUnitsTransform(const Screens& screens, const MeaFSize& defaultFromPixels, const MeaUnitsContext& context,
+                      long virtualHeight);
+
+    /// Converts the specified coordinate from pixels to the units, taking into account the location of the
+    /// origin and the orientation of the y-axis. Positions that are not on any screen are converted using the
+    /// factors of the nearest screen.
+    ///
+    /// @param pos      [in] Coordinates in pixels.
+    /// @return Coordinates in the units.
+    ///
+    MeaFPoint ConvertCoord(const POINT& pos) const {
+        return Convert(pos, FindFromPixels(pos));
+    }
+
+    /// Converts the specified coordinates from pixels to the units. The results are identical to calling
+    /// ConvertCoord for each point.
+    ///
+    /// @param points   [in] Coordinates in pixels.
+    /// @param coords   [out] Coordinates in the units. Must have room for count points.
+    /// @param count    [in] Number of points to convert.
+    ///
+    void ConvertCoords(const POINT* points, MeaFPoint* coords, std::size_t count) const;
+
+    /// Converts the specified coordinate from the units to pixels, taking into account the location of the
+    /// origin and the orientation of the y-axis.
+    ///
+    /// @param pos      [in] Coordinates in the units.
+    /// @return Coordinates in pixels.
+    ///
+    POINT UnconvertCoord(const MeaFPoint& pos) const {
+        return Unconvert(pos, FindFromPixelsByCoord(pos));
+    }
+
+    /// Converts the specified coordinates from the units to pixels. The results are identical to calling
+    /// UnconvertCoord for each point.
+    ///
+    /// @param coords   [in] Coordinates in the units.
+    /// @param points   [out] Coordinates in pixels. Must have room for count points.
+    /// @param count    [in] Number of points to convert.
+    ///
+    void UnconvertCoords(const MeaFPoint* coords, POINT* points, std::size_t count) const;
+
+    /// Converts the specified position from pixels to the units without regard to the location of the origin
+    /// or the orientation of the y-axis.
+    ///
+    /// @param pos      [in] Position in pixels.
+    /// @return Position in the units.
+    ///
+    MeaFPoint ConvertPos(const POINT& pos) const {
+        const MeaFSize& fromPixels = FindFromPixels(pos);
+        return MeaFPoint(fromPixels.cx * pos.x, fromPixels.cy * pos.y);
+    }
+
+    /// Converts the specified position from the units to pixels without regard to the location of the origin
+    /// or the orientation of the y-axis.
+    ///
+    /// @param pos      [in] Position in the units.
+    /// @return Position in pixels.
+    ///
+    POINT UnconvertPos(const MeaFPoint& pos) const {
+        const MeaFSize& fromPixels = FindFromPixelsByPos(pos);
+        POINT point;
+        point.x = static_cast<long>(pos.x / fromPixels.cx);
+        point.y = static_cast<long>(pos.y / fromPixels.cy);
+        return point;
+    }
+
+    /// Obtains the conversion factors for the screen containing the specified position. Positions that are
+    /// not on any screen use the factors for the nearest screen.
+    ///
+    /// @param pos      [in] Position in pixels.
+    /// @return Conversion factors from pixels to the units.
+    ///
+    const MeaFSize& FindFromPixels(const POINT& pos) const;
+
+    /// Obtains the conversion factors for the screen containing the specified coordinate, which takes into
+    /// account the location of the origin and the orientation of the y-axis.
+    ///
+    /// @param pos      [in] Coordinate in the units.
+    /// @return Conversion factors from pixels to the units.
+    ///
+    const MeaFSize& FindFromPixelsByCoord(const MeaFPoint& pos) const;
+
+    /// Obtains the conversion factors for the screen containing the specified position, which does not take
+    /// into account the location of the origin nor the orientation of the y-axis.
+    ///
+    /// @param pos      [in] Position in the units.
+    /// @return Conversion factors from pixels to the units.
+    ///
+    const MeaFSize& FindFromPixelsByPos(const MeaFPoint& pos) const;
+
+private:
+    /// Converts a point from pixels to the units, taking into account the location of the origin and the
+    /// orientation of the y-axis (see MeaUnitsConversion::Origin).
+    ///
+    MeaFPoint Convert(const POINT& pos, const MeaFSize& fromPixels) const {
+        return MeaFPoint(m_origin.ConvertX(pos.x, fromPixels.cx), m_origin.ConvertY(pos.y, fromPixels.cy));
+    }
+
+    /// Converts a point from the units to pixels, truncating the results to whole pixels.
+    ///
+    POINT Unconvert(const MeaFPoint& pos, const MeaFSize& fromPixels) const {
+        POINT point;
+        point.x = static_cast<long>(m_origin.UnconvertX(pos.x, fromPixels.cx));
+        point.y = static_cast<long>(m_origin.UnconvertY(pos.y, fromPixels.cy));
+        return point;
+    }
+
+    /// Locates the screen nearest to a position that is not on any screen.
+    ///
+    /// @param pos      [in] Position in pixels.
+    /// @return Index of the nearest screen, or MeaRectIndex::kNotFound if there are no screens.
+    ///
+    int FindNearestScreen(const POINT& pos) const;
+
+
+    std::vector<MeaFSize> m_fromPixels;     ///< Conversion factors for each screen.
+    std::vector<MeaFRect> m_pixelRects;     ///< Screen rectangles, in pixels.
+    std::vector<MeaFRect> m_coordRects;     ///< Screen rectangles in the units, with top <= bottom.
+    MeaFSize m_defaultFromPixels;           ///< Conversion factors for coordinates not on any screen.
+    MeaUnitsConversion::Origin m_origin;    ///< Location of the origin and orientation of the y-axis.
+    MeaRectIndex m_pixelIndex;              ///< Locates a screen from a position in pixels.
+    MeaRectIndex m_coordIndex;              ///< Locates a screen from a coordinate in the units.
+    MeaRectIndex m_posIndex;                ///< Locates a screen from an uncorrected position in the units.
+};
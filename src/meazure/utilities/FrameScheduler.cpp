@@ -0,0 +1,111 @@
+/*
+ * Copyright 2022 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "FrameScheduler.h"
+#include <algorithm>
+
+
+MeaFrameScheduler::MeaFrameScheduler(Backend& backend) :
+    m_backend(backend),
+    m_frameRequested(false),
+    m_flushing(false),
+    m_metrics() {}
+
+void MeaFrameScheduler::Move(WindowId window, int x, int y) {
+    Update& update = GetUpdate(window);
+    update.m_x = x;
+    update.m_y = y;
+    update.m_move = true;
+    m_metrics.m_requestedMoves++;
+}
+
+void MeaFrameScheduler::Repaint(WindowId window) {
+    GetUpdate(window).m_repaint = true;
+    m_metrics.m_requestedRepaints++;
+}
+
+void MeaFrameScheduler::Remove(WindowId window) {
+    m_pending.erase(std::remove_if(m_pending.begin(), m_pending.end(),
+                                   [window](const Update& update) { return update.m_window == window; }),
+                    m_pending.end());
+}
+
+void MeaFrameScheduler::OnFrame() {
+    m_frameRequested = false;
+    Flush();
+}
+
+void MeaFrameScheduler::Flush() {
+    if (m_pending.empty() || m_flushing) {
+        return;
+    }
+
+    // The backend's window operations can cause further updates to be requested or a flush to be attempted (e.g.
+    // a window procedure responding to a move). Those updates are collected for the next frame rather than
+    // modifying the set being applied.
+    m_flushing = true;
+    m_applying.swap(m_pending);
+    m_pending.clear();
+
+    m_moves.clear();
+    for (const Update& update : m_applying) {
+        if (update.m_move) {
+            m_moves.push_back(update);
+        }
+    }
+    if (!m_moves.empty()) {
+        m_backend.MoveWindows(m_moves.data(), m_moves.size());
+    }
+
+    std::size_t repaints = 0;
+    for (const Update& update : m_applying) {
+        if (update.m_repaint) {
+            m_backend.RepaintWindow(update.m_window);
+            repaints++;
+        }
+    }
+
+    m_metrics.m_frames++;
+    m_metrics.m_appliedMoves += m_moves.size();
+    m_metrics.m_appliedRepaints += repaints;
+    m_metrics.m_lastUpdatesPerFrame = m_applying.size();
+    if (m_applying.size() > m_metrics.m_maxUpdatesPerFrame) {
+        m_metrics.m_maxUpdatesPerFrame = m_applying.size();
+    }
+
+    m_applying.clear();
+    m_flushing = false;
+}
+
+MeaFrameScheduler::Update& MeaFrameScheduler::GetUpdate(WindowId window) {
+    if (!m_frameRequested) {
+        m_frameRequested = true;
+        m_backend.RequestFrame();
+    }
+
+    // Only a handful of windows are updated per frame, so a linear search is faster than a map.
+    for (Update& update : m_pending) {
+        if (update.m_window == window) {
+            return update;
+        }
+    }
+
+    m_pending.push_back({ window, 0, 0, false, false });
+    return m_pending.back();
+}
@@ -0,0 +1,171 @@
+/*
+ * Copyright 2022 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/// @file
+/// @brief Header file for a scheduler that applies window updates once per display frame.
+
+#pragma once
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+
+/// Collects window moves and repaints requested while events are processed and applies them together at the
+/// start of the next display frame. Moving the mouse causes a tool to reposition several windows (crosshairs,
+/// data windows, rulers), and each may be moved more than once before the screen is refreshed. Only the last
+/// position requested for each window is applied, all moves are applied as a single batch, and windows are
+/// repainted after they have been moved.
+///
+/// The scheduler does not manipulate windows itself. A Backend performs the window operations and tells the
+/// scheduler when a frame starts. This allows the scheduling to be used without a windowing system, and this
+/// class does not depend on MFC or Windows.
+///
+class MeaFrameScheduler {
+
+public:
+    typedef const void* WindowId;       ///< Identifies a window (e.g. an HWND).
+
+    /// Pending update for a window.
+    ///
+    struct Update {
+        WindowId m_window;              ///< Window to update.
+        int m_x;                        ///< New left edge of the window, if m_move is true.
+        int m_y;                        ///< New top edge of the window, if m_move is true.
+        bool m_move;                    ///< Indicates the window is to be moved.
+        bool m_repaint;                 ///< Indicates the window is to be repainted.
+    };
+
+
+    /// Performs the window operations for the scheduler.
+    ///
+    class Backend {
+
+    public:
+        virtual ~Backend() {}
+
+        /// Arranges for MeaFrameScheduler::OnFrame to be called at the start of the next display frame. This
+        /// is called at most once per frame.
+        ///
+        virtual void RequestFrame() = 0;
+
+        /// Moves the specified windows as a single operation.
+        ///
+        /// @param updates  [in] Windows to move. Only updates with m_move set are passed.
+        /// @param count    [in] Number of updates.
+        ///
+        virtual void MoveWindows(const Update* updates, std::size_t count) = 0;
+
+        /// Repaints the specified window immediately.
+        ///
+        /// @param window   [in] Window to repaint.
+        ///
+        virtual void RepaintWindow(WindowId window) = 0;
+    };
+
+
+    /// Counters describing the work performed by the scheduler.
+    ///
+    struct Metrics {
+        std::uint64_t m_frames;                 ///< Number of frames in which updates were applied.
+        std::uint64_t m_requestedMoves;         ///< Number of moves requested.
+        std::uint64_t m_appliedMoves;           ///< Number of moves applied. Moves of the same window in a frame
+                                                ///< are combined.
+        std::uint64_t m_requestedRepaints;      ///< Number of repaints requested.
+        std::uint64_t m_appliedRepaints;        ///< Number of repaints performed.
+        std::size_t m_lastUpdatesPerFrame;      ///< Number of windows updated in the most recent frame.
+        std::size_t m_maxUpdatesPerFrame;       ///< Largest number of windows updated in a frame.
+    };
+
+
+    /// Constructs a scheduler.
+    ///
+    /// @param backend  [in] Performs the window operations. Must outlive the scheduler.
+    ///
+    explicit MeaFrameScheduler(Backend& backend);
+
+    MeaFrameScheduler(const MeaFrameScheduler&) = delete;
+    MeaFrameScheduler& operator=(const MeaFrameScheduler&) = delete;
+
+    /// Requests that the specified window be moved at the next frame. A later request for the same window in the
+    /// same frame replaces this one.
+    ///
+    /// @param window   [in] Window to move.
+    /// @param x        [in] New left edge of the window.
+    /// @param y        [in] New top edge of the window.
+    ///
+    void Move(WindowId window, int x, int y);
+
+    /// Requests that the specified window be repainted at the next frame, after any windows have been moved.
+    ///
+    /// @param window   [in] Window to repaint.
+    ///
+    void Repaint(WindowId window);
+
+    /// Discards any pending updates for the specified window (e.g. because it is being destroyed).
+    ///
+    /// @param window   [in] Window whose updates are discarded.
+    ///
+    void Remove(WindowId window);
+
+    /// Indicates whether any updates are waiting for the next frame.
+    ///
+    /// @return <b>true</b> if updates are pending.
+    ///
+    bool HasPending() const { return !m_pending.empty(); }
+
+    /// Called by the backend at the start of a display frame. Applies all pending updates.
+    ///
+    void OnFrame();
+
+    /// Applies all pending updates immediately rather than waiting for the next frame.
+    ///
+    void Flush();
+
+    /// Obtains the scheduler counters.
+    ///
+    /// @return Counters accumulated since the scheduler was constructed or the counters were reset.
+    ///
+    const Metrics& GetMetrics() const { return m_metrics; }
+
+    /// Sets all scheduler counters to zero.
+    ///
+    void ResetMetrics() { m_metrics = Metrics(); }
+
+private:
+    typedef std::vector<Update> Updates;
+
+    /// Locates the pending update for the specified window, adding one if necessary, and requests a frame if
+    /// one has not already been requested.
+    ///
+    /// @param window   [in] Window whose update is requested.
+    ///
+    /// @return Pending update for the window.
+    ///
+    Update& GetUpdate(WindowId window);
+
+
+    Backend& m_backend;                 ///< Performs the window operations.
+    Updates m_pending;                  ///< Updates waiting for the next frame, one per window.
+    Updates m_applying;                 ///< Updates being applied. Kept to reuse its capacity.
+    Updates m_moves;                    ///< Moves passed to the backend. Kept to reuse its capacity.
+    bool m_frameRequested;              ///< Indicates a frame has been requested from the backend.
+    bool m_flushing;                    ///< Indicates updates are being applied.
+    Metrics m_metrics;                  ///< Scheduler counters.
+};
@@ -0,0 +1,131 @@
+/*
+ * Copyright 2022 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "NumberFormat.h"
+#include <charconv>
+#include <cassert>
+#include <cmath>
+#include <cfloat>
+
+
+namespace {
+    /// Powers of ten for every supported precision. All are exactly representable as doubles.
+    constexpr double kPowersOf10[MeaNumberFormat::kMaxPrecision + 1] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10,
+        1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20
+    };
+
+    /// Scaled values at or above this limit (2^52) may not have an exactly representable fractional part.
+    constexpr double kMaxScaled = 4503599627370496.0;
+
+    int ClampPrecision(int precision) {
+        if (precision < 0) {
+            return 6;
+        }
+        return (precision > MeaNumberFormat::kMaxPrecision) ? MeaNumberFormat::kMaxPrecision : precision;
+    }
+
+    /// Rounds the magnitude of the specified value to an integral number of units in the last decimal place.
+    ///
+    /// @return false if the rounding cannot be decided reliably in floating point.
+    ///
+    bool RoundScaled(double value, int precision, double& rounded) {
+        double scaled = std::fabs(value) * kPowersOf10[precision];
+        if (!(scaled < kMaxScaled)) {
+            return false;           // Too large, infinite or NaN
+        }
+
+        // The product is within half an ulp of the exact scaled value, so the
+        // direction of rounding is only in doubt near the half-way point.
+        double whole = std::floor(scaled);
+        double frac = scaled - whole;
+        if (std::fabs(frac - 0.5) <= scaled * DBL_EPSILON) {
+            return false;
+        }
+
+        rounded = (frac > 0.5) ? whole + 1.0 : whole;
+        return true;
+    }
+}
+
+
+std::string_view MeaNumberFormat::FormatFixed(Buffer& buffer, double value, int precision) {
+    if (precision < 0) {
+        precision = 6;
+    } else if (precision > kMaxPrecision) {
+        precision = kMaxPrecision;
+    }
+
+    char* first = buffer.data();
+    std::to_chars_result result = std::to_chars(first, first + buffer.size(), value, std::chars_format::fixed,
+                                                precision);
+    assert(result.ec == std::errc());
+
+    return std::string_view(first, result.ptr - first);
+}
+
+std::string_view MeaNumberFormat::FormatShortest(Buffer& buffer, double value) {
+    char* first = buffer.data();
+    std::to_chars_result result = std::to_chars(first, first + buffer.size(), value);
+    assert(result.ec == std::errc());
+
+    return std::string_view(first, result.ptr - first);
+}
+
+std::string_view MeaNumberFormat::FormatTrimmed(Buffer& buffer, double value) {
+    std::string_view str = FormatFixed(buffer, value, kTrimmedPrecision);
+
+    std::size_t len = str.size();
+    while (len > 2 && str[len - 1] == '0' && str[len - 2] != '.') {
+        len--;
+    }
+
+    return str.substr(0, len);
+}
+
+std::string_view MeaNumberFormat::FormatInt(Buffer& buffer, int value) {
+    char* first = buffer.data();
+    std::to_chars_result result = std::to_chars(first, first + buffer.size(), value);
+    assert(result.ec == std::errc());
+
+    return std::string_view(first, result.ptr - first);
+}
+
+bool MeaNumberFormat::SameFixed(double a, double b, int precision) {
+    precision = ClampPrecision(precision);
+
+    // Formatted values carry a minus sign whenever the sign bit is set, even if they round to zero.
+    double ra;
+    double rb;
+    if (RoundScaled(a, precision, ra) && RoundScaled(b, precision, rb)) {
+        return ra == rb && std::signbit(a) == std::signbit(b);
+    }
+
+    Buffer bufferA;
+    Buffer bufferB;
+    return FormatFixed(bufferA, a, precision) == FormatFixed(bufferB, b, precision);
+}
+
+void MeaNumberFormat::SameFixed(const double* a, const double* b, bool* results, std::size_t count, int precision) {
+    precision = ClampPrecision(precision);
+
+    for (std::size_t i = 0; i < count; i++) {
+        results[i] = SameFixed(a[i], b[i], precision);
+    }
+}
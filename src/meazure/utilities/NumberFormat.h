@@ -0,0 +1,122 @@
+/*
+ * Copyright 2022 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+ /// @file
+ /// @brief Locale independent number formatting into caller provided buffers.
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <string_view>
+
+
+/// Locale independent conversion of numbers to text. The functions in this namespace are built on std::to_chars
+/// and write into a caller provided buffer, typically allocated on the stack, so that no heap allocation takes
+/// place. The output of the fixed precision functions is identical to that produced by the printf "%.*f" format.
+/// The functions do not depend on MFC and can be used on any platform.
+///
+namespace MeaNumberFormat {
+
+    /// Maximum number of decimal places supported by the fixed precision functions. Larger precisions are clamped
+    /// to this value.
+    ///
+    constexpr int kMaxPrecision = 20;
+
+    /// Number of decimal places used by FormatTrimmed before trailing zeros are removed. This matches the
+    /// DBL_DIG - 1 digits historically used by MeaStringUtils::DblToStr.
+    ///
+    constexpr int kTrimmedPrecision = 14;
+
+    /// Size of a buffer large enough to hold any double formatted with up to kMaxPrecision decimal places (the
+    /// largest double has 309 integral digits).
+    ///
+    constexpr std::size_t kBufferSize = 1 + 309 + 1 + kMaxPrecision + 1;
+
+
+    /// Caller provided storage for the formatted characters. The string views returned by the formatting
+    /// functions point into this buffer and remain valid until the buffer is reused or goes out of scope.
+    ///
+    typedef std::array<char, kBufferSize> Buffer;
+
+
+    /// Formats the specified value with a fixed number of decimal places. Equivalent to printf("%.*f").
+    ///
+    /// @param buffer       [out] Storage for the formatted characters.
+    /// @param value        [in] Value to format.
+    /// @param precision    [in] Number of decimal places. As with printf, a negative precision is treated as 6.
+    ///
+    /// @return View of the formatted characters within the buffer. The view is not null terminated.
+    ///
+    std::string_view FormatFixed(Buffer& buffer, double value, int precision);
+
+    /// Formats the specified value using the shortest representation that parses back to exactly the same
+    /// value. Scientific notation is used when it is shorter than the fixed notation.
+    ///
+    /// @param buffer       [out] Storage for the formatted characters.
+    /// @param value        [in] Value to format.
+    ///
+    /// @return View of the formatted characters within the buffer. The view is not null terminated.
+    ///
+    std::string_view FormatShortest(Buffer& buffer, double value);
+
+    /// Formats the specified value with kTrimmedPrecision decimal places and then removes trailing zeros, always
+    /// leaving at least one digit after the decimal point (e.g. 10.5 is "10.5" and 0 is "0.0").
+    ///
+    /// @param buffer       [out] Storage for the formatted characters.
+    /// @param value        [in] Value to format.
+    ///
+    /// @return View of the formatted characters within the buffer. The view is not null terminated.
+    ///
+    std::string_view FormatTrimmed(Buffer& buffer, double value);
+
+    /// Formats the specified integer. Equivalent to printf("%d").
+    ///
+    /// @param buffer       [out] Storage for the formatted characters.
+    /// @param value        [in] Value to format.
+    ///
+    /// @return View of the formatted characters within the buffer. The view is not null terminated.
+    ///
+    std::string_view FormatInt(Buffer& buffer, int value);
+
+    /// Indicates whether the specified values produce the same text when formatted by FormatFixed with the
+    /// specified precision. The values are compared after rounding them numerically to the precision, using
+    /// precomputed powers of ten. Only when a value lies so close to a rounding half-way point that the
+    /// floating point product cannot decide the direction are the values actually formatted, so the result
+    /// always agrees with comparing the FormatFixed text, including the handling of exact ties and of "-0".
+    ///
+    /// @param a            [in] First value to compare.
+    /// @param b            [in] Second value to compare.
+    /// @param precision    [in] Number of decimal places. As with FormatFixed, a negative precision is treated
+    ///                     as 6.
+    ///
+    /// @return <b>true</b> if the formatted values are identical.
+    ///
+    bool SameFixed(double a, double b, int precision);
+
+    /// Compares pairs of values as SameFixed does.
+    ///
+    /// @param a            [in] First values to compare.
+    /// @param b            [in] Second values to compare.
+    /// @param results      [out] Result of comparing a[i] with b[i]. Must have room for count results.
+    /// @param count        [in] Number of pairs to compare.
+    /// @param precision    [in] Number of decimal places.
+    ///
+    void SameFixed(const double* a, const double* b, bool* results, std::size_t count, int precision);
+};
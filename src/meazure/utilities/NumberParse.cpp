@@ -0,0 +1,165 @@
+/*
+ * Copyright 2022 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "NumberParse.h"
+#include <charconv>
+#include <cstddef>
+
+
+namespace {
+
+    /// Longest wide character string that is parsed. Wide strings are narrowed onto the stack before being
+    /// handed to std::from_chars, and longer strings are rejected rather than allocating.
+    ///
+    constexpr std::size_t kMaxWideLength = 128;
+
+
+    bool IsSpace(char ch) {
+        return ch == ' ' || (ch >= '\t' && ch <= '\r');
+    }
+
+    /// Parses a number from the beginning of the specified string.
+    ///
+    /// @param str      [in] String to parse.
+    /// @param value    [out] Parsed value. Only modified if Result::Ok is returned.
+    /// @param end      [out] Set to the first character following the number.
+    ///
+    /// @return Result::Ok if the string begins with a number, otherwise the reason for the failure.
+    ///
+    template<typename T>
+    MeaNumberParse::Result ParsePrefix(std::string_view str, T& value, const char*& end) {
+        if (str.empty()) {
+            return MeaNumberParse::Result::Empty;
+        }
+
+        const char* first = str.data();
+        const char* last = first + str.size();
+
+        // std::from_chars does not accept a leading '+'. Skip it but do not allow a second sign to follow it.
+        if (*first == '+') {
+            first++;
+            if (first == last || *first == '-') {
+                return MeaNumberParse::Result::Invalid;
+            }
+        }
+
+        T v;
+        std::from_chars_result result = std::from_chars(first, last, v);
+        if (result.ec == std::errc::invalid_argument) {
+            return MeaNumberParse::Result::Invalid;
+        }
+        if (result.ec == std::errc::result_out_of_range) {
+            return MeaNumberParse::Result::OutOfRange;
+        }
+
+        value = v;
+        end = result.ptr;
+        return MeaNumberParse::Result::Ok;
+    }
+
+    template<typename T>
+    MeaNumberParse::Result Parse(std::string_view str, T& value) {
+        T v;
+        const char* end;
+        MeaNumberParse::Result result = ParsePrefix(str, v, end);
+        if (result != MeaNumberParse::Result::Ok) {
+            return result;
+        }
+        if (end != str.data() + str.size()) {
+            return MeaNumberParse::Result::TrailingChars;
+        }
+
+        value = v;
+        return result;
+    }
+
+    template<typename T>
+    T To(std::string_view str, T defaultValue) {
+        std::size_t start = 0;
+        while (start < str.size() && IsSpace(str[start])) {
+            start++;
+        }
+
+        T value = defaultValue;
+        const char* end;
+        ParsePrefix(str.substr(start), value, end);
+        return value;
+    }
+
+
+    /// Narrows a wide character string onto the stack. Characters outside the ASCII range cannot be part of a
+    /// number and are replaced with DEL so that parsing stops at them.
+    ///
+    class NarrowStr {
+    public:
+        explicit NarrowStr(std::wstring_view str) : m_len(str.size()), m_truncated(false) {
+            if (m_len > kMaxWideLength) {
+                m_len = kMaxWideLength;
+                m_truncated = true;
+            }
+            for (std::size_t i = 0; i < m_len; i++) {
+                m_buffer[i] = (str[i] < 0x80) ? static_cast<char>(str[i]) : '\x7F';
+            }
+        }
+
+        bool IsTruncated() const { return m_truncated; }
+
+        std::string_view View() const { return std::string_view(m_buffer, m_len); }
+
+    private:
+        char m_buffer[kMaxWideLength];
+        std::size_t m_len;
+        bool m_truncated;
+    };
+}
+
+
+MeaNumberParse::Result MeaNumberParse::ParseDbl(std::string_view str, double& value) {
+    return Parse(str, value);
+}
+
+MeaNumberParse::Result MeaNumberParse::ParseDbl(std::wstring_view str, double& value) {
+    NarrowStr narrowStr(str);
+    return narrowStr.IsTruncated() ? Result::OutOfRange : Parse(narrowStr.View(), value);
+}
+
+MeaNumberParse::Result MeaNumberParse::ParseInt(std::string_view str, int& value) {
+    return Parse(str, value);
+}
+
+MeaNumberParse::Result MeaNumberParse::ParseInt(std::wstring_view str, int& value) {
+    NarrowStr narrowStr(str);
+    return narrowStr.IsTruncated() ? Result::OutOfRange : Parse(narrowStr.View(), value);
+}
+
+double MeaNumberParse::ToDbl(std::string_view str, double defaultValue) {
+    return To(str, defaultValue);
+}
+
+double MeaNumberParse::ToDbl(std::wstring_view str, double defaultValue) {
+    return To(NarrowStr(str).View(), defaultValue);
+}
+
+int MeaNumberParse::ToInt(std::string_view str, int defaultValue) {
+    return To(str, defaultValue);
+}
+
+int MeaNumberParse::ToInt(std::wstring_view str, int defaultValue) {
+    return To(NarrowStr(str).View(), defaultValue);
+}
@@ -0,0 +1,110 @@
+/*
+ * Copyright 2022 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+ /// @file
+ /// @brief Locale independent parsing of numbers from text.
+
+#pragma once
+
+#include <string_view>
+
+
+/// Locale independent conversion of text to numbers built on std::from_chars. Parsing is performed directly on
+/// the caller's characters without creating temporary strings. Two flavors of parsing are provided:
+///
+/// <ul>
+///     <li>Parse functions are strict. The entire string must be a number with no surrounding whitespace. Failures
+///         are reported through a Result code. Already trimmed input, which is the common case for values written
+///         by Meazure, is handed directly to std::from_chars.</li>
+///     <li>To functions are lenient replacements for atoi and strtod. Leading whitespace is skipped, parsing stops
+///         at the first character that is not part of the number, and a default value is returned if no number
+///         is present.</li>
+/// </ul>
+///
+/// Wide character strings are supported so that the functions can be used with TCHAR strings in either a
+/// Unicode or MBCS build. The functions do not depend on MFC and can be used on any platform.
+///
+namespace MeaNumberParse {
+
+    /// Outcome of a strict parse.
+    ///
+    enum class Result {
+        Ok,                 ///< The entire string was parsed as a number.
+        Empty,              ///< The string is empty.
+        Invalid,            ///< The string does not begin with a number (e.g. leading whitespace or letters).
+        OutOfRange,         ///< The number cannot be represented by the destination type.
+        TrailingChars       ///< A number was parsed but it is followed by other characters.
+    };
+
+
+    /// Parses the specified string as a base 10 floating point number. An optional leading '+' sign is accepted.
+    ///
+    /// @param str      [in] String to parse.
+    /// @param value    [out] Parsed value. Only modified if Result::Ok is returned.
+    ///
+    /// @return Result::Ok if the entire string was parsed, otherwise the reason for the failure.
+    ///
+    Result ParseDbl(std::string_view str, double& value);
+
+    /// Parses the specified wide character string as a base 10 floating point number.
+    /// See ParseDbl(std::string_view, double&).
+    ///
+    Result ParseDbl(std::wstring_view str, double& value);
+
+    /// Parses the specified string as a base 10 integer. An optional leading '+' sign is accepted.
+    ///
+    /// @param str      [in] String to parse.
+    /// @param value    [out] Parsed value. Only modified if Result::Ok is returned.
+    ///
+    /// @return Result::Ok if the entire string was parsed, otherwise the reason for the failure.
+    ///
+    Result ParseInt(std::string_view str, int& value);
+
+    /// Parses the specified wide character string as a base 10 integer. See ParseInt(std::string_view, int&).
+    ///
+    Result ParseInt(std::wstring_view str, int& value);
+
+    /// Converts the specified string to a floating point number in the manner of strtod. Leading whitespace is
+    /// skipped and any characters following the number are ignored.
+    ///
+    /// @param str              [in] String to convert.
+    /// @param defaultValue     [in] Value to return if the string does not begin with a number.
+    ///
+    /// @return Converted value or the default value.
+    ///
+    double ToDbl(std::string_view str, double defaultValue = 0.0);
+
+    /// Converts the specified wide character string to a floating point number. See ToDbl(std::string_view, double).
+    ///
+    double ToDbl(std::wstring_view str, double defaultValue = 0.0);
+
+    /// Converts the specified string to an integer in the manner of atoi. Leading whitespace is skipped and any
+    /// characters following the number are ignored.
+    ///
+    /// @param str              [in] String to convert.
+    /// @param defaultValue     [in] Value to return if the string does not begin with a number.
+    ///
+    /// @return Converted value or the default value.
+    ///
+    int ToInt(std::string_view str, int defaultValue = 0);
+
+    /// Converts the specified wide character string to an integer. See ToInt(std::string_view, int).
+    ///
+    int ToInt(std::wstring_view str, int defaultValue = 0);
+};
@@ -0,0 +1,96 @@
+/*
+ * Copyright 2022 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <meazure/pch.h>
+#include "RectIndex.h"
+#include <algorithm>
+
+
+void MeaRectIndex::Build(const std::vector<MeaFRect>& rects) {
+    Clear();
+
+    std::vector<MeaFRect> normalized;
+    normalized.reserve(rects.size());
+
+    for (const MeaFRect& rect : rects) {
+        MeaFRect norm(std::min(rect.top, rect.bottom), std::max(rect.top, rect.bottom),
+                      std::min(rect.left, rect.right), std::max(rect.left, rect.right));
+        normalized.push_back(norm);
+
+        m_xEdges.push_back(norm.left);
+        m_xEdges.push_back(norm.right);
+        m_yEdges.push_back(norm.top);
+        m_yEdges.push_back(norm.bottom);
+    }
+
+    std::sort(m_xEdges.begin(), m_xEdges.end());
+    m_xEdges.erase(std::unique(m_xEdges.begin(), m_xEdges.end()), m_xEdges.end());
+    std::sort(m_yEdges.begin(), m_yEdges.end());
+    m_yEdges.erase(std::unique(m_yEdges.begin(), m_yEdges.end()), m_yEdges.end());
+
+    if (m_xEdges.size() < 2 || m_yEdges.size() < 2) {
+        Clear();
+        return;
+    }
+
+    std::size_t columns = m_xEdges.size() - 1;
+    std::size_t rows = m_yEdges.size() - 1;
+    m_cells.assign(columns * rows, kNotFound);
+
+    // Because every rectangle edge is a grid line, a cell is inside a rectangle if its top left corner is.
+    for (std::size_t row = 0; row < rows; row++) {
+        double y = m_yEdges[row];
+        for (std::size_t column = 0; column < columns; column++) {
+            double x = m_xEdges[column];
+            for (std::size_t i = 0; i < normalized.size(); i++) {
+                const MeaFRect& rect = normalized[i];
+                if (rect.left <= x && x < rect.right && rect.top <= y && y < rect.bottom) {
+                    m_cells[row * columns + column] = static_cast<int>(i);
+                    break;
+                }
+            }
+        }
+    }
+}
+
+int MeaRectIndex::Find(double x, double y) const {
+    int column = FindInterval(m_xEdges, x);
+    int row = FindInterval(m_yEdges, y);
+    if (column == kNotFound || row == kNotFound) {
+        return kNotFound;
+    }
+
+    return m_cells[static_cast<std::size_t>(row) * (m_xEdges.size() - 1) + column];
+}
+
+void MeaRectIndex::Clear() {
+    m_xEdges.clear();
+    m_yEdges.clear();
+    m_cells.clear();
+}
+
+int MeaRectIndex::FindInterval(const std::vector<double>& edges, double value) {
+    // Written so that NaN values are rejected.
+    if (edges.empty() || !(value >= edges.front() && value < edges.back())) {
+        return kNotFound;
+    }
+
+    auto iter = std::upper_bound(edges.begin(), edges.end(), value);
+    return static_cast<int>(iter - edges.begin()) - 1;
+}
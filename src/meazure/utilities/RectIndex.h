@@ -0,0 +1,90 @@
+/*
+ * Copyright 2022 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/// @file
+/// @brief Header file for locating the rectangle that contains a point.
+
+#pragma once
+
+#include "Geometry.h"
+#include <vector>
+
+
+/// Locates which of a small set of rectangles contains a point, such as which display screen contains a position.
+/// The distinct left and right edges of the rectangles, and separately the distinct top and bottom edges, are
+/// sorted. Together they divide the plane into a grid of cells, each of which lies either entirely inside or
+/// entirely outside of each rectangle. The rectangle containing each cell is determined when the index is built,
+/// so that locating a point requires only a binary search of the edges in each direction.
+///
+/// A rectangle contains the points on its left and top edges but not those on its right and bottom edges. The
+/// edges of a rectangle may be specified in either order (e.g. top may be greater than bottom when the y-axis is
+/// inverted). If rectangles overlap, points in the overlap are reported as belonging to the rectangle that appears
+/// first.
+///
+class MeaRectIndex {
+
+public:
+    static constexpr int kNotFound = -1;    ///< Returned when no rectangle contains a point.
+
+
+    /// Builds the index for the specified rectangles, replacing any previous contents of the index.
+    ///
+    /// @param rects    [in] Rectangles to index.
+    ///
+    void Build(const std::vector<MeaFRect>& rects);
+
+    /// Locates the rectangle containing the specified point.
+    ///
+    /// @param x        [in] X coordinate of the point.
+    /// @param y        [in] Y coordinate of the point.
+    ///
+    /// @return Position of the containing rectangle in the list given to Build, or kNotFound if the point is not
+    ///         in any of the rectangles.
+    ///
+    int Find(double x, double y) const;
+
+    /// Locates the rectangle containing the specified point.
+    ///
+    /// @param point    [in] Point to locate.
+    ///
+    /// @return Position of the containing rectangle in the list given to Build, or kNotFound if the point is not
+    ///         in any of the rectangles.
+    ///
+    int Find(const MeaFPoint& point) const { return Find(point.x, point.y); }
+
+    /// Removes all rectangles from the index.
+    ///
+    void Clear();
+
+private:
+    /// Locates the interval containing the specified value.
+    ///
+    /// @param edges    [in] Sorted edges delimiting the intervals.
+    /// @param value    [in] Value to locate.
+    ///
+    /// @return Index of the interval, where interval i begins at edges[i], or kNotFound if the value lies outside
+    ///         of all intervals.
+    ///
+    static int FindInterval(const std::vector<double>& edges, double value);
+
+
+    std::vector<double> m_xEdges;       ///< Sorted distinct left and right rectangle edges.
+    std::vector<double> m_yEdges;       ///< Sorted distinct top and bottom rectangle edges.
+    std::vector<int> m_cells;           ///< Containing rectangle for each grid cell, row by row.
+};
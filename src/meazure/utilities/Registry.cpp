@@ -19,6 +19,7 @@
 
 #include <meazure/pch.h>
 #include "Registry.h"
+#include <cstring>
 
 
 BOOL MeaRegistry::WriteInt(PCTSTR section, PCTSTR entry, int value) {
@@ -37,6 +38,87 @@ CString MeaRegistry::GetString(PCTSTR section, PCTSTR entry, PCTSTR defaultValue
     return AfxGetApp()->GetProfileString(section, entry, defaultValue);
 }
 
+BOOL MeaRegistry::ReadSection(PCTSTR section, MeaRegistryValues& values) {
+    CString subKey;
+    subKey.Format(_T("Software\\%s\\%s\\%s"), GetKeyName(), AfxGetAppName(), section);
+
+    HKEY hKey;
+    if (OpenKey(HKEY_CURRENT_USER, subKey, 0, KEY_READ, &hKey) != ERROR_SUCCESS) {
+        return FALSE;
+    }
+
+    // Size the name and data buffers once for the largest value in the section.
+    //
+    DWORD numValues = 0;
+    DWORD maxNameLen = 0;
+    DWORD maxDataLen = 0;
+    if (::RegQueryInfoKey(hKey, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, &numValues, &maxNameLen,
+                          &maxDataLen, nullptr, nullptr) != ERROR_SUCCESS) {
+        CloseKey(hKey);
+        return FALSE;
+    }
+
+    std::vector<TCHAR> name(maxNameLen + 1);
+    std::vector<BYTE> data(maxDataLen + sizeof(TCHAR));
+    values.reserve(values.size() + numValues);
+
+    for (DWORD i = 0; i < numValues; i++) {
+        DWORD nameLen = static_cast<DWORD>(name.size());
+        DWORD dataLen = static_cast<DWORD>(data.size());
+        DWORD type;
+
+        if (::RegEnumValue(hKey, i, name.data(), &nameLen, nullptr, &type, data.data(), &dataLen) != ERROR_SUCCESS) {
+            continue;
+        }
+
+        if (type == REG_DWORD && dataLen == sizeof(DWORD)) {
+            DWORD value;
+            std::memcpy(&value, data.data(), sizeof(value));
+            values.emplace_back(name.data(), static_cast<int>(value));
+        } else if (type == REG_SZ) {
+            // The stored string is not guaranteed to be null terminated.
+            PCTSTR str = reinterpret_cast<PCTSTR>(data.data());
+            int len = static_cast<int>(dataLen / sizeof(TCHAR));
+            while (len > 0 && str[len - 1] == _T('\0')) {
+                len--;
+            }
+            values.emplace_back(name.data(), CString(str, len));
+        }
+    }
+
+    CloseKey(hKey);
+    return TRUE;
+}
+
+BOOL MeaRegistry::WriteSection(PCTSTR section, const MeaRegistryValues& values) {
+    HKEY hKey = AfxGetApp()->GetSectionKey(section);
+    if (hKey == nullptr) {
+        return FALSE;
+    }
+
+    BOOL success = TRUE;
+
+    for (const MeaRegistryValue& value : values) {
+        LSTATUS status;
+        if (value.m_type == REG_DWORD) {
+            DWORD intValue = static_cast<DWORD>(value.m_intValue);
+            status = ::RegSetValueEx(hKey, value.m_name, 0, REG_DWORD, reinterpret_cast<const BYTE*>(&intValue),
+                                     sizeof(intValue));
+        } else {
+            status = ::RegSetValueEx(hKey, value.m_name, 0, REG_SZ,
+                                     reinterpret_cast<const BYTE*>(static_cast<PCTSTR>(value.m_strValue)),
+                                     (value.m_strValue.GetLength() + 1) * sizeof(TCHAR));
+        }
+
+        if (status != ERROR_SUCCESS) {
+            success = FALSE;
+        }
+    }
+
+    CloseKey(hKey);
+    return success;
+}
+
 PCTSTR MeaRegistry::GetKeyName() {
     return AfxGetApp()->m_pszRegistryKey;
 }
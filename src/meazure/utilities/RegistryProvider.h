@@ -22,6 +22,46 @@
 
 #pragma once
 
+#include <vector>
+
+
+/// Named value in a section of the application's registry. Only the integer (REG_DWORD) and string (REG_SZ)
+/// value types used by the application are represented.
+///
+struct MeaRegistryValue {
+    /// Constructs an integer value.
+    ///
+    /// @param name     [in] Name of the value
+    /// @param value    [in] Integer value
+    ///
+    MeaRegistryValue(PCTSTR name, int value) : m_name(name), m_type(REG_DWORD), m_intValue(value) {}
+
+    /// Constructs a string value.
+    ///
+    /// @param name     [in] Name of the value
+    /// @param value    [in] String value
+    ///
+    MeaRegistryValue(PCTSTR name, PCTSTR value) : m_name(name), m_type(REG_SZ), m_intValue(0), m_strValue(value) {}
+
+    /// Tests whether the type and contents of this value are the same as those of the specified value. The
+    /// names of the values are not compared.
+    ///
+    /// @param other    [in] Value to compare
+    /// @return <b>true</b> if the values have the same type and contents.
+    ///
+    bool SameValue(const MeaRegistryValue& other) const {
+        return (m_type == other.m_type) &&
+            ((m_type == REG_DWORD) ? (m_intValue == other.m_intValue) : (m_strValue == other.m_strValue));
+    }
+
+    CString m_name;         ///< Name of the value
+    DWORD m_type;           ///< REG_DWORD or REG_SZ
+    int m_intValue;         ///< Value if the type is REG_DWORD
+    CString m_strValue;     ///< Value if the type is REG_SZ
+};
+
+typedef std::vector<MeaRegistryValue> MeaRegistryValues;
+
 
 /// Interface for Windows Registry interaction.
 ///
@@ -74,6 +114,26 @@ struct MeaRegistryProvider {
     /// 
     virtual CString GetString(PCTSTR section, PCTSTR entry, PCTSTR defaultValue) = 0;
 
+    /// Retrieves all integer and string values in the specified section of the application's registry using a
+    /// single open of the section's key.
+    ///
+    /// @param section  [in] Points to a null-terminated string that specifies the section whose values are to be
+    ///     retrieved.
+    /// @param values   [out] The values in the section are appended to this list.
+    /// @return TRUE if the section exists and was read; otherwise FALSE.
+    ///
+    virtual BOOL ReadSection(PCTSTR section, MeaRegistryValues& values) = 0;
+
+    /// Writes the specified values into the specified section of the application's registry using a single
+    /// open of the section's key.
+    ///
+    /// @param section  [in] Points to a null-terminated string that specifies the section into which the values
+    ///     are to be written. If the section does not exist, it is created.
+    /// @param values   [in] Values to write. Entries that do not exist in the section are created.
+    /// @return TRUE if all values were written; otherwise FALSE.
+    ///
+    virtual BOOL WriteSection(PCTSTR section, const MeaRegistryValues& values) = 0;
+
     /// Determines where, in the registry or INI file, application profile settings are stored
     ///
     /// @return Application registry key.
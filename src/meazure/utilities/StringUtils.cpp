@@ -19,42 +19,31 @@
 
 #include <meazure/pch.h>
 #include "StringUtils.h"
+#include "NumberFormat.h"
+#include "NumberParse.h"
 #include <iostream>
+#include <memory>
 
 
 CString MeaStringUtils::IntToStr(int value) {
-    CString numStr;
-    numStr.Format("%d", value);
-    return numStr;
+    MeaNumberFormat::Buffer buffer;
+    std::string_view numStr = MeaNumberFormat::FormatInt(buffer, value);
+    return CString(numStr.data(), static_cast<int>(numStr.size()));
 }
 
 CString MeaStringUtils::DblToStr(double value) {
-    CString numStr;
-    numStr.Format(_T("%.*f"), DBL_DIG - 1, value);
-
-    int idx = numStr.GetLength();
-    while (idx-- > 1) {
-        if ((numStr[idx] != _T('0')) || (numStr[idx - 1] == _T('.'))) {
-            break;
-        }
-    }
-
-    return numStr.Left(idx + 1);
+    MeaNumberFormat::Buffer buffer;
+    std::string_view numStr = MeaNumberFormat::FormatTrimmed(buffer, value);
+    return CString(numStr.data(), static_cast<int>(numStr.size()));
 }
 
 bool MeaStringUtils::IsNumber(PCTSTR str, double* valuep) {
-    CString vstr(str);
-    PTSTR endStr;
-
-    vstr.TrimLeft();
-    vstr.TrimRight();
-    if (vstr.IsEmpty() || (static_cast<int>(_tcslen(str)) != vstr.GetLength())) {
+    if (str == nullptr) {
         return false;
     }
 
-    errno = 0;
-    double v = _tcstod(str, &endStr);
-    if ((*endStr != _T('\0')) || (errno == ERANGE)) {
+    double v;
+    if (MeaNumberParse::ParseDbl(str, v) != MeaNumberParse::Result::Ok) {
         return false;
     }
 
@@ -117,95 +106,81 @@ CString MeaStringUtils::CRLFtoLF(CString str) {
     return conv;
 }
 
-CStringA MeaStringUtils::ACPtoUTF8(const CString& str) {
-    return ACPtoUTF8(static_cast<PCTSTR>(str), str.GetLength());
-}
-
-CStringA MeaStringUtils::ACPtoUTF8(PCTSTR str, std::size_t len) {
-    CStringA utf8Str;
-
+void MeaStringUtils::AppendUTF8(std::string& out, PCTSTR str, std::size_t len) {
     if (str == nullptr || len == 0) {
-        return utf8Str;
+        return;
     }
 
     std::size_t strLen = (len == SIZE_MAX) ? _tcslen(str) : len;
     if (strLen == 0) {
-        return utf8Str;
+        return;
     }
 
 #ifdef _UNICODE
-    int numBytes = WideCharToMultiByte(CP_UTF8, 0, str, strLen, nullptr, 0, nullptr, nullptr);
-    if (numBytes > 0) {
-        WideCharToMultiByte(CP_UTF8, 0, str, strLen, utf8Str.GetBuffer(numBytes), numBytes, nullptr, nullptr);
-        utf8Str.ReleaseBufferSetLength(numBytes);
-    } else {
-        DWORD errorCode = GetLastError();
-        if (GetConsoleWindow() != nullptr) {
-            std::cerr << "Could not convert wide character to UTF-8. Error code " << errorCode << '\n';
-        }
-    }
+    MeaUTF8Transcoder::Append(out, str, strLen);
 #else
-    CStringW wideStr(str, static_cast<int>(strLen));
-
-    int numWideChars = wideStr.GetLength();
-    int numBytes = WideCharToMultiByte(CP_UTF8, 0, static_cast<PCWSTR>(wideStr), numWideChars, nullptr, 0,
-                                       nullptr, nullptr);
-    if (numBytes > 0) {
-        WideCharToMultiByte(CP_UTF8, 0, static_cast<PCWSTR>(wideStr), numWideChars,
-                            utf8Str.GetBuffer(numBytes), numBytes, nullptr, nullptr);
-        utf8Str.ReleaseBufferSetLength(numBytes);
-    } else {
+    const MeaUTF8Transcoder* transcoder = GetACPTranscoder();
+    if (transcoder != nullptr) {
+        transcoder->Append(out, str, strLen);
+        return;
+    }
+
+    // The active code page is a multibyte code page, which cannot be table driven. Fall back to converting
+    // through wide characters.
+    int numWideChars = MultiByteToWideChar(CP_ACP, 0, str, static_cast<int>(strLen), nullptr, 0);
+    if (numWideChars <= 0) {
         DWORD errorCode = GetLastError();
         if (GetConsoleWindow() != nullptr) {
-            std::cerr << "Could not convert wide character to UTF-8. Error code " << errorCode << '\n';
+            std::cerr << "Could not convert character to wide character. Error code " << errorCode << '\n';
         }
+        return;
     }
-#endif
 
-    return utf8Str;
+    std::wstring wideStr(numWideChars, L'\0');
+    MultiByteToWideChar(CP_ACP, 0, str, static_cast<int>(strLen), wideStr.data(), numWideChars);
+    MeaUTF8Transcoder::Append(out, wideStr.data(), wideStr.size());
+#endif
 }
 
-CStringA MeaStringUtils::ACPtoUTF8(TCHAR ch) {
+CStringA MeaStringUtils::ACPtoUTF8(const CString& str) {
+    return ACPtoUTF8(static_cast<PCTSTR>(str), str.GetLength());
+}
 
-#ifdef _UNICODE
-    if (ch > '\u001F' && ch < '\u007F') {
-        return CStringA(&ch, 1);
-    }
+CStringA MeaStringUtils::ACPtoUTF8(PCTSTR str, std::size_t len) {
+    std::string utf8Str;
+    AppendUTF8(utf8Str, str, len);
+    return CStringA(utf8Str.data(), static_cast<int>(utf8Str.size()));
+}
 
-    CStringA utf8Str;
+CStringA MeaStringUtils::ACPtoUTF8(TCHAR ch) {
+    return ACPtoUTF8(&ch, 1);
+}
 
-    int numBytes = WideCharToMultiByte(CP_UTF8, 0, &ch, 1, nullptr, 0, nullptr, nullptr);
-    if (numBytes > 0) {
-        WideCharToMultiByte(CP_UTF8, 0, &ch, 1, utf8Str.GetBuffer(numBytes), numBytes, nullptr, nullptr);
-        utf8Str.ReleaseBufferSetLength(numBytes);
-    } else {
-        DWORD errorCode = GetLastError();
-        if (GetConsoleWindow() != nullptr) {
-            std::cerr << "Could not convert wide character to UTF-8. Error code " << errorCode << '\n';
+#ifndef _UNICODE
+const MeaUTF8Transcoder* MeaStringUtils::GetACPTranscoder() {
+    static const std::unique_ptr<MeaUTF8Transcoder> transcoder = []() -> std::unique_ptr<MeaUTF8Transcoder> {
+        CPINFO cpInfo;
+        if (!GetCPInfo(CP_ACP, &cpInfo) || cpInfo.MaxCharSize != 1) {
+            return nullptr;
         }
-    }
 
-    return utf8Str;
-#else
-    if (ch > '\x1F' && ch < '\x7F') {
-        return CStringA(&ch, 1);
-    }
+        char highBytes[128];
+        for (int i = 0; i < 128; i++) {
+            highBytes[i] = static_cast<char>(0x80 + i);
+        }
 
-    CStringW wideStr(&ch, 1);
-    CStringA utf8Str;
+        wchar_t wideChars[128];
+        if (MultiByteToWideChar(CP_ACP, 0, highBytes, 128, wideChars, 128) != 128) {
+            return nullptr;
+        }
 
-    int numBytes = WideCharToMultiByte(CP_UTF8, 0, static_cast<PCWSTR>(wideStr), 1, nullptr, 0, nullptr, nullptr);
-    if (numBytes > 0) {
-        WideCharToMultiByte(CP_UTF8, 0, static_cast<PCWSTR>(wideStr), 1, utf8Str.GetBuffer(numBytes), numBytes,
-                            nullptr, nullptr);
-        utf8Str.ReleaseBufferSetLength(numBytes);
-    } else {
-        DWORD errorCode = GetLastError();
-        if (GetConsoleWindow() != nullptr) {
-            std::cerr << "Could not convert wide character to UTF-8. Error code " << errorCode << '\n';
+        MeaUTF8Transcoder::HighTable table;
+        for (int i = 0; i < 128; i++) {
+            table[i] = wideChars[i];
         }
-    }
+        return std::make_unique<MeaUTF8Transcoder>(table);
+    }();
 
-    return utf8Str;
-#endif
+    return transcoder.get();
 }
+#endif
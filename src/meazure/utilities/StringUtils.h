@@ -22,8 +22,10 @@
 
 #pragma once
 
+#include "UTF8Transcoder.h"
 #include <limits.h>
 #include <cstddef>
+#include <string>
 
 
 namespace MeaStringUtils {
@@ -81,6 +83,19 @@ namespace MeaStringUtils {
     ///
     CString CRLFtoLF(CString str);
 
+    /// Converts a string encoded in the active code page (ACP) to UTF-8 and appends it to the specified output.
+    /// This is the bulk form of ACPtoUTF8. Because the output is appended to a caller provided buffer, the buffer
+    /// can be reused across conversions to avoid allocation. When the ACP is a single byte code page, the
+    /// conversion is table driven with a fast path for ASCII text.
+    ///
+    /// @param out      [in, out] String to which the UTF-8 characters are appended.
+    /// @param str      [in] String to convert to UTF-8 encoding. If _UNICODE is defined, the string in converted
+    ///     from wide characters to UTF-8. If _UNICODE is not defined, the string is converted from the ACP to UTF-8.
+    /// @param strLen   [in] Number of characters (unicode) or bytes (mbcs) for the specified string. Default is
+    ///     SIZE_MAX if the length of the string is unknown.
+    ///
+    void AppendUTF8(std::string& out, PCTSTR str, std::size_t strLen = SIZE_MAX);
+
     /// Converts a string encoded in the active code page (ACP) to a string in UTF-8 encoding.
     /// 
     /// @param str  [in] String to covert to UTF-8 encoding. If _UNICODE is defined, the string in converted from
@@ -107,4 +122,13 @@ namespace MeaStringUtils {
     /// @return The specified character converted to UTF-8 encoding.
     /// 
     CStringA ACPtoUTF8(TCHAR ch);
+
+#ifndef _UNICODE
+    /// Obtains the table driven transcoder for the active code page (ACP). The transcoder is created the first
+    /// time this function is called.
+    ///
+    /// @return Transcoder for the ACP, or nullptr if the ACP is a multibyte code page.
+    ///
+    const MeaUTF8Transcoder* GetACPTranscoder();
+#endif
 };
@@ -22,26 +22,18 @@
 
 
 MeaTimer::MeaTimer() :
-    m_timerThread(nullptr),
-    m_stopEvent(FALSE, TRUE),
-    m_exitEvent(FALSE, TRUE),
-    m_elapse(0),
+    m_timerId(MeaTimerService::kNoTimer),
     m_parent(nullptr),
-    m_userData(0) {
-    // The m_exitEvent indicates whether we are in the timer procedure. Since
-    // we are just starting, we are not in the timer thread.
-    //
-    m_exitEvent.SetEvent();
-}
+    m_userData(0),
+    m_message(MeaHPTimerMsg) {}
 
 MeaTimer::~MeaTimer() {
     try {
-        // Don't leave the timer thread running or we will pull the object
+        // Don't leave the timer scheduled or we will pull the object
         // instance out from under it.
         //
         Stop();
 
-        m_timerThread = nullptr;
         m_parent = nullptr;
     } catch (...) {
         assert(false);
@@ -53,62 +45,57 @@ void MeaTimer::Start(int elapse) {
     //
     assert(m_parent != nullptr);
 
-    // Only one thread at a time can set or read the timer thread ID.
+    // Only one thread at a time can set or read the timer ID.
     //
     m_critSect.Lock();
 
-    m_elapse = elapse;
-
-    // Only one timer thread is allowed to run at one time. In other
-    // words, multiple calls to Start will not cause multiple timer
-    // threads to pile up.
+    // Only one timer is allowed to be scheduled at one time. In other
+    // words, multiple calls to Start will not cause multiple timers
+    // to pile up.
     //
-    if (m_timerThread == nullptr) {
-        m_timerThread = AfxBeginThread(MeaTimer::TimerProc, this);
+    if (m_timerId == MeaTimerService::kNoTimer) {
+        m_timerId = GetService().Schedule(std::chrono::milliseconds(elapse),
+                                          [this](MeaTimerService::TimerId id) { Expired(id); }, this);
     }
 
     m_critSect.Unlock();
 }
 
 void MeaTimer::Stop() {
-    // Stop the timer thread.
-    //
-    m_stopEvent.PulseEvent();
+    m_critSect.Lock();
+    m_timerId = MeaTimerService::kNoTimer;
+    m_critSect.Unlock();
 
-    // Wait for the signal that the timer thread is done.
+    // Every timer scheduled by this object is cancelled, including ones
+    // that have already expired. Expired clears m_timerId before it
+    // posts the timer message, so the handler of an earlier timer may
+    // still be running and using this object after a later timer has
+    // been started. Cancelling waits for any such handler to complete,
+    // so the lock must not be held here.
     //
-    ::WaitForSingleObject(m_exitEvent, INFINITE);
+    GetService().CancelAll(this);
 }
 
-UINT MeaTimer::TimerProc() {
-    // Indicate that the timer thread has begun.
-    //
-    m_exitEvent.ResetEvent();
-
-    //
-    // Wait for the requested amount of time interruptible by stop event.
-    //
-    DWORD ret = ::WaitForSingleObject(m_stopEvent, m_elapse);
+MeaTimerService& MeaTimer::GetService() {
+    static MeaTimerService service;
+    return service;
+}
 
-    // Allow another timer thread to start. This must happen
-    // before posting the timer message in case the timer message
-    // handler calls the timer Start method.
+void MeaTimer::Expired(MeaTimerService::TimerId timerId) {
+    // Allow another timer to start. This must happen before posting
+    // the timer message in case the timer message handler calls the
+    // timer Start method. If the timer was stopped (and possibly
+    // restarted) while this handler was being called, the expiration
+    // is stale and no message is sent.
     //
     m_critSect.Lock();
-    m_timerThread = nullptr;
+    bool current = (m_timerId == timerId);
+    if (current) {
+        m_timerId = MeaTimerService::kNoTimer;
+    }
     m_critSect.Unlock();
 
-    // Tell the parent that the timer has expired if the wait
-    // exited due to the elapsed time expiring rather than the
-    // stop event being issued.
-    //
-    if (ret == WAIT_TIMEOUT) {        // Normal path
-        m_parent->PostMessage(MeaHPTimerMsg, m_userData);
+    if (current) {
+        m_parent->PostMessage(m_message, m_userData);
     }
-
-    // Indicate that the timer thread is done.
-    //
-    m_exitEvent.SetEvent();
-
-    return 0;
 }
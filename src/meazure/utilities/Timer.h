@@ -25,11 +25,15 @@
 
 #include <afxmt.h>
 #include <meazure/Messages.h>
+#include "TimerService.h"
 #include <cassert>
 
 
 /// Implements a timer that issues timing messages at a higher priority
-/// than the standard windows timer that issues WM_TIMER messages.
+/// than the standard windows timer that issues WM_TIMER messages. All
+/// timers are run by a single MeaTimerService thread that is shared by
+/// the application. This class adapts the service to post a message to
+/// a window when the timer expires.
 ///
 class MeaTimer {
 
@@ -44,19 +48,22 @@ public:
     virtual ~MeaTimer();
 
     /// Registers the specified parent window to receive the timer
-    /// messages. The timer will send the parent a MeaHPTimerMsg
-    /// message.
+    /// messages. By default, the timer will send the parent a
+    /// MeaHPTimerMsg message.
     ///
-    /// @param parent   [in] Parent window to receive the MeaHPTimerMsg message.
+    /// @param parent   [in] Parent window to receive the timer message.
     /// @param userData [in] Caller defined data.
+    /// @param message  [in] Message to post to the parent when the timer expires.
     ///
-    void Create(CWnd* parent, WPARAM userData = 0) {
+    void Create(CWnd* parent, WPARAM userData = 0, UINT message = MeaHPTimerMsg) {
         assert(parent != nullptr);
         m_parent = parent;
         m_userData = userData;
+        m_message = message;
     }
 
     /// Sets the timer to the specified interval and starts it running.
+    /// If the timer is already running, this method has no effect.
     ///
     /// @param elapse   [in] Time interval in milliseconds.
     ///
@@ -67,30 +74,24 @@ public:
     void Stop();
 
 private:
-    /// Called when the timer expires. Simply calls the instance
-    /// method of the same name.
+    /// Obtains the timer service shared by all timers in the application.
     ///
-    /// @param pParam   [i] Timer instance pointer.
+    /// @return Timer service.
     ///
-    /// @return Zero indicating success.
-    ///
-    static UINT TimerProc(LPVOID pParam) {
-        return static_cast<MeaTimer*>(pParam)->TimerProc();
-    }
+    static MeaTimerService& GetService();
 
-    /// Called when the timer expires. Sends the MeaHPTimerMsg message
-    /// to the parent window.
+    /// Called on the timer service thread when the timer expires. Sends
+    /// the timer message to the parent window unless the timer has been
+    /// stopped.
     ///
-    /// @return Zero indicating success.
+    /// @param timerId  [in] Timer that expired.
     ///
-    UINT TimerProc();
+    void Expired(MeaTimerService::TimerId timerId);
 
 
-    CWinThread* m_timerThread;      ///< Thread in which the timer runs.
-    CCriticalSection m_critSect;    ///< Critical section guard.
-    CEvent m_stopEvent;             ///< Used internally to indicate the timer has been stopped.
-    CEvent m_exitEvent;             ///< Used internally to indicate the timer has completed all processing.
-    int m_elapse;                   ///< Timer period, in milliseconds.
-    CWnd* m_parent;                 ///< Window to receive the timer expire message.
-    WPARAM m_userData;              ///< Caller defined data.
+    CCriticalSection m_critSect;            ///< Critical section guard.
+    MeaTimerService::TimerId m_timerId;     ///< Currently scheduled timer, or kNoTimer.
+    CWnd* m_parent;                         ///< Window to receive the timer expire message.
+    WPARAM m_userData;                      ///< Caller defined data.
+    UINT m_message;                         ///< Message posted to the parent window when the timer expires.
 };
@@ -0,0 +1,158 @@
+/*
+ * Copyright 2022 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "TimerService.h"
+#include <algorithm>
+
+
+MeaTimerService::MeaTimerService() :
+    m_nextId(kNoTimer + 1),
+    m_runningId(kNoTimer),
+    m_runningOwner(nullptr),
+    m_shutdown(false) {}
+
+MeaTimerService::~MeaTimerService() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_shutdown = true;
+    }
+    m_wakeup.notify_one();
+
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+}
+
+MeaTimerService::TimerId MeaTimerService::Schedule(std::chrono::milliseconds delay, Callback callback,
+                                                   const void* owner) {
+    Clock::time_point when = Clock::now() + std::max(delay, std::chrono::milliseconds::zero());
+    bool wake;
+    TimerId id;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        if (!m_thread.joinable()) {
+            m_thread = std::thread(&MeaTimerService::Run, this);
+        }
+
+        id = m_nextId++;
+        m_callbacks.emplace(id, Pending { std::move(callback), owner });
+
+        // The service thread only needs to be woken if the new timer expires before the one it is waiting on.
+        wake = m_heap.empty() || (when < m_heap.front().m_when);
+
+        m_heap.push_back({ when, id });
+        std::push_heap(m_heap.begin(), m_heap.end(), std::greater<Expiration>());
+    }
+
+    if (wake) {
+        m_wakeup.notify_one();
+    }
+
+    return id;
+}
+
+bool MeaTimerService::Cancel(TimerId id) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    bool cancelled = m_callbacks.erase(id) > 0;
+
+    // The heap entry is left in place and discarded by the service thread when it reaches the top of the heap.
+    // If the timer's callback is running, wait for it to complete unless it is the callback cancelling itself.
+    if (!cancelled && id != kNoTimer && std::this_thread::get_id() != m_thread.get_id()) {
+        m_callbackDone.wait(lock, [this, id]() { return m_runningId != id; });
+    }
+
+    return cancelled;
+}
+
+std::size_t MeaTimerService::CancelAll(const void* owner) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    if (owner == nullptr) {
+        return 0;
+    }
+
+    std::size_t cancelled = 0;
+    for (auto iter = m_callbacks.begin(); iter != m_callbacks.end(); ) {
+        if (iter->second.m_owner == owner) {
+            iter = m_callbacks.erase(iter);
+            cancelled++;
+        } else {
+            ++iter;
+        }
+    }
+
+    if (std::this_thread::get_id() != m_thread.get_id()) {
+        m_callbackDone.wait(lock, [this, owner]() { return m_runningOwner != owner; });
+    }
+
+    return cancelled;
+}
+
+std::size_t MeaTimerService::GetPendingCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_callbacks.size();
+}
+
+void MeaTimerService::Run() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    while (!m_shutdown) {
+        if (m_heap.empty()) {
+            m_wakeup.wait(lock);
+            continue;
+        }
+
+        const Expiration& next = m_heap.front();
+
+        auto iter = m_callbacks.find(next.m_id);
+        if (iter == m_callbacks.end()) {
+            // Cancelled timer
+            std::pop_heap(m_heap.begin(), m_heap.end(), std::greater<Expiration>());
+            m_heap.pop_back();
+            continue;
+        }
+
+        if (Clock::now() < next.m_when) {
+            // Copy the expiration time because the heap can change while waiting.
+            Clock::time_point when = next.m_when;
+            m_wakeup.wait_until(lock, when);
+            continue;
+        }
+
+        TimerId id = next.m_id;
+        Callback callback = std::move(iter->second.m_callback);
+        m_runningOwner = iter->second.m_owner;
+        m_callbacks.erase(iter);
+        m_runningId = id;
+        std::pop_heap(m_heap.begin(), m_heap.end(), std::greater<Expiration>());
+        m_heap.pop_back();
+
+        // Run the callback without holding the lock so that it can schedule and cancel timers.
+        lock.unlock();
+        callback(id);
+        lock.lock();
+
+        m_runningId = kNoTimer;
+        m_runningOwner = nullptr;
+        m_callbackDone.notify_all();
+    }
+}
@@ -0,0 +1,147 @@
+/*
+ * Copyright 2022 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/// @file
+/// @brief Header file for a shared one-shot timer service.
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+
+/// Runs one-shot timers on a single service thread. Timers are kept in a min-heap ordered by expiration
+/// time, and the service thread sleeps until the earliest timer expires or the set of timers changes. When
+/// a timer expires, its callback is run on the service thread. Callbacks should therefore be brief (e.g.
+/// posting a message to a window) so that other timers are not delayed.
+///
+/// The service thread is created when the first timer is scheduled and lives until the service is destroyed,
+/// so arming and cancelling timers never creates threads. This class does not depend on MFC or Windows and
+/// can be used on any platform.
+///
+class MeaTimerService {
+
+public:
+    typedef std::uint64_t TimerId;                  ///< Identifies a scheduled timer.
+    typedef std::function<void(TimerId)> Callback;  ///< Called on the service thread when a timer expires.
+
+    static constexpr TimerId kNoTimer = 0;          ///< Never used to identify a timer.
+
+
+    /// Constructs a timer service. The service thread is not started until a timer is scheduled.
+    ///
+    MeaTimerService();
+
+    /// Stops the service thread. Timers that have not yet expired are discarded without calling their
+    /// callbacks.
+    ///
+    ~MeaTimerService();
+
+    MeaTimerService(const MeaTimerService&) = delete;
+    MeaTimerService& operator=(const MeaTimerService&) = delete;
+
+    /// Schedules a one-shot timer.
+    ///
+    /// @param delay        [in] Time from now at which the timer expires.
+    /// @param callback     [in] Called on the service thread when the timer expires. The timer's identifier is
+    ///                     passed to the callback.
+    /// @param owner        [in] Object whose timers can be cancelled together using CancelAll, or nullptr if the
+    ///                     timer has no owner. Typically the object used by the callback.
+    ///
+    /// @return Identifier for the timer, which can be used to cancel it.
+    ///
+    TimerId Schedule(std::chrono::milliseconds delay, Callback callback, const void* owner = nullptr);
+
+    /// Cancels the specified timer. If the timer's callback is running on the service thread when this method
+    /// is called from another thread, the method waits for the callback to complete. This guarantees that the
+    /// callback will not be running once this method returns, so that the objects it uses can be destroyed.
+    ///
+    /// @param id       [in] Timer to cancel.
+    ///
+    /// @return <b>true</b> if the timer was cancelled before it expired. <b>false</b> if the timer has
+    ///         already expired, has already been cancelled, or was never scheduled.
+    ///
+    bool Cancel(TimerId id);
+
+    /// Cancels all timers scheduled for the specified owner. If a callback of any of the owner's timers is
+    /// running on the service thread when this method is called from another thread, the method waits for the
+    /// callback to complete. Unlike cancelling the owner's most recent timer, this covers a callback of an
+    /// earlier timer that is still running after a new timer has been scheduled, so that the owner can be
+    /// destroyed once this method returns.
+    ///
+    /// @param owner    [in] Owner whose timers are cancelled. Timers without an owner are not affected.
+    ///
+    /// @return Number of timers cancelled before they expired.
+    ///
+    std::size_t CancelAll(const void* owner);
+
+    /// Obtains the number of timers that are scheduled and have not yet expired.
+    ///
+    /// @return Number of pending timers.
+    ///
+    std::size_t GetPendingCount() const;
+
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    /// Timer that is scheduled and has not yet expired.
+    ///
+    struct Pending {
+        Callback m_callback;            ///< Called when the timer expires.
+        const void* m_owner;            ///< Owner of the timer, or nullptr.
+    };
+
+    /// Entry in the min-heap of timers. Cancelled timers are left in the heap and are discarded when they reach
+    /// the top, so that cancellation does not require searching the heap.
+    ///
+    struct Expiration {
+        Clock::time_point m_when;       ///< Time at which the timer expires.
+        TimerId m_id;                   ///< Timer that expires.
+
+        /// Orders the heap so that the earliest expiration is at the top. Timers with the same expiration time
+        /// expire in the order in which they were scheduled.
+        ///
+        bool operator>(const Expiration& other) const {
+            return (m_when > other.m_when) || ((m_when == other.m_when) && (m_id > other.m_id));
+        }
+    };
+
+
+    /// Body of the service thread.
+    ///
+    void Run();
+
+
+    mutable std::mutex m_mutex;                     ///< Guards all members below.
+    std::condition_variable m_wakeup;               ///< Signals the service thread that timers have changed.
+    std::condition_variable m_callbackDone;         ///< Signals that a callback has finished running.
+    std::vector<Expiration> m_heap;                 ///< Min-heap of timer expirations.
+    std::unordered_map<TimerId, Pending> m_callbacks;  ///< Callbacks of pending timers.
+    TimerId m_nextId;                               ///< Identifier for the next timer scheduled.
+    TimerId m_runningId;                            ///< Timer whose callback is running, or kNoTimer.
+    const void* m_runningOwner;                     ///< Owner of the timer whose callback is running, or nullptr.
+    bool m_shutdown;                                ///< Indicates the service thread should exit.
+    std::thread m_thread;                           ///< Service thread.
+};
@@ -0,0 +1,157 @@
+/*
+ * Copyright 2022 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "UTF8Transcoder.h"
+#include <cstdint>
+#include <cstring>
+
+
+namespace {
+    constexpr std::uint64_t kHighBits = 0x8080808080808080ULL;
+    constexpr char32_t kReplacementChar = 0xFFFD;
+}
+
+
+MeaUTF8Transcoder::MeaUTF8Transcoder(const HighTable& highTable) {
+    std::string encoded;
+
+    for (std::size_t i = 0; i < highTable.size(); i++) {
+        encoded.clear();
+        AppendCodePoint(encoded, highTable[i]);
+
+        Encoded& entry = m_highTable[i];
+        std::memcpy(entry.m_bytes, encoded.data(), encoded.size());
+        entry.m_len = static_cast<unsigned char>(encoded.size());
+    }
+}
+
+MeaUTF8Transcoder::HighTable MeaUTF8Transcoder::Latin1Table() {
+    HighTable table;
+    for (std::size_t i = 0; i < table.size(); i++) {
+        table[i] = static_cast<char32_t>(0x80 + i);
+    }
+    return table;
+}
+
+std::size_t MeaUTF8Transcoder::AsciiPrefixLength(const char* str, std::size_t len) {
+    std::size_t i = 0;
+
+    // Examine 16 bytes at a time. memcpy is used for the loads so that unaligned input is handled portably; the
+    // compiler turns it into plain register loads.
+    while (i + 16 <= len) {
+        std::uint64_t w1;
+        std::uint64_t w2;
+        std::memcpy(&w1, str + i, sizeof(w1));
+        std::memcpy(&w2, str + i + 8, sizeof(w2));
+        if (((w1 | w2) & kHighBits) != 0) {
+            break;
+        }
+        i += 16;
+    }
+
+    while (i < len && (static_cast<unsigned char>(str[i]) & 0x80) == 0) {
+        i++;
+    }
+
+    return i;
+}
+
+void MeaUTF8Transcoder::Append(std::string& out, const char* str, std::size_t len) const {
+    std::size_t i = 0;
+
+    while (i < len) {
+        std::size_t asciiLen = AsciiPrefixLength(str + i, len - i);
+        out.append(str + i, asciiLen);
+        i += asciiLen;
+
+        while (i < len && (static_cast<unsigned char>(str[i]) & 0x80) != 0) {
+            const Encoded& entry = m_highTable[static_cast<unsigned char>(str[i]) - 0x80];
+            out.append(entry.m_bytes, entry.m_len);
+            i++;
+        }
+    }
+}
+
+void MeaUTF8Transcoder::Append(std::string& out, const wchar_t* str, std::size_t len) {
+    std::size_t i = 0;
+
+    while (i < len) {
+        // ASCII run
+        std::size_t start = i;
+        while (i < len && static_cast<std::uint32_t>(str[i]) < 0x80) {
+            i++;
+        }
+        if (i > start) {
+            std::size_t outLen = out.size();
+            out.resize(outLen + (i - start));
+            for (std::size_t j = start; j < i; j++) {
+                out[outLen++] = static_cast<char>(str[j]);
+            }
+        }
+
+        if (i < len) {
+            char32_t cp = static_cast<char32_t>(static_cast<std::uint32_t>(str[i++]));
+            if constexpr (sizeof(wchar_t) == 2) {
+                if (cp >= 0xD800 && cp <= 0xDBFF) {
+                    char32_t low = (i < len) ? static_cast<char32_t>(static_cast<std::uint16_t>(str[i])) : 0;
+                    if (low >= 0xDC00 && low <= 0xDFFF) {
+                        cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+                        i++;
+                    } else {
+                        cp = kReplacementChar;
+                    }
+                } else if (cp >= 0xDC00 && cp <= 0xDFFF) {
+                    cp = kReplacementChar;
+                }
+            }
+            AppendCodePoint(out, cp);
+        }
+    }
+}
+
+void MeaUTF8Transcoder::AppendCodePoint(std::string& out, char32_t cp) {
+    if (cp > 0x10FFFF || (cp >= 0xD800 && cp <= 0xDFFF)) {
+        cp = kReplacementChar;
+    }
+
+    if (cp < 0x80) {
+        out.push_back(static_cast<char>(cp));
+    } else if (cp < 0x800) {
+        char bytes[] = {
+            static_cast<char>(0xC0 | (cp >> 6)),
+            static_cast<char>(0x80 | (cp & 0x3F))
+        };
+        out.append(bytes, sizeof(bytes));
+    } else if (cp < 0x10000) {
+        char bytes[] = {
+            static_cast<char>(0xE0 | (cp >> 12)),
+            static_cast<char>(0x80 | ((cp >> 6) & 0x3F)),
+            static_cast<char>(0x80 | (cp & 0x3F))
+        };
+        out.append(bytes, sizeof(bytes));
+    } else {
+        char bytes[] = {
+            static_cast<char>(0xF0 | (cp >> 18)),
+            static_cast<char>(0x80 | ((cp >> 12) & 0x3F)),
+            static_cast<char>(0x80 | ((cp >> 6) & 0x3F)),
+            static_cast<char>(0x80 | (cp & 0x3F))
+        };
+        out.append(bytes, sizeof(bytes));
+    }
+}
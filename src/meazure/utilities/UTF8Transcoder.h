@@ -0,0 +1,102 @@
+/*
+ * Copyright 2022 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+ /// @file
+ /// @brief Table driven transcoding of single byte code page and UTF-16 strings to UTF-8.
+
+#pragma once
+
+#include <array>
+#include <string>
+#include <cstddef>
+
+
+/// Transcodes strings to UTF-8. Single byte code page strings are converted using a table that maps each byte
+/// with its high bit set to a Unicode code point. Bytes without the high bit set are ASCII and are copied
+/// unchanged. Because most text handled by Meazure is ASCII, runs of ASCII characters are detected and copied
+/// 16 bytes at a time.
+///
+/// Output is appended to a caller provided std::string so that the same buffer, and its capacity, can be reused
+/// across conversions. This class does not depend on MFC or Windows and can be used on any platform.
+///
+class MeaUTF8Transcoder {
+
+public:
+    /// Unicode code points for the bytes 0x80 through 0xFF of a single byte code page.
+    ///
+    typedef std::array<char32_t, 128> HighTable;
+
+
+    /// Constructs a transcoder for the single byte code page described by the specified table.
+    ///
+    /// @param highTable    [in] Unicode code points for the bytes 0x80 through 0xFF.
+    ///
+    explicit MeaUTF8Transcoder(const HighTable& highTable);
+
+    /// Returns the table for ISO 8859-1 (Latin-1), where each byte maps to the code point of the same value.
+    ///
+    /// @return Table for the Latin-1 code page.
+    ///
+    static HighTable Latin1Table();
+
+    /// Converts the specified single byte code page string to UTF-8 and appends it to the output.
+    ///
+    /// @param out      [in, out] String to which the UTF-8 characters are appended.
+    /// @param str      [in] Characters to convert.
+    /// @param len      [in] Number of characters to convert.
+    ///
+    void Append(std::string& out, const char* str, std::size_t len) const;
+
+    /// Converts the specified UTF-16 (or UTF-32 where wchar_t is 32 bits) string to UTF-8 and appends it to the
+    /// output. Unpaired surrogates are replaced with U+FFFD.
+    ///
+    /// @param out      [in, out] String to which the UTF-8 characters are appended.
+    /// @param str      [in] Characters to convert.
+    /// @param len      [in] Number of characters to convert.
+    ///
+    static void Append(std::string& out, const wchar_t* str, std::size_t len);
+
+    /// Returns the number of leading characters in the specified string that are ASCII (i.e. do not have their
+    /// high bit set). The string is examined 16 bytes at a time.
+    ///
+    /// @param str      [in] Characters to examine.
+    /// @param len      [in] Number of characters to examine.
+    ///
+    /// @return Length of the ASCII prefix of the string.
+    ///
+    static std::size_t AsciiPrefixLength(const char* str, std::size_t len);
+
+    /// Appends the UTF-8 encoding of the specified code point to the output.
+    ///
+    /// @param out      [in, out] String to which the UTF-8 characters are appended.
+    /// @param cp       [in] Unicode code point to encode.
+    ///
+    static void AppendCodePoint(std::string& out, char32_t cp);
+
+private:
+    /// UTF-8 encoding of a table entry. Entries are encoded once, when the transcoder is constructed.
+    ///
+    struct Encoded {
+        char m_bytes[4];
+        unsigned char m_len;
+    };
+
+
+    std::array<Encoded, 128> m_highTable;   ///< UTF-8 encodings for the bytes 0x80 through 0xFF.
+};
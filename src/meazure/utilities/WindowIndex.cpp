@@ -0,0 +1,178 @@
+/*
+ * Copyright 2022 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "WindowIndex.h"
+#include <algorithm>
+#include <numeric>
+#include <cmath>
+#include <cassert>
+
+
+namespace {
+    bool IsEmpty(const MeaWindowIndex::Rect& rect) {
+        return rect.left >= rect.right || rect.top >= rect.bottom;
+    }
+}
+
+
+void MeaWindowIndex::Build(const std::vector<Rect>& rects) {
+    Clear();
+
+    if (rects.empty()) {
+        return;
+    }
+
+    m_rects = rects;
+    m_leaves.assign(rects.size(), kNotFound);
+
+    std::vector<int> items(rects.size());
+    std::iota(items.begin(), items.end(), 0);
+
+    // Each pass packs a level of the tree into its parent level, until only the root remains.
+    bool leaf = true;
+    do {
+        Pack(items, leaf);
+        leaf = false;
+    } while (items.size() > 1);
+}
+
+int MeaWindowIndex::FindTopmost(int x, int y) const {
+    if (m_nodes.empty()) {
+        return kNotFound;
+    }
+
+    // The tree is at most a few levels deep, so the pending nodes fit comfortably in a fixed size stack.
+    int stack[128];
+    int stackSize = 0;
+    int best = kNotFound;
+
+    stack[stackSize++] = static_cast<int>(m_nodes.size()) - 1;
+
+    while (stackSize > 0) {
+        const Node& node = m_nodes[stack[--stackSize]];
+        if (node.m_topmost <= best || !Contains(node.m_bounds, x, y)) {
+            continue;
+        }
+
+        for (int i = node.m_first; i < node.m_first + node.m_count; i++) {
+            int child = m_children[i];
+            if (node.m_leaf) {
+                if (child > best && Contains(m_rects[child], x, y)) {
+                    best = child;
+                }
+            } else {
+                assert(stackSize < static_cast<int>(sizeof(stack) / sizeof(stack[0])));
+                stack[stackSize++] = child;
+            }
+        }
+    }
+
+    return best;
+}
+
+void MeaWindowIndex::Update(int id, const Rect& rect) {
+    assert(id >= 0 && id < static_cast<int>(m_rects.size()));
+
+    m_rects[id] = rect;
+    for (int node = m_leaves[id]; node != kNotFound; node = m_nodes[node].m_parent) {
+        Include(m_nodes[node].m_bounds, rect);
+    }
+}
+
+void MeaWindowIndex::Clear() {
+    m_rects.clear();
+    m_children.clear();
+    m_leaves.clear();
+    m_nodes.clear();
+}
+
+void MeaWindowIndex::Pack(std::vector<int>& items, bool leaf) {
+    std::size_t count = items.size();
+    std::size_t parentCount = (count + kFanout - 1) / kFanout;
+    std::size_t sliceCount = static_cast<std::size_t>(std::ceil(std::sqrt(static_cast<double>(parentCount))));
+    std::size_t sliceSize = sliceCount * kFanout;
+
+    // Sort the items into vertical slices by the x coordinate of their centers, and within each slice by the
+    // y coordinate of their centers. Coordinates are summed rather than averaged to avoid rounding.
+    auto centerX = [this, leaf](int item) {
+        const Rect& rect = GetBounds(item, leaf);
+        return static_cast<long long>(rect.left) + rect.right;
+    };
+    auto centerY = [this, leaf](int item) {
+        const Rect& rect = GetBounds(item, leaf);
+        return static_cast<long long>(rect.top) + rect.bottom;
+    };
+
+    std::sort(items.begin(), items.end(), [&centerX](int a, int b) { return centerX(a) < centerX(b); });
+    for (std::size_t start = 0; start < count; start += sliceSize) {
+        auto end = items.begin() + static_cast<std::ptrdiff_t>(std::min(start + sliceSize, count));
+        std::sort(items.begin() + static_cast<std::ptrdiff_t>(start), end,
+                  [&centerY](int a, int b) { return centerY(a) < centerY(b); });
+    }
+
+    // Group consecutive runs of items under new parent nodes.
+    std::vector<int> parents;
+    parents.reserve(parentCount);
+
+    for (std::size_t start = 0; start < count; start += kFanout) {
+        int index = static_cast<int>(m_nodes.size());
+
+        Node node;
+        node.m_bounds = Rect { 0, 0, 0, 0 };
+        node.m_topmost = kNotFound;
+        node.m_first = static_cast<int>(m_children.size());
+        node.m_count = static_cast<int>(std::min<std::size_t>(kFanout, count - start));
+        node.m_parent = kNotFound;
+        node.m_leaf = leaf;
+
+        for (int i = 0; i < node.m_count; i++) {
+            int item = items[start + i];
+            m_children.push_back(item);
+            Include(node.m_bounds, GetBounds(item, leaf));
+
+            if (leaf) {
+                node.m_topmost = std::max(node.m_topmost, item);
+                m_leaves[item] = index;
+            } else {
+                node.m_topmost = std::max(node.m_topmost, m_nodes[item].m_topmost);
+                m_nodes[item].m_parent = index;
+            }
+        }
+
+        m_nodes.push_back(node);
+        parents.push_back(index);
+    }
+
+    items.swap(parents);
+}
+
+void MeaWindowIndex::Include(Rect& bounds, const Rect& rect) {
+    if (IsEmpty(rect)) {
+        return;
+    }
+    if (IsEmpty(bounds)) {
+        bounds = rect;
+        return;
+    }
+
+    bounds.left = std::min(bounds.left, rect.left);
+    bounds.top = std::min(bounds.top, rect.top);
+    bounds.right = std::max(bounds.right, rect.right);
+    bounds.bottom = std::max(bounds.bottom, rect.bottom);
+}
@@ -0,0 +1,157 @@
+/*
+ * Copyright 2022 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/// @file
+/// @brief Header file for the spatial index of window rectangles.
+
+#pragma once
+
+#include <vector>
+#include <cstddef>
+
+
+/// Spatial index of the rectangles of a set of windows, used to locate the window under the mouse pointer
+/// without walking the window hierarchy. When several rectangles contain a point, the one added last wins and
+/// is referred to as the topmost entry. This is the tie-break used when walking the windows visited by
+/// EnumChildWindows, which visits a parent before its children and siblings from top to bottom of the z-order,
+/// so that the last window containing a point is the deepest one under it. A point query returns the topmost
+/// entry containing the point.
+///
+/// The index is a bulk loaded R-tree whose nodes are packed using the Sort-Tile-Recursive algorithm. Each node
+/// records the topmost entry in its subtree so that a query can skip any subtree that cannot contain an entry
+/// above the best one found so far. Rectangles can be updated in place when a window moves, in which case the
+/// bounds of the enclosing nodes are enlarged. Enlarged bounds are conservative, so queries remain exact; the
+/// index should be rebuilt when the windows change substantially.
+///
+/// This class does not depend on MFC and can be used on any platform.
+///
+class MeaWindowIndex {
+
+public:
+    static constexpr int kNotFound = -1;        ///< Returned when no rectangle contains a point.
+
+
+    /// Rectangle in integer screen coordinates. The members have the same names and meaning as those of the
+    /// Windows RECT structure.
+    ///
+    struct Rect {
+        int left;           ///< Left edge, which is inside the rectangle.
+        int top;            ///< Top edge, which is inside the rectangle.
+        int right;          ///< Right edge, which is outside the rectangle.
+        int bottom;         ///< Bottom edge, which is outside the rectangle.
+    };
+
+
+    /// Replaces the contents of the index with the specified rectangles. Each rectangle is identified by its
+    /// position in the vector. When rectangles overlap, a later rectangle takes precedence over an earlier one
+    /// regardless of the windows' z-order. Empty rectangles are stored but never contain a point.
+    ///
+    /// @param rects    [in] Rectangles to index, in the order EnumChildWindows visits the windows: parents
+    ///                 before their children, and siblings from top to bottom of the z-order.
+    ///
+    void Build(const std::vector<Rect>& rects);
+
+    /// Locates the topmost rectangle containing the specified point. As with PtInRect, a rectangle contains
+    /// the points on its left and top edges but not those on its right and bottom edges.
+    ///
+    /// @param x        [in] X coordinate of the point to locate.
+    /// @param y        [in] Y coordinate of the point to locate.
+    /// @return Identifier of the topmost rectangle containing the point, or kNotFound if none contain it.
+    ///
+    int FindTopmost(int x, int y) const;
+
+    /// Replaces the specified rectangle.
+    ///
+    /// @param id       [in] Identifier of the rectangle to replace.
+    /// @param rect     [in] New rectangle.
+    ///
+    void Update(int id, const Rect& rect);
+
+    /// Obtains the specified rectangle.
+    ///
+    /// @param id       [in] Identifier of the rectangle.
+    /// @return Rectangle with the identifier.
+    ///
+    const Rect& GetRect(int id) const { return m_rects[id]; }
+
+    /// Obtains the number of rectangles in the index.
+    ///
+    /// @return Number of rectangles.
+    ///
+    std::size_t GetSize() const { return m_rects.size(); }
+
+    /// Removes all rectangles from the index.
+    ///
+    void Clear();
+
+private:
+    static constexpr int kFanout = 8;           ///< Maximum number of children of a node.
+
+    /// Node of the R-tree. The children of a leaf node are rectangle identifiers and the children of an
+    /// interior node are node indices. In both cases the children are contiguous in m_children.
+    ///
+    struct Node {
+        Rect m_bounds;          ///< Bounding box of the rectangles in the subtree.
+        int m_topmost;          ///< Largest rectangle identifier in the subtree.
+        int m_first;            ///< Index of the first child in m_children.
+        int m_count;            ///< Number of children.
+        int m_parent;           ///< Index of the parent node, or -1 for the root.
+        bool m_leaf;            ///< Indicates whether the children are rectangle identifiers.
+    };
+
+    /// Packs the specified items into parent nodes using the Sort-Tile-Recursive algorithm. The items are
+    /// reordered so that the children of each parent are contiguous.
+    ///
+    /// @param items    [in, out] Items to pack, either rectangle identifiers or node indices.
+    /// @param leaf     [in] Indicates whether the items are rectangle identifiers.
+    ///
+    void Pack(std::vector<int>& items, bool leaf);
+
+    /// Obtains the bounding box of the specified item.
+    ///
+    /// @param item     [in] Rectangle identifier or node index.
+    /// @param leaf     [in] Indicates whether the item is a rectangle identifier.
+    /// @return Bounding box of the item.
+    ///
+    const Rect& GetBounds(int item, bool leaf) const { return leaf ? m_rects[item] : m_nodes[item].m_bounds; }
+
+    /// Enlarges a bounding box to include a rectangle. Empty rectangles do not enlarge the box.
+    ///
+    /// @param bounds   [in, out] Bounding box to enlarge.
+    /// @param rect     [in] Rectangle to include.
+    ///
+    static void Include(Rect& bounds, const Rect& rect);
+
+    /// Indicates whether a rectangle contains a point.
+    ///
+    /// @param rect     [in] Rectangle to test.
+    /// @param x        [in] X coordinate of the point to test.
+    /// @param y        [in] Y coordinate of the point to test.
+    /// @return true if the point is within the rectangle.
+    ///
+    static bool Contains(const Rect& rect, int x, int y) {
+        return x >= rect.left && x < rect.right && y >= rect.top && y < rect.bottom;
+    }
+
+
+    std::vector<Rect> m_rects;          ///< Rectangles by identifier.
+    std::vector<int> m_children;        ///< Children of the nodes, grouped by node.
+    std::vector<int> m_leaves;          ///< Leaf node containing each rectangle, by identifier.
+    std::vector<Node> m_nodes;          ///< Nodes of the tree. The root is the last node.
+};
@@ -0,0 +1,323 @@
+/*
+ * Copyright 2022 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "XMLDocument.h"
+#include <meazure/utilities/UTF8Transcoder.h>
+#include <algorithm>
+
+
+namespace {
+    constexpr int kMaxDepth = 256;      ///< Deepest element nesting accepted, to bound recursion.
+
+    bool IsSpace(char ch) {
+        return ch == ' ' || ch == '\t' || ch == '\r' || ch == '\n';
+    }
+
+    bool IsNameChar(char ch) {
+        return (ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z') || (ch >= '0' && ch <= '9') ||
+                ch == '_' || ch == ':' || ch == '-' || ch == '.' || (static_cast<unsigned char>(ch) & 0x80) != 0;
+    }
+}
+
+
+const std::string* MeaXMLDocument::Element::GetAttribute(std::string_view name) const {
+    for (const Attribute& attribute : m_attributes) {
+        if (attribute.first == name) {
+            return &attribute.second;
+        }
+    }
+    return nullptr;
+}
+
+const MeaXMLDocument::Element* MeaXMLDocument::Element::GetChild(std::string_view name) const {
+    for (const Element& child : m_children) {
+        if (child.m_name == name) {
+            return &child;
+        }
+    }
+    return nullptr;
+}
+
+
+MeaXMLDocument::MeaXMLDocument(std::string_view text) : m_text(text), m_pos(0), m_depth(0) {
+    // Skip a UTF-8 byte order mark.
+    if (LookingAt("\xEF\xBB\xBF")) {
+        m_pos += 3;
+    }
+
+    SkipMisc();
+    if (m_pos >= m_text.size() || m_text[m_pos] != '<') {
+        Fail("root element expected");
+    }
+    ParseElement(m_root);
+
+    SkipMisc();
+    if (m_pos < m_text.size()) {
+        Fail("content after the root element");
+    }
+}
+
+void MeaXMLDocument::ParseElement(Element& element) {
+    if (++m_depth > kMaxDepth) {
+        Fail("elements nested too deeply");
+    }
+
+    Expect('<');
+    element.m_name = ParseName();
+
+    // Attributes
+    for (;;) {
+        SkipSpace();
+        if (m_pos >= m_text.size()) {
+            Fail("unterminated start tag");
+        }
+        char ch = m_text[m_pos];
+        if (ch == '/' || ch == '>') {
+            break;
+        }
+
+        std::string name(ParseName());
+        SkipSpace();
+        Expect('=');
+        SkipSpace();
+        std::string value = ParseAttributeValue();
+        if (element.GetAttribute(name) != nullptr) {
+            Fail("duplicate attribute " + name);
+        }
+        element.m_attributes.emplace_back(std::move(name), std::move(value));
+    }
+
+    if (LookingAt("/>")) {
+        m_pos += 2;
+        m_depth--;
+        return;
+    }
+    Expect('>');
+
+    // Content
+    for (;;) {
+        ParseText(element.m_text);
+        if (m_pos >= m_text.size()) {
+            Fail("missing end tag for " + element.m_name);
+        }
+
+        if (LookingAt("</")) {
+            m_pos += 2;
+            if (ParseName() != element.m_name) {
+                Fail("mismatched end tag for " + element.m_name);
+            }
+            SkipSpace();
+            Expect('>');
+            m_depth--;
+            return;
+        }
+        if (LookingAt("<!--")) {
+            SkipPast("-->");
+        } else if (LookingAt("<![CDATA[")) {
+            m_pos += 9;
+            std::size_t end = m_text.find("]]>", m_pos);
+            if (end == std::string_view::npos) {
+                Fail("unterminated CDATA section");
+            }
+            element.m_text.append(m_text.substr(m_pos, end - m_pos));
+            m_pos = end + 3;
+        } else if (LookingAt("<?")) {
+            SkipPast("?>");
+        } else {
+            element.m_children.emplace_back();
+            ParseElement(element.m_children.back());
+        }
+    }
+}
+
+void MeaXMLDocument::ParseText(std::string& text) {
+    while (m_pos < m_text.size()) {
+        std::size_t end = m_text.find_first_of("<&", m_pos);
+        if (end == std::string_view::npos) {
+            end = m_text.size();
+        }
+        text.append(m_text.substr(m_pos, end - m_pos));
+        m_pos = end;
+
+        if (m_pos >= m_text.size() || m_text[m_pos] == '<') {
+            return;
+        }
+        ParseReference(text);
+    }
+}
+
+std::string MeaXMLDocument::ParseAttributeValue() {
+    if (m_pos >= m_text.size() || (m_text[m_pos] != '"' && m_text[m_pos] != '\'')) {
+        Fail("quoted attribute value expected");
+    }
+    char quote = m_text[m_pos++];
+
+    std::string value;
+    for (;;) {
+        if (m_pos >= m_text.size()) {
+            Fail("unterminated attribute value");
+        }
+        char ch = m_text[m_pos];
+        if (ch == quote) {
+            m_pos++;
+            return value;
+        }
+        if (ch == '<') {
+            Fail("'<' in attribute value");
+        }
+        if (ch == '&') {
+            ParseReference(value);
+        } else {
+            // Attribute value normalization replaces whitespace characters with spaces.
+            value.push_back(IsSpace(ch) ? ' ' : ch);
+            m_pos++;
+        }
+    }
+}
+
+void MeaXMLDocument::ParseReference(std::string& text) {
+    std::size_t end = m_text.find(';', m_pos);
+    if (end == std::string_view::npos || end - m_pos > 12) {
+        Fail("unterminated reference");
+    }
+    std::string_view name = m_text.substr(m_pos + 1, end - m_pos - 1);
+
+    if (!name.empty() && name[0] == '#') {
+        bool hex = name.size() > 1 && name[1] == 'x';
+        std::string_view digits = name.substr(hex ? 2 : 1);
+        if (digits.empty()) {
+            Fail("invalid character reference");
+        }
+
+        char32_t cp = 0;
+        for (char ch : digits) {
+            int digit;
+            if (ch >= '0' && ch <= '9') {
+                digit = ch - '0';
+            } else if (hex && ch >= 'a' && ch <= 'f') {
+                digit = ch - 'a' + 10;
+            } else if (hex && ch >= 'A' && ch <= 'F') {
+                digit = ch - 'A' + 10;
+            } else {
+                Fail("invalid character reference");
+            }
+            cp = cp * (hex ? 16 : 10) + digit;
+            if (cp > 0x10FFFF) {
+                Fail("invalid character reference");
+            }
+        }
+        MeaUTF8Transcoder::AppendCodePoint(text, cp);
+    } else if (name == "lt") {
+        text.push_back('<');
+    } else if (name == "gt") {
+        text.push_back('>');
+    } else if (name == "amp") {
+        text.push_back('&');
+    } else if (name == "quot") {
+        text.push_back('"');
+    } else if (name == "apos") {
+        text.push_back('\'');
+    } else {
+        Fail("undefined entity " + std::string(name));
+    }
+
+    m_pos = end + 1;
+}
+
+std::string_view MeaXMLDocument::ParseName() {
+    std::size_t start = m_pos;
+    while (m_pos < m_text.size() && IsNameChar(m_text[m_pos])) {
+        m_pos++;
+    }
+    if (m_pos == start) {
+        Fail("name expected");
+    }
+    return m_text.substr(start, m_pos - start);
+}
+
+void MeaXMLDocument::SkipMisc() {
+    for (;;) {
+        SkipSpace();
+        if (LookingAt("<?")) {
+            SkipPast("?>");
+        } else if (LookingAt("<!--")) {
+            SkipPast("-->");
+        } else if (LookingAt("<!DOCTYPE")) {
+            // The DOCTYPE may contain an internal subset in square brackets, which in turn may contain quoted
+            // strings and comments with '>' characters in them.
+            m_pos += 9;
+            bool inSubset = false;
+            for (;;) {
+                if (m_pos >= m_text.size()) {
+                    Fail("unterminated DOCTYPE");
+                }
+                char ch = m_text[m_pos];
+                if (ch == '"' || ch == '\'') {
+                    std::size_t end = m_text.find(ch, m_pos + 1);
+                    if (end == std::string_view::npos) {
+                        Fail("unterminated DOCTYPE");
+                    }
+                    m_pos = end + 1;
+                } else if (inSubset && LookingAt("<!--")) {
+                    SkipPast("-->");
+                } else if (ch == '[') {
+                    inSubset = true;
+                    m_pos++;
+                } else if (ch == ']') {
+                    inSubset = false;
+                    m_pos++;
+                } else if (ch == '>' && !inSubset) {
+                    m_pos++;
+                    break;
+                } else {
+                    m_pos++;
+                }
+            }
+        } else {
+            return;
+        }
+    }
+}
+
+void MeaXMLDocument::SkipPast(std::string_view terminator) {
+    std::size_t end = m_text.find(terminator, m_pos);
+    if (end == std::string_view::npos) {
+        Fail("unterminated markup");
+    }
+    m_pos = end + terminator.size();
+}
+
+void MeaXMLDocument::SkipSpace() {
+    while (m_pos < m_text.size() && IsSpace(m_text[m_pos])) {
+        m_pos++;
+    }
+}
+
+void MeaXMLDocument::Expect(char ch) {
+    if (m_pos >= m_text.size() || m_text[m_pos] != ch) {
+        Fail(std::string("'") + ch + "' expected");
+    }
+    m_pos++;
+}
+
+void MeaXMLDocument::Fail(const std::string& message) const {
+    std::size_t pos = std::min(m_pos, m_text.size());
+    int line = 1 + static_cast<int>(std::count(m_text.begin(), m_text.begin() + pos, '\n'));
+    throw MeaXMLDocumentException(message, line);
+}
@@ -0,0 +1,173 @@
+/*
+ * Copyright 2022 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/// @file
+/// @brief Header file for a minimal, portable XML document parser.
+
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <utility>
+#include <stdexcept>
+
+
+/// Exception thrown when a document cannot be parsed by MeaXMLDocument.
+///
+class MeaXMLDocumentException : public std::runtime_error {
+
+public:
+    /// Constructs the exception.
+    ///
+    /// @param message  [in] Description of the problem.
+    /// @param line     [in] Line number in the document at which the problem was found, starting at 1.
+    ///
+    MeaXMLDocumentException(const std::string& message, int line) :
+        std::runtime_error("line " + std::to_string(line) + ": " + message), m_line(line) {}
+
+    /// Obtains the line at which the problem was found.
+    ///
+    /// @return Line number, starting at 1.
+    ///
+    int GetLine() const { return m_line; }
+
+private:
+    int m_line;     ///< Line at which the problem was found.
+};
+
+
+/// Minimal non-validating XML parser that reads a document into a tree of elements. It is used where Xerces
+/// and MFC are not available, such as the headless position log converter, to read files written by
+/// MeaXMLWriter. Elements, attributes, character data, CDATA sections, comments, processing instructions, the
+/// predefined entities and character references are supported. The DOCTYPE declaration is skipped: the DTD is
+/// neither read nor applied, so callers must supply the attribute defaults it specifies.
+///
+/// Text is UTF-8, and character references are encoded as UTF-8. This class does not depend on MFC or Windows
+/// and can be used on any platform.
+///
+class MeaXMLDocument {
+
+public:
+    /// An element and its content. Character data directly inside the element is concatenated into m_text.
+    ///
+    struct Element {
+        typedef std::pair<std::string, std::string> Attribute;
+
+        std::string m_name;                         ///< Element name.
+        std::vector<Attribute> m_attributes;        ///< Attributes in document order.
+        std::string m_text;                         ///< Character data within the element.
+        std::vector<Element> m_children;            ///< Child elements in document order.
+
+        /// Obtains the value of the specified attribute.
+        ///
+        /// @param name     [in] Attribute name.
+        /// @return Attribute value, or nullptr if the element does not have the attribute.
+        ///
+        const std::string* GetAttribute(std::string_view name) const;
+
+        /// Obtains the first child element with the specified name.
+        ///
+        /// @param name     [in] Element name.
+        /// @return First child with the name, or nullptr if there is no such child.
+        ///
+        const Element* GetChild(std::string_view name) const;
+    };
+
+
+    /// Parses the specified document.
+    ///
+    /// @param text     [in] Document to parse, in UTF-8.
+    ///
+    /// @throws MeaXMLDocumentException if the document is not well formed.
+    ///
+    explicit MeaXMLDocument(std::string_view text);
+
+    /// Obtains the root element of the document.
+    ///
+    /// @return Root element.
+    ///
+    const Element& GetRoot() const { return m_root; }
+
+private:
+    /// Parses an element whose start tag begins at the current position, including its content and end tag.
+    ///
+    /// @param element  [out] Parsed element.
+    ///
+    void ParseElement(Element& element);
+
+    /// Parses character data up to the next markup, resolving references, and appends it to the text.
+    ///
+    /// @param text     [in, out] Text to which the character data is appended.
+    ///
+    void ParseText(std::string& text);
+
+    /// Parses a quoted attribute value, resolving references.
+    ///
+    /// @return Attribute value.
+    ///
+    std::string ParseAttributeValue();
+
+    /// Resolves the entity or character reference at the current position and appends its replacement.
+    ///
+    /// @param text     [in, out] Text to which the replacement is appended.
+    ///
+    void ParseReference(std::string& text);
+
+    /// Parses an element or attribute name.
+    ///
+    /// @return Name.
+    ///
+    std::string_view ParseName();
+
+    /// Skips the XML declaration, comments, processing instructions, the DOCTYPE declaration and whitespace
+    /// preceding or following the root element.
+    ///
+    void SkipMisc();
+
+    /// Skips past the next occurrence of the specified terminator.
+    ///
+    /// @param terminator   [in] Characters ending the construct being skipped.
+    ///
+    void SkipPast(std::string_view terminator);
+
+    /// Skips any whitespace at the current position.
+    ///
+    void SkipSpace();
+
+    /// Indicates whether the text at the current position begins with the specified characters.
+    ///
+    bool LookingAt(std::string_view str) const { return m_text.compare(m_pos, str.size(), str) == 0; }
+
+    /// Consumes the specified character or reports an error if it is not at the current position.
+    ///
+    void Expect(char ch);
+
+    /// Reports an error at the current position.
+    ///
+    /// @param message  [in] Description of the problem.
+    ///
+    [[noreturn]] void Fail(const std::string& message) const;
+
+
+    std::string_view m_text;    ///< Document being parsed.
+    std::size_t m_pos;          ///< Current position in the document.
+    int m_depth;                ///< Current element nesting depth.
+    Element m_root;             ///< Root element.
+};
@@ -20,6 +20,8 @@
 #include <meazure/pch.h>
 #include "XMLParser.h"
 #include <meazure/resource.h>
+#include <meazure/utilities/NumberParse.h>
+#include <meazure/utilities/StringUtils.h>
 #include <xercesc/util/PlatformUtils.hpp>
 #include <xercesc/framework/MemBufInputSource.hpp>
 #include <cstring>
@@ -59,7 +61,7 @@ bool MeaXMLAttributes::GetValueStr(PCTSTR name, CString& value) const {
 bool MeaXMLAttributes::GetValueInt(PCTSTR name, int& value) const {
     AttributeMap::const_iterator iter = m_attributeMap.find(name);
     if (iter != m_attributeMap.end()) {
-        value = _ttoi((*iter).second);
+        value = MeaNumberParse::ToInt(static_cast<PCTSTR>((*iter).second));
         return true;
     }
     return false;
@@ -68,7 +70,7 @@ bool MeaXMLAttributes::GetValueInt(PCTSTR name, int& value) const {
 bool MeaXMLAttributes::GetValueDbl(PCTSTR name, double& value) const {
     AttributeMap::const_iterator iter = m_attributeMap.find(name);
     if (iter != m_attributeMap.end()) {
-        value = _tcstod((*iter).second, nullptr);
+        value = MeaNumberParse::ToDbl(static_cast<PCTSTR>((*iter).second));
         return true;
     }
     return false;
@@ -281,29 +283,12 @@ void MeaXMLParser::ParseFile(PCTSTR pathname) {
 void MeaXMLParser::ParseString(PCTSTR content) {
     assert(content != nullptr);
 
-#ifdef _UNICODE
-    int numWideChars = wcslen(content);
-    int numBytes = WideCharToMultiByte(CP_UTF8, 0, content, numWideChars, nullptr, 0, nullptr, nullptr);
-    char* utf8Content = new char[numBytes];
-    WideCharToMultiByte(CP_UTF8, 0, content, numWideChars, utf8Content, numBytes, nullptr, nullptr);
-#else
-    int numWideChars = MultiByteToWideChar(CP_ACP, 0, content, -1, nullptr, 0);
-    wchar_t* wideContent = new wchar_t[numWideChars];
-    MultiByteToWideChar(CP_ACP, 0, content, -1, wideContent, numWideChars);
-
-    int numBytes = WideCharToMultiByte(CP_UTF8, 0, wideContent, numWideChars, nullptr, 0, nullptr, nullptr);
-    char* utf8Content = new char[numBytes];
-    WideCharToMultiByte(CP_UTF8, 0, wideContent, numWideChars, utf8Content, numBytes, nullptr, nullptr);
+    m_utf8Content.clear();
+    MeaStringUtils::AppendUTF8(m_utf8Content, content);
 
-    delete[] wideContent;
-#endif /* XML_UNICODE */
-
-    xercesc::MemBufInputSource source(reinterpret_cast<const XMLByte*>(utf8Content), numBytes, "XMLBuf");
+    xercesc::MemBufInputSource source(reinterpret_cast<const XMLByte*>(m_utf8Content.data()), m_utf8Content.size(),
+                                      "XMLBuf");
     m_parser->parse(source);
-
-#ifndef _UNICODE
-    delete[] utf8Content;
-#endif
 }
 
 
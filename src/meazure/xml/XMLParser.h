@@ -34,6 +34,7 @@
 #include <map>
 #include <list>
 #include <stack>
+#include <string>
 #include <iostream>
 #include <cassert>
 
@@ -547,4 +548,5 @@ private:
     NodeStack m_nodeStack;                  ///< Stack of XML DOM nodes.
     PathnameStack m_pathnameStack;          ///< Stack of pathnames for the entities being parsed.
     MeaXMLNode* m_dom;                     ///< Root node of the DOM being built, or nullptr.
+    std::string m_utf8Content;              ///< Reusable buffer for the UTF-8 content parsed by ParseString.
 };
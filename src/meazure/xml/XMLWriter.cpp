@@ -330,8 +330,23 @@ void MeaXMLWriter::WriteQuoted(PCTSTR str) {
 void MeaXMLWriter::WriteEscaped(PCTSTR str) {
     if (str != nullptr) {
         size_t len = _tcslen(str);
-        for (size_t i = 0; i < len; i++) {
-            WriteEscaped(str[i]);
+        size_t i = 0;
+
+        while (i < len) {
+            // Write runs of characters that do not require escaping in bulk.
+            size_t start = i;
+            while (i < len && !NeedsEscape(str[i])) {
+                i++;
+            }
+            if (i > start) {
+                m_utf8Buffer.clear();
+                MeaStringUtils::AppendUTF8(m_utf8Buffer, str + start, i - start);
+                m_out.write(m_utf8Buffer.data(), m_utf8Buffer.size());
+            }
+
+            if (i < len) {
+                WriteEscaped(str[i++]);
+            }
         }
     }
 }
@@ -365,7 +380,7 @@ void MeaXMLWriter::WriteEscaped(TCHAR ch) {
     default:
 #ifdef _UNICODE
         if (ch > '\u001F' && ch < '\u007F') {
-            writeRaw(ch);
+            WriteRaw(ch);
         } else {
             if ((ch >= '\u007F' && ch <= '\uD7FF') || (ch >= '\uE000' && ch <= '\uFFFD')) {
                 WriteUTF8Literal(u8"&#");
@@ -401,12 +416,16 @@ void MeaXMLWriter::WriteNewline() {
 
 
 void MeaXMLWriter::WriteRaw(PCTSTR str) {
-    WriteUTF8Literal(MeaStringUtils::ACPtoUTF8(str));
+    m_utf8Buffer.clear();
+    MeaStringUtils::AppendUTF8(m_utf8Buffer, str);
+    m_out.write(m_utf8Buffer.data(), m_utf8Buffer.size());
 }
 
 
 void MeaXMLWriter::WriteRaw(TCHAR ch) {
-    WriteUTF8Literal(MeaStringUtils::ACPtoUTF8(ch));
+    m_utf8Buffer.clear();
+    MeaStringUtils::AppendUTF8(m_utf8Buffer, &ch, 1);
+    m_out.write(m_utf8Buffer.data(), m_utf8Buffer.size());
 }
 
 void MeaXMLWriter::WriteUTF8Literal(PCSTR str) {
@@ -28,6 +28,7 @@
 #include <list>
 #include <stack>
 #include <memory>
+#include <string>
 
 
 /// This class writes pretty printed XML in UTF-8 encoding. Because this class serves only the needs of this
@@ -298,6 +299,16 @@ private:
     ///
     static PCSTR GetEventName(Event event);
 
+    /// Indicates whether the specified character must be escaped by WriteEscaped(TCHAR) rather than written as is.
+    ///
+    /// @param ch   [in] Character to test
+    /// @return <b>true</b> if the character is not a printable ASCII character or is an XML special character.
+    ///
+    static bool NeedsEscape(TCHAR ch) {
+        return (ch < _T('\x20')) || (ch > _T('\x7E')) || (ch == _T('&')) || (ch == _T('<')) || (ch == _T('>')) ||
+               (ch == _T('\'')) || (ch == _T('"'));
+    }
+
 
     static const char* kIndent;     ///< String for each level of indentation
 
@@ -305,4 +316,5 @@ private:
     std::ostream& m_out;            ///< Output stream to write the XML
     ElementStack m_elementStack;    ///< Stack of open elements
     State m_currentState;           ///< Current state of the writer state machine.
+    std::string m_utf8Buffer;       ///< Reusable buffer for transcoding output to UTF-8
 };
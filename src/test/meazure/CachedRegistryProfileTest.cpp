@@ -0,0 +1,227 @@
+/*
+ * Copyright 2022 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "pch.h"
+#define BOOST_TEST_MODULE CachedRegistryProfileTest
+#include "GlobalFixture.h"
+#include <boost/test/unit_test.hpp>
+#include "mocks/MockRegistry.h"
+#include <meazure/profile/CachedRegistryProfile.h>
+#include <float.h>
+
+namespace tt = boost::test_tools;
+
+
+struct TestFixture {
+    TestFixture() {
+        // The registry holds a current version profile containing a value of each type.
+        mock.m_readSection = [](PCTSTR section, MeaRegistryValues& values) {
+            if (CString(section) != _T("2.0")) {
+                return FALSE;
+            }
+            values.emplace_back(_T("bool"), 1);
+            values.emplace_back(_T("int"), 13);
+            values.emplace_back(_T("dbl"), _T("13.700000"));
+            values.emplace_back(_T("str"), _T("something"));
+            return TRUE;
+        };
+
+        mock.m_writeSection = [this](PCTSTR section, const MeaRegistryValues& values) {
+            writtenSection = section;
+            writtenValues = values;
+            return TRUE;
+        };
+    }
+
+    MockRegistry mock;
+    CString writtenSection;
+    MeaRegistryValues writtenValues;
+};
+
+
+BOOST_FIXTURE_TEST_CASE(TestCtorLoadsOnce, TestFixture) {
+    MeaCachedRegistryProfile profile(mock);
+
+    BOOST_TEST(mock.m_readSectionCount == 1);
+    BOOST_TEST(profile.GetVersion() == 2);
+}
+
+BOOST_FIXTURE_TEST_CASE(TestCtorOldVersion, TestFixture) {
+    mock.m_readSection = [](PCTSTR section, MeaRegistryValues& values) {
+        if (CString(section) != _T("1.0")) {
+            return FALSE;
+        }
+        values.emplace_back(_T("int"), 7);
+        return TRUE;
+    };
+
+    MeaCachedRegistryProfile profile(mock);
+
+    BOOST_TEST(mock.m_readSectionCount == 2);
+    BOOST_TEST(profile.GetVersion() == 1);
+    BOOST_TEST(profile.ReadInt(_T("int"), 0) == 7U);
+}
+
+BOOST_FIXTURE_TEST_CASE(TestCtorNoProfile, TestFixture) {
+    mock.m_readSection = mock.m_readSectionNoop;
+
+    MeaCachedRegistryProfile profile(mock);
+
+    BOOST_TEST(mock.m_readSectionCount == 2);
+    BOOST_TEST(profile.GetVersion() == 2);
+    BOOST_TEST(profile.ReadInt(_T("int"), 17) == 17U);
+}
+
+BOOST_FIXTURE_TEST_CASE(TestRead, TestFixture) {
+    MeaCachedRegistryProfile profile(mock);
+
+    BOOST_TEST(profile.ReadBool(_T("bool"), false));
+    BOOST_TEST(profile.ReadInt(_T("int"), 17) == 13U);
+    BOOST_TEST(profile.ReadDbl(_T("dbl"), 17.5) == 13.7, tt::tolerance(FLT_EPSILON));
+    BOOST_TEST(profile.ReadStr(_T("str"), _T("test def")) == _T("something"));
+
+    BOOST_TEST(mock.m_readSectionCount == 1);
+    BOOST_TEST(mock.m_getIntCount == 0);
+    BOOST_TEST(mock.m_getStringCount == 0);
+}
+
+BOOST_FIXTURE_TEST_CASE(TestReadDefault, TestFixture) {
+    MeaCachedRegistryProfile profile(mock);
+
+    BOOST_TEST(!profile.ReadBool(_T("missing"), false));
+    BOOST_TEST(profile.ReadInt(_T("missing"), 17) == 17U);
+    BOOST_TEST(profile.ReadDbl(_T("missing"), 17.5) == 17.5, tt::tolerance(FLT_EPSILON));
+    BOOST_TEST(profile.ReadStr(_T("missing"), _T("test def")) == _T("test def"));
+
+    // A value of the wrong type is treated as missing.
+    BOOST_TEST(profile.ReadInt(_T("str"), 17) == 17U);
+    BOOST_TEST(profile.ReadStr(_T("int"), _T("test def")) == _T("test def"));
+}
+
+BOOST_FIXTURE_TEST_CASE(TestWriteCoalesced, TestFixture) {
+    {
+        MeaCachedRegistryProfile profile(mock);
+
+        BOOST_TEST(profile.WriteInt(_T("new"), 1));
+        BOOST_TEST(profile.WriteInt(_T("new"), 2));
+        BOOST_TEST(profile.WriteDbl(_T("dbl"), 17.5));
+        BOOST_TEST(profile.WriteStr(_T("str2"), _T("a value")));
+
+        BOOST_TEST(profile.ReadInt(_T("new"), 0) == 2U);
+        BOOST_TEST(mock.m_writeSectionCount == 0);
+    }
+
+    BOOST_TEST(mock.m_writeSectionCount == 1);
+    BOOST_TEST(mock.m_writeIntCount == 0);
+    BOOST_TEST(mock.m_writeStringCount == 0);
+    BOOST_TEST(writtenSection == _T("2.0"));
+    BOOST_TEST_REQUIRE(writtenValues.size() == 3U);
+
+    for (const MeaRegistryValue& value : writtenValues) {
+        if (value.m_name == _T("new")) {
+            BOOST_TEST(value.m_type == static_cast<DWORD>(REG_DWORD));
+            BOOST_TEST(value.m_intValue == 2);
+        } else if (value.m_name == _T("dbl")) {
+            BOOST_TEST(value.m_type == static_cast<DWORD>(REG_SZ));
+            BOOST_TEST(value.m_strValue == _T("17.500000"));
+        } else {
+            BOOST_TEST(value.m_name == _T("str2"));
+            BOOST_TEST(value.m_strValue == _T("a value"));
+        }
+    }
+}
+
+BOOST_FIXTURE_TEST_CASE(TestWriteUnchanged, TestFixture) {
+    {
+        MeaCachedRegistryProfile profile(mock);
+
+        BOOST_TEST(profile.WriteBool(_T("bool"), true));
+        BOOST_TEST(profile.WriteInt(_T("int"), 13));
+        BOOST_TEST(profile.WriteDbl(_T("dbl"), 13.7));
+        BOOST_TEST(profile.WriteStr(_T("str"), _T("something")));
+    }
+
+    BOOST_TEST(mock.m_writeSectionCount == 0);
+}
+
+BOOST_FIXTURE_TEST_CASE(TestWriteRevert, TestFixture) {
+    {
+        MeaCachedRegistryProfile profile(mock);
+
+        BOOST_TEST(profile.WriteInt(_T("int"), 20));
+        BOOST_TEST(profile.WriteInt(_T("int"), 13));
+    }
+
+    BOOST_TEST(mock.m_writeSectionCount == 0);
+}
+
+BOOST_FIXTURE_TEST_CASE(TestFlush, TestFixture) {
+    MeaCachedRegistryProfile profile(mock);
+
+    BOOST_TEST(profile.Flush());
+    BOOST_TEST(mock.m_writeSectionCount == 0);
+
+    BOOST_TEST(profile.WriteInt(_T("int"), 20));
+    BOOST_TEST(profile.Flush());
+    BOOST_TEST(mock.m_writeSectionCount == 1);
+    BOOST_TEST(writtenValues.size() == 1U);
+
+    BOOST_TEST(profile.Flush());
+    BOOST_TEST(mock.m_writeSectionCount == 1);
+    BOOST_TEST(profile.ReadInt(_T("int"), 0) == 20U);
+}
+
+BOOST_FIXTURE_TEST_CASE(TestFlushFailure, TestFixture) {
+    mock.m_writeSection = [](PCTSTR, const MeaRegistryValues&) {
+        return FALSE;
+    };
+
+    MeaCachedRegistryProfile profile(mock);
+
+    BOOST_TEST(profile.WriteInt(_T("int"), 20));
+    BOOST_TEST(!profile.Flush());
+    BOOST_TEST(profile.ReadInt(_T("int"), 0) == 20U);
+}
+
+BOOST_FIXTURE_TEST_CASE(TestWriteUpgradesVersion, TestFixture) {
+    mock.m_readSection = [](PCTSTR section, MeaRegistryValues& values) {
+        if (CString(section) != _T("1.0")) {
+            return FALSE;
+        }
+        values.emplace_back(_T("int"), 13);
+        return TRUE;
+    };
+
+    {
+        MeaCachedRegistryProfile profile(mock);
+
+        // Values are always written to the current version, even if unchanged from the old version.
+        BOOST_TEST(profile.WriteInt(_T("int"), 13));
+        BOOST_TEST(profile.ReadInt(_T("int"), 0) == 13U);
+    }
+
+    BOOST_TEST(mock.m_writeSectionCount == 1);
+    BOOST_TEST(writtenSection == _T("2.0"));
+    BOOST_TEST(writtenValues.size() == 1U);
+}
+
+BOOST_FIXTURE_TEST_CASE(TestUserInitiated, TestFixture) {
+    MeaCachedRegistryProfile profile(mock);
+    BOOST_TEST(!profile.UserInitiated());
+}
@@ -0,0 +1,197 @@
+/*
+ * Copyright 2022 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "pch.h"
+#define BOOST_TEST_MODULE CrossHairShapeTest
+#include "GlobalFixture.h"
+#include <boost/test/unit_test.hpp>
+#include <meazure/graphics/CrossHairShape.h>
+#include <vector>
+#include <string>
+
+
+namespace {
+    MeaCrossHairShape::Key MakeKey(int size, int spread, int layers = 5, double dpiScale = 1.0) {
+        MeaCrossHairShape::Key key;
+        key.m_size = SIZE { size, size };
+        key.m_spread = SIZE { spread, spread };
+        key.m_layers = layers;
+        key.m_dpiScale = dpiScale;
+        return key;
+    }
+
+    bool InRect(const RECT& rect, int x, int y) {
+        return x >= rect.left && x < rect.right && y >= rect.top && y < rect.bottom;
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(TestMask) {
+    MeaCrossHairShape shape(MakeKey(5, 1, 2));
+
+    BOOST_TEST(shape.GetVertices().size() == 32U);
+    BOOST_TEST(shape.GetPolyCounts().size() == 8U);
+
+    // Top petal
+    BOOST_TEST(shape.GetMask(0, 0) == MeaCrossHairShape::kOutside);
+    BOOST_TEST(shape.GetMask(1, 0) == MeaCrossHairShape::kBorder);
+    BOOST_TEST(shape.GetMask(3, 0) == MeaCrossHairShape::kBorder);
+    BOOST_TEST(shape.GetMask(4, 0) == MeaCrossHairShape::kOutside);
+    BOOST_TEST(shape.GetMask(-1, 0) == MeaCrossHairShape::kOutside);
+    BOOST_TEST(shape.GetMask(5, 0) == MeaCrossHairShape::kOutside);
+
+    MeaCrossHairShape large(MakeKey(25, 4));
+    bool haveInside = false;
+    for (int y = 0; y < 25; y++) {
+        for (int x = 0; x < 25; x++) {
+            haveInside = haveInside || (large.GetMask(x, y) == MeaCrossHairShape::kInside);
+        }
+    }
+    BOOST_TEST(haveInside);
+    BOOST_TEST(large.GetMask(12, 0) == MeaCrossHairShape::kBorder);
+    BOOST_TEST(large.GetMask(12, 1) == MeaCrossHairShape::kInside);
+    BOOST_TEST(large.GetMask(0, 0) == MeaCrossHairShape::kOutside);
+}
+
+BOOST_AUTO_TEST_CASE(TestMaskImage) {
+    MeaCrossHairShape shape(MakeKey(11, 2));
+
+    // Same crosshair as the mask rendered by LayeredRasterTest.
+    std::string text;
+    for (int y = 0; y < 11; y++) {
+        for (int x = 0; x < 11; x++) {
+            text += ".12"[shape.GetMask(x, y)];
+        }
+        text += '\n';
+    }
+    BOOST_TEST(text ==
+        "...22222...\n"
+        "....212....\n"
+        ".....2.....\n"
+        "2.........2\n"
+        "22.......22\n"
+        "212.....212\n"
+        "22.......22\n"
+        "2.........2\n"
+        ".....2.....\n"
+        "....212....\n"
+        "...22222...\n");
+}
+
+BOOST_AUTO_TEST_CASE(TestRegionRects) {
+    for (int size : { 5, 11, 25, 49 }) {
+        for (int spread : { 0, 2, 4, 8 }) {
+            MeaCrossHairShape shape(MakeKey(size, spread));
+            const std::vector<RECT>& rects = shape.GetRegionRects();
+
+            // The rectangles cover exactly the pixels of the crosshair, without overlap.
+            for (int y = 0; y < size; y++) {
+                for (int x = 0; x < size; x++) {
+                    int count = 0;
+                    for (const RECT& rect : rects) {
+                        count += InRect(rect, x, y) ? 1 : 0;
+                    }
+                    BOOST_TEST(count == ((shape.GetMask(x, y) == MeaCrossHairShape::kOutside) ? 0 : 1));
+                }
+            }
+
+            // Rectangles are banded and sorted.
+            for (std::size_t i = 1; i < rects.size(); i++) {
+                const RECT& prev = rects[i - 1];
+                const RECT& rect = rects[i];
+                bool sameBand = prev.top == rect.top;
+                BOOST_TEST((sameBand ? (prev.bottom == rect.bottom && prev.right < rect.left) :
+                                       (prev.bottom <= rect.top)));
+            }
+
+            const RECT& bounds = shape.GetRegionBounds();
+            for (const RECT& rect : rects) {
+                BOOST_TEST(rect.left >= bounds.left);
+                BOOST_TEST(rect.top >= bounds.top);
+                BOOST_TEST(rect.right <= bounds.right);
+                BOOST_TEST(rect.bottom <= bounds.bottom);
+            }
+        }
+    }
+
+    // Each layer of a petal is several rows high, and the rows of a layer are merged into a single band.
+    MeaCrossHairShape shape(MakeKey(25, 4));
+    BOOST_TEST(shape.GetRegionRects().front().bottom - shape.GetRegionRects().front().top > 1);
+}
+
+BOOST_AUTO_TEST_CASE(TestPolygonRegion) {
+    // The mask must cover the same pixels as the window region previously created by filling the crosshair
+    // polygons with CreatePolyPolygonRgn in alternate mode.
+    for (int size : { 5, 11, 25, 49 }) {
+        for (int spread : { 0, 2, 4, 8 }) {
+            MeaCrossHairShape shape(MakeKey(size, spread));
+            const std::vector<POINT>& vertices = shape.GetVertices();
+            const std::vector<int>& polyCounts = shape.GetPolyCounts();
+
+            HRGN region = CreatePolyPolygonRgn(vertices.data(), polyCounts.data(),
+                                               static_cast<int>(polyCounts.size()), ALTERNATE);
+            BOOST_TEST_REQUIRE(region != nullptr);
+
+            for (int y = 0; y < size; y++) {
+                for (int x = 0; x < size; x++) {
+                    bool inRegion = PtInRegion(region, x, y) != FALSE;
+                    bool inMask = shape.GetMask(x, y) != MeaCrossHairShape::kOutside;
+                    BOOST_TEST(inRegion == inMask, "size " << size << ", spread " << spread << ", pixel (" <<
+                               x << ", " << y << ")");
+                }
+            }
+
+            DeleteObject(region);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(TestCache) {
+    MeaCrossHairShapeCache cache;
+
+    MeaCrossHairShapeCache::ShapePtr shape1 = cache.Acquire(MakeKey(25, 4));
+    MeaCrossHairShapeCache::ShapePtr shape2 = cache.Acquire(MakeKey(25, 4));
+    BOOST_TEST(shape1 == shape2);
+    BOOST_TEST(cache.GetSize() == 1U);
+    BOOST_TEST(cache.GetBuildCount() == 1U);
+
+    // Unused shapes remain cached until a different shape is requested.
+    shape1.reset();
+    shape2.reset();
+    BOOST_TEST(cache.GetSize() == 1U);
+    shape1 = cache.Acquire(MakeKey(25, 4));
+    BOOST_TEST(cache.GetBuildCount() == 1U);
+
+    // A different DPI scale requires a new shape. The old shape is kept because it is still in use.
+    shape2 = cache.Acquire(MakeKey(25, 4, 5, 1.5));
+    BOOST_TEST(shape1 != shape2);
+    BOOST_TEST(cache.GetSize() == 2U);
+    BOOST_TEST(cache.GetBuildCount() == 2U);
+
+    // Once released, the old shape is discarded when another shape is requested.
+    shape1.reset();
+    MeaCrossHairShapeCache::ShapePtr shape3 = cache.Acquire(MakeKey(33, 6, 5, 2.0));
+    BOOST_TEST(cache.GetSize() == 2U);
+    BOOST_TEST(cache.GetBuildCount() == 3U);
+
+    shape2.reset();
+    shape3.reset();
+    cache.Purge();
+    BOOST_TEST(cache.GetSize() == 0U);
+}
@@ -0,0 +1,128 @@
+/*
+ * Copyright 2022 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "pch.h"
+#define BOOST_TEST_MODULE DataPresenterTest
+#include "GlobalFixture.h"
+#include <boost/test/unit_test.hpp>
+#include <meazure/ui/DataPresenter.h>
+
+
+namespace {
+    MeaDataPresenter::Precisions MakePrecisions(int precision) {
+        MeaDataPresenter::Precisions precisions;
+        precisions.fill(precision);
+        return precisions;
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(TestSnapshot) {
+    MeaMeasurementSnapshot snapshot;
+    snapshot.SetXY1({ 10, 20 }, MeaFPoint(1.0, 2.0))
+            .SetWH(MeaFSize(3.0, 4.0))
+            .SetDistance(MeaFSize(3.0, 4.0))
+            .SetAspect(MeaFSize(3.0, 0.0))
+            .SetCircleArea(1.0);
+
+    BOOST_TEST(snapshot.GetFields() == (MeaX1Field | MeaY1Field | MeaWidthField | MeaHeightField |
+                                        MeaDistanceField | MeaAspectField | MeaAreaField));
+    BOOST_TEST(snapshot.Has(MeaX1Field));
+    BOOST_TEST(!snapshot.Has(MeaX2Field));
+    BOOST_TEST(snapshot.GetValue(MeaY1Field) == 2.0);
+    BOOST_TEST(snapshot.GetPixels(MeaY1Field) == 20);
+    BOOST_TEST(snapshot.GetPoint(MeaX1Field, MeaY1Field).x == 10);
+    BOOST_TEST(snapshot.GetValue(MeaDistanceField) == 5.0);
+    BOOST_TEST(snapshot.GetValue(MeaAspectField) == 0.0);
+    BOOST_TEST(snapshot.GetValue(MeaAreaField) == MeaNumericUtils::PI);
+
+    BOOST_TEST(MeaMeasurementSnapshot::FieldIndex(MeaX1Field) == 0);
+    BOOST_TEST(MeaMeasurementSnapshot::FieldIndex(MeaAspectField) == 15);
+}
+
+BOOST_AUTO_TEST_CASE(TestPresent) {
+    MeaDataPresenter presenter;
+    MeaDataPresenter::Precisions precisions = MakePrecisions(2);
+
+    // Everything is new the first time.
+    MeaMeasurementSnapshot snapshot1;
+    snapshot1.SetXY1({ 10, 20 }, MeaFPoint(1.0, 2.0)).SetDistance(5.0);
+    MeaDataPresenter::Changes changes = presenter.Present(snapshot1, precisions);
+    BOOST_TEST(changes.m_text == (MeaX1Field | MeaY1Field | MeaDistanceField));
+    BOOST_TEST(changes.m_pixels == (MeaX1Field | MeaY1Field));
+
+    // Nothing changes when the values display the same text.
+    MeaMeasurementSnapshot snapshot2;
+    snapshot2.SetXY1({ 10, 20 }, MeaFPoint(1.004, 2.0)).SetDistance(5.001);
+    changes = presenter.Present(snapshot2, precisions);
+    BOOST_TEST(changes.m_text == 0U);
+    BOOST_TEST(changes.m_pixels == 0U);
+
+    // Only the changed fields are reported.
+    MeaMeasurementSnapshot snapshot3;
+    snapshot3.SetXY1({ 11, 20 }, MeaFPoint(1.01, 2.0)).SetDistance(5.001);
+    changes = presenter.Present(snapshot3, precisions);
+    BOOST_TEST(changes.m_text == MeaX1Field);
+    BOOST_TEST(changes.m_pixels == MeaX1Field);
+
+    // A change in precision redisplays the field.
+    precisions[MeaMeasurementSnapshot::FieldIndex(MeaDistanceField)] = 3;
+    changes = presenter.Present(snapshot3, precisions);
+    BOOST_TEST(changes.m_text == MeaDistanceField);
+    BOOST_TEST(changes.m_pixels == 0U);
+}
+
+BOOST_AUTO_TEST_CASE(TestSmallSteps) {
+    MeaDataPresenter presenter;
+    MeaDataPresenter::Precisions precisions = MakePrecisions(1);
+
+    // Many small movements that eventually cross a rounding boundary must be reported when they do.
+    MeaMeasurementSnapshot first;
+    presenter.Present(first.SetDistance(1.0), precisions);
+
+    int reported = 0;
+    for (int i = 1; i <= 10; i++) {
+        MeaMeasurementSnapshot snapshot;
+        MeaDataPresenter::Changes changes = presenter.Present(snapshot.SetDistance(1.0 + i * 0.01), precisions);
+        if (changes.m_text != 0) {
+            reported++;
+            BOOST_TEST(i == 5);     // 1.0 + 0.05 is slightly above 1.05 and displays as "1.1"
+        }
+    }
+    BOOST_TEST(reported == 1);
+}
+
+BOOST_AUTO_TEST_CASE(TestInvalidate) {
+    MeaDataPresenter presenter;
+    MeaDataPresenter::Precisions precisions = MakePrecisions(2);
+
+    MeaMeasurementSnapshot snapshot;
+    snapshot.SetXY1({ 10, 20 }, MeaFPoint(1.0, 2.0)).SetAngle(45.0);
+    presenter.Present(snapshot, precisions);
+
+    presenter.Invalidate(MeaY1Field);
+    MeaDataPresenter::Changes changes = presenter.Present(snapshot, precisions);
+    BOOST_TEST(changes.m_text == MeaY1Field);
+    BOOST_TEST(changes.m_pixels == MeaY1Field);
+
+    presenter.Invalidate();
+    changes = presenter.Present(snapshot, precisions);
+    BOOST_TEST(changes.m_text == (MeaX1Field | MeaY1Field | MeaAngleField));
+    BOOST_TEST(changes.m_pixels == (MeaX1Field | MeaY1Field));
+}
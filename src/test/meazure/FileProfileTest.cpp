@@ -50,6 +50,8 @@ BOOST_FIXTURE_TEST_CASE(TestReadWrite, TestFixture) {
         BOOST_TEST(profile.WriteInt(_T("key2"), 17));
         BOOST_TEST(profile.WriteDbl(_T("key3"), 3.14159));
         BOOST_TEST(profile.WriteStr(_T("key4"), _T("abcd")));
+        BOOST_CHECK_NO_THROW(profile.Commit());
+        BOOST_CHECK_NO_THROW(profile.Commit());
     }
 
     BOOST_TEST(std::filesystem::exists(tempFileName));
@@ -0,0 +1,132 @@
+/*
+ * Copyright 2022 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "pch.h"
+#define BOOST_TEST_MODULE PositionExportWriterTest
+#include "GlobalFixture.h"
+#include <boost/test/unit_test.hpp>
+#include <meazure/position/PositionExportWriter.h>
+#include <meazure/position/PositionLogConverter.h>
+#include <meazure/position/PositionDesktop.h>
+#include "mocks/MockScreenProvider.h"
+#include "mocks/MockUnitsProvider.h"
+#include "mocks/MockPositionDesktopRefCounter.h"
+#include "mocks/MockPositionProvider.h"
+#include <sstream>
+#include <algorithm>
+#include <string>
+
+
+struct TestFixture {
+    TestFixture() : unitsProvider(screenProvider), desktop(unitsProvider, screenProvider), ref(&counter, desktop) {
+        positionProvider.AddReferencedDesktop(desktop);
+        desktopId = static_cast<PCTSTR>(desktop.GetId().ToString());
+
+        MeaPosition* position1 = new MeaPosition(ref, _T("LineTool"), _T("2022-05-01T12:30:15Z"));
+        position1->RecordXY1(MeaFPoint(1.0, 2.0));
+        position1->RecordXY2(MeaFPoint(3.0, 7.5));
+        position1->RecordWH(MeaFSize(2.0, 5.5));
+        position1->RecordDistance(4.0);
+        position1->SetDesc(_T("Width, \"height\""));
+        positionProvider.AddPosition(position1);
+
+        MeaPosition* position2 = new MeaPosition(ref, _T("AngleTool"), _T("2022-05-01T12:31:00Z"));
+        position2->RecordXY1(MeaFPoint(1.0, 2.0));
+        position2->RecordXY2(MeaFPoint(3.0, 7.0));
+        position2->RecordXYV(MeaFPoint(6.0, 9.0));
+        position2->RecordAngle(20.0);
+        positionProvider.AddPosition(position2);
+    }
+
+    MockScreenProvider screenProvider;
+    MockUnitsProvider unitsProvider;
+    MockPositionProvider positionProvider;
+    MeaPositionDesktop desktop;
+    MockPositionDesktopRefCounter counter;
+    MeaPositionDesktopRef ref;
+    std::string desktopId;
+};
+
+
+BOOST_FIXTURE_TEST_CASE(TestExportCSV, TestFixture) {
+    std::ostringstream stream;
+    MeaPositionExportWriter writer(stream, positionProvider);
+    BOOST_CHECK_NO_THROW(writer.Export());
+
+    std::string expected =
+        "tool,timestamp,x1,y1,x2,y2,xv,yv,width,height,distance,area,angle,desktop id,desc\n"
+        "LineTool,2022-05-01T12:30:15Z,1.0,2.0,3.0,7.5,,,2.0,5.5,4.0,,," + desktopId + ",\"Width, \"\"height\"\"\"\n"
+        "AngleTool,2022-05-01T12:31:00Z,1.0,2.0,3.0,7.0,6.0,9.0,,,,,20.0," + desktopId + ",\n";
+    BOOST_TEST(stream.str() == expected);
+}
+
+BOOST_FIXTURE_TEST_CASE(TestExportLarge, TestFixture) {
+    // Enough positions that the output is flushed in several chunks.
+    for (int i = 0; i < 5000; i++) {
+        MeaPosition* position = new MeaPosition(ref, _T("PointTool"), _T("2022-05-01T12:32:00Z"));
+        position->RecordXY1(MeaFPoint(i, i + 0.5));
+        positionProvider.AddPosition(position);
+    }
+
+    std::ostringstream csvStream;
+    MeaPositionExportWriter csvWriter(csvStream, positionProvider);
+    csvWriter.Export();
+
+    std::string csv = csvStream.str();
+    BOOST_TEST(csv.size() > MeaPositionExportWriter::kChunkSize);
+    BOOST_TEST(std::count(csv.begin(), csv.end(), '\n') == 5003);
+    std::string lastRow = "PointTool,2022-05-01T12:32:00Z,4999.0,4999.5,,,,,,,,,," + desktopId + ",\n";
+    BOOST_TEST(csv.compare(csv.size() - lastRow.size(), lastRow.size(), lastRow) == 0);
+}
+
+BOOST_FIXTURE_TEST_CASE(TestExportMatchesConverter, TestFixture) {
+    // A log converted by the headless converter must have the same columns as an exported log.
+    MeaPositionLogConverter::Position position;
+    position.m_tool = "LineTool";
+    position.m_date = "2022-05-01T12:30:15Z";
+    position.m_desktopRef = desktopId;
+    position.m_desc = "Width, \"height\"";
+    position.m_points.push_back({ "1", 1.0, 2.0 });
+    position.m_points.push_back({ "2", 3.0, 7.5 });
+    position.m_properties = MeaPositionLogConverter::kWidth | MeaPositionLogConverter::kHeight |
+                            MeaPositionLogConverter::kDistance;
+    position.m_width = 2.0;
+    position.m_height = 5.5;
+    position.m_distance = 4.0;
+
+    MeaPositionLogConverter::Log log;
+    log.m_positions.push_back(position);
+
+    std::ostringstream convertStream;
+    MeaPositionLogConverter::WriteCSV(convertStream, log);
+
+    std::ostringstream exportStream;
+    MeaPositionExportWriter writer(exportStream, positionProvider);
+    writer.Export();
+
+    std::string exported = exportStream.str();
+    std::string converted = convertStream.str();
+    std::string exportedHeader = exported.substr(0, exported.find('\n'));
+    std::string convertedHeader = converted.substr(0, converted.find('\n'));
+    BOOST_TEST(convertedHeader == exportedHeader);
+
+    // The first exported position is the one converted.
+    std::size_t exportedEnd = exported.find('\n', exportedHeader.size() + 1);
+    BOOST_TEST(converted == exported.substr(0, exportedEnd + 1));
+}
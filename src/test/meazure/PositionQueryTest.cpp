@@ -0,0 +1,204 @@
+/*
+ * Copyright 2022 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "pch.h"
+#define BOOST_TEST_MODULE PositionQueryTest
+#include "GlobalFixture.h"
+#include <boost/test/unit_test.hpp>
+#include <meazure/position/PositionQuery.h>
+#include <meazure/position/PositionCollection.h>
+#include <meazure/utilities/TimeStamp.h>
+#include "mocks/MockScreenProvider.h"
+#include "mocks/MockUnitsProvider.h"
+#include "mocks/MockPositionDesktopRefCounter.h"
+#include <stdexcept>
+#include <vector>
+
+namespace tt = boost::test_tools;
+
+
+struct TestFixture {
+    TestFixture() :
+        unitsProvider(screenProvider),
+        desktop1(unitsProvider, screenProvider),
+        desktop2(unitsProvider, screenProvider),
+        ref1(&counter, desktop1),
+        ref2(&counter, desktop2) {
+        AddRect(ref1, _T("2022-05-01T10:00:00Z"), 10.0, 20.0);
+        AddRect(ref1, _T("2022-05-01T11:00:00Z"), 20.0, 40.0);
+        AddRect(ref2, _T("2022-05-01T12:00:00Z"), 30.0, 60.0);
+        AddRect(ref2, _T("2022-05-01T13:00:00Z"), 40.0, 80.0);
+
+        MeaPosition* angle = new MeaPosition(ref1, _T("AngleTool"), _T("2022-05-01T14:00:00Z"));
+        angle->RecordAngle(45.0);
+        positions.Add(angle);
+    }
+
+    void AddRect(const MeaPositionDesktopRef& ref, PCTSTR timeStamp, double width, double height) {
+        MeaPosition* position = new MeaPosition(ref, _T("RectTool"), timeStamp);
+        position->RecordWH(MeaFSize(width, height));
+        position->RecordRectArea(MeaFSize(width, height));
+        positions.Add(position);
+    }
+
+    MockScreenProvider screenProvider;
+    MockUnitsProvider unitsProvider;
+    MeaPositionDesktop desktop1;
+    MeaPositionDesktop desktop2;
+    MockPositionDesktopRefCounter counter;
+    MeaPositionDesktopRef ref1;
+    MeaPositionDesktopRef ref2;
+    MeaPositionCollection positions;
+};
+
+
+BOOST_FIXTURE_TEST_CASE(TestSelectAll, TestFixture) {
+    MeaPositionQuery query(positions);
+
+    BOOST_TEST(query.Count() == 5U);
+    BOOST_TEST(query.Select() == std::vector<unsigned int>({ 0, 1, 2, 3, 4 }), tt::per_element());
+}
+
+BOOST_FIXTURE_TEST_CASE(TestFilters, TestFixture) {
+    MeaPositionQuery query(positions);
+
+    query.Tool(_T("AngleTool"));
+    BOOST_TEST(query.Select() == std::vector<unsigned int>({ 4 }), tt::per_element());
+
+    query.Tool(_T("RectTool")).Desktop(desktop2.GetId());
+    BOOST_TEST(query.Select() == std::vector<unsigned int>({ 2, 3 }), tt::per_element());
+
+    query.Reset();
+    query.TimeRange(_T("2022-05-01T11:00:00Z"), _T("2022-05-01T13:00:00Z"));
+    BOOST_TEST(query.Select() == std::vector<unsigned int>({ 1, 2, 3 }), tt::per_element());
+
+    query.TimeRange(MeaTimeStamp::Parse(_T("2022-05-01T13:00:00Z")), MeaTimeStamp::Parse(_T("2022-05-01T14:00:00Z")));
+    BOOST_TEST(query.Select() == std::vector<unsigned int>({ 3, 4 }), tt::per_element());
+
+    query.Reset();
+    query.Range(MeaWidthField, 15.0, 35.0);
+    BOOST_TEST(query.Select() == std::vector<unsigned int>({ 1, 2 }), tt::per_element());
+
+    query.Range(MeaHeightField, 50.0, 100.0);
+    BOOST_TEST(query.Select() == std::vector<unsigned int>({ 2 }), tt::per_element());
+
+    query.Reset();
+    query.Tool(_T("CircleTool"));
+    BOOST_TEST(query.Count() == 0U);
+
+    query.Reset();
+    query.Range(MeaDistanceField, 0.0, 100.0);         // No position recorded a distance
+    BOOST_TEST(query.Count() == 0U);
+
+    BOOST_CHECK_THROW(query.Range(MeaX1Field, 0.0, 1.0), std::invalid_argument);
+    BOOST_CHECK_THROW(query.TimeRange(_T("yesterday"), _T("today")), std::invalid_argument);
+}
+
+BOOST_FIXTURE_TEST_CASE(TestSummarize, TestFixture) {
+    MeaPositionQuery query(positions);
+
+    MeaPositionQuery::Summary summary = query.Summarize(MeaWidthField);
+    BOOST_TEST(summary.m_count == 4U);
+    BOOST_TEST(summary.m_mean == 25.0, tt::tolerance(1e-9));
+    BOOST_TEST(summary.m_min == 10.0);
+    BOOST_TEST(summary.m_max == 40.0);
+
+    summary = query.Summarize(MeaAngleField);
+    BOOST_TEST(summary.m_count == 1U);
+    BOOST_TEST(summary.m_mean == 45.0);
+
+    summary = query.Desktop(desktop2.GetId()).Summarize(MeaAreaField);
+    BOOST_TEST(summary.m_count == 2U);
+    BOOST_TEST(summary.m_min == 1800.0);
+    BOOST_TEST(summary.m_max == 3200.0);
+
+    summary = query.Summarize(MeaDistanceField);
+    BOOST_TEST(summary.m_count == 0U);
+    BOOST_TEST(summary.m_mean == 0.0);
+
+    BOOST_CHECK_THROW(query.Summarize(MeaXVField), std::invalid_argument);
+}
+
+BOOST_FIXTURE_TEST_CASE(TestPercentile, TestFixture) {
+    MeaPositionQuery query(positions);
+    double value = 0.0;
+
+    BOOST_TEST(query.Percentile(MeaWidthField, 0.0, value));
+    BOOST_TEST(value == 10.0);
+    BOOST_TEST(query.Percentile(MeaWidthField, 100.0, value));
+    BOOST_TEST(value == 40.0);
+    BOOST_TEST(query.Percentile(MeaWidthField, 50.0, value));
+    BOOST_TEST(value == 25.0, tt::tolerance(1e-9));
+    BOOST_TEST(query.Percentile(MeaHeightField, 25.0, value));
+    BOOST_TEST(value == 35.0, tt::tolerance(1e-9));
+
+    value = -1.0;
+    BOOST_TEST(!query.Percentile(MeaDistanceField, 50.0, value));
+    BOOST_TEST(value == -1.0);
+
+    BOOST_CHECK_THROW(query.Percentile(MeaWidthField, 101.0, value), std::invalid_argument);
+    BOOST_CHECK_THROW(query.Percentile(MeaWidthField, -1.0, value), std::invalid_argument);
+}
+
+BOOST_FIXTURE_TEST_CASE(TestHistogram, TestFixture) {
+    MeaPositionQuery query(positions);
+
+    MeaPositionQuery::Histogram histogram = query.MakeHistogram(MeaWidthField, 3);
+    BOOST_TEST(histogram.m_min == 10.0);
+    BOOST_TEST(histogram.m_binWidth == 10.0, tt::tolerance(1e-9));
+    BOOST_TEST(histogram.m_counts == std::vector<unsigned int>({ 1, 1, 2 }), tt::per_element());
+
+    histogram = query.MakeHistogram(MeaAngleField, 4);
+    BOOST_TEST(histogram.m_min == 45.0);
+    BOOST_TEST(histogram.m_binWidth == 0.0);
+    BOOST_TEST(histogram.m_counts == std::vector<unsigned int>({ 1, 0, 0, 0 }), tt::per_element());
+
+    histogram = query.MakeHistogram(MeaDistanceField, 2);
+    BOOST_TEST(histogram.m_counts == std::vector<unsigned int>({ 0, 0 }), tt::per_element());
+
+    BOOST_CHECK_THROW(query.MakeHistogram(MeaWidthField, 0), std::invalid_argument);
+}
+
+BOOST_FIXTURE_TEST_CASE(TestInvalidation, TestFixture) {
+    MeaPositionQuery query(positions);
+    query.Tool(_T("RectTool"));
+
+    BOOST_TEST(query.Count() == 4U);
+    BOOST_TEST(positions.GetColumns().Size() == 5U);
+
+    AddRect(ref1, _T("2022-05-01T15:00:00Z"), 50.0, 100.0);
+    BOOST_TEST(query.Count() == 5U);
+    BOOST_TEST(query.Summarize(MeaWidthField).m_max == 50.0);
+
+    positions.Delete(0);
+    BOOST_TEST(query.Count() == 4U);
+    BOOST_TEST(query.Summarize(MeaWidthField).m_min == 20.0);
+
+    MeaPosition* angle = new MeaPosition(ref1, _T("AngleTool"), _T("2022-05-01T16:00:00Z"));
+    angle->RecordAngle(90.0);
+    positions.Set(0, angle);
+    BOOST_TEST(query.Count() == 3U);
+
+    query.Reset();
+    BOOST_TEST(query.Summarize(MeaAngleField).m_count == 2U);
+
+    positions.DeleteAll();
+    BOOST_TEST(query.Count() == 0U);
+    BOOST_TEST(positions.GetColumns().Size() == 0U);
+}
@@ -0,0 +1,243 @@
+/*
+ * Copyright 2022 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "pch.h"
+#define BOOST_TEST_MODULE PositionRecorderTest
+#include "GlobalFixture.h"
+#include <boost/test/unit_test.hpp>
+#include <meazure/position/PositionRecorder.h>
+#include <meazure/position/PositionCollection.h>
+#include <meazure/position/PositionLogObserver.h>
+#include <meazure/utilities/Geometry.h>
+#include <meazure/utilities/NumericUtils.h>
+#include "mocks/MockScreenProvider.h"
+#include "mocks/MockUnitsProvider.h"
+#include "mocks/MockPositionDesktopRefCounter.h"
+#include <float.h>
+#include <cmath>
+#include <initializer_list>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace tt = boost::test_tools;
+
+
+struct TestFixture {
+    TestFixture() : unitsProvider(screenProvider), desktop(unitsProvider, screenProvider), ref(&counter, desktop) {}
+
+    MockScreenProvider screenProvider;
+    MockUnitsProvider unitsProvider;
+    MeaPositionDesktop desktop;
+    MockPositionDesktopRefCounter counter;
+    MeaPositionDesktopRef ref;
+};
+
+class TestObserver : public MeaPositionLogObserver {
+
+public:
+    void LogLoaded() override {}
+    void LogSaved() override {}
+    void PositionAdded(int) override {}
+    void PositionsAdded(int firstIndex, int count) override { added.emplace_back(firstIndex, count); }
+    void PositionReplaced(int) override {}
+    void PositionDeleted(int) override {}
+    void PositionsDeleted() override {}
+
+    std::vector<std::pair<int, int>> added;
+};
+
+MeaPositionRecorder::Measurement MakeMeasurement(PCTSTR toolName, std::initializer_list<PCTSTR> names) {
+    MeaPositionRecorder::Measurement measurement;
+    measurement.m_toolName = toolName;
+    int coord = 10;
+    for (PCTSTR name : names) {
+        measurement.m_points[name] = POINT { coord, coord + 5 };
+        coord += 20;
+    }
+    return measurement;
+}
+
+
+BOOST_FIXTURE_TEST_CASE(TestRecordPoint, TestFixture) {
+    MeaPosition position(ref);
+    MeaPositionRecorder::RecordPoint(position, _T("PointTool"), POINT { 10, 20 }, unitsProvider);
+
+    BOOST_TEST(position.GetToolName() == _T("PointTool"));
+    BOOST_TEST(position.GetPoints().size() == 1U);
+    BOOST_TEST(position.GetPoints().at(_T("1")).x == 10.0, tt::tolerance(FLT_EPSILON));
+    BOOST_TEST(position.GetPoints().at(_T("1")).y == 20.0, tt::tolerance(FLT_EPSILON));
+    BOOST_TEST(position.GetDistance() == 0.0, tt::tolerance(FLT_EPSILON));
+}
+
+BOOST_FIXTURE_TEST_CASE(TestRecordSegment, TestFixture) {
+    MeaPosition position(ref);
+    MeaPositionRecorder::RecordSegment(position, _T("LineTool"), POINT { 10, 20 }, POINT { 40, 60 }, unitsProvider);
+
+    BOOST_TEST(position.GetToolName() == _T("LineTool"));
+    BOOST_TEST(position.GetPoints().size() == 2U);
+    BOOST_TEST(position.GetPoints().at(_T("2")).x == 40.0, tt::tolerance(FLT_EPSILON));
+    BOOST_TEST(position.GetPoints().at(_T("2")).y == 60.0, tt::tolerance(FLT_EPSILON));
+    BOOST_TEST(position.GetWidth() == 31.0, tt::tolerance(FLT_EPSILON));
+    BOOST_TEST(position.GetHeight() == 41.0, tt::tolerance(FLT_EPSILON));
+    BOOST_TEST(position.GetDistance() == std::sqrt(31.0 * 31.0 + 41.0 * 41.0), tt::tolerance(FLT_EPSILON));
+    BOOST_TEST(position.GetArea() == 31.0 * 41.0, tt::tolerance(FLT_EPSILON));
+
+    double angle = MeaGeometry::CalcAngle(MeaFPoint(10.0, 20.0), MeaFPoint(40.0, 60.0));
+    BOOST_TEST(position.GetAngle() == unitsProvider.ConvertAngle(angle), tt::tolerance(FLT_EPSILON));
+}
+
+BOOST_FIXTURE_TEST_CASE(TestRecordCircle, TestFixture) {
+    MeaPosition position(ref);
+    MeaPositionRecorder::RecordCircle(position, _T("CircleTool"), POINT { 100, 100 }, POINT { 103, 104 },
+                                      unitsProvider);
+
+    // Radius of 5 pixels, so the bounding box spans 11 pixels.
+    BOOST_TEST(position.GetPoints().size() == 2U);
+    BOOST_TEST(position.GetPoints().at(_T("v")).x == 100.0, tt::tolerance(FLT_EPSILON));
+    BOOST_TEST(position.GetPoints().at(_T("1")).x == 103.0, tt::tolerance(FLT_EPSILON));
+    BOOST_TEST(position.GetWidth() == 11.0, tt::tolerance(FLT_EPSILON));
+    BOOST_TEST(position.GetHeight() == 11.0, tt::tolerance(FLT_EPSILON));
+    BOOST_TEST(position.GetDistance() == 5.5, tt::tolerance(FLT_EPSILON));
+    BOOST_TEST(position.GetArea() == MeaNumericUtils::PI * 5.5 * 5.5, tt::tolerance(FLT_EPSILON));
+}
+
+BOOST_FIXTURE_TEST_CASE(TestRecordAngle, TestFixture) {
+    MeaPosition position(ref);
+    MeaPositionRecorder::RecordAngle(position, _T("AngleTool"), POINT { 10, 0 }, POINT { 0, 10 }, POINT { 0, 0 },
+                                     unitsProvider);
+
+    BOOST_TEST(position.GetPoints().size() == 3U);
+    BOOST_TEST(std::fabs(position.GetAngle()) == 90.0, tt::tolerance(FLT_EPSILON));
+}
+
+BOOST_FIXTURE_TEST_CASE(TestRecord, TestFixture) {
+    MeaPositionRecorder::Measurement measurement;
+    measurement.m_toolName = _T("RectTool");
+    measurement.m_points[_T("1")] = POINT { 10, 20 };
+    measurement.m_points[_T("2")] = POINT { 40, 60 };
+    measurement.m_desc = _T("Button");
+
+    MeaPosition recorded(ref);
+    MeaPositionRecorder::Record(recorded, measurement, unitsProvider);
+
+    MeaPosition expected(ref);
+    MeaPositionRecorder::RecordSegment(expected, _T("RectTool"), POINT { 10, 20 }, POINT { 40, 60 }, unitsProvider);
+
+    BOOST_TEST(recorded.GetToolName() == _T("RectTool"));
+    BOOST_TEST(recorded.GetDesc() == _T("Button"));
+    BOOST_TEST(recorded.GetPoints().size() == 2U);
+    BOOST_TEST(recorded.GetArea() == expected.GetArea(), tt::tolerance(FLT_EPSILON));
+    BOOST_TEST(recorded.GetAngle() == expected.GetAngle(), tt::tolerance(FLT_EPSILON));
+
+    measurement.m_toolName = _T("AngleTool");
+    measurement.m_points[_T("v")] = POINT { 0, 0 };
+    MeaPosition angle(ref);
+    MeaPositionRecorder::Record(angle, measurement, unitsProvider);
+    BOOST_TEST(angle.GetPoints().size() == 3U);
+
+    measurement.m_toolName = _T("CircleTool");
+    measurement.m_points.erase(_T("2"));
+    MeaPosition circle(ref);
+    MeaPositionRecorder::Record(circle, measurement, unitsProvider);
+    BOOST_TEST(circle.GetPoints().at(_T("v")).x == 0.0, tt::tolerance(FLT_EPSILON));
+    BOOST_TEST(circle.GetPoints().at(_T("1")).x == 10.0, tt::tolerance(FLT_EPSILON));
+}
+
+BOOST_FIXTURE_TEST_CASE(TestRecordInvalid, TestFixture) {
+    MeaPosition position(ref);
+    MeaPositionRecorder::Measurement measurement;
+    measurement.m_toolName = _T("LineTool");
+
+    BOOST_CHECK_THROW(MeaPositionRecorder::Record(position, measurement, unitsProvider), std::invalid_argument);
+
+    measurement.m_points[_T("2")] = POINT { 1, 2 };
+    BOOST_CHECK_THROW(MeaPositionRecorder::Record(position, measurement, unitsProvider), std::invalid_argument);
+
+    measurement.m_points[_T("1")] = POINT { 1, 2 };
+    measurement.m_points[_T("3")] = POINT { 1, 2 };
+    BOOST_CHECK_THROW(MeaPositionRecorder::Record(position, measurement, unitsProvider), std::invalid_argument);
+
+    // Points of a different tool.
+    measurement.m_points.erase(_T("3"));
+    measurement.m_points[_T("v")] = POINT { 1, 2 };
+    BOOST_CHECK_THROW(MeaPositionRecorder::Record(position, measurement, unitsProvider), std::invalid_argument);
+
+    measurement.m_toolName = _T("PointTool");
+    BOOST_CHECK_THROW(MeaPositionRecorder::Record(position, measurement, unitsProvider), std::invalid_argument);
+
+    // Not a measurement tool.
+    measurement.m_toolName = _T("RulerTool");
+    measurement.m_points.erase(_T("v"));
+    BOOST_CHECK_THROW(MeaPositionRecorder::Record(position, measurement, unitsProvider), std::invalid_argument);
+
+    // Points matching the tool.
+    measurement.m_toolName = _T("WindowTool");
+    BOOST_CHECK_NO_THROW(MeaPositionRecorder::Record(position, measurement, unitsProvider));
+}
+
+BOOST_FIXTURE_TEST_CASE(TestRecordBatch, TestFixture) {
+    MeaPositionCollection positions;
+    positions.Add(new MeaPosition(ref, _T("PointTool"), _T("2022-05-01T12:00:00Z")));
+    TestObserver observer;
+
+    std::vector<MeaPositionRecorder::Measurement> measurements = {
+        MakeMeasurement(_T("LineTool"), { _T("1"), _T("2") }),
+        MakeMeasurement(_T("PointTool"), { _T("1") }),
+        MakeMeasurement(_T("CircleTool"), { _T("1"), _T("v") })
+    };
+    MeaPositionRecorder::RecordBatch(positions, measurements, ref, _T("2022-05-01T12:30:15Z"), unitsProvider,
+                                     &observer);
+
+    // Positions are appended in the order of the measurements and the observer is notified once.
+    BOOST_TEST(positions.Size() == 4U);
+    BOOST_TEST(positions.Get(1).GetToolName() == _T("LineTool"));
+    BOOST_TEST(positions.Get(2).GetToolName() == _T("PointTool"));
+    BOOST_TEST(positions.Get(3).GetToolName() == _T("CircleTool"));
+    for (int i = 1; i < 4; i++) {
+        BOOST_TEST(positions.Get(i).GetTimeStamp() == _T("2022-05-01T12:30:15Z"));
+    }
+    BOOST_TEST(positions.Get(2).GetPoints().at(_T("1")).x == 10.0, tt::tolerance(FLT_EPSILON));
+    BOOST_TEST(observer.added.size() == 1U);
+    BOOST_TEST(observer.added.front().first == 1);
+    BOOST_TEST(observer.added.front().second == 3);
+
+    // An empty batch adds nothing and is not reported.
+    MeaPositionRecorder::RecordBatch(positions, {}, ref, _T("2022-05-01T12:31:00Z"), unitsProvider, &observer);
+    BOOST_TEST(positions.Size() == 4U);
+    BOOST_TEST(observer.added.size() == 1U);
+}
+
+BOOST_FIXTURE_TEST_CASE(TestRecordBatchRejected, TestFixture) {
+    MeaPositionCollection positions;
+    positions.Add(new MeaPosition(ref, _T("PointTool"), _T("2022-05-01T12:00:00Z")));
+    TestObserver observer;
+
+    // The last measurement does not have the points of its tool, so none of the batch is recorded.
+    std::vector<MeaPositionRecorder::Measurement> measurements = {
+        MakeMeasurement(_T("LineTool"), { _T("1"), _T("2") }),
+        MakeMeasurement(_T("AngleTool"), { _T("1"), _T("2") })
+    };
+    BOOST_CHECK_THROW(MeaPositionRecorder::RecordBatch(positions, measurements, ref, _T("2022-05-01T12:30:15Z"),
+                                                       unitsProvider, &observer), std::invalid_argument);
+
+    BOOST_TEST(positions.Size() == 1U);
+    BOOST_TEST(positions.Get(0).GetToolName() == _T("PointTool"));
+    BOOST_TEST(observer.added.empty());
+}
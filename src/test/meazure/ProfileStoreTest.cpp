@@ -0,0 +1,103 @@
+/*
+ * Copyright 2022 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "pch.h"
+#define BOOST_TEST_MODULE ProfileStoreTest
+#include "GlobalFixture.h"
+#include <boost/test/unit_test.hpp>
+#include <meazure/profile/ProfileStore.h>
+
+
+BOOST_AUTO_TEST_CASE(TestEmpty) {
+    MeaProfileStore store;
+
+    BOOST_TEST(store.GetSize() == 0U);
+    BOOST_TEST(store.Get(_T("key1")) == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(TestSetGet) {
+    MeaProfileStore store;
+
+    store.Set(_T("key1"), _T("abcd"));
+    store.Set(_T("key2"), _T("17"));
+
+    BOOST_TEST(store.GetSize() == 2U);
+    BOOST_TEST(*store.Get(_T("key1")) == _T("abcd"));
+    BOOST_TEST(*store.Get(_T("key2")) == _T("17"));
+    BOOST_TEST(store.Get(_T("key3")) == nullptr);
+
+    store.Set(_T("key1"), _T("efgh"));
+    BOOST_TEST(store.GetSize() == 2U);
+    BOOST_TEST(*store.Get(_T("key1")) == _T("efgh"));
+}
+
+BOOST_AUTO_TEST_CASE(TestInsertionOrder) {
+    MeaProfileStore store;
+
+    store.Set(_T("zeta"), _T("1"));
+    store.Set(_T("alpha"), _T("2"));
+    store.Set(_T("mu"), _T("3"));
+    store.Set(_T("zeta"), _T("4"));
+
+    const MeaProfileStore::Entries& entries = store.GetEntries();
+    BOOST_TEST(entries.size() == 3U);
+    BOOST_TEST(entries[0].m_key == _T("zeta"));
+    BOOST_TEST(entries[0].m_value == _T("4"));
+    BOOST_TEST(entries[1].m_key == _T("alpha"));
+    BOOST_TEST(entries[2].m_key == _T("mu"));
+}
+
+BOOST_AUTO_TEST_CASE(TestGrow) {
+    MeaProfileStore store(4);
+
+    for (int i = 0; i < 1000; i++) {
+        CString key;
+        key.Format(_T("key%d"), i);
+        CString value;
+        value.Format(_T("%d"), i * 2);
+        store.Set(key, value);
+    }
+
+    BOOST_TEST(store.GetSize() == 1000U);
+
+    for (int i = 0; i < 1000; i++) {
+        CString key;
+        key.Format(_T("key%d"), i);
+        CString value;
+        value.Format(_T("%d"), i * 2);
+        const CString* storedValue = store.Get(key);
+        BOOST_TEST_REQUIRE(storedValue != nullptr);
+        BOOST_TEST(*storedValue == value);
+        BOOST_TEST(store.GetEntries()[i].m_key == key);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(TestClear) {
+    MeaProfileStore store;
+
+    store.Set(_T("key1"), _T("abcd"));
+    store.Clear();
+
+    BOOST_TEST(store.GetSize() == 0U);
+    BOOST_TEST(store.Get(_T("key1")) == nullptr);
+
+    store.Set(_T("key1"), _T("efgh"));
+    BOOST_TEST(*store.Get(_T("key1")) == _T("efgh"));
+}
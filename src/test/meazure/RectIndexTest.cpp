@@ -0,0 +1,115 @@
+/*
+ * Copyright 2022 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "pch.h"
+#define BOOST_TEST_MODULE RectIndexTest
+#include "GlobalFixture.h"
+#include <boost/test/unit_test.hpp>
+#include <meazure/utilities/RectIndex.h>
+#include <vector>
+#include <random>
+#include <limits>
+
+
+namespace {
+    // Locates the point by examining each rectangle in turn.
+    int LinearFind(const std::vector<MeaFRect>& rects, double x, double y) {
+        for (std::size_t i = 0; i < rects.size(); i++) {
+            const MeaFRect& r = rects[i];
+            double left = std::min(r.left, r.right);
+            double right = std::max(r.left, r.right);
+            double top = std::min(r.top, r.bottom);
+            double bottom = std::max(r.top, r.bottom);
+            if (left <= x && x < right && top <= y && y < bottom) {
+                return static_cast<int>(i);
+            }
+        }
+        return MeaRectIndex::kNotFound;
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(TestEmpty) {
+    MeaRectIndex index;
+    BOOST_TEST(index.Find(0.0, 0.0) == MeaRectIndex::kNotFound);
+
+    index.Build({});
+    BOOST_TEST(index.Find(0.0, 0.0) == MeaRectIndex::kNotFound);
+
+    index.Build({ MeaFRect(10.0, 10.0, 0.0, 20.0) });      // Zero height
+    BOOST_TEST(index.Find(5.0, 10.0) == MeaRectIndex::kNotFound);
+}
+
+BOOST_AUTO_TEST_CASE(TestScreens) {
+    // Primary screen with one screen to its left and one above and to its right, offset vertically.
+    std::vector<MeaFRect> screens {
+        MeaFRect(0.0, 1080.0, 0.0, 1920.0),
+        MeaFRect(200.0, 1224.0, -1280.0, 0.0),
+        MeaFRect(-1440.0, 0.0, 1920.0, 4480.0)
+    };
+
+    MeaRectIndex index;
+    index.Build(screens);
+
+    BOOST_TEST(index.Find(0.0, 0.0) == 0);
+    BOOST_TEST(index.Find(1919.0, 1079.0) == 0);
+    BOOST_TEST(index.Find(1920.0, 0.0) == MeaRectIndex::kNotFound);
+    BOOST_TEST(index.Find(1920.0, -1.0) == 2);
+    BOOST_TEST(index.Find(-1.0, 200.0) == 1);
+    BOOST_TEST(index.Find(-1.0, 199.0) == MeaRectIndex::kNotFound);
+    BOOST_TEST(index.Find(-1280.0, 1223.5) == 1);
+    BOOST_TEST(index.Find(-1280.5, 500.0) == MeaRectIndex::kNotFound);
+    BOOST_TEST(index.Find(MeaFPoint(4479.0, -1440.0)) == 2);
+    BOOST_TEST(index.Find(std::numeric_limits<double>::quiet_NaN(), 0.0) == MeaRectIndex::kNotFound);
+
+    index.Clear();
+    BOOST_TEST(index.Find(0.0, 0.0) == MeaRectIndex::kNotFound);
+}
+
+BOOST_AUTO_TEST_CASE(TestReversedEdges) {
+    // Rectangles in a space with an inverted y-axis.
+    MeaRectIndex index;
+    index.Build({ MeaFRect(10.0, 0.0, 0.0, 5.0), MeaFRect(20.0, 10.0, 0.0, 5.0) });
+
+    BOOST_TEST(index.Find(1.0, 0.0) == 0);
+    BOOST_TEST(index.Find(1.0, 9.9) == 0);
+    BOOST_TEST(index.Find(1.0, 10.0) == 1);
+    BOOST_TEST(index.Find(1.0, 20.0) == MeaRectIndex::kNotFound);
+}
+
+BOOST_AUTO_TEST_CASE(TestMatchesLinearSearch) {
+    std::mt19937 generator(3);
+    std::uniform_int_distribution<int> coord(-50, 50);
+
+    for (int trial = 0; trial < 50; trial++) {
+        std::vector<MeaFRect> rects;
+        for (int i = 0; i < 6; i++) {
+            rects.emplace_back(coord(generator), coord(generator), coord(generator), coord(generator));
+        }
+
+        MeaRectIndex index;
+        index.Build(rects);
+
+        for (double y = -55.0; y <= 55.0; y += 0.5) {
+            for (double x = -55.0; x <= 55.0; x += 0.5) {
+                BOOST_TEST(index.Find(x, y) == LinearFind(rects, x, y));
+            }
+        }
+    }
+}
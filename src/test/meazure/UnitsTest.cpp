@@ -21,8 +21,12 @@
 #define BOOST_TEST_MODULE UnitsTest
 #include "GlobalFixture.h"
 #include <boost/test/unit_test.hpp>
+#include "mocks/MockProfile.h"
 #include "mocks/MockScreenProvider.h"
 #include <meazure/units/Units.h>
+#include <meazure/utilities/NumericUtils.h>
+#include <vector>
+#include <memory>
 
 namespace bt = boost::unit_test;
 namespace tt = boost::test_tools;
@@ -470,3 +474,261 @@ BOOST_AUTO_TEST_CASE(TestCustomUnits, *bt::tolerance(0.0001)) {
     VerifyToPixels(units, 50, 20, 10000, 3600);
     VerifyFromPixels(units, 0.0050000000000000001, 0.0055555555555555558);
 }
+
+BOOST_AUTO_TEST_CASE(TestConversionSettingsChange, *bt::tolerance(0.0001)) {
+    MockScreenProvider* screenProvider = new MockScreenProvider();
+    MeaCustomUnits units(*screenProvider, &MockScreenProvider::ChangeLabel);
+    POINT pos = { 100, 200 };
+
+    units.SetScaleFactor(2.0);
+    MeaFPoint result = units.ConvertCoord(pos);
+    BOOST_TEST(result.x == 50.0);
+    BOOST_TEST(result.y == 100.0);
+    BOOST_TEST(units.UnconvertCoord(MeaFPoint(50.0, 100.0)) == pos);
+
+    units.SetScaleFactor(4.0);
+    result = units.ConvertCoord(pos);
+    BOOST_TEST(result.x == 25.0);
+    BOOST_TEST(result.y == 50.0);
+    BOOST_TEST(units.UnconvertPos(MeaFPoint(25.0, 50.0)) == pos);
+
+    units.SetScaleBasis(MeaCustomUnits::InchBasis);
+    units.SetScaleFactor(1.0);
+    result = units.ConvertPos(pos);
+    BOOST_TEST(result.x == 100.0 / 96.0);
+    BOOST_TEST(result.y == 200.0 / 96.0);
+
+    POINT origin = { 4, 8 };
+    units.SetOrigin(origin);
+    result = units.ConvertCoord(pos);
+    BOOST_TEST(result.x == 1.0);
+    BOOST_TEST(result.y == 2.0);
+    BOOST_TEST(units.UnconvertCoord(MeaFPoint(1.0, 2.0)) == pos);
+
+    units.SetInvertY(true);
+    result = units.ConvertCoord(pos);
+    BOOST_TEST(result.y == -2.0);
+    BOOST_TEST(units.UnconvertCoord(MeaFPoint(1.0, -2.0)) == pos);
+
+    origin = { 0, 0 };
+    units.SetOrigin(origin);
+    units.SetInvertY(false);
+}
+
+BOOST_AUTO_TEST_CASE(TestBatchConversion) {
+    MockScreenProvider* screenProvider = new MockScreenProvider();
+    MeaPixelUnits pixelUnits(*screenProvider);
+    MeaInchUnits inchUnits(*screenProvider);
+    MeaCentimeterUnits cmUnits(*screenProvider);
+    MeaCustomUnits customUnits(*screenProvider, &MockScreenProvider::ChangeLabel);
+    customUnits.SetScaleFactor(3.0);
+
+    MeaLinearUnits* allUnits[] = { &pixelUnits, &inchUnits, &cmUnits, &customUnits };
+    const POINT origins[] = { { 0, 0 }, { 100, 200 }, { -37, 1500 } };
+
+    // Points on and off the screen, including its edges.
+    std::vector<POINT> points;
+    for (int y = -60; y <= 1100; y += 97) {
+        for (int x = -40; x <= 1350; x += 113) {
+            points.push_back({ x, y });
+        }
+    }
+    points.push_back({ 0, 0 });
+    points.push_back({ 1279, 1023 });
+    points.push_back({ 1280, 1024 });
+
+    std::vector<MeaFPoint> coords(points.size());
+    std::vector<POINT> unconverted(points.size());
+
+    for (MeaLinearUnits* units : allUnits) {
+        for (const POINT& origin : origins) {
+            for (bool invertY : { false, true }) {
+                units->SetOrigin(origin);
+                units->SetInvertY(invertY);
+
+                units->ConvertCoords(points.data(), coords.data(), points.size());
+                for (std::size_t i = 0; i < points.size(); i++) {
+                    MeaFPoint expected = units->ConvertCoord(points[i]);
+                    BOOST_TEST(coords[i].x == expected.x);
+                    BOOST_TEST(coords[i].y == expected.y);
+                }
+
+                units->UnconvertCoords(coords.data(), unconverted.data(), coords.size());
+                for (std::size_t i = 0; i < coords.size(); i++) {
+                    BOOST_TEST(unconverted[i] == units->UnconvertCoord(coords[i]));
+                }
+            }
+        }
+
+        units->SetOrigin({ 0, 0 });
+        units->SetInvertY(false);
+    }
+
+    inchUnits.ConvertCoords(points.data(), coords.data(), 0);
+    inchUnits.UnconvertCoords(coords.data(), unconverted.data(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(TestTransformSnapshot) {
+    MockScreenProvider* screenProvider = new MockScreenProvider();
+    MeaInchUnits units(*screenProvider);
+    POINT pos = { 192, 288 };
+
+    std::shared_ptr<const MeaUnitsTransform> transform = units.GetTransform();
+    BOOST_TEST(units.GetTransform() == transform);
+    BOOST_TEST(transform->ConvertCoord(pos).x == 2.0);
+    BOOST_TEST(transform->ConvertCoord(pos).y == 3.0);
+
+    POINT origin = { 96, 96 };
+    units.SetOrigin(origin);
+
+    std::shared_ptr<const MeaUnitsTransform> moved = units.GetTransform();
+    BOOST_TEST(moved != transform);
+    BOOST_TEST(moved->ConvertCoord(pos).x == 1.0);
+    BOOST_TEST(moved->ConvertCoord(pos).y == 2.0);
+    BOOST_TEST(transform->ConvertCoord(pos).x == 2.0);
+    BOOST_TEST(transform->ConvertCoord(pos).y == 3.0);
+
+    origin = { 0, 0 };
+    units.SetOrigin(origin);
+}
+
+BOOST_AUTO_TEST_CASE(TestUnitsContext) {
+    MockScreenProvider* screenProvider = new MockScreenProvider();
+    MeaInchUnits units(*screenProvider);
+    MeaDegreeUnits degrees;
+
+    BOOST_TEST(!MeaUnits::GetDefaultContext().m_invertY);
+    BOOST_TEST(!MeaUnits::GetDefaultContext().m_supplementalAngle);
+
+    MeaUnitsContext context;
+    context.m_origin = { 96, 192 };
+    context.m_invertY = true;
+    context.m_supplementalAngle = true;
+
+    // Converting with a context gives the same results as applying its settings, without changing the defaults.
+    const POINT points[] = { { 0, 0 }, { 192, 96 }, { 1000, 1000 } };
+    MeaFPoint coords[3];
+    POINT pixels[3];
+
+    units.ConvertCoords(points, coords, 3, context);
+    units.UnconvertCoords(coords, pixels, 3, context);
+    BOOST_TEST(units.GetOrigin().x == 0);
+    BOOST_TEST(!units.IsInvertY());
+    BOOST_TEST(units.ConvertCoord(points[1]).x == 2.0);
+
+    units.SetOrigin(context.m_origin);
+    units.SetInvertY(true);
+    BOOST_TEST(MeaUnits::GetDefaultContext().SameLinear(context));
+    BOOST_TEST(units.GetTransform(context) == units.GetTransform());
+    for (int i = 0; i < 3; i++) {
+        BOOST_TEST(coords[i].x == units.ConvertCoord(points[i]).x);
+        BOOST_TEST(coords[i].y == units.ConvertCoord(points[i]).y);
+        BOOST_TEST(pixels[i] == points[i]);
+    }
+    units.SetOrigin({ 0, 0 });
+    units.SetInvertY(false);
+
+    BOOST_TEST(degrees.ConvertAngle(MeaNumericUtils::PI / 3.0, context) == 120.0, tt::tolerance(0.000001));
+    BOOST_TEST(degrees.ConvertAngle(MeaNumericUtils::PI / 3.0) == 60.0, tt::tolerance(0.000001));
+    BOOST_TEST(!MeaAngularUnits::IsSupplementalAngle());
+}
+
+BOOST_AUTO_TEST_CASE(TestExactTicks) {
+    MockScreenProvider* screenProvider = new MockScreenProvider();
+    MeaPixelUnits pixelUnits(*screenProvider);
+    MeaPointUnits pointUnits(*screenProvider);
+    MeaPicaUnits picaUnits(*screenProvider);
+    MeaTwipUnits twipUnits(*screenProvider);
+    MeaInchUnits inchUnits(*screenProvider);
+    MeaCentimeterUnits cmUnits(*screenProvider);
+    MeaMillimeterUnits mmUnits(*screenProvider);
+    MeaCustomUnits customUnits(*screenProvider, &MockScreenProvider::ChangeLabel);
+    customUnits.SetScaleBasis(MeaCustomUnits::InchBasis);
+    customUnits.SetScaleFactor(3.7);
+
+    MeaLinearUnits* allUnits[] = {
+        &pixelUnits, &pointUnits, &picaUnits, &twipUnits, &inchUnits, &cmUnits, &mmUnits, &customUnits
+    };
+    const POINT origins[] = { { 0, 0 }, { 100, 200 } };
+
+    std::vector<double> positions;
+    std::vector<MeaLinearUnits::TickPixels> ticks;
+
+    // The exactness check must agree with comparing the formatted coordinates for every units,
+    // display precision, origin and y-axis orientation.
+    for (MeaLinearUnits* units : allUnits) {
+        MeaUnits::DisplayPrecisions savedPrecisions = units->GetDisplayPrecisions();
+        MeaFSize incr = units->FromPixels(MeaFSize(96.0, 96.0));
+
+        for (int precision = 0; precision <= 6; precision++) {
+            MeaUnits::DisplayPrecisions precisions = savedPrecisions;
+            precisions[MeaX] = precision;
+            units->SetDisplayPrecisions(precisions);
+
+            for (const POINT& origin : origins) {
+                for (bool invertY : { false, true }) {
+                    units->SetOrigin(origin);
+                    units->SetInvertY(invertY);
+
+                    positions.clear();
+                    for (int i = -300; i <= 300; i++) {
+                        positions.push_back(i * incr.cx / 7.0);
+                        positions.push_back(i * incr.cx);
+                        positions.push_back(i * 0.05);
+                    }
+                    ticks.resize(positions.size());
+
+                    for (MeaConvertDir dir : { MeaConvertX, MeaConvertY }) {
+                        units->UnconvertTicks(dir, nullptr, positions.data(), ticks.data(), positions.size());
+
+                        for (std::size_t i = 0; i < positions.size(); i++) {
+                            double pos = positions[i];
+                            int c1, c2;
+                            bool exact = units->UnconvertCoord(dir, nullptr, pos, c1, c2);
+
+                            POINT pixel = { c1, c1 };
+                            MeaFPoint la = units->ConvertCoord(pixel);
+                            double closest = (dir == MeaConvertX) ? la.x : la.y;
+                            bool expected = (units->Format(MeaX, pos) == units->Format(MeaX, closest));
+
+                            BOOST_TEST(exact == expected);
+                            BOOST_TEST(ticks[i].m_exact == exact);
+                            BOOST_TEST(ticks[i].m_c1 == c1);
+                            BOOST_TEST(ticks[i].m_c2 == c2);
+                        }
+                    }
+                }
+            }
+        }
+
+        units->SetDisplayPrecisions(savedPrecisions);
+        units->SetOrigin({ 0, 0 });
+        units->SetInvertY(false);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(TestPrecisionProfile) {
+    MockScreenProvider* screenProvider = new MockScreenProvider();
+    MeaInchUnits inchUnits(*screenProvider);
+    MeaRadianUnits radianUnits;
+
+    MockProfile profile;
+    inchUnits.SaveProfile(profile);
+    radianUnits.SaveProfile(profile);
+
+    BOOST_TEST_REQUIRE(profile.m_values.size() == 9U);
+    for (std::size_t i = 0; i < linearPrecisionNames.size(); i++) {
+        BOOST_TEST(profile.m_values[i].first == _T("Precision-") + linearPrecisionNames[i] + _T("-in"));
+        BOOST_TEST(profile.m_values[i].second == inchUnits.GetDisplayPrecisions()[i]);
+    }
+    BOOST_TEST(profile.m_values[8].first == _T("Precision-angle-rad"));
+
+    for (auto& value : profile.m_values) {
+        value.second = 5;
+    }
+    inchUnits.LoadProfile(profile);
+    radianUnits.LoadProfile(profile);
+
+    BOOST_TEST(inchUnits.GetDisplayPrecisions() == MeaUnits::DisplayPrecisions(8, 5));
+    BOOST_TEST(radianUnits.GetDisplayPrecisions() == MeaUnits::DisplayPrecisions(1, 5));
+}
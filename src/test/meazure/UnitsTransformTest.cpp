@@ -0,0 +1,154 @@
+/*
+ * Copyright 2022 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "pch.h"
+#define BOOST_TEST_MODULE UnitsTransformTest
+#include "GlobalFixture.h"
+#include <boost/test/unit_test.hpp>
+#include <meazure/units/UnitsTransform.h>
+#include <vector>
+
+
+namespace {
+    // Two side by side screens. The left screen is 96 dpi and the right is 144 dpi.
+    // Conversion is to inches.
+    const MeaFSize leftFromPixels(1.0 / 96.0, 1.0 / 96.0);
+    const MeaFSize rightFromPixels(1.0 / 144.0, 1.0 / 144.0);
+    const long virtualHeight = 1200;
+
+    MeaUnitsTransform::Screens MakeScreens() {
+        MeaUnitsTransform::Screens screens(2);
+        screens[0].m_rect = MeaFRect(0, 1024, 0, 1280);
+        screens[0].m_fromPixels = leftFromPixels;
+        screens[1].m_rect = MeaFRect(0, 1200, 1280, 3200);
+        screens[1].m_fromPixels = rightFromPixels;
+        return screens;
+    }
+
+    POINT Pt(long x, long y) {
+        POINT pt = { x, y };
+        return pt;
+    }
+
+    MeaUnitsContext Context(const POINT& origin, bool invertY) {
+        MeaUnitsContext context;
+        context.m_origin = origin;
+        context.m_invertY = invertY;
+        return context;
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(TestConvertCoord) {
+    MeaUnitsTransform transform(MakeScreens(), leftFromPixels, Context(Pt(0, 0), false), virtualHeight);
+
+    MeaFPoint coord = transform.ConvertCoord(Pt(96, 192));
+    BOOST_TEST(coord.x == 96 * leftFromPixels.cx);
+    BOOST_TEST(coord.y == 192 * leftFromPixels.cy);
+
+    coord = transform.ConvertCoord(Pt(1424, 144));
+    BOOST_TEST(coord.x == 1424 * rightFromPixels.cx);
+    BOOST_TEST(coord.y == 144 * rightFromPixels.cy);
+
+    // Positions off the screens use the nearest screen.
+    coord = transform.ConvertCoord(Pt(3300, 100));
+    BOOST_TEST(coord.x == 3300 * rightFromPixels.cx);
+    coord = transform.ConvertCoord(Pt(-50, 1100));
+    BOOST_TEST(coord.x == -50 * leftFromPixels.cx);
+    coord = transform.ConvertCoord(Pt(1270, 1100));
+    BOOST_TEST(coord.x == 1270 * rightFromPixels.cx);
+
+    POINT pos = transform.UnconvertCoord(MeaFPoint(1.0, 2.0));
+    BOOST_TEST(pos.x == 96);
+    BOOST_TEST(pos.y == 192);
+    // In inches the screens overlap horizontally, so the coordinate is chosen beyond the left screen.
+    pos = transform.UnconvertCoord(MeaFPoint(20.0, 1.0));
+    BOOST_TEST(pos.x == 2880);
+    BOOST_TEST(pos.y == 144);
+}
+
+BOOST_AUTO_TEST_CASE(TestOriginAndInvertY) {
+    MeaUnitsTransform moved(MakeScreens(), leftFromPixels, Context(Pt(100, 200), true), virtualHeight);
+
+    MeaFPoint coord = moved.ConvertCoord(Pt(196, 104));
+    BOOST_TEST(coord.x == 96 * leftFromPixels.cx);
+    BOOST_TEST(coord.y == 96 * leftFromPixels.cy);
+
+    POINT pos = moved.UnconvertCoord(coord);
+    BOOST_TEST(pos.x == 196);
+    BOOST_TEST(pos.y == 104);
+
+    // With the origin at the system origin, an inverted y-axis starts at the bottom of the virtual screen.
+    MeaUnitsTransform inverted(MakeScreens(), leftFromPixels, Context(Pt(0, 0), true), virtualHeight);
+
+    coord = inverted.ConvertCoord(Pt(1440, 1055));
+    BOOST_TEST(coord.x == 1440 * rightFromPixels.cx);
+    BOOST_TEST(coord.y == (virtualHeight - 1 - 1055) * rightFromPixels.cy);
+
+    pos = inverted.UnconvertCoord(coord);
+    BOOST_TEST(pos.x == 1440);
+    BOOST_TEST(pos.y == 1055);
+
+    BOOST_TEST(inverted.FindFromPixelsByCoord(coord).cx == rightFromPixels.cx);
+}
+
+BOOST_AUTO_TEST_CASE(TestConvertPos) {
+    MeaUnitsTransform transform(MakeScreens(), leftFromPixels, Context(Pt(100, 200), true), virtualHeight);
+
+    MeaFPoint coord = transform.ConvertPos(Pt(2880, 288));
+    BOOST_TEST(coord.x == 20.0);
+    BOOST_TEST(coord.y == 2.0);
+
+    POINT pos = transform.UnconvertPos(coord);
+    BOOST_TEST(pos.x == 2880);
+    BOOST_TEST(pos.y == 288);
+
+    pos = transform.UnconvertPos(MeaFPoint(1.0, 1.0));
+    BOOST_TEST(pos.x == 96);
+    BOOST_TEST(pos.y == 96);
+}
+
+BOOST_AUTO_TEST_CASE(TestBatchConversion) {
+    for (bool invertY : { false, true }) {
+        MeaUnitsTransform transform(MakeScreens(), leftFromPixels, Context(Pt(0, 0), invertY), virtualHeight);
+
+        std::vector<POINT> points;
+        for (long y = -100; y < 1300; y += 37) {
+            for (long x = -100; x < 3300; x += 53) {
+                points.push_back(Pt(x, y));
+            }
+        }
+
+        std::vector<MeaFPoint> coords(points.size());
+        transform.ConvertCoords(points.data(), coords.data(), points.size());
+        for (std::size_t i = 0; i < points.size(); i++) {
+            MeaFPoint expected = transform.ConvertCoord(points[i]);
+            BOOST_TEST(coords[i].x == expected.x);
+            BOOST_TEST(coords[i].y == expected.y);
+        }
+
+        std::vector<POINT> unconverted(coords.size());
+        transform.UnconvertCoords(coords.data(), unconverted.data(), coords.size());
+        for (std::size_t i = 0; i < coords.size(); i++) {
+            POINT expected = transform.UnconvertCoord(coords[i]);
+            BOOST_TEST(unconverted[i].x == expected.x);
+            BOOST_TEST(unconverted[i].y == expected.y);
+        }
+    }
+}
@@ -0,0 +1,65 @@
+/*
+ * Copyright 2022 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <meazure/profile/Profile.h>
+#include <vector>
+#include <utility>
+
+
+/// Profile that records the integer values written to it. Reading an integer returns the most recently written
+/// value for the key, or the default value if the key has not been written.
+///
+class MockProfile : public MeaProfile {
+
+public:
+    bool WriteBool(PCTSTR, bool) override { return true; }
+
+    bool WriteInt(PCTSTR key, int value) override {
+        m_values.emplace_back(key, value);
+        return true;
+    }
+
+    bool WriteDbl(PCTSTR, double) override { return true; }
+
+    bool WriteStr(PCTSTR, PCTSTR) override { return true; }
+
+    bool ReadBool(PCTSTR, bool defaultValue) override { return defaultValue; }
+
+    UINT ReadInt(PCTSTR key, int defaultValue) override {
+        for (auto iter = m_values.rbegin(); iter != m_values.rend(); ++iter) {
+            if (iter->first == key) {
+                return iter->second;
+            }
+        }
+        return defaultValue;
+    }
+
+    double ReadDbl(PCTSTR, double defaultValue) override { return defaultValue; }
+
+    CString ReadStr(PCTSTR, PCTSTR defaultValue) override { return defaultValue; }
+
+    bool UserInitiated() override { return false; }
+
+    int GetVersion() override { return 1; }
+
+
+    std::vector<std::pair<CString, int>> m_values;     ///< Integer values in the order they were written.
+};
@@ -51,6 +51,16 @@ public:
         return m_getString(section, entry, defaultValue);
     }
 
+    BOOL ReadSection(PCTSTR section, MeaRegistryValues& values) override {
+        m_readSectionCount++;
+        return m_readSection(section, values);
+    }
+
+    BOOL WriteSection(PCTSTR section, const MeaRegistryValues& values) override {
+        m_writeSectionCount++;
+        return m_writeSection(section, values);
+    }
+
     PCTSTR GetKeyName() override {
         return _T("cthing");
     }
@@ -70,6 +80,8 @@ public:
         m_writeStringCount = 0;
         m_getIntCount = 0;
         m_getStringCount = 0;
+        m_readSectionCount = 0;
+        m_writeSectionCount = 0;
         m_openKeyCount = 0;
         m_closeKeyCount = 0;
 
@@ -89,6 +101,14 @@ public:
             BOOST_FAIL("GetString callback not provided");
             return _T("");
         };
+        m_readSection = [](PCTSTR, MeaRegistryValues&) {
+            BOOST_FAIL("ReadSection callback not provided");
+            return TRUE;
+        };
+        m_writeSection = [](PCTSTR, const MeaRegistryValues&) {
+            BOOST_FAIL("WriteSection callback not provided");
+            return TRUE;
+        };
         m_openKey = [](HKEY, PCTSTR, DWORD, REGSAM, PHKEY) {
             BOOST_FAIL("OpenKey callback not provided");
             return ERROR_SUCCESS;
@@ -110,6 +130,12 @@ public:
         m_getStringNoop = [](PCTSTR, PCTSTR, PCTSTR) {
             return _T("");
         };
+        m_readSectionNoop = [](PCTSTR, MeaRegistryValues&) {
+            return FALSE;
+        };
+        m_writeSectionNoop = [](PCTSTR, const MeaRegistryValues&) {
+            return TRUE;
+        };
         m_openKeyNoop = [](HKEY, PCTSTR, DWORD, REGSAM, PHKEY) {
             return ERROR_SUCCESS;
         };
@@ -123,6 +149,8 @@ public:
     int m_writeStringCount;
     int m_getIntCount;
     int m_getStringCount;
+    int m_readSectionCount;
+    int m_writeSectionCount;
     int m_openKeyCount;
     int m_closeKeyCount;
 
@@ -130,6 +158,8 @@ public:
     std::function<BOOL(PCTSTR, PCTSTR, PCTSTR)> m_writeString;
     std::function<UINT(PCTSTR, PCTSTR, int)> m_getInt;
     std::function<CString(PCTSTR, PCTSTR, PCTSTR)> m_getString;
+    std::function<BOOL(PCTSTR, MeaRegistryValues&)> m_readSection;
+    std::function<BOOL(PCTSTR, const MeaRegistryValues&)> m_writeSection;
     std::function<LSTATUS(HKEY, PCTSTR, DWORD, REGSAM, PHKEY)> m_openKey;
     std::function<LSTATUS(HKEY)> m_closeKey;
 
@@ -137,6 +167,8 @@ public:
     std::function<BOOL(PCTSTR, PCTSTR, PCTSTR)> m_writeStringNoop;
     std::function<UINT(PCTSTR, PCTSTR, int)> m_getIntNoop;
     std::function<CString(PCTSTR, PCTSTR, PCTSTR)> m_getStringNoop;
+    std::function<BOOL(PCTSTR, MeaRegistryValues&)> m_readSectionNoop;
+    std::function<BOOL(PCTSTR, const MeaRegistryValues&)> m_writeSectionNoop;
     std::function<LSTATUS(HKEY, PCTSTR, DWORD, REGSAM, PHKEY)> m_openKeyNoop;
     std::function<LSTATUS(HKEY)> m_closeKeyNoop;
 };
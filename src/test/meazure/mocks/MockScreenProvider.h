@@ -118,6 +118,10 @@ public:
         return limitPt;
     }
 
+    virtual unsigned int GetLayoutVersion() const override {
+        return 0;
+    }
+
     static void ChangeLabel(MeaLinearUnitsId unitsId, const CString& label) {
         changeLabelCalled = true;
         changeLabelUnits = unitsId;
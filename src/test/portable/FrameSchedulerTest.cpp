@@ -0,0 +1,180 @@
+/*
+ * Copyright 2022 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "pch.h"
+#define BOOST_TEST_MODULE FrameSchedulerTest
+#include "GlobalFixture.h"
+#include <boost/test/unit_test.hpp>
+#include <meazure/utilities/FrameScheduler.h>
+#include <vector>
+#include <string>
+
+
+namespace {
+    /// Backend that records the operations performed on windows.
+    ///
+    class FakeBackend : public MeaFrameScheduler::Backend {
+
+    public:
+        void RequestFrame() override { m_frameRequests++; }
+
+        void MoveWindows(const MeaFrameScheduler::Update* updates, std::size_t count) override {
+            m_batches.emplace_back(updates, updates + count);
+            m_log.push_back("move");
+        }
+
+        void RepaintWindow(MeaFrameScheduler::WindowId window) override {
+            m_repaints.push_back(window);
+            m_log.push_back("repaint");
+        }
+
+        int m_frameRequests { 0 };
+        std::vector<std::vector<MeaFrameScheduler::Update>> m_batches;
+        std::vector<MeaFrameScheduler::WindowId> m_repaints;
+        std::vector<std::string> m_log;
+    };
+
+    int window1;
+    int window2;
+    int window3;
+}
+
+
+BOOST_AUTO_TEST_CASE(TestCoalesce) {
+    FakeBackend backend;
+    MeaFrameScheduler scheduler(backend);
+
+    BOOST_TEST(!scheduler.HasPending());
+
+    scheduler.Move(&window1, 10, 20);
+    scheduler.Move(&window2, 30, 40);
+    scheduler.Move(&window1, 11, 21);
+    scheduler.Repaint(&window1);
+    scheduler.Repaint(&window1);
+    scheduler.Repaint(&window3);
+
+    // Nothing is applied until the frame starts, and only one frame is requested.
+    BOOST_TEST(scheduler.HasPending());
+    BOOST_TEST(backend.m_frameRequests == 1);
+    BOOST_TEST(backend.m_batches.empty());
+
+    scheduler.OnFrame();
+
+    // All moves in one batch, latest position per window, then repaints.
+    BOOST_TEST_REQUIRE(backend.m_batches.size() == 1U);
+    const std::vector<MeaFrameScheduler::Update>& batch = backend.m_batches[0];
+    BOOST_TEST_REQUIRE(batch.size() == 2U);
+    BOOST_TEST(batch[0].m_window == &window1);
+    BOOST_TEST(batch[0].m_x == 11);
+    BOOST_TEST(batch[0].m_y == 21);
+    BOOST_TEST(batch[1].m_window == &window2);
+    BOOST_TEST(batch[1].m_x == 30);
+
+    BOOST_TEST(backend.m_repaints == std::vector<MeaFrameScheduler::WindowId>({ &window1, &window3 }));
+    BOOST_TEST(backend.m_log == std::vector<std::string>({ "move", "repaint", "repaint" }));
+    BOOST_TEST(!scheduler.HasPending());
+
+    const MeaFrameScheduler::Metrics& metrics = scheduler.GetMetrics();
+    BOOST_TEST(metrics.m_frames == 1U);
+    BOOST_TEST(metrics.m_requestedMoves == 3U);
+    BOOST_TEST(metrics.m_appliedMoves == 2U);
+    BOOST_TEST(metrics.m_requestedRepaints == 3U);
+    BOOST_TEST(metrics.m_appliedRepaints == 2U);
+    BOOST_TEST(metrics.m_lastUpdatesPerFrame == 3U);
+    BOOST_TEST(metrics.m_maxUpdatesPerFrame == 3U);
+}
+
+BOOST_AUTO_TEST_CASE(TestFrames) {
+    FakeBackend backend;
+    MeaFrameScheduler scheduler(backend);
+
+    // An empty frame does nothing.
+    scheduler.OnFrame();
+    BOOST_TEST(scheduler.GetMetrics().m_frames == 0U);
+
+    scheduler.Repaint(&window1);
+    scheduler.OnFrame();
+    BOOST_TEST(backend.m_batches.empty());          // No moves so no batch
+    BOOST_TEST(backend.m_repaints.size() == 1U);
+
+    // A new frame is requested after the previous one has started.
+    scheduler.Move(&window2, 1, 2);
+    BOOST_TEST(backend.m_frameRequests == 2);
+    scheduler.OnFrame();
+
+    const MeaFrameScheduler::Metrics& metrics = scheduler.GetMetrics();
+    BOOST_TEST(metrics.m_frames == 2U);
+    BOOST_TEST(metrics.m_lastUpdatesPerFrame == 1U);
+
+    scheduler.ResetMetrics();
+    BOOST_TEST(scheduler.GetMetrics().m_frames == 0U);
+}
+
+BOOST_AUTO_TEST_CASE(TestFlushAndRemove) {
+    FakeBackend backend;
+    MeaFrameScheduler scheduler(backend);
+
+    scheduler.Move(&window1, 1, 1);
+    scheduler.Move(&window2, 2, 2);
+    scheduler.Remove(&window1);
+    scheduler.Flush();
+
+    BOOST_TEST_REQUIRE(backend.m_batches.size() == 1U);
+    BOOST_TEST_REQUIRE(backend.m_batches[0].size() == 1U);
+    BOOST_TEST(backend.m_batches[0][0].m_window == &window2);
+
+    // The frame requested before the flush finds nothing left to do.
+    scheduler.OnFrame();
+    BOOST_TEST(backend.m_batches.size() == 1U);
+    BOOST_TEST(scheduler.GetMetrics().m_frames == 1U);
+}
+
+BOOST_AUTO_TEST_CASE(TestReentrantUpdates) {
+    /// Backend whose window operations request more updates, as a window procedure might.
+    ///
+    class ReentrantBackend : public FakeBackend {
+    public:
+        explicit ReentrantBackend(MeaFrameScheduler*& scheduler) : m_scheduler(scheduler) {}
+
+        void RepaintWindow(MeaFrameScheduler::WindowId window) override {
+            FakeBackend::RepaintWindow(window);
+            m_scheduler->Move(&window3, 5, 5);
+            m_scheduler->Flush();
+        }
+
+        MeaFrameScheduler*& m_scheduler;
+    };
+
+    MeaFrameScheduler* schedulerPtr = nullptr;
+    ReentrantBackend backend(schedulerPtr);
+    MeaFrameScheduler scheduler(backend);
+    schedulerPtr = &scheduler;
+
+    scheduler.Repaint(&window1);
+    scheduler.OnFrame();
+
+    // The move requested while repainting waits for the next frame.
+    BOOST_TEST(backend.m_batches.empty());
+    BOOST_TEST(scheduler.HasPending());
+    BOOST_TEST(backend.m_frameRequests == 2);
+
+    scheduler.OnFrame();
+    BOOST_TEST_REQUIRE(backend.m_batches.size() == 1U);
+    BOOST_TEST(backend.m_batches[0][0].m_window == &window3);
+}
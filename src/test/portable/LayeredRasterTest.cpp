@@ -0,0 +1,236 @@
+/*
+ * Copyright 2022 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "pch.h"
+#define BOOST_TEST_MODULE LayeredRasterTest
+#include "GlobalFixture.h"
+#include <boost/test/unit_test.hpp>
+#include <meazure/graphics/LayeredRaster.h>
+#include <vector>
+#include <string>
+#include <utility>
+
+typedef MeaLayeredRaster::Pixel Pixel;
+typedef MeaLayeredRaster::Image Image;
+
+
+namespace {
+    struct Buffer {
+        Buffer(int width, int height, Pixel fill = 0x12345678) :
+            pixels(static_cast<size_t>(width) * height, fill),
+            image { pixels.data(), width, height, width } {}
+
+        std::vector<Pixel> pixels;
+        Image image;
+    };
+
+    // Renders the image as text, one character per pixel, using the specified legend. Pixels not in the
+    // legend are rendered as '?'.
+    std::string ToText(const Image& image, const std::vector<std::pair<Pixel, char>>& legend) {
+        std::string text;
+        for (int y = 0; y < image.m_height; y++) {
+            for (int x = 0; x < image.m_width; x++) {
+                char c = '?';
+                for (const auto& entry : legend) {
+                    if (entry.first == image.Row(y)[x]) {
+                        c = entry.second;
+                        break;
+                    }
+                }
+                text += c;
+            }
+            text += '\n';
+        }
+        return text;
+    }
+
+    // Builds a content image from text, one character per pixel, using the specified legend.
+    Buffer FromText(const std::vector<std::string>& rows, const std::vector<std::pair<char, Pixel>>& legend) {
+        Buffer buffer(static_cast<int>(rows[0].size()), static_cast<int>(rows.size()));
+        for (int y = 0; y < buffer.image.m_height; y++) {
+            for (int x = 0; x < buffer.image.m_width; x++) {
+                for (const auto& entry : legend) {
+                    if (entry.first == rows[y][x]) {
+                        buffer.image.Row(y)[x] = entry.second;
+                    }
+                }
+            }
+        }
+        return buffer;
+    }
+
+    // Builds a mask from text, one character per mask value, using the specified legend.
+    std::vector<unsigned char> MaskFromText(const std::vector<std::string>& rows,
+                                            const std::vector<std::pair<char, unsigned char>>& legend) {
+        std::vector<unsigned char> mask;
+        for (const std::string& row : rows) {
+            for (char c : row) {
+                unsigned char value = 0;
+                for (const auto& entry : legend) {
+                    if (entry.first == c) {
+                        value = entry.second;
+                    }
+                }
+                mask.push_back(value);
+            }
+        }
+        return mask;
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(TestPremultiply) {
+    BOOST_TEST(MeaLayeredRaster::Premultiply(0x00FF8000, 255) == 0xFFFF8000U);
+    BOOST_TEST(MeaLayeredRaster::Premultiply(0xAAFF8000, 0) == 0U);
+    BOOST_TEST(MeaLayeredRaster::Premultiply(0x00FF8001, 128) == 0x80804001U);
+    BOOST_TEST(MeaLayeredRaster::FromColorRef(0x00112233) == 0x00332211U);
+
+    for (std::uint32_t c = 0; c < 256; c++) {
+        for (std::uint32_t a = 0; a < 256; a++) {
+            Pixel pixel = MeaLayeredRaster::Premultiply(c | (c << 8) | (c << 16), static_cast<std::uint8_t>(a));
+            std::uint32_t expected = (c * a + 127) / 255;
+            BOOST_TEST(pixel == ((a << 24) | (expected << 16) | (expected << 8) | expected));
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(TestSub) {
+    Buffer buffer(6, 4);
+    Image sub = buffer.image.Sub(4, 1, 5, 2);
+    BOOST_TEST(sub.m_width == 2);
+    BOOST_TEST(sub.m_height == 2);
+    BOOST_TEST(sub.m_pixels == buffer.image.Row(1) + 4);
+
+    MeaLayeredRaster::Fill(buffer.image, 0);
+    MeaLayeredRaster::Fill(sub, 1);
+    BOOST_TEST(ToText(buffer.image, { { 0, '.' }, { 1, '#' } }) ==
+        "......\n"
+        "....##\n"
+        "....##\n"
+        "......\n");
+
+    BOOST_TEST(buffer.image.Sub(-3, 0, 2, 2).m_width == 0);
+    BOOST_TEST(buffer.image.Sub(0, 4, 2, 2).m_height == 0);
+}
+
+BOOST_AUTO_TEST_CASE(TestRenderMask) {
+    // Mask of an 11x11 crosshair with a spread of 2, with 0 outside, 1 inside and 2 on the border.
+    std::vector<unsigned char> mask = MaskFromText({
+        "...22222...",
+        "....212....",
+        ".....2.....",
+        "2.........2",
+        "22.......22",
+        "212.....212",
+        "22.......22",
+        "2.........2",
+        ".....2.....",
+        "....212....",
+        "...22222..." }, { { '.', 0 }, { '1', 1 }, { '2', 2 } });
+
+    const Pixel back = MeaLayeredRaster::Premultiply(0x0000FF, 255);
+    const Pixel border = MeaLayeredRaster::Premultiply(0xFF0000, 255);
+    const Pixel palette[] = { 0, back, border };
+
+    Buffer buffer(11, 11);
+    MeaLayeredRaster::RenderMask(buffer.image, mask.data(), 11, palette, 3);
+
+    BOOST_TEST(ToText(buffer.image, { { 0, '.' }, { back, 'o' }, { border, '#' } }) ==
+        "...#####...\n"
+        "....#o#....\n"
+        ".....#.....\n"
+        "#.........#\n"
+        "##.......##\n"
+        "#o#.....#o#\n"
+        "##.......##\n"
+        "#.........#\n"
+        ".....#.....\n"
+        "....#o#....\n"
+        "...#####...\n");
+
+    // Mask values without a palette entry are transparent.
+    MeaLayeredRaster::RenderMask(buffer.image, mask.data(), 11, palette, 2);
+    BOOST_TEST(buffer.image.Row(0)[3] == 0U);
+    BOOST_TEST(buffer.image.Row(1)[5] == back);
+}
+
+BOOST_AUTO_TEST_CASE(TestApplyOpacity) {
+    const Pixel white = 0xFFFFFF;
+    const Pixel black = 0x000000;
+    Buffer content = FromText({
+        "WWWW",
+        "WBBW",
+        "WWWW" }, { { 'W', white | 0xAB000000 }, { 'B', black } });
+    Buffer buffer(4, 3);
+
+    MeaLayeredRaster::ApplyOpacity(buffer.image, content.image, 255);
+    BOOST_TEST(ToText(buffer.image, { { 0xFFFFFFFF, 'W' }, { 0xFF000000, 'B' } }) ==
+        "WWWW\n"
+        "WBBW\n"
+        "WWWW\n");
+
+    const Pixel halfWhite = MeaLayeredRaster::Premultiply(white, 128);
+    const Pixel halfBlack = MeaLayeredRaster::Premultiply(black, 128);
+    MeaLayeredRaster::ApplyOpacity(buffer.image, content.image, 128);
+    BOOST_TEST(ToText(buffer.image, { { halfWhite, 'w' }, { halfBlack, 'b' } }) ==
+        "wwww\n"
+        "wbbw\n"
+        "wwww\n");
+
+    MeaLayeredRaster::ApplyOpacity(buffer.image, content.image, 0);
+    BOOST_TEST(ToText(buffer.image, { { 0, '.' } }) ==
+        "....\n"
+        "....\n"
+        "....\n");
+}
+
+BOOST_AUTO_TEST_CASE(TestApplyOpacityDottedXor) {
+    const Pixel white = 0xFFFFFF;
+    const Pixel red = 0xFF0000;
+    Buffer content = FromText({
+        "WWWWW",
+        "WWWWW",
+        "WWWWW",
+        "WWWWW" }, { { 'W', white } });
+    Buffer buffer(5, 4);
+    MeaLayeredRaster::ApplyOpacity(buffer.image, content.image, 255);
+
+    // Vertical indicator in column 1, horizontal indicator in row 3.
+    MeaLayeredRaster::ApplyOpacityDottedXor(buffer.image.Sub(1, 0, 1, 4), content.image.Sub(1, 0, 1, 4), 255, red);
+    MeaLayeredRaster::ApplyOpacityDottedXor(buffer.image.Sub(0, 3, 5, 1), content.image.Sub(0, 3, 5, 1), 255, red);
+
+    const Pixel cyan = 0xFF00FFFF;
+    BOOST_TEST(ToText(buffer.image, { { 0xFFFFFFFF, 'W' }, { cyan, 'c' } }) ==
+        "WcWWW\n"
+        "WWWWW\n"
+        "WcWWW\n"
+        "cWcWc\n");
+
+    // Restoring a line from the content removes its indicator.
+    MeaLayeredRaster::ApplyOpacity(buffer.image.Sub(0, 3, 5, 1), content.image.Sub(0, 3, 5, 1), 255);
+    BOOST_TEST(ToText(buffer.image, { { 0xFFFFFFFF, 'W' }, { cyan, 'c' } }) ==
+        "WcWWW\n"
+        "WWWWW\n"
+        "WcWWW\n"
+        "WWWWW\n");
+
+    MeaLayeredRaster::ApplyOpacityDottedXor(buffer.image.Sub(1, 0, 1, 4), content.image.Sub(1, 0, 1, 4), 128, red);
+    BOOST_TEST(buffer.image.Row(0)[1] == MeaLayeredRaster::Premultiply(0x00FFFF, 128));
+    BOOST_TEST(buffer.image.Row(1)[1] == MeaLayeredRaster::Premultiply(white, 128));
+}
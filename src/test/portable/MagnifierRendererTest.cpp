@@ -0,0 +1,275 @@
+/*
+ * Copyright 2022 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "pch.h"
+#define BOOST_TEST_MODULE MagnifierRendererTest
+#include "GlobalFixture.h"
+#include <boost/test/unit_test.hpp>
+#include <meazure/graphics/MagnifierRenderer.h>
+#include <vector>
+#include <string>
+#include <algorithm>
+
+typedef MeaMagnifierRenderer::Pixel Pixel;
+typedef MeaMagnifierRenderer::Image Image;
+
+
+namespace {
+    struct Buffer {
+        Buffer(int width, int height, int stride = 0, Pixel fill = 0x123456) :
+            pixels(static_cast<size_t>(height) * (stride == 0 ? width : stride), fill),
+            image { pixels.data(), width, height, (stride == 0 ? width : stride) } {}
+
+        std::vector<Pixel> pixels;
+        Image image;
+    };
+
+    // Renders the image as text, one character per pixel, using the specified legend. Pixels not in the
+    // legend are rendered as '?'.
+    std::string ToText(const Image& image, const std::vector<std::pair<Pixel, char>>& legend) {
+        std::string text;
+        for (int y = 0; y < image.m_height; y++) {
+            for (int x = 0; x < image.m_width; x++) {
+                char c = '?';
+                for (const auto& entry : legend) {
+                    if (entry.first == image.Row(y)[x]) {
+                        c = entry.second;
+                        break;
+                    }
+                }
+                text += c;
+            }
+            text += '\n';
+        }
+        return text;
+    }
+
+    const Pixel kA = 0x0000AA;
+    const Pixel kB = 0x00BB00;
+    const Pixel kC = 0xCC0000;
+    const Pixel kD = 0xDDDDDD;
+
+    // Straightforward rendering in the manner of the original GDI implementation: scale, then frame, then grid,
+    // then center marker.
+    void ReferenceRender(const Image& src, const Image& dst, bool showGrid) {
+        auto xEdge = [&](int i) { return i * dst.m_width / src.m_width; };
+        auto yEdge = [&](int i) { return i * dst.m_height / src.m_height; };
+        auto set = [&](int x, int y, Pixel color) {
+            if (x >= 0 && x < dst.m_width && y >= 0 && y < dst.m_height) {
+                dst.Row(y)[x] = color;
+            }
+        };
+        auto frameRect = [&](int left, int top, int right, int bottom, Pixel color) {
+            for (int x = left; x < right; x++) {
+                set(x, top, color);
+                set(x, bottom - 1, color);
+            }
+            for (int y = top; y < bottom; y++) {
+                set(left, y, color);
+                set(right - 1, y, color);
+            }
+        };
+
+        for (int sy = 0; sy < src.m_height; sy++) {
+            for (int sx = 0; sx < src.m_width; sx++) {
+                for (int y = yEdge(sy); y < yEdge(sy + 1); y++) {
+                    for (int x = xEdge(sx); x < xEdge(sx + 1); x++) {
+                        set(x, y, src.Row(sy)[sx]);
+                    }
+                }
+            }
+        }
+
+        frameRect(0, 0, dst.m_width, dst.m_height, MeaMagnifierRenderer::kFrameColor);
+
+        if (showGrid) {
+            for (int sx = 0; sx < src.m_width; sx++) {
+                for (int y = 0; y < dst.m_height; y++) {
+                    set(xEdge(sx), y, MeaMagnifierRenderer::kFrameColor);
+                }
+            }
+            for (int sy = 0; sy < src.m_height; sy++) {
+                for (int x = 0; x < dst.m_width; x++) {
+                    set(x, yEdge(sy), MeaMagnifierRenderer::kFrameColor);
+                }
+            }
+        }
+
+        int cx = src.m_width / 2;
+        int cy = src.m_height / 2;
+        frameRect(xEdge(cx), yEdge(cy), xEdge(cx + 1) + 1, yEdge(cy + 1) + 1, MeaMagnifierRenderer::kMarkerColor);
+    }
+
+    const std::vector<std::pair<Pixel, char>> kLegend = {
+        { MeaMagnifierRenderer::kFrameColor, '#' },
+        { MeaMagnifierRenderer::kMarkerColor, 'r' },
+        { kA, 'a' }, { kB, 'b' }, { kC, 'c' }, { kD, 'd' }
+    };
+}
+
+
+BOOST_AUTO_TEST_CASE(TestToColorRef) {
+    BOOST_TEST(MeaMagnifierRenderer::ToColorRef(0x112233) == 0x332211U);
+    BOOST_TEST(MeaMagnifierRenderer::ToColorRef(0xFF0000) == 0x0000FFU);
+}
+
+BOOST_AUTO_TEST_CASE(TestClearOutside) {
+    Buffer buffer(4, 3, 0, kA);
+
+    MeaMagnifierRenderer::ClearOutside(buffer.image, 1, 1, 3, 5);
+
+    BOOST_TEST(ToText(buffer.image, kLegend) ==
+        "####\n"
+        "#aa#\n"
+        "#aa#\n");
+
+    Buffer none(2, 2, 0, kA);
+    MeaMagnifierRenderer::ClearOutside(none.image, 5, 5, 6, 6);
+    BOOST_TEST(ToText(none.image, kLegend) == "##\n##\n");
+}
+
+BOOST_AUTO_TEST_CASE(TestRenderNoGrid) {
+    Buffer src(3, 3);
+    Pixel srcPixels[] = { kA, kB, kA, kB, kD, kB, kC, kB, kC };
+    std::copy(std::begin(srcPixels), std::end(srcPixels), src.pixels.begin());
+
+    Buffer dst(12, 12);
+    MeaMagnifierRenderer renderer;
+    renderer.Render(src.image, dst.image, false);
+
+    BOOST_TEST(ToText(dst.image, kLegend) ==
+        "############\n"
+        "#aaabbbbaaa#\n"
+        "#aaabbbbaaa#\n"
+        "#aaabbbbaaa#\n"
+        "#bbbrrrrrbb#\n"
+        "#bbbrdddrbb#\n"
+        "#bbbrdddrbb#\n"
+        "#bbbrdddrbb#\n"
+        "#cccrrrrrcc#\n"
+        "#cccbbbbccc#\n"
+        "#cccbbbbccc#\n"
+        "############\n");
+}
+
+BOOST_AUTO_TEST_CASE(TestRenderGrid) {
+    Buffer src(3, 3);
+    Pixel srcPixels[] = { kA, kB, kA, kB, kD, kB, kC, kB, kC };
+    std::copy(std::begin(srcPixels), std::end(srcPixels), src.pixels.begin());
+
+    Buffer dst(12, 12);
+    MeaMagnifierRenderer renderer;
+    renderer.Render(src.image, dst.image, true);
+
+    BOOST_TEST(ToText(dst.image, kLegend) ==
+        "############\n"
+        "#aaa#bbb#aa#\n"
+        "#aaa#bbb#aa#\n"
+        "#aaa#bbb#aa#\n"
+        "####rrrrr###\n"
+        "#bbbrdddrbb#\n"
+        "#bbbrdddrbb#\n"
+        "#bbbrdddrbb#\n"
+        "####rrrrr###\n"
+        "#ccc#bbb#cc#\n"
+        "#ccc#bbb#cc#\n"
+        "############\n");
+}
+
+BOOST_AUTO_TEST_CASE(TestRenderStride) {
+    Buffer src(3, 3, 5);
+    for (int y = 0; y < 3; y++) {
+        std::fill(src.image.Row(y), src.image.Row(y) + 3, kD);
+    }
+
+    Buffer dst(6, 6, 8, kA);
+    MeaMagnifierRenderer renderer;
+    renderer.Render(src.image, dst.image, false);
+
+    BOOST_TEST(ToText(dst.image, kLegend) ==
+        "######\n"
+        "#dddd#\n"
+        "#drrr#\n"
+        "#drdr#\n"
+        "#drrr#\n"
+        "######\n");
+
+    // Pixels beyond the width of the destination are untouched.
+    for (int y = 0; y < 6; y++) {
+        BOOST_TEST(dst.image.Row(y)[6] == kA);
+        BOOST_TEST(dst.image.Row(y)[7] == kA);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(TestRenderResize) {
+    MeaMagnifierRenderer renderer;
+
+    Buffer src1(1, 1, 0, kD);
+    Buffer dst1(4, 4);
+    renderer.Render(src1.image, dst1.image, true);
+
+    // The marker is clipped at the right and bottom edges, where the frame remains.
+    BOOST_TEST(ToText(dst1.image, kLegend) ==
+        "rrrr\n"
+        "rdd#\n"
+        "rdd#\n"
+        "r###\n");
+
+    Buffer src2(2, 2, 0, kD);
+    Buffer dst2(4, 4);
+    renderer.Render(src2.image, dst2.image, true);
+
+    BOOST_TEST(ToText(dst2.image, kLegend) ==
+        "####\n"
+        "#d##\n"
+        "##rr\n"
+        "##r#\n");
+}
+
+BOOST_AUTO_TEST_CASE(TestRenderMatchesReference) {
+    const int zoomFactors[] = { 1, 2, 3, 4, 6, 8, 16, 32 };
+    const int widths[] = { 97, 128, 255 };
+
+    MeaMagnifierRenderer renderer;
+
+    for (int width : widths) {
+        for (int zoom : zoomFactors) {
+            // Sized as by the magnifier
+            int srcLen = std::max((width / zoom) / 2, 1);
+            int srcWidth = 2 * srcLen - 1;
+
+            Buffer src(srcWidth, srcWidth);
+            for (size_t i = 0; i < src.pixels.size(); i++) {
+                src.pixels[i] = static_cast<Pixel>(i * 2654435761U) & 0xFFFFFF;
+            }
+
+            for (bool showGrid : { false, true }) {
+                Buffer expected(width, width, width + 3);
+                ReferenceRender(src.image, expected.image, showGrid);
+
+                Buffer actual(width, width, width + 3);
+                renderer.Render(src.image, actual.image, showGrid);
+
+                BOOST_TEST_CONTEXT("width " << width << " zoom " << zoom << " grid " << showGrid) {
+                    BOOST_TEST((actual.pixels == expected.pixels));
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,170 @@
+/*
+ * Copyright 2022 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "pch.h"
+#define BOOST_TEST_MODULE NumberFormatTest
+#include "GlobalFixture.h"
+#include <boost/test/unit_test.hpp>
+#include <meazure/utilities/NumberFormat.h>
+#include <string>
+#include <cstdio>
+#include <cfloat>
+#include <climits>
+#include <charconv>
+#include <cmath>
+#include <vector>
+
+
+namespace {
+    std::string PrintfFixed(double value, int precision) {
+        char buffer[512];
+        int len = std::snprintf(buffer, sizeof(buffer), "%.*f", precision, value);
+        return std::string(buffer, len);
+    }
+
+    const double testValues[] = {
+        0.0, -0.0, 1.0, -1.0, 0.5, 1.5, 2.5, -2.5, 0.125, 0.05, 0.15, 0.25, 0.35, 1.005, 2.675, 123.456,
+        -123.456, 1.0 / 3.0, 2.0 / 3.0, 96.0, 72.0 / 96.0, 2.54 / 96.0, 25.4 / 110.0, 1440.0 / 120.0, 999.9995,
+        -0.0004, 1e-7, 1e15, 123456789.987654321, 4294967296.5, DBL_MAX, DBL_MIN, DBL_EPSILON
+    };
+}
+
+
+BOOST_AUTO_TEST_CASE(TestFormatFixed) {
+    MeaNumberFormat::Buffer buffer;
+
+    BOOST_TEST(MeaNumberFormat::FormatFixed(buffer, 123.456, 2) == "123.46");
+    BOOST_TEST(MeaNumberFormat::FormatFixed(buffer, -123.456, 1) == "-123.5");
+    BOOST_TEST(MeaNumberFormat::FormatFixed(buffer, 10.0, 0) == "10");
+    BOOST_TEST(MeaNumberFormat::FormatFixed(buffer, 0.0, 3) == "0.000");
+    BOOST_TEST(MeaNumberFormat::FormatFixed(buffer, 1.5, -1) == "1.500000");
+}
+
+BOOST_AUTO_TEST_CASE(TestFormatFixedMatchesPrintf) {
+    MeaNumberFormat::Buffer buffer;
+
+    for (double value : testValues) {
+        for (int precision = 0; precision <= MeaNumberFormat::kMaxPrecision; precision++) {
+            BOOST_TEST(MeaNumberFormat::FormatFixed(buffer, value, precision) == PrintfFixed(value, precision));
+        }
+    }
+
+    for (int i = -100000; i <= 100000; i += 7) {
+        double value = i / 1000.0;
+        for (int precision = 0; precision <= 4; precision++) {
+            BOOST_TEST(MeaNumberFormat::FormatFixed(buffer, value, precision) == PrintfFixed(value, precision));
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(TestFormatShortest) {
+    MeaNumberFormat::Buffer buffer;
+
+    BOOST_TEST(MeaNumberFormat::FormatShortest(buffer, 0.1) == "0.1");
+    BOOST_TEST(MeaNumberFormat::FormatShortest(buffer, -2.5) == "-2.5");
+    BOOST_TEST(MeaNumberFormat::FormatShortest(buffer, 100.0) == "100");
+
+    for (double value : testValues) {
+        std::string_view str = MeaNumberFormat::FormatShortest(buffer, value);
+        double parsed = 0.0;
+        std::from_chars(str.data(), str.data() + str.size(), parsed);
+        BOOST_TEST(parsed == value);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(TestFormatTrimmed) {
+    MeaNumberFormat::Buffer buffer;
+
+    BOOST_TEST(MeaNumberFormat::FormatTrimmed(buffer, 123.456) == "123.456");
+    BOOST_TEST(MeaNumberFormat::FormatTrimmed(buffer, -123.456) == "-123.456");
+    BOOST_TEST(MeaNumberFormat::FormatTrimmed(buffer, 10.0) == "10.0");
+    BOOST_TEST(MeaNumberFormat::FormatTrimmed(buffer, 0.0) == "0.0");
+    BOOST_TEST(MeaNumberFormat::FormatTrimmed(buffer, 0.1) == "0.1");
+    BOOST_TEST(MeaNumberFormat::FormatTrimmed(buffer, 1e-20) == "0.0");
+}
+
+BOOST_AUTO_TEST_CASE(TestFormatInt) {
+    MeaNumberFormat::Buffer buffer;
+
+    BOOST_TEST(MeaNumberFormat::FormatInt(buffer, 0) == "0");
+    BOOST_TEST(MeaNumberFormat::FormatInt(buffer, 10) == "10");
+    BOOST_TEST(MeaNumberFormat::FormatInt(buffer, -10) == "-10");
+    BOOST_TEST(MeaNumberFormat::FormatInt(buffer, INT_MAX) == "2147483647");
+    BOOST_TEST(MeaNumberFormat::FormatInt(buffer, INT_MIN) == "-2147483648");
+}
+
+BOOST_AUTO_TEST_CASE(TestSameFixed) {
+    BOOST_TEST(MeaNumberFormat::SameFixed(1.004, 1.0, 2));
+    BOOST_TEST(!MeaNumberFormat::SameFixed(1.006, 1.0, 2));
+    BOOST_TEST(MeaNumberFormat::SameFixed(0.125, 0.12, 2));       // Exact tie rounds to even
+    BOOST_TEST(!MeaNumberFormat::SameFixed(-0.001, 0.001, 2));    // "-0.00" and "0.00"
+    BOOST_TEST(MeaNumberFormat::SameFixed(-0.001, -0.0, 2));
+    BOOST_TEST(MeaNumberFormat::SameFixed(1.0, 1.0000004, -1));
+}
+
+BOOST_AUTO_TEST_CASE(TestSameFixedMatchesFormat) {
+    MeaNumberFormat::Buffer bufferA;
+    MeaNumberFormat::Buffer bufferB;
+
+    auto formatEqual = [&](double a, double b, int precision) {
+        return MeaNumberFormat::FormatFixed(bufferA, a, precision) ==
+               MeaNumberFormat::FormatFixed(bufferB, b, precision);
+    };
+
+    // Values around every rounding boundary, including exact and nearly exact ties, at every precision.
+    std::vector<double> values(std::begin(testValues), std::end(testValues));
+    for (int precision = 0; precision <= MeaNumberFormat::kMaxPrecision; precision++) {
+        double unit = std::pow(10.0, -precision);
+        for (int i = -25; i <= 25; i++) {
+            double boundary = (i + 0.5) * unit;
+            values.push_back(boundary);
+            values.push_back(std::nextafter(boundary, 0.0));
+            values.push_back(std::nextafter(boundary, 1e300));
+            values.push_back(i * unit);
+        }
+    }
+
+    for (int precision = -1; precision <= MeaNumberFormat::kMaxPrecision + 1; precision++) {
+        for (double a : values) {
+            for (double b : { a, std::nextafter(a, 0.0), std::nextafter(a, 1e300), -a, a + 0.5, a * 1.0000001 }) {
+                BOOST_TEST(MeaNumberFormat::SameFixed(a, b, precision) == formatEqual(a, b, precision));
+            }
+        }
+    }
+
+    // Multiples of the tick increments used by the rulers, compared with their neighbors.
+    for (int precision = 0; precision <= 6; precision++) {
+        for (double incr : { 0.01, 0.1, 0.25, 1.0 / 96.0, 2.54 / 96.0, 72.0 / 96.0, 1.0 / 3.0 }) {
+            for (int i = -2000; i <= 2000; i++) {
+                double a = i * incr;
+                double b = a + incr / 3.0;
+                BOOST_TEST(MeaNumberFormat::SameFixed(a, b, precision) == formatEqual(a, b, precision));
+                BOOST_TEST(MeaNumberFormat::SameFixed(a, a + 1e-9, precision) == formatEqual(a, a + 1e-9, precision));
+            }
+        }
+    }
+
+    double a[] = { 1.004, 1.006, 0.125, -0.001 };
+    double b[] = { 1.0, 1.0, 0.12, 0.001 };
+    bool results[4];
+    MeaNumberFormat::SameFixed(a, b, results, 4, 2);
+    for (int i = 0; i < 4; i++) {
+        BOOST_TEST(results[i] == formatEqual(a[i], b[i], 2));
+    }
+}
@@ -0,0 +1,105 @@
+/*
+ * Copyright 2022 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "pch.h"
+#define BOOST_TEST_MODULE NumberParseTest
+#include "GlobalFixture.h"
+#include <boost/test/unit_test.hpp>
+#include <meazure/utilities/NumberParse.h>
+
+namespace bt = boost::unit_test;
+using MeaNumberParse::Result;
+
+BOOST_TEST_DONT_PRINT_LOG_VALUE(MeaNumberParse::Result)
+
+
+BOOST_AUTO_TEST_CASE(TestParseDbl, *bt::tolerance(1e-12)) {
+    double value = -1.0;
+
+    BOOST_TEST(MeaNumberParse::ParseDbl("123", value) == Result::Ok);
+    BOOST_TEST(value == 123.0);
+    BOOST_TEST(MeaNumberParse::ParseDbl("+123", value) == Result::Ok);
+    BOOST_TEST(value == 123.0);
+    BOOST_TEST(MeaNumberParse::ParseDbl("-123.5", value) == Result::Ok);
+    BOOST_TEST(value == -123.5);
+    BOOST_TEST(MeaNumberParse::ParseDbl("1.30", value) == Result::Ok);
+    BOOST_TEST(value == 1.3);
+    BOOST_TEST(MeaNumberParse::ParseDbl("1e3", value) == Result::Ok);
+    BOOST_TEST(value == 1000.0);
+    BOOST_TEST(MeaNumberParse::ParseDbl(".5", value) == Result::Ok);
+    BOOST_TEST(value == 0.5);
+
+    value = 7.0;
+    BOOST_TEST(MeaNumberParse::ParseDbl("", value) == Result::Empty);
+    BOOST_TEST(MeaNumberParse::ParseDbl("a123", value) == Result::Invalid);
+    BOOST_TEST(MeaNumberParse::ParseDbl(" 123", value) == Result::Invalid);
+    BOOST_TEST(MeaNumberParse::ParseDbl("+", value) == Result::Invalid);
+    BOOST_TEST(MeaNumberParse::ParseDbl("+-1", value) == Result::Invalid);
+    BOOST_TEST(MeaNumberParse::ParseDbl("123 ", value) == Result::TrailingChars);
+    BOOST_TEST(MeaNumberParse::ParseDbl("12a", value) == Result::TrailingChars);
+    BOOST_TEST(MeaNumberParse::ParseDbl("1e999", value) == Result::OutOfRange);
+    BOOST_TEST(value == 7.0);
+}
+
+BOOST_AUTO_TEST_CASE(TestParseDblWide, *bt::tolerance(1e-12)) {
+    double value = -1.0;
+
+    BOOST_TEST(MeaNumberParse::ParseDbl(L"-2.25", value) == Result::Ok);
+    BOOST_TEST(value == -2.25);
+    BOOST_TEST(MeaNumberParse::ParseDbl(L"2\u00B2", value) == Result::TrailingChars);
+    BOOST_TEST(MeaNumberParse::ParseDbl(L"", value) == Result::Empty);
+    BOOST_TEST(MeaNumberParse::ParseDbl(std::wstring(200, L'1'), value) == Result::OutOfRange);
+}
+
+BOOST_AUTO_TEST_CASE(TestParseInt) {
+    int value = -1;
+
+    BOOST_TEST(MeaNumberParse::ParseInt("0", value) == Result::Ok);
+    BOOST_TEST(value == 0);
+    BOOST_TEST(MeaNumberParse::ParseInt("+42", value) == Result::Ok);
+    BOOST_TEST(value == 42);
+    BOOST_TEST(MeaNumberParse::ParseInt("-42", value) == Result::Ok);
+    BOOST_TEST(value == -42);
+    BOOST_TEST(MeaNumberParse::ParseInt(L"17", value) == Result::Ok);
+    BOOST_TEST(value == 17);
+
+    BOOST_TEST(MeaNumberParse::ParseInt("4.2", value) == Result::TrailingChars);
+    BOOST_TEST(MeaNumberParse::ParseInt("99999999999", value) == Result::OutOfRange);
+    BOOST_TEST(MeaNumberParse::ParseInt("x", value) == Result::Invalid);
+    BOOST_TEST(value == 17);
+}
+
+BOOST_AUTO_TEST_CASE(TestToDbl, *bt::tolerance(1e-12)) {
+    BOOST_TEST(MeaNumberParse::ToDbl("123.5") == 123.5);
+    BOOST_TEST(MeaNumberParse::ToDbl("  \t-0.25") == -0.25);
+    BOOST_TEST(MeaNumberParse::ToDbl("+3.5mm") == 3.5);
+    BOOST_TEST(MeaNumberParse::ToDbl(L" 96.0 ") == 96.0);
+    BOOST_TEST(MeaNumberParse::ToDbl("") == 0.0);
+    BOOST_TEST(MeaNumberParse::ToDbl("abc") == 0.0);
+    BOOST_TEST(MeaNumberParse::ToDbl("abc", 2.0) == 2.0);
+}
+
+BOOST_AUTO_TEST_CASE(TestToInt) {
+    BOOST_TEST(MeaNumberParse::ToInt("123") == 123);
+    BOOST_TEST(MeaNumberParse::ToInt(" -7") == -7);
+    BOOST_TEST(MeaNumberParse::ToInt("12.9") == 12);
+    BOOST_TEST(MeaNumberParse::ToInt(L"+5 px") == 5);
+    BOOST_TEST(MeaNumberParse::ToInt("") == 0);
+    BOOST_TEST(MeaNumberParse::ToInt("true", 1) == 1);
+}
@@ -0,0 +1,527 @@
+/*
+ * Copyright 2022 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "pch.h"
+#define BOOST_TEST_MODULE PositionLogConverterTest
+#include "GlobalFixture.h"
+#include <boost/test/unit_test.hpp>
+#include <meazure/position/PositionLogConverter.h>
+#include <meazure/utilities/NumberFormat.h>
+#include <meazure/xml/XMLDocument.h>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+namespace tt = boost::test_tools;
+
+
+namespace {
+    typedef MeaPositionLogConverter Converter;
+
+    /// Screen to be written to a test log, in pixels.
+    ///
+    struct TestScreen {
+        double left;
+        double top;
+        double right;
+        double bottom;
+        double ppi;
+        bool primary;
+    };
+
+    std::string Num(double value) {
+        MeaNumberFormat::Buffer buffer;
+        return std::string(MeaNumberFormat::FormatTrimmed(buffer, value));
+    }
+
+    /// Builds a log in the same way as the application: coordinates are converted from pixels using the factors
+    /// of the screen containing them, relative to the origin and with the y-axis orientation of the desktop.
+    ///
+    class LogBuilder {
+    public:
+        LogBuilder(const std::string& units, double unitsPerInch, std::vector<TestScreen> screens, double originX = 0,
+                   double originY = 0, bool invertY = false) :
+            m_units(units), m_unitsPerInch(unitsPerInch), m_screens(std::move(screens)), m_originX(originX),
+            m_originY(originY), m_invertY(invertY) {
+            m_virtualHeight = 0;
+            for (const TestScreen& screen : m_screens) {
+                m_virtualHeight = std::max(m_virtualHeight, screen.bottom);
+            }
+        }
+
+        double Factor(double x, double y) const {
+            for (const TestScreen& screen : m_screens) {
+                if (x >= screen.left && x < screen.right && y >= screen.top && y < screen.bottom) {
+                    return (m_unitsPerInch == 0.0) ? 1.0 : m_unitsPerInch / screen.ppi;
+                }
+            }
+            return (m_unitsPerInch == 0.0) ? 1.0 : m_unitsPerInch / m_screens.front().ppi;
+        }
+
+        double X(double x, double y) const { return Factor(x, y) * (x - m_originX); }
+
+        double Y(double x, double y) const {
+            if (!m_invertY) {
+                return Factor(x, y) * (y - m_originY);
+            }
+            if (m_originX == 0 && m_originY == 0) {
+                return Factor(x, y) * (-y + m_virtualHeight - 1);
+            }
+            return Factor(x, y) * (-y + m_originY);
+        }
+
+        void AddPosition(const std::string& tool, double x1, double y1, double x2, double y2, double angle) {
+            double f = Factor(x1, y1);
+            double width = (std::fabs(x2 - x1) + 1) * f;
+            double height = (std::fabs(y2 - y1) + 1) * f;
+
+            m_positions += "<position desktopRef=\"d1\" tool=\"" + tool + "\" date=\"2022-05-01T12:30:15Z\">"
+                "<points>"
+                "<point name=\"1\" x=\"" + Num(X(x1, y1)) + "\" y=\"" + Num(Y(x1, y1)) + "\"/>"
+                "<point name=\"2\" x=\"" + Num(X(x2, y2)) + "\" y=\"" + Num(Y(x2, y2)) + "\"/>"
+                "</points>"
+                "<properties>"
+                "<width value=\"" + Num(width) + "\"/>"
+                "<height value=\"" + Num(height) + "\"/>"
+                "<distance value=\"" + Num(std::hypot(width, height)) + "\"/>"
+                "<area value=\"" + Num(width * height) + "\"/>"
+                "<angle value=\"" + Num(angle) + "\"/>"
+                "</properties>"
+                "</position>";
+        }
+
+        std::string Build(const std::string& extraUnits = "") const {
+            std::string text =
+                "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                "<!DOCTYPE positionLog SYSTEM \"https://www.cthing.com/dtd/PositionLog1.dtd\">\n"
+                "<positionLog version=\"1\">"
+                "<info><title>Test &amp; Log</title><created date=\"2022-05-01T12:00:00Z\"/>"
+                "<generator name=\"Meazure\" version=\"4.0.0\" build=\"2\"/><machine name=\"host\"/></info>"
+                "<desktops><desktop id=\"d1\">"
+                "<units length=\"" + m_units + "\"/>" + extraUnits +
+                "<origin xoffset=\"" + Num(Factor(m_originX, m_originY) * m_originX) + "\" yoffset=\"" +
+                Num(Factor(m_originX, m_originY) * m_originY) + "\"" + (m_invertY ? " invertY=\"true\"" : "") + "/>"
+                "<size x=\"" + Num(Factor(0, 0) * Width()) + "\" y=\"" + Num(Factor(0, 0) * m_virtualHeight) + "\"/>"
+                "<screens>";
+            for (const TestScreen& screen : m_screens) {
+                double res = (m_unitsPerInch == 0.0) ? screen.ppi : screen.ppi / m_unitsPerInch;
+                text += std::string("<screen desc=\"Screen\"") + (screen.primary ? " primary=\"true\"" : "") + ">"
+                    "<rect top=\"" + Num(Y(screen.left, screen.top)) + "\" bottom=\"" +
+                    Num(Y(screen.right, screen.bottom)) + "\" left=\"" + Num(X(screen.left, screen.top)) +
+                    "\" right=\"" + Num(X(screen.right, screen.bottom)) + "\"/>"
+                    "<resolution x=\"" + Num(res) + "\" y=\"" + Num(res) + "\"/>"
+                    "</screen>";
+            }
+            text += "</screens></desktop></desktops><positions>" + m_positions + "</positions></positionLog>\n";
+            return text;
+        }
+
+    private:
+        double Width() const {
+            double width = 0;
+            for (const TestScreen& screen : m_screens) {
+                width = std::max(width, screen.right);
+            }
+            return width;
+        }
+
+        std::string m_units;
+        double m_unitsPerInch;
+        std::vector<TestScreen> m_screens;
+        double m_originX;
+        double m_originY;
+        bool m_invertY;
+        double m_virtualHeight;
+        std::string m_positions;
+    };
+
+    const std::vector<TestScreen> kSingleScreen = { { 0, 0, 1024, 768, 96, true } };
+}
+
+
+BOOST_AUTO_TEST_CASE(TestParse) {
+    LogBuilder builder("cm", 2.54, kSingleScreen);
+    builder.AddPosition("LineTool", 100, 200, 300, 250, 14.036);
+
+    Converter::Log log = Converter::Parse(builder.Build());
+
+    BOOST_TEST(log.m_title == "Test & Log");
+    BOOST_TEST(log.m_created == "2022-05-01T12:00:00Z");
+    BOOST_TEST(log.m_generatorName == "Meazure");
+    BOOST_TEST(log.m_generatorBuild == "2");
+    BOOST_TEST(log.m_machine == "host");
+
+    BOOST_TEST(log.m_desktops.size() == 1U);
+    const Converter::Desktop& desktop = log.m_desktops.front();
+    BOOST_TEST(desktop.m_id == "d1");
+    BOOST_TEST(desktop.m_lengthUnits == "cm");
+    BOOST_TEST(desktop.m_angleUnits == "deg");      // DTD default
+    BOOST_TEST(!desktop.m_invertY);                 // DTD default
+    BOOST_TEST(desktop.m_screens.size() == 1U);
+    BOOST_TEST(desktop.m_screens.front().m_primary);
+    BOOST_TEST(!desktop.m_screens.front().m_manualRes);
+    BOOST_TEST(desktop.m_screens.front().m_resX == 96 / 2.54, tt::tolerance(1e-9));
+
+    BOOST_TEST(log.m_positions.size() == 1U);
+    const Converter::Position& position = log.m_positions.front();
+    BOOST_TEST(position.m_tool == "LineTool");
+    BOOST_TEST(position.m_date == "2022-05-01T12:30:15Z");
+    BOOST_TEST(position.m_points.size() == 2U);
+    BOOST_TEST(position.m_points[0].m_name == "1");
+    BOOST_TEST(position.m_points[0].m_x == 100 * 2.54 / 96, tt::tolerance(1e-9));
+    BOOST_TEST(position.m_properties == (Converter::kWidth | Converter::kHeight | Converter::kDistance |
+                                         Converter::kArea | Converter::kAngle));
+    BOOST_TEST(position.m_angle == 14.036, tt::tolerance(1e-9));
+}
+
+BOOST_AUTO_TEST_CASE(TestParseErrors) {
+    BOOST_CHECK_THROW(Converter::Parse("<positionLog"), MeaXMLDocumentException);
+    BOOST_CHECK_THROW(Converter::Parse("<profile/>"), MeaPositionLogConverterException);
+    BOOST_CHECK_THROW(Converter::Parse("<positionLog><positions><position tool=\"x\"/></positions></positionLog>"),
+                      MeaPositionLogConverterException);
+    BOOST_CHECK_THROW(Converter::Parse("<positionLog><desktops><desktop id=\"d\"><units length=\"px\"/>"
+                                       "<origin xoffset=\"abc\" yoffset=\"0\"/></desktop></desktops></positionLog>"),
+                      MeaPositionLogConverterException);
+}
+
+BOOST_AUTO_TEST_CASE(TestConvertToPixels) {
+    LogBuilder builder("cm", 2.54, kSingleScreen);
+    builder.AddPosition("LineTool", 100, 200, 300, 250, 14.036);
+
+    Converter::Log log = Converter::Parse(builder.Build());
+    Converter::Convert(log, Converter::Target());
+
+    const Converter::Position& position = log.m_positions.front();
+    BOOST_TEST(position.m_points[0].m_x == 100.0, tt::tolerance(1e-9));
+    BOOST_TEST(position.m_points[0].m_y == 200.0, tt::tolerance(1e-9));
+    BOOST_TEST(position.m_points[1].m_x == 300.0, tt::tolerance(1e-9));
+    BOOST_TEST(position.m_points[1].m_y == 250.0, tt::tolerance(1e-9));
+    BOOST_TEST(position.m_width == 201.0, tt::tolerance(1e-9));
+    BOOST_TEST(position.m_height == 51.0, tt::tolerance(1e-9));
+    BOOST_TEST(position.m_area == 201.0 * 51.0, tt::tolerance(1e-9));
+    BOOST_TEST(position.m_distance == std::hypot(201.0, 51.0), tt::tolerance(1e-9));
+    BOOST_TEST(position.m_angle == 14.036, tt::tolerance(1e-9));
+
+    const Converter::Desktop& desktop = log.m_desktops.front();
+    BOOST_TEST(desktop.m_lengthUnits == "px");
+    BOOST_TEST(desktop.m_sizeX == 1024.0, tt::tolerance(1e-9));
+    BOOST_TEST(desktop.m_sizeY == 768.0, tt::tolerance(1e-9));
+    BOOST_TEST(desktop.m_screens.front().m_right == 1024.0, tt::tolerance(1e-9));
+    BOOST_TEST(desktop.m_screens.front().m_bottom == 768.0, tt::tolerance(1e-9));
+    BOOST_TEST(desktop.m_screens.front().m_resX == 96.0, tt::tolerance(1e-9));
+}
+
+BOOST_AUTO_TEST_CASE(TestConvertOriginAndInversion) {
+    LogBuilder builder("px", 0.0, kSingleScreen);
+    builder.AddPosition("LineTool", 100, 200, 300, 250, 14.036);
+
+    Converter::Target target;
+    target.m_lengthUnits = "in";
+    target.m_angleUnits = "rad";
+    target.m_originX = 10;
+    target.m_originY = 20;
+    target.m_invertY = true;
+
+    Converter::Log log = Converter::Parse(builder.Build());
+    Converter::Convert(log, target);
+
+    const Converter::Position& position = log.m_positions.front();
+    BOOST_TEST(position.m_points[0].m_x == 90.0 / 96.0, tt::tolerance(1e-9));
+    BOOST_TEST(position.m_points[0].m_y == -180.0 / 96.0, tt::tolerance(1e-9));
+    BOOST_TEST(position.m_width == 201.0 / 96.0, tt::tolerance(1e-9));
+    BOOST_TEST(position.m_angle == -14.036 * 3.14159265358979323846 / 180.0, tt::tolerance(1e-9));
+
+    const Converter::Desktop& desktop = log.m_desktops.front();
+    BOOST_TEST(desktop.m_lengthUnits == "in");
+    BOOST_TEST(desktop.m_angleUnits == "rad");
+    BOOST_TEST(desktop.m_invertY);
+    BOOST_TEST(desktop.m_originX == 10.0 / 96.0, tt::tolerance(1e-9));
+    BOOST_TEST(desktop.m_originY == 20.0 / 96.0, tt::tolerance(1e-9));
+    BOOST_TEST(desktop.m_screens.front().m_resX == 96.0, tt::tolerance(1e-9));
+
+    // Converting back recovers the original pixels.
+    Converter::Convert(log, Converter::Target());
+    BOOST_TEST(log.m_positions.front().m_points[0].m_x == 100.0, tt::tolerance(1e-9));
+    BOOST_TEST(log.m_positions.front().m_points[0].m_y == 200.0, tt::tolerance(1e-9));
+    BOOST_TEST(log.m_positions.front().m_angle == 14.036, tt::tolerance(1e-9));
+}
+
+BOOST_AUTO_TEST_CASE(TestConvertFromInvertedDesktop) {
+    // With an inverted y-axis and the origin not moved, the origin is at the bottom of the desktop.
+    LogBuilder builder("mm", 25.4, kSingleScreen, 0, 0, true);
+    builder.AddPosition("RectTool", 100, 200, 300, 250, 0);
+
+    Converter::Log log = Converter::Parse(builder.Build());
+    BOOST_TEST(log.m_positions.front().m_points[0].m_y == 567 * 25.4 / 96, tt::tolerance(1e-9));
+
+    Converter::Convert(log, Converter::Target());
+    BOOST_TEST(log.m_positions.front().m_points[0].m_y == 200.0, tt::tolerance(1e-9));
+    BOOST_TEST(log.m_desktops.front().m_screens.front().m_top == 0.0, tt::tolerance(1e-9));
+    BOOST_TEST(log.m_desktops.front().m_screens.front().m_bottom == 768.0, tt::tolerance(1e-9));
+}
+
+BOOST_AUTO_TEST_CASE(TestConvertFromMovedOrigin) {
+    LogBuilder builder("pt", 72, kSingleScreen, 50, 60, false);
+    builder.AddPosition("PointTool", 100, 200, 10, 20, 0);
+
+    Converter::Log log = Converter::Parse(builder.Build());
+    Converter::Convert(log, Converter::Target());
+
+    const Converter::Position& position = log.m_positions.front();
+    BOOST_TEST(position.m_points[0].m_x == 100.0, tt::tolerance(1e-9));
+    BOOST_TEST(position.m_points[0].m_y == 200.0, tt::tolerance(1e-9));
+    BOOST_TEST(position.m_points[1].m_x == 10.0, tt::tolerance(1e-9));
+    BOOST_TEST(position.m_points[1].m_y == 20.0, tt::tolerance(1e-9));
+    BOOST_TEST(log.m_desktops.front().m_originX == 0.0);
+    BOOST_TEST(log.m_desktops.front().m_originY == 0.0);
+}
+
+BOOST_AUTO_TEST_CASE(TestConvertMultipleScreens) {
+    const std::vector<TestScreen> screens = {
+        { 0, 0, 1024, 768, 96, true },
+        { 1024, 0, 2048, 768, 120, false }
+    };
+    LogBuilder builder("in", 1, screens);
+    builder.AddPosition("LineTool", 1500, 100, 1600, 150, 0);
+    builder.AddPosition("LineTool", 500, 100, 600, 150, 0);
+
+    Converter::Log log = Converter::Parse(builder.Build());
+    Converter::Convert(log, Converter::Target());
+
+    BOOST_TEST(log.m_positions[0].m_points[0].m_x == 1500.0, tt::tolerance(1e-9));
+    BOOST_TEST(log.m_positions[0].m_points[1].m_x == 1600.0, tt::tolerance(1e-9));
+    BOOST_TEST(log.m_positions[0].m_width == 101.0, tt::tolerance(1e-9));
+    BOOST_TEST(log.m_positions[1].m_points[0].m_x == 500.0, tt::tolerance(1e-9));
+    BOOST_TEST(log.m_positions[1].m_width == 101.0, tt::tolerance(1e-9));
+
+    const Converter::Desktop& desktop = log.m_desktops.front();
+    BOOST_TEST(desktop.m_screens[1].m_left == 1024.0, tt::tolerance(1e-9));
+    BOOST_TEST(desktop.m_screens[1].m_resX == 120.0, tt::tolerance(1e-9));
+
+    // Each screen's own resolution is used when converting to resolution dependent units.
+    Converter::Target target;
+    target.m_lengthUnits = "cm";
+    Converter::Convert(log, target);
+    BOOST_TEST(log.m_positions[0].m_points[0].m_x == 1500 * 2.54 / 120, tt::tolerance(1e-9));
+    BOOST_TEST(log.m_positions[1].m_points[0].m_x == 500 * 2.54 / 96, tt::tolerance(1e-9));
+}
+
+BOOST_AUTO_TEST_CASE(TestConvertCustomUnits) {
+    // Custom units based on inches: 2 units per inch
+    LogBuilder inchBuilder("custom", 2, kSingleScreen);
+    inchBuilder.AddPosition("LineTool", 100, 200, 300, 250, 0);
+    Converter::Log log = Converter::Parse(inchBuilder.Build(
+        "<customUnits name=\"Halves\" abbrev=\"hf\" scaleBasis=\"in\" scaleFactor=\"0.5\"/>"));
+    Converter::Convert(log, Converter::Target());
+    BOOST_TEST(log.m_positions.front().m_points[0].m_x == 100.0, tt::tolerance(1e-9));
+    BOOST_TEST(log.m_desktops.front().m_customName.empty());
+
+    // Custom units based on pixels do not record the screen resolution.
+    LogBuilder pixelBuilder("custom", 0, kSingleScreen);
+    pixelBuilder.AddPosition("LineTool", 100, 200, 300, 250, 0);
+    log = Converter::Parse(pixelBuilder.Build(
+        "<customUnits name=\"Cells\" abbrev=\"cl\" scaleBasis=\"px\" scaleFactor=\"8\"/>"));
+    BOOST_CHECK_THROW(Converter::Convert(log, Converter::Target()), MeaPositionLogConverterException);
+}
+
+BOOST_AUTO_TEST_CASE(TestConvertErrors) {
+    LogBuilder builder("px", 0, kSingleScreen);
+    builder.AddPosition("LineTool", 100, 200, 300, 250, 0);
+    Converter::Log log = Converter::Parse(builder.Build());
+
+    Converter::Target target;
+    target.m_lengthUnits = "custom";
+    BOOST_CHECK_THROW(Converter::Convert(log, target), MeaPositionLogConverterException);
+
+    target = Converter::Target();
+    target.m_angleUnits = "grad";
+    BOOST_CHECK_THROW(Converter::Convert(log, target), MeaPositionLogConverterException);
+
+    log.m_positions.front().m_desktopRef = "unknown";
+    BOOST_CHECK_THROW(Converter::Convert(log, Converter::Target()), MeaPositionLogConverterException);
+}
+
+BOOST_AUTO_TEST_CASE(TestWriteXML) {
+    LogBuilder builder("cm", 2.54, kSingleScreen);
+    builder.AddPosition("LineTool", 100, 200, 300, 250, 14.036);
+    Converter::Log log = Converter::Parse(builder.Build());
+    log.m_positions.front().m_desc = "A <line> & \"quote\"";
+    Converter::Convert(log, Converter::Target());
+
+    std::ostringstream out;
+    Converter::WriteXML(out, log);
+    std::string text = out.str();
+    BOOST_TEST(text.find("<!DOCTYPE positionLog SYSTEM \"https://www.cthing.com/dtd/PositionLog1.dtd\">") !=
+               std::string::npos);
+    BOOST_TEST(text.find("<point name=\"1\" x=\"100.0\" y=\"200.0\"/>") != std::string::npos);
+
+    Converter::Log reread = Converter::Parse(text);
+    BOOST_TEST(reread.m_title == log.m_title);
+    BOOST_TEST(reread.m_desktops.front().m_lengthUnits == "px");
+    BOOST_TEST(reread.m_desktops.front().m_screens.front().m_resX == 96.0, tt::tolerance(1e-9));
+    BOOST_TEST(reread.m_positions.front().m_desc == log.m_positions.front().m_desc);
+    BOOST_TEST(reread.m_positions.front().m_points[1].m_x == 300.0, tt::tolerance(1e-9));
+    BOOST_TEST(reread.m_positions.front().m_properties == log.m_positions.front().m_properties);
+    BOOST_TEST(reread.m_positions.front().m_angle == 14.036, tt::tolerance(1e-9));
+}
+
+BOOST_AUTO_TEST_CASE(TestWriteCSV) {
+    Converter::Log log;
+    Converter::Position position;
+    position.m_desktopRef = "d1";
+    position.m_tool = "PointTool";
+    position.m_date = "2022-05-01T12:30:15Z";
+    position.m_desc = "Say \"hi\", then go";
+    position.m_points.push_back({ "1", 10.5, 20.0 });
+    position.m_properties = Converter::kWidth;
+    position.m_width = 3.0;
+    log.m_positions.push_back(position);
+
+    std::ostringstream out;
+    Converter::WriteCSV(out, log);
+    BOOST_TEST(out.str() ==
+               "tool,timestamp,x1,y1,x2,y2,xv,yv,width,height,distance,area,angle,desktop id,desc\n"
+               "PointTool,2022-05-01T12:30:15Z,10.5,20.0,,,,,3.0,,,,,d1,\"Say \"\"hi\"\", then go\"\n");
+}
+
+BOOST_AUTO_TEST_CASE(TestWriteBinary) {
+    LogBuilder builder("px", 0, kSingleScreen);
+    builder.AddPosition("RectTool", 100, 200, 300, 250, 0);
+    builder.AddPosition("NewTool", 1, 2, 3, 4, 0);
+    Converter::Log log = Converter::Parse(builder.Build());
+
+    std::ostringstream out(std::ios::binary);
+    Converter::WriteBinary(out, log);
+    std::string data = out.str();
+
+    BOOST_TEST(data.size() == 24U + 2U * 104U);
+    BOOST_TEST(data.substr(0, 4) == "MPLB");
+    BOOST_TEST(data.substr(8, 2) == "px");
+    BOOST_TEST(static_cast<unsigned char>(data[20]) == 2);          // Position count
+
+    auto uint32At = [&data](std::size_t offset) {
+        std::uint32_t value = 0;
+        for (int i = 3; i >= 0; i--) {
+            value = (value << 8) | static_cast<unsigned char>(data[offset + i]);
+        }
+        return value;
+    };
+    auto doubleAt = [&data](std::size_t offset) {
+        std::uint64_t bits = 0;
+        for (int i = 7; i >= 0; i--) {
+            bits = (bits << 8) | static_cast<unsigned char>(data[offset + i]);
+        }
+        double value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    };
+
+    BOOST_TEST(uint32At(24) == 3U);                                 // RectTool
+    BOOST_TEST(uint32At(28) == (0x03U | (0x1FU << 3)));             // Points 1 and 2, all properties
+    BOOST_TEST(uint32At(32) == 1651408215U);                        // 2022-05-01T12:30:15Z
+    BOOST_TEST(doubleAt(40) == 100.0);                              // x1
+    BOOST_TEST(doubleAt(48) == 200.0);                              // y1
+    BOOST_TEST(doubleAt(72) == 0.0);                                // xv
+    BOOST_TEST(doubleAt(88) == 201.0);                              // width
+    BOOST_TEST(uint32At(24 + 104) == 0xFFFFFFFFU);                  // Unknown tool
+}
+
+BOOST_AUTO_TEST_CASE(TestConvertFiles) {
+    namespace fs = std::filesystem;
+
+    fs::path dir = fs::temp_directory_path() / "PositionLogConverterTest";
+    fs::remove_all(dir);
+    fs::create_directories(dir / "out");
+
+    std::vector<std::string> inputs;
+    for (int i = 0; i < 8; i++) {
+        LogBuilder builder("cm", 2.54, kSingleScreen);
+        builder.AddPosition("LineTool", 100 + i, 200, 300, 250, 0);
+        fs::path input = dir / ("log" + std::to_string(i) + ".mpl");
+        std::ofstream(input, std::ios::binary) << builder.Build();
+        inputs.push_back(input.string());
+    }
+    std::ofstream(dir / "bad.mpl") << "<positionLog>";
+    inputs.push_back((dir / "bad.mpl").string());
+    inputs.push_back((dir / "missing.mpl").string());
+
+    std::vector<std::string> errors = Converter::ConvertFiles(inputs, (dir / "out").string(), Converter::Target(),
+                                                              Converter::Format::CSV, 4);
+
+    BOOST_TEST(errors.size() == inputs.size());
+    for (int i = 0; i < 8; i++) {
+        BOOST_TEST(errors[i].empty());
+
+        std::ifstream in(dir / "out" / ("log" + std::to_string(i) + ".csv"));
+        std::string header;
+        std::string row;
+        std::getline(in, header);
+        std::getline(in, row);
+        BOOST_TEST(row.find("," + std::to_string(100 + i) + ".0,200.0,300.0,250.0,") != std::string::npos);
+        BOOST_TEST(row.find(",d1,") != std::string::npos);
+    }
+    BOOST_TEST(!errors[8].empty());
+    BOOST_TEST(!errors[9].empty());
+
+    fs::remove_all(dir);
+}
+
+BOOST_AUTO_TEST_CASE(TestConvertFilesKeepsInput) {
+    namespace fs = std::filesystem;
+
+    fs::path dir = fs::temp_directory_path() / "PositionLogConverterKeepTest";
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+
+    LogBuilder builder("cm", 2.54, kSingleScreen);
+    builder.AddPosition("LineTool", 100, 200, 300, 250, 0);
+    std::string original = builder.Build();
+
+    fs::path input = dir / "log.mpl";
+    std::ofstream(input, std::ios::binary) << original;
+
+    // Converting an XML log into its own directory would replace the log with the converted log.
+    std::vector<std::string> errors = Converter::ConvertFiles({ input.string(), (dir / "." / "log.mpl").string() },
+                                                              dir.string(), Converter::Target(),
+                                                              Converter::Format::XML, 1);
+    BOOST_TEST(errors.size() == 2U);
+    BOOST_TEST(errors[0].find("would replace an input file") != std::string::npos);
+    BOOST_TEST(!errors[1].empty());
+
+    std::ifstream in(input, std::ios::binary);
+    std::string text((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    BOOST_TEST(text == original);
+
+    // Converting to another directory replaces an existing output file and leaves no temporary file.
+    fs::create_directories(dir / "out");
+    std::ofstream(dir / "out" / "log.mpl") << "old";
+    errors = Converter::ConvertFiles({ input.string() }, (dir / "out").string(), Converter::Target(),
+                                     Converter::Format::XML, 1);
+    BOOST_TEST(errors[0].empty());
+    BOOST_TEST(fs::file_size(dir / "out" / "log.mpl") > 3U);
+    BOOST_TEST(!fs::exists(dir / "out" / "log.mpl.tmp"));
+
+    fs::remove_all(dir);
+}
@@ -0,0 +1,220 @@
+/*
+ * Copyright 2022 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "pch.h"
+#define BOOST_TEST_MODULE RegionSamplerTest
+#include "GlobalFixture.h"
+#include <boost/test/unit_test.hpp>
+#include <meazure/graphics/RegionSampler.h>
+#include <vector>
+#include <algorithm>
+#include <random>
+#include <cmath>
+
+typedef MeaRegionSampler::Pixel Pixel;
+typedef MeaRegionSampler::Image Image;
+
+
+namespace {
+    struct Buffer {
+        Buffer(int width, int height, int stride) :
+            pixels(static_cast<size_t>(height) * stride, 0xFFFFFFFF),
+            image { pixels.data(), width, height, stride } {}
+
+        std::vector<Pixel> pixels;
+        Image image;
+    };
+
+    Buffer RandomBuffer(int width, int height, int stride, unsigned int seed) {
+        Buffer buffer(width, height, stride);
+        std::mt19937 generator(seed);
+        for (int y = 0; y < height; y++) {
+            for (int x = 0; x < width; x++) {
+                buffer.image.Row(y)[x] = generator() & 0xFFFFFF;
+            }
+        }
+        return buffer;
+    }
+
+    // Computes the statistics directly from the pixels of the region.
+    MeaRegionSampler::Stats ReferenceStats(const Image& image, int left, int top, int right, int bottom) {
+        left = std::clamp(left, 0, image.m_width);
+        right = std::clamp(right, left, image.m_width);
+        top = std::clamp(top, 0, image.m_height);
+        bottom = std::clamp(bottom, top, image.m_height);
+
+        MeaRegionSampler::Stats stats = {};
+        const int shifts[] = { 16, 8, 0 };
+
+        for (int channel = 0; channel < MeaRegionSampler::kNumChannels; channel++) {
+            std::vector<int> values;
+            for (int y = top; y < bottom; y++) {
+                for (int x = left; x < right; x++) {
+                    values.push_back((image.Row(y)[x] >> shifts[channel]) & 0xFF);
+                }
+            }
+            stats.m_count = static_cast<int>(values.size());
+            if (values.empty()) {
+                continue;
+            }
+
+            std::sort(values.begin(), values.end());
+            double sum = 0.0;
+            for (int value : values) {
+                sum += value;
+            }
+            double mean = sum / values.size();
+            double deviations = 0.0;
+            for (int value : values) {
+                deviations += (value - mean) * (value - mean);
+            }
+
+            MeaRegionSampler::ChannelStats& channelStats = stats.m_channels[channel];
+            channelStats.m_min = values.front();
+            channelStats.m_max = values.back();
+            channelStats.m_median = values[(values.size() - 1) / 2];
+            channelStats.m_mean = mean;
+            channelStats.m_stdDev = std::sqrt(deviations / values.size());
+        }
+
+        return stats;
+    }
+
+    void CheckStats(const MeaRegionSampler& sampler, const MeaRegionSampler::Stats& expected) {
+        MeaRegionSampler::Stats actual = sampler.GetStats();
+
+        BOOST_TEST(actual.m_count == expected.m_count);
+        BOOST_TEST(sampler.GetCount() == expected.m_count);
+        for (int channel = 0; channel < MeaRegionSampler::kNumChannels; channel++) {
+            const MeaRegionSampler::ChannelStats& a = actual.m_channels[channel];
+            const MeaRegionSampler::ChannelStats& e = expected.m_channels[channel];
+            BOOST_TEST(a.m_min == e.m_min);
+            BOOST_TEST(a.m_max == e.m_max);
+            BOOST_TEST(a.m_median == e.m_median);
+            BOOST_TEST(std::abs(a.m_mean - e.m_mean) < 1e-9);
+            BOOST_TEST(std::abs(a.m_stdDev - e.m_stdDev) < 1e-6);
+        }
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(TestUniformRegion) {
+    Buffer buffer(5, 5, 5);
+    std::fill(buffer.pixels.begin(), buffer.pixels.end(), 0x102030);
+
+    MeaRegionSampler sampler;
+    sampler.Sample(buffer.image, 1, 1, 4, 4);
+
+    MeaRegionSampler::Stats stats = sampler.GetStats();
+    BOOST_TEST(stats.m_count == 9);
+    BOOST_TEST(stats.m_channels[MeaRegionSampler::Red].m_min == 0x10);
+    BOOST_TEST(stats.m_channels[MeaRegionSampler::Red].m_max == 0x10);
+    BOOST_TEST(stats.m_channels[MeaRegionSampler::Green].m_median == 0x20);
+    BOOST_TEST(stats.m_channels[MeaRegionSampler::Blue].m_mean == 48.0);
+    BOOST_TEST(stats.m_channels[MeaRegionSampler::Blue].m_stdDev == 0.0);
+    BOOST_TEST(sampler.GetMeanColor() == 0x102030U);
+    BOOST_TEST(sampler.GetHistogram(MeaRegionSampler::Green)[0x20] == 9U);
+}
+
+BOOST_AUTO_TEST_CASE(TestKnownValues) {
+    Buffer buffer(4, 1, 4);
+    buffer.pixels = { 0x000000, 0x0A0000, 0x140000, 0xFF0000 };
+    buffer.image.m_pixels = buffer.pixels.data();
+
+    MeaRegionSampler sampler;
+    sampler.Sample(buffer.image, 0, 0, 4, 1);
+
+    const MeaRegionSampler::ChannelStats& red = sampler.GetStats().m_channels[MeaRegionSampler::Red];
+    BOOST_TEST(red.m_min == 0);
+    BOOST_TEST(red.m_max == 255);
+    BOOST_TEST(red.m_median == 10);
+    BOOST_TEST(red.m_mean == 71.25);
+    BOOST_TEST(sampler.GetMeanColor() == 0x470000U);
+}
+
+BOOST_AUTO_TEST_CASE(TestEmptyRegion) {
+    Buffer buffer = RandomBuffer(8, 8, 8, 1);
+
+    MeaRegionSampler sampler;
+    sampler.Sample(buffer.image, 20, 20, 30, 30);
+    BOOST_TEST(sampler.GetCount() == 0);
+    BOOST_TEST(sampler.GetMeanColor() == 0U);
+    BOOST_TEST(sampler.GetStats().m_channels[MeaRegionSampler::Red].m_max == 0);
+
+    sampler.Move(buffer.image, 2, 2, 5, 5);
+    CheckStats(sampler, ReferenceStats(buffer.image, 2, 2, 5, 5));
+}
+
+BOOST_AUTO_TEST_CASE(TestSampleMatchesReference) {
+    // Widths that exercise the vector and scalar portions of the span accumulation, and a stride wider than the
+    // image to ensure that pixels beyond the image are not sampled.
+    for (int width : { 1, 3, 4, 7, 16, 33 }) {
+        Buffer buffer = RandomBuffer(width, 11, width + 5, width);
+        MeaRegionSampler sampler;
+
+        sampler.Sample(buffer.image, 0, 0, width, 11);
+        CheckStats(sampler, ReferenceStats(buffer.image, 0, 0, width, 11));
+
+        sampler.Sample(buffer.image, -2, 3, width / 2 + 1, 40);
+        CheckStats(sampler, ReferenceStats(buffer.image, -2, 3, width / 2 + 1, 40));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(TestLargeRegion) {
+    // Large enough that the 32-bit vector lanes must be flushed to the 64-bit totals.
+    Buffer buffer(20000, 3, 20000);
+    std::fill(buffer.pixels.begin(), buffer.pixels.end(), 0xFFFFFF);
+
+    MeaRegionSampler sampler;
+    sampler.Sample(buffer.image, 0, 0, 20000, 3);
+
+    MeaRegionSampler::Stats stats = sampler.GetStats();
+    BOOST_TEST(stats.m_count == 60000);
+    BOOST_TEST(stats.m_channels[MeaRegionSampler::Red].m_mean == 255.0);
+    BOOST_TEST(stats.m_channels[MeaRegionSampler::Red].m_stdDev == 0.0);
+    BOOST_TEST(sampler.GetMeanColor() == 0xFFFFFFU);
+}
+
+BOOST_AUTO_TEST_CASE(TestMoveMatchesSample) {
+    Buffer buffer = RandomBuffer(40, 30, 43, 7);
+    std::mt19937 generator(11);
+    std::uniform_int_distribution<int> step(-6, 6);
+    std::uniform_int_distribution<int> size(0, 12);
+
+    MeaRegionSampler sampler;
+    int left = 10;
+    int top = 10;
+    int width = 9;
+    int height = 9;
+    sampler.Sample(buffer.image, left, top, left + width, top + height);
+
+    for (int i = 0; i < 500; i++) {
+        left += step(generator);
+        top += step(generator);
+        if (i % 50 == 0) {
+            width = size(generator);
+            height = size(generator);
+        }
+        left = std::clamp(left, -10, 45);
+        top = std::clamp(top, -10, 35);
+
+        sampler.Move(buffer.image, left, top, left + width, top + height);
+        CheckStats(sampler, ReferenceStats(buffer.image, left, top, left + width, top + height));
+    }
+}
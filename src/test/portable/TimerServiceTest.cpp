@@ -0,0 +1,181 @@
+/*
+ * Copyright 2022 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "pch.h"
+#define BOOST_TEST_MODULE TimerServiceTest
+#include "GlobalFixture.h"
+#include <boost/test/unit_test.hpp>
+#include <meazure/utilities/TimerService.h>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+
+BOOST_AUTO_TEST_CASE(TestExpire) {
+    MeaTimerService service;
+    std::promise<MeaTimerService::TimerId> expired;
+
+    auto start = std::chrono::steady_clock::now();
+    MeaTimerService::TimerId id = service.Schedule(20ms, [&](MeaTimerService::TimerId timerId) {
+        expired.set_value(timerId);
+    });
+
+    BOOST_TEST(id != MeaTimerService::kNoTimer);
+
+    std::future<MeaTimerService::TimerId> result = expired.get_future();
+    BOOST_TEST_REQUIRE((result.wait_for(5s) == std::future_status::ready));
+    BOOST_TEST(result.get() == id);
+    BOOST_TEST((std::chrono::steady_clock::now() - start >= 20ms));
+    BOOST_TEST(service.GetPendingCount() == 0U);
+}
+
+BOOST_AUTO_TEST_CASE(TestOrder) {
+    MeaTimerService service;
+    std::mutex mutex;
+    std::vector<int> order;
+    std::promise<void> done;
+
+    auto record = [&](int value) {
+        return [&, value](MeaTimerService::TimerId) {
+            std::lock_guard<std::mutex> lock(mutex);
+            order.push_back(value);
+            if (order.size() == 4) {
+                done.set_value();
+            }
+        };
+    };
+
+    service.Schedule(60ms, record(3));
+    service.Schedule(20ms, record(1));
+    service.Schedule(40ms, record(2));
+    service.Schedule(60ms, record(4));
+
+    BOOST_TEST_REQUIRE((done.get_future().wait_for(5s) == std::future_status::ready));
+    BOOST_TEST(order == std::vector<int>({ 1, 2, 3, 4 }));
+}
+
+BOOST_AUTO_TEST_CASE(TestCancel) {
+    MeaTimerService service;
+    std::atomic<int> count = 0;
+    std::promise<void> done;
+
+    MeaTimerService::TimerId id = service.Schedule(20ms, [&](MeaTimerService::TimerId) { count++; });
+    service.Schedule(50ms, [&](MeaTimerService::TimerId) { done.set_value(); });
+
+    BOOST_TEST(service.GetPendingCount() == 2U);
+    BOOST_TEST(service.Cancel(id));
+    BOOST_TEST(!service.Cancel(id));
+    BOOST_TEST(service.GetPendingCount() == 1U);
+
+    BOOST_TEST_REQUIRE((done.get_future().wait_for(5s) == std::future_status::ready));
+    BOOST_TEST(count == 0);
+    BOOST_TEST(!service.Cancel(MeaTimerService::kNoTimer));
+}
+
+BOOST_AUTO_TEST_CASE(TestCancelWaitsForCallback) {
+    MeaTimerService service;
+    std::promise<void> started;
+    std::atomic<bool> finished = false;
+
+    MeaTimerService::TimerId id = service.Schedule(0ms, [&](MeaTimerService::TimerId) {
+        started.set_value();
+        std::this_thread::sleep_for(50ms);
+        finished = true;
+    });
+
+    BOOST_TEST_REQUIRE((started.get_future().wait_for(5s) == std::future_status::ready));
+    BOOST_TEST(!service.Cancel(id));
+    BOOST_TEST(finished);
+}
+
+BOOST_AUTO_TEST_CASE(TestCancelAll) {
+    MeaTimerService service;
+    int owner = 0;
+    int otherOwner = 0;
+    std::promise<void> started;
+    std::promise<void> otherDone;
+    std::atomic<bool> finished = false;
+    std::atomic<int> count = 0;
+
+    service.Schedule(0ms, [&](MeaTimerService::TimerId) {
+        started.set_value();
+        std::this_thread::sleep_for(50ms);
+        finished = true;
+    }, &owner);
+
+    // A later timer for the same owner is scheduled while the earlier one's callback is still running.
+    BOOST_TEST_REQUIRE((started.get_future().wait_for(5s) == std::future_status::ready));
+    service.Schedule(20ms, [&](MeaTimerService::TimerId) { count++; }, &owner);
+    service.Schedule(20ms, [&](MeaTimerService::TimerId) { count++; });
+    service.Schedule(40ms, [&](MeaTimerService::TimerId) { otherDone.set_value(); }, &otherOwner);
+
+    BOOST_TEST(service.CancelAll(&owner) == 1U);
+    BOOST_TEST(finished);
+    BOOST_TEST(service.CancelAll(&owner) == 0U);
+    BOOST_TEST(service.CancelAll(nullptr) == 0U);
+
+    BOOST_TEST_REQUIRE((otherDone.get_future().wait_for(5s) == std::future_status::ready));
+    BOOST_TEST(count == 1);
+}
+
+BOOST_AUTO_TEST_CASE(TestRearmFromCallback) {
+    MeaTimerService service;
+    std::mutex mutex;
+    std::set<std::thread::id> threads;
+    std::atomic<int> count = 0;
+    std::promise<void> done;
+
+    std::function<void(MeaTimerService::TimerId)> callback = [&](MeaTimerService::TimerId) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            threads.insert(std::this_thread::get_id());
+        }
+        if (++count < 20) {
+            service.Schedule(1ms, callback);
+        } else {
+            done.set_value();
+        }
+    };
+
+    service.Schedule(1ms, callback);
+
+    BOOST_TEST_REQUIRE((done.get_future().wait_for(5s) == std::future_status::ready));
+    BOOST_TEST(count == 20);
+
+    // All expirations are delivered on the one service thread.
+    BOOST_TEST(threads.size() == 1U);
+    BOOST_TEST((*threads.begin() != std::this_thread::get_id()));
+}
+
+BOOST_AUTO_TEST_CASE(TestDestroyPending) {
+    std::atomic<int> count = 0;
+
+    {
+        MeaTimerService service;
+        service.Schedule(10s, [&](MeaTimerService::TimerId) { count++; });
+    }
+
+    BOOST_TEST(count == 0);
+}
@@ -0,0 +1,131 @@
+/*
+ * Copyright 2022 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "pch.h"
+#define BOOST_TEST_MODULE UTF8TranscoderTest
+#include "GlobalFixture.h"
+#include <boost/test/unit_test.hpp>
+#include <meazure/utilities/UTF8Transcoder.h>
+#include <string>
+
+
+namespace {
+    /// Windows-1252 table for the bytes 0x80 - 0x9F. The remaining bytes match Latin-1.
+    MeaUTF8Transcoder::HighTable Make1252Table() {
+        static const char32_t cp1252[32] = {
+            0x20AC, 0x0081, 0x201A, 0x0192, 0x201E, 0x2026, 0x2020, 0x2021,
+            0x02C6, 0x2030, 0x0160, 0x2039, 0x0152, 0x008D, 0x017D, 0x008F,
+            0x0090, 0x2018, 0x2019, 0x201C, 0x201D, 0x2022, 0x2013, 0x2014,
+            0x02DC, 0x2122, 0x0161, 0x203A, 0x0153, 0x009D, 0x017E, 0x0178
+        };
+
+        MeaUTF8Transcoder::HighTable table = MeaUTF8Transcoder::Latin1Table();
+        for (int i = 0; i < 32; i++) {
+            table[i] = cp1252[i];
+        }
+        return table;
+    }
+
+    std::string Transcode(const MeaUTF8Transcoder& transcoder, const std::string& str) {
+        std::string out;
+        transcoder.Append(out, str.data(), str.size());
+        return out;
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(TestAsciiPrefixLength) {
+    std::string str(100, 'a');
+
+    BOOST_TEST(MeaUTF8Transcoder::AsciiPrefixLength(str.data(), 0) == 0U);
+    BOOST_TEST(MeaUTF8Transcoder::AsciiPrefixLength(str.data(), str.size()) == str.size());
+
+    for (std::size_t pos = 0; pos < str.size(); pos++) {
+        std::string s(str);
+        s[pos] = '\xE9';
+        BOOST_TEST(MeaUTF8Transcoder::AsciiPrefixLength(s.data(), s.size()) == pos);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(TestAppendLatin1) {
+    MeaUTF8Transcoder transcoder(MeaUTF8Transcoder::Latin1Table());
+
+    BOOST_TEST(Transcode(transcoder, "") == "");
+    BOOST_TEST(Transcode(transcoder, "Hello world") == "Hello world");
+    BOOST_TEST(Transcode(transcoder, "caf\xE9") == "caf\xC3\xA9");
+    BOOST_TEST(Transcode(transcoder, "\xFF\x80") == "\xC3\xBF\xC2\x80");
+    BOOST_TEST(Transcode(transcoder, std::string("a\0b", 3)) == std::string("a\0b", 3));
+}
+
+BOOST_AUTO_TEST_CASE(TestAppend1252) {
+    MeaUTF8Transcoder transcoder(Make1252Table());
+
+    BOOST_TEST(Transcode(transcoder, "\x99\x85") == "\xE2\x84\xA2\xE2\x80\xA6");
+    BOOST_TEST(Transcode(transcoder, "\x80") == "\xE2\x82\xAC");
+
+    // Non-ASCII characters on either side of the 16 byte blocks.
+    std::string ascii(40, 'x');
+    std::string expected;
+    std::string str;
+    for (std::size_t i = 0; i < 3; i++) {
+        str += ascii + "\x99";
+        expected += ascii + "\xE2\x84\xA2";
+    }
+    BOOST_TEST(Transcode(transcoder, str) == expected);
+}
+
+BOOST_AUTO_TEST_CASE(TestAppendReusesBuffer) {
+    MeaUTF8Transcoder transcoder(MeaUTF8Transcoder::Latin1Table());
+    std::string out;
+
+    transcoder.Append(out, "abc", 3);
+    transcoder.Append(out, "\xE9", 1);
+    BOOST_TEST(out == "abc\xC3\xA9");
+
+    out.clear();
+    transcoder.Append(out, "z", 1);
+    BOOST_TEST(out == "z");
+}
+
+BOOST_AUTO_TEST_CASE(TestAppendWide) {
+    std::string out;
+
+    MeaUTF8Transcoder::Append(out, L"Hello", 5);
+    BOOST_TEST(out == "Hello");
+
+    out.clear();
+    const wchar_t wide[] = { 0x00E9, 0x2122, 0x0041 };
+    MeaUTF8Transcoder::Append(out, wide, 3);
+    BOOST_TEST(out == "\xC3\xA9\xE2\x84\xA2" "A");
+}
+
+BOOST_AUTO_TEST_CASE(TestAppendCodePoint) {
+    std::string out;
+
+    MeaUTF8Transcoder::AppendCodePoint(out, 0x41);
+    MeaUTF8Transcoder::AppendCodePoint(out, 0x7FF);
+    MeaUTF8Transcoder::AppendCodePoint(out, 0xFFFD);
+    MeaUTF8Transcoder::AppendCodePoint(out, 0x1F600);
+    BOOST_TEST(out == "A\xDF\xBF\xEF\xBF\xBD\xF0\x9F\x98\x80");
+
+    out.clear();
+    MeaUTF8Transcoder::AppendCodePoint(out, 0xD800);
+    MeaUTF8Transcoder::AppendCodePoint(out, 0x110000);
+    BOOST_TEST(out == "\xEF\xBF\xBD\xEF\xBF\xBD");
+}
@@ -0,0 +1,100 @@
+/*
+ * Copyright 2022 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "pch.h"
+#define BOOST_TEST_MODULE UnitsConversionTest
+#include "GlobalFixture.h"
+#include <boost/test/unit_test.hpp>
+#include <meazure/units/UnitsConversion.h>
+#include <cmath>
+
+
+BOOST_AUTO_TEST_CASE(TestUnitsPerInch) {
+    BOOST_TEST(MeaUnitsConversion::UnitsPerInch("in") == MeaUnitsConversion::kInchesPerInch);
+    BOOST_TEST(MeaUnitsConversion::UnitsPerInch("pt") == MeaUnitsConversion::kPointsPerInch);
+    BOOST_TEST(MeaUnitsConversion::UnitsPerInch("tp") == MeaUnitsConversion::kTwipsPerInch);
+    BOOST_TEST(MeaUnitsConversion::UnitsPerInch("pc") == MeaUnitsConversion::kPicasPerInch);
+    BOOST_TEST(MeaUnitsConversion::UnitsPerInch("cm") == MeaUnitsConversion::kCentimetersPerInch);
+    BOOST_TEST(MeaUnitsConversion::UnitsPerInch("mm") == MeaUnitsConversion::kMillimetersPerInch);
+    BOOST_TEST(MeaUnitsConversion::UnitsPerInch("px") == 0.0);
+    BOOST_TEST(MeaUnitsConversion::UnitsPerInch("custom") == 0.0);
+    BOOST_TEST(MeaUnitsConversion::UnitsPerInch("") == 0.0);
+}
+
+BOOST_AUTO_TEST_CASE(TestFromPixels) {
+    BOOST_TEST(MeaUnitsConversion::FromPixels(MeaUnitsConversion::kPointsPerInch, 96.0) == 0.75);
+    BOOST_TEST(MeaUnitsConversion::FromPixels(MeaUnitsConversion::kInchesPerInch, 100.0) == 0.01);
+    BOOST_TEST(MeaUnitsConversion::FromPixels(MeaUnitsConversion::kMillimetersPerInch, 110.0) == 25.4 / 110.0);
+    static_assert(MeaUnitsConversion::FromPixels(MeaUnitsConversion::kTwipsPerInch, 120.0) == 12.0);
+}
+
+BOOST_AUTO_TEST_CASE(TestScreenDistanceSq) {
+    // Screen from (0, 0) to (100, 50), right and bottom exclusive.
+    BOOST_TEST(MeaUnitsConversion::ScreenDistanceSq(0, 0, 100, 50, 0, 0) == 0.0);
+    BOOST_TEST(MeaUnitsConversion::ScreenDistanceSq(0, 0, 100, 50, 99, 49) == 0.0);
+    BOOST_TEST(MeaUnitsConversion::ScreenDistanceSq(0, 0, 100, 50, 100, 10) == 1.0);
+    BOOST_TEST(MeaUnitsConversion::ScreenDistanceSq(0, 0, 100, 50, 10, 52) == 9.0);
+    BOOST_TEST(MeaUnitsConversion::ScreenDistanceSq(0, 0, 100, 50, -3, -4) == 25.0);
+}
+
+BOOST_AUTO_TEST_CASE(TestOriginDefault) {
+    MeaUnitsConversion::Origin origin(0.0, 0.0, false, 1080.0);
+
+    BOOST_TEST(origin.ConvertX(10.0, 0.5) == 5.0);
+    BOOST_TEST(origin.ConvertY(20.0, 0.25) == 5.0);
+    BOOST_TEST(origin.UnconvertX(5.0, 0.5) == 10.0);
+    BOOST_TEST(origin.UnconvertY(5.0, 0.25) == 20.0);
+}
+
+BOOST_AUTO_TEST_CASE(TestOriginMoved) {
+    MeaUnitsConversion::Origin origin(100.0, 200.0, false, 1080.0);
+
+    BOOST_TEST(origin.ConvertX(110.0, 1.0) == 10.0);
+    BOOST_TEST(origin.ConvertY(190.0, 1.0) == -10.0);
+    BOOST_TEST(origin.UnconvertX(10.0, 1.0) == 110.0);
+    BOOST_TEST(origin.UnconvertY(-10.0, 1.0) == 190.0);
+}
+
+BOOST_AUTO_TEST_CASE(TestOriginInverted) {
+    // With the origin at the system origin, an inverted y-axis places it at the bottom of the virtual screen.
+    MeaUnitsConversion::Origin bottom(0.0, 0.0, true, 1080.0);
+    BOOST_TEST(bottom.ConvertY(1079.0, 1.0) == 0.0);
+    BOOST_TEST(bottom.ConvertY(0.0, 1.0) == 1079.0);
+    BOOST_TEST(bottom.UnconvertY(1079.0, 1.0) == 0.0);
+
+    // Elsewhere, the y-axis increases upward from the origin.
+    MeaUnitsConversion::Origin moved(100.0, 200.0, true, 1080.0);
+    BOOST_TEST(moved.ConvertY(190.0, 1.0) == 10.0);
+    BOOST_TEST(moved.ConvertY(250.0, 1.0) == -50.0);
+    BOOST_TEST(moved.UnconvertY(10.0, 1.0) == 190.0);
+}
+
+BOOST_AUTO_TEST_CASE(TestOriginRoundTrip) {
+    const double factor = MeaUnitsConversion::FromPixels(MeaUnitsConversion::kMillimetersPerInch, 96.0);
+    const bool inverts[] = { false, true };
+
+    for (bool invertY : inverts) {
+        MeaUnitsConversion::Origin origin(37.0, 412.0, invertY, 1080.0);
+
+        for (double px = -500.0; px <= 2000.0; px += 7.0) {
+            BOOST_TEST(std::round(origin.UnconvertX(origin.ConvertX(px, factor), factor)) == px);
+            BOOST_TEST(std::round(origin.UnconvertY(origin.ConvertY(px, factor), factor)) == px);
+        }
+    }
+}
@@ -0,0 +1,152 @@
+/*
+ * Copyright 2022 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "pch.h"
+#define BOOST_TEST_MODULE WindowIndexTest
+#include "GlobalFixture.h"
+#include <boost/test/unit_test.hpp>
+#include <meazure/utilities/WindowIndex.h>
+#include <vector>
+#include <random>
+
+
+namespace {
+    typedef MeaWindowIndex::Rect Rect;
+
+    // Locates the point in the manner of the EnumChildWindows search: the last rectangle containing it wins.
+    int LinearFind(const std::vector<Rect>& rects, int x, int y) {
+        int found = MeaWindowIndex::kNotFound;
+        for (std::size_t i = 0; i < rects.size(); i++) {
+            const Rect& r = rects[i];
+            if (r.left <= x && x < r.right && r.top <= y && y < r.bottom) {
+                found = static_cast<int>(i);
+            }
+        }
+        return found;
+    }
+
+    // Generates randomly placed and sized window rectangles.
+    std::vector<Rect> MakeWindows(std::mt19937& gen, int count) {
+        std::uniform_int_distribution<int> pos(-200, 2000);
+        std::uniform_int_distribution<int> size(1, 400);
+
+        std::vector<Rect> rects;
+        while (static_cast<int>(rects.size()) < count) {
+            int x = pos(gen);
+            int y = pos(gen);
+            Rect rect { x, y, x + size(gen), y + size(gen) };
+            rects.push_back(rect);
+        }
+        return rects;
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(TestEmpty) {
+    MeaWindowIndex index;
+    BOOST_TEST(index.FindTopmost(0, 0) == MeaWindowIndex::kNotFound);
+
+    index.Build({});
+    BOOST_TEST(index.GetSize() == 0U);
+    BOOST_TEST(index.FindTopmost(0, 0) == MeaWindowIndex::kNotFound);
+
+    index.Build({ Rect { 0, 10, 20, 10 } });       // Zero height
+    BOOST_TEST(index.GetSize() == 1U);
+    BOOST_TEST(index.FindTopmost(5, 10) == MeaWindowIndex::kNotFound);
+
+    index.Clear();
+    BOOST_TEST(index.GetSize() == 0U);
+}
+
+BOOST_AUTO_TEST_CASE(TestHierarchy) {
+    // A frame containing a toolbar and a client area, the client area containing an editor with a scrollbar.
+    std::vector<Rect> rects = {
+        Rect { 0, 0, 800, 600 },            // 0: frame
+        Rect { 0, 0, 800, 40 },             // 1: toolbar
+        Rect { 10, 5, 40, 35 },             // 2: toolbar button
+        Rect { 0, 40, 800, 600 },           // 3: client area
+        Rect { 100, 40, 800, 600 },         // 4: editor
+        Rect { 780, 40, 800, 600 },         // 5: editor scrollbar
+    };
+
+    MeaWindowIndex index;
+    index.Build(rects);
+
+    BOOST_TEST(index.FindTopmost(20, 20) == 2);
+    BOOST_TEST(index.FindTopmost(50, 20) == 1);
+    BOOST_TEST(index.FindTopmost(50, 300) == 3);
+    BOOST_TEST(index.FindTopmost(100, 40) == 4);      // Left and top edges are inside
+    BOOST_TEST(index.FindTopmost(780, 300) == 5);
+    BOOST_TEST(index.FindTopmost(800, 300) == MeaWindowIndex::kNotFound);   // Right edge is outside
+    BOOST_TEST(index.FindTopmost(-1, 0) == MeaWindowIndex::kNotFound);
+}
+
+BOOST_AUTO_TEST_CASE(TestMatchesLinearSearch) {
+    std::mt19937 gen(2022);
+    std::uniform_int_distribution<int> coord(-300, 2500);
+
+    for (int count : { 1, 7, 8, 9, 64, 65, 500, 3000 }) {
+        std::vector<Rect> rects = MakeWindows(gen, count);
+
+        MeaWindowIndex index;
+        index.Build(rects);
+        BOOST_TEST(index.GetSize() == rects.size());
+
+        for (int i = 0; i < 2000; i++) {
+            int x = coord(gen);
+            int y = coord(gen);
+            BOOST_TEST(index.FindTopmost(x, y) == LinearFind(rects, x, y));
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(TestUpdate) {
+    std::mt19937 gen(1234);
+    std::uniform_int_distribution<int> coord(-300, 2500);
+    std::uniform_int_distribution<int> offset(-300, 300);
+
+    std::vector<Rect> rects = MakeWindows(gen, 400);
+    MeaWindowIndex index;
+    index.Build(rects);
+
+    std::uniform_int_distribution<int> which(0, static_cast<int>(rects.size()) - 1);
+    for (int round = 0; round < 50; round++) {
+        // Move, resize, or hide a few windows.
+        for (int i = 0; i < 5; i++) {
+            int id = which(gen);
+            Rect& rect = rects[id];
+            if (i == 4) {
+                rect = Rect { 0, 0, 0, 0 };
+            } else {
+                int dx = offset(gen);
+                int dy = offset(gen);
+                rect = Rect { rect.left + dx, rect.top + dy, rect.right + dx + offset(gen) / 4,
+                              rect.bottom + dy + offset(gen) / 4 };
+            }
+            index.Update(id, rect);
+            BOOST_TEST(index.GetRect(id).left == rect.left);
+        }
+
+        for (int i = 0; i < 200; i++) {
+            int x = coord(gen);
+            int y = coord(gen);
+            BOOST_TEST(index.FindTopmost(x, y) == LinearFind(rects, x, y));
+        }
+    }
+}
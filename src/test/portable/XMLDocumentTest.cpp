@@ -0,0 +1,118 @@
+/*
+ * Copyright 2022 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "pch.h"
+#define BOOST_TEST_MODULE XMLDocumentTest
+#include "GlobalFixture.h"
+#include <boost/test/unit_test.hpp>
+#include <meazure/xml/XMLDocument.h>
+#include <string>
+
+
+BOOST_AUTO_TEST_CASE(TestElements) {
+    MeaXMLDocument document(
+        "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+        "<!-- Leading comment -->\n"
+        "<root a=\"1\" b='two'>\n"
+        "    <child name=\"first\"/>\n"
+        "    <child name=\"second\">text</child>\n"
+        "    <?pi ignored?>\n"
+        "    <!-- comment -->\n"
+        "    <other/>\n"
+        "</root>\n");
+
+    const MeaXMLDocument::Element& root = document.GetRoot();
+    BOOST_TEST(root.m_name == "root");
+    BOOST_TEST(root.m_attributes.size() == 2U);
+    BOOST_TEST(*root.GetAttribute("a") == "1");
+    BOOST_TEST(*root.GetAttribute("b") == "two");
+    BOOST_TEST(root.GetAttribute("c") == nullptr);
+
+    BOOST_TEST(root.m_children.size() == 3U);
+    BOOST_TEST(*root.GetChild("child")->GetAttribute("name") == "first");
+    BOOST_TEST(root.m_children[1].m_text == "text");
+    BOOST_TEST(root.GetChild("other") != nullptr);
+    BOOST_TEST(root.GetChild("missing") == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(TestDoctype) {
+    MeaXMLDocument external("<!DOCTYPE positionLog SYSTEM \"https://www.cthing.com/dtd/PositionLog1.dtd\">"
+                            "<positionLog version=\"1\"/>");
+    BOOST_TEST(external.GetRoot().m_name == "positionLog");
+
+    MeaXMLDocument internal("<!DOCTYPE a [\n"
+                            "    <!ELEMENT a EMPTY>\n"
+                            "    <!-- a comment with a > in it -->\n"
+                            "    <!ATTLIST a b CDATA \"x>y\">\n"
+                            "]>\n"
+                            "<a/>");
+    BOOST_TEST(internal.GetRoot().m_name == "a");
+}
+
+BOOST_AUTO_TEST_CASE(TestReferences) {
+    MeaXMLDocument document("<a v=\"&lt;&gt;&amp;&quot;&apos;\">&#65;&#x42;&#xe9;&#x20AC;<![CDATA[<&>]]></a>");
+
+    BOOST_TEST(*document.GetRoot().GetAttribute("v") == "<>&\"'");
+    BOOST_TEST(document.GetRoot().m_text == "AB\xC3\xA9\xE2\x82\xAC<&>");
+}
+
+BOOST_AUTO_TEST_CASE(TestAttributeNormalization) {
+    MeaXMLDocument document("<a v=\"one\ntwo\tthree\"/>");
+    BOOST_TEST(*document.GetRoot().GetAttribute("v") == "one two three");
+}
+
+BOOST_AUTO_TEST_CASE(TestByteOrderMark) {
+    MeaXMLDocument document("\xEF\xBB\xBF<a/>");
+    BOOST_TEST(document.GetRoot().m_name == "a");
+}
+
+BOOST_AUTO_TEST_CASE(TestErrors) {
+    const char* const malformed[] = {
+        "",
+        "text",
+        "<a>",
+        "<a></b>",
+        "<a b=c/>",
+        "<a b=\"1\" b=\"2\"/>",
+        "<a>&unknown;</a>",
+        "<a>&#xZZ;</a>",
+        "<a/><b/>",
+        "<a><!-- unterminated </a>",
+        "<a><![CDATA[ unterminated </a>"
+    };
+
+    for (const char* text : malformed) {
+        BOOST_CHECK_THROW(MeaXMLDocument document(text), MeaXMLDocumentException);
+    }
+
+    try {
+        MeaXMLDocument document("<a>\n<b>\n</c>\n</a>");
+        BOOST_FAIL("Exception not thrown");
+    } catch (const MeaXMLDocumentException& ex) {
+        BOOST_TEST(ex.GetLine() == 3);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(TestNestingLimit) {
+    std::string deep;
+    for (int i = 0; i < 1000; i++) {
+        deep += "<a>";
+    }
+    BOOST_CHECK_THROW(MeaXMLDocument document(deep), MeaXMLDocumentException);
+}